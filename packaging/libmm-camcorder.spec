@@ -1,6 +1,6 @@
 Name:       libmm-camcorder
 Summary:    Camera and recorder library
-Version:    0.10.192
+Version:    0.10.217
 Release:    0
 Group:      Multimedia/Libraries
 License:    Apache-2.0
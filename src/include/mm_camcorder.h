@@ -1697,6 +1697,23 @@ typedef enum {
 } MMCamStreamData;
 
 
+/**********************************
+*          Preview profile        *
+**********************************/
+/**
+ * An enumeration for measured stage of preview buffer handling.
+ */
+typedef enum {
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_PROBE = 0,   /**< Whole preview probe from entry to return */
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_MAP,         /**< Getting memory of buffer and mapping it */
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_LOCK,        /**< Waiting for the lock of video stream callback */
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_CALLBACK,    /**< Video stream callback of application */
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_BO_SYNC,     /**< TBM bo map and unmap after video stream callback */
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_UNMAP,       /**< Unmapping memory of buffer */
+	MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM,         /**< Number of measured stages */
+} MMCamcorderPreviewProfileStage;
+
+
 /*=======================================================================================
 | STRUCTURE DEFINITIONS									|
 ========================================================================================*/
@@ -1830,10 +1847,61 @@ typedef struct {
 typedef struct {
 	void *data;             /**< pointer of muxed stream */
 	unsigned int length;    /**< length of stream buffer (in byte) */
-	unsigned long long offset;  /**< current offset for data */
+	unsigned long long offset;  /**< current offset for data, it starts from 0 again with each file of segmented recording */
 } MMCamcorderMuxedStreamDataType;
 
 
+/**
+ * Structure for finished segment of segmented recording.
+ */
+typedef struct {
+	const char *filename;           /**< file name of finished segment */
+	unsigned int index;             /**< number of segment, it starts from 1 */
+	unsigned long long duration;    /**< duration of segment (msec) */
+	unsigned long long filesize;    /**< size of segment file (KB) */
+} MMCamcorderRecordingSegmentType;
+
+
+/**
+ * Structure for latency of a stage in preview profile.
+ * The bucket N of histogram counts the latency in [2^(N-1), 2^N) usec,
+ * the bucket 0 counts the latency under 1 usec and the last bucket counts all the longer ones.
+ */
+#define MM_CAMCORDER_PREVIEW_PROFILE_BUCKET_NUM 20
+
+typedef struct {
+	unsigned int count;             /**< number of measurement */
+	unsigned long long total;       /**< sum of latency (usec) */
+	unsigned int min;               /**< minimum latency (usec) */
+	unsigned int max;               /**< maximum latency (usec) */
+	unsigned int histogram[MM_CAMCORDER_PREVIEW_PROFILE_BUCKET_NUM]; /**< histogram of latency */
+} MMCamcorderPreviewProfileStageType;
+
+
+/**
+ * Structure for preview profile.
+ */
+typedef struct {
+	unsigned int frame_count;       /**< number of measured preview buffer */
+	MMCamcorderPreviewProfileStageType stage[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM]; /**< latency of each stage */
+} MMCamcorderPreviewProfileType;
+
+
+/**
+ * Structure for statistics of recording.
+ */
+typedef struct {
+	unsigned long long elapsed;             /**< recording time (msec) */
+	unsigned long long filesize;            /**< recorded file size including expected trailer (KB) */
+	unsigned long long remained_time;       /**< remained time which can be recorded (msec) */
+	unsigned long long trailer_size;        /**< expected trailer size of muxer (byte) */
+	unsigned int dropped_frames;            /**< buffers dropped by storage error, size limit or time limit */
+	unsigned int video_queue_level;         /**< data in video encoder queue (byte) */
+	unsigned int audio_queue_level;         /**< data in audio encoder queue (byte) */
+	unsigned int start_latency;             /**< time from record request to first frame sent to encoder (msec) */
+} MMCamcorderRecordingStatsType;
+
+
 /**
   * Prerequisite information for mm_camcorder_create()
   * The information to set prior to create.
@@ -1928,6 +1996,22 @@ typedef gboolean (*mm_camcorder_audio_stream_callback)(MMCamcorderAudioStreamDat
 typedef gboolean (*mm_camcorder_muxed_stream_callback)(MMCamcorderMuxedStreamDataType *stream, void *user_param);
 
 
+/**
+ *	Function definition for recording segment callback.
+ *  It's called when a segment file of segmented recording is finished.
+ *  Be careful! In this function, you can't call functions that change the state of camcorder such as mm_camcorder_commit() and mm_camcorder_cancel().
+ *  All muxed stream of the finished file is delivered before it's called,
+ *  and muxed stream of the next file is delivered after it returns, starting from offset 0.
+ *  Please don't hang this function long. Next segment is not written until it returns.
+ *
+ *	@param[in]	segment			Reference pointer to finished segment
+ *	@param[in]	user_param		User parameter which is received from user when callback function was set
+ *	@return		This function returns true on success, or false on failure.
+ *	@remarks
+ */
+typedef gboolean (*mm_camcorder_recording_segment_callback)(MMCamcorderRecordingSegmentType *segment, void *user_param);
+
+
 /**
  *	Function definition for video capture callback.
  *  Like '#mm_camcorder_video_stream_callback', you can't call mm_camcorder_stop() while you are hanging this function.
@@ -2969,7 +3053,8 @@ int mm_camcorder_set_audio_stream_callback(MMHandleType camcorder, mm_camcorder_
  *	@see		mm_camcorder_muxed_stream_callback
  *	@pre		None
  *	@post		None
- *	@remarks	registered 'callback' is called on internal thread of camcorder. Regardless of the status of main loop, this function will be called.
+ *	@remarks	registered 'callback' is called on internal thread of camcorder. Regardless of the status of main loop, this function will be called.\n
+ *			In segmented recording, offset is reset to 0 for each file, and recording segment callback is called between files.
  *	@par example
  *	@code
 
@@ -3023,6 +3108,257 @@ int mm_camcorder_get_state(MMHandleType camcorder, MMCamcorderStateType *state);
 int mm_camcorder_get_state2(MMHandleType camcorder, MMCamcorderStateType *state, MMCamcorderStateType *old_state);
 
 
+/**
+ *    mm_camcorder_set_preview_profile:\n
+ *  Enable or disable the latency profiling of preview buffer.
+ *  While it's enabled, each stage of the preview probe is measured with monotonic clock
+ *  and the latency is accumulated to the histogram of the stage.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[in]	enable		Enable(1) or disable(0) the preview profiling.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_get_preview_profile
+ *	@pre		None
+ *	@post		None
+ *	@remarks	The preview profiling is disabled by default and it costs nothing while disabled.\n
+ *			Collected data is cleared whenever the preview profiling is enabled.
+ */
+int mm_camcorder_set_preview_profile(MMHandleType camcorder, int enable);
+
+
+/**
+ *    mm_camcorder_get_preview_profile:\n
+ *  Get the latency data of preview buffer collected after mm_camcorder_set_preview_profile() is enabled.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[out]	profile		On return, it contains the latency of each stage.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_set_preview_profile, MMCamcorderPreviewProfileStage
+ *	@pre		None
+ *	@post		None
+ *	@remarks	None
+ *	@par example
+ *	@code
+
+#include <mm_camcorder.h>
+
+gboolean print_callback_latency()
+{
+	MMCamcorderPreviewProfileType profile;
+	MMCamcorderPreviewProfileStageType *stage = NULL;
+
+	mm_camcorder_get_preview_profile(hcam, &profile);
+
+	stage = &profile.stage[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_CALLBACK];
+	if (stage->count > 0)
+		printf("callback latency avg %llu, max %u usec\n", stage->total / stage->count, stage->max);
+
+	return TRUE;
+}
+
+ *	@endcode
+ */
+int mm_camcorder_get_preview_profile(MMHandleType camcorder, MMCamcorderPreviewProfileType *profile);
+
+
+/**
+ *    mm_camcorder_get_jpeg_fallback_count:\n
+ *  Get the count of internal JPEG encoding which used color conversion to I420.
+ *  NV12, YUYV and UYVY source are encoded directly if the encoder supports it,
+ *  otherwise they are converted to I420 before encoding.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[out]	count		On return, it contains the count of fallback to color conversion.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@pre		None
+ *	@post		None
+ *	@remarks	The count is accumulated from the creation of the handle.
+ */
+int mm_camcorder_get_jpeg_fallback_count(MMHandleType camcorder, int *count);
+
+
+/**
+ *    mm_camcorder_get_video_stream_delivery_count:\n
+ *  Get the count of preview frames delivered to video stream callback and dropped before delivery.
+ *  If queue depth of video stream is set in configure, video stream callback is called in another thread
+ *  and preview frames are dropped while the queue is full.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[out]	delivered	On return, it contains the count of frames delivered to video stream callback.
+ *	@param[out]	dropped		On return, it contains the count of frames dropped because the queue is full.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_set_video_stream_callback
+ *	@pre		None
+ *	@post		None
+ *	@remarks	The counts are accumulated from the creation of the handle.\n
+ *			Frames are never dropped if video stream callback is called in the streaming thread.
+ */
+int mm_camcorder_get_video_stream_delivery_count(MMHandleType camcorder, int *delivered, int *dropped);
+
+
+/**
+ *    mm_camcorder_get_recording_stats:\n
+ *  Get the statistics of current or last recording.
+ *  It's updated by every recorded buffer, so it can be read at any time
+ *  instead of waiting for MM_MESSAGE_CAMCORDER_RECORDING_STATUS.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[out]	stats		On return, it contains the statistics of recording.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_set_recording_status_interval
+ *	@pre		None
+ *	@post		None
+ *	@remarks	The statistics is cleared when new recording is started.
+ *	@par example
+ *	@code
+
+#include <mm_camcorder.h>
+
+gboolean print_recording_stats()
+{
+	MMCamcorderRecordingStatsType stats;
+
+	if (mm_camcorder_get_recording_stats(hcam, &stats) != MM_ERROR_NONE)
+		return FALSE;
+
+	printf("elapsed %llu ms, size %llu KB, dropped %u\n", stats.elapsed, stats.filesize, stats.dropped_frames);
+
+	return TRUE;
+}
+
+ *	@endcode
+ */
+int mm_camcorder_get_recording_stats(MMHandleType camcorder, MMCamcorderRecordingStatsType *stats);
+
+
+/**
+ *    mm_camcorder_set_recording_status_interval:\n
+ *  Set the minimum interval of MM_MESSAGE_CAMCORDER_RECORDING_STATUS.
+ *  For example, 250 sends the message 4 times per second.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[in]	interval	Minimum interval in recording time (msec), 0 sends the message for every recorded buffer.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_get_recording_stats
+ *	@pre		None
+ *	@post		None
+ *	@remarks	The default interval is 0.\n
+ *			The message at size limit or time limit is sent regardless of the interval.
+ */
+int mm_camcorder_set_recording_status_interval(MMHandleType camcorder, int interval);
+
+
+/**
+ *    mm_camcorder_set_pre_record:\n
+ *  Keep encoded preview frames of the last @a duration in memory,
+ *  then they are recorded in front of the frames after mm_camcorder_record().
+ *  Frames are kept from a keyframe and the oldest GOP(group of pictures) is discarded as a whole,
+ *  so the recorded file starts with keyframe and has no gap at record start.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[in]	duration	Duration to keep before record start (msec), 0 disables pre-record.
+ *	@param[in]	max_size	Maximum size of kept frames (KB). It's required if @a duration is not 0.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_record
+ *	@pre		None
+ *	@post		None
+ *	@remarks	Pre-record works only with encoded preview format(MM_PIXEL_FORMAT_ENCODED_H264)
+ *			and the same preview and video resolution.\n
+ *			Audio is not captured before record start, so it starts after pre-recorded frames.\n
+ *			Kept frames are discarded when preview is stopped or this function is called again.
+ */
+int mm_camcorder_set_pre_record(MMHandleType camcorder, int duration, int max_size);
+
+
+/**
+ *    mm_camcorder_set_warm_record:\n
+ *  Keep encoding pipeline ready while preview is running, then recording starts without building it.
+ *  Encoding pipeline is built in background after preview starts,
+ *  and it's kept in READY state for next recording after recording is finished.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[in]	enable		1 to keep encoding pipeline, 0 to remove it.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_record, mm_camcorder_get_recording_stats
+ *	@pre		None
+ *	@post		None
+ *	@remarks	It's supported only in video capture mode.\n
+ *			Kept encoding pipeline is rebuilt at record start if recording attributes are changed.\n
+ *			Encoder resource is kept together with encoding pipeline,
+ *			so it's removed when the resource is taken by other.\n
+ *			The time from record request to the first encoded frame can be checked with start_latency of recording statistics.
+ */
+int mm_camcorder_set_warm_record(MMHandleType camcorder, int enable);
+
+
+/**
+ *    mm_camcorder_set_recording_segment:\n
+ *  Record to a sequence of files instead of stopping at the limit of recording.
+ *  When MMCAM_TARGET_MAX_SIZE or MMCAM_TARGET_TIME_LIMIT is reached,
+ *  recording rolls over to the next file from a keyframe without restarting encoder and dropping frames,
+ *  and MM_MESSAGE_CAMCORDER_MAX_SIZE and MM_MESSAGE_CAMCORDER_TIME_LIMIT are not sent.
+ *
+ *	@param[in]	camcorder		A handle of camcorder.
+ *	@param[in]	enable			1 to enable segmented recording, 0 to disable it.
+ *	@param[in]	filename_template	Template of segment file name, or NULL.\n
+ *					"%N" is replaced by the number of segment which starts from 1,
+ *					and the others are replaced as g_date_time_format() with local time of segment start.\n
+ *					If it's NULL, the first segment is MMCAM_TARGET_FILENAME
+ *					and "_N" is added in front of its extension for the next ones.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_set_recording_segment_callback
+ *	@pre		Camcorder state should not be MM_CAMCORDER_STATE_RECORDING or MM_CAMCORDER_STATE_PAUSED.
+ *	@post		None
+ *	@remarks	It's supported only in video capture mode with file recording.\n
+ *			Segment is finished at the first keyframe after the limit, so it could be a little longer than the limit.\n
+ *			Segment files should be on the same storage with MMCAM_TARGET_FILENAME.
+ */
+int mm_camcorder_set_recording_segment(MMHandleType camcorder, int enable, const char *filename_template);
+
+
+/**
+ *    mm_camcorder_set_recording_segment_callback:\n
+ *  Set callback which is called when a segment file of segmented recording is finished.
+ *  The last segment is also reported before MM_MESSAGE_CAMCORDER_VIDEO_CAPTURED.
+ *
+ *	@param[in]	camcorder	A handle of camcorder.
+ *	@param[in]	callback	Function pointer of callback function.
+ *	@param[in]	user_data	User parameter for passing to callback function.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@see		mm_camcorder_recording_segment_callback, mm_camcorder_set_recording_segment
+ *	@pre		None
+ *	@post		None
+ *	@remarks	registered 'callback' is called on internal thread of camcorder. Regardless of the status of main loop, this function will be called.
+ */
+int mm_camcorder_set_recording_segment_callback(MMHandleType camcorder, mm_camcorder_recording_segment_callback callback, void *user_data);
+
+
+/**
+ *    mm_camcorder_invalidate_configure:\n
+ *  Invalidate configure which is shared by camcorder handles in the process.
+ *  Configure files are read once and shared by handles created after that,
+ *  so this function should be called if configure files are changed.
+ *
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@pre		None
+ *	@post		Handle created after this reads configure files again.
+ *	@remarks	Handles which are already created keep using their configure until they are destroyed.\n
+ *			Changes of configure files are also detected by modification time when a handle is created.
+ */
+int mm_camcorder_invalidate_configure(void);
+
+
 /**
  *    mm_camcorder_get_attributes:\n
  *  Get attributes of camcorder with given attribute names. This function can get multiple attributes
@@ -3136,6 +3472,70 @@ gboolean setting_attribute()
 int mm_camcorder_set_attributes(MMHandleType camcorder,  char **err_attr_name, const char *attribute_name, ...) G_GNUC_NULL_TERMINATED;
 
 
+/**
+ *    mm_camcorder_begin_attributes:\n
+ *  Begin attribute transaction. Until mm_camcorder_commit_attributes() is called,
+ *  camera resolution, camera rotation, camera flip, display rotation and display flip set by
+ *  mm_camcorder_set_attributes() are stored, but not applied to the pipeline.
+ *
+ *	@param[in]	camcorder	Specifies the camcorder  handle.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@pre		None
+ *	@post		None
+ *	@remarks	Other attributes are applied immediately as before.
+ *	@see		mm_camcorder_commit_attributes, mm_camcorder_set_attributes
+ *	@par example
+ *	@code
+
+#include <mm_camcorder.h>
+
+gboolean change_preview_mode()
+{
+	int err;
+
+	err = mm_camcorder_begin_attributes((MMHandleType)hcam);
+	if (err < 0)
+		return FALSE;
+
+	mm_camcorder_set_attributes((MMHandleType)hcam, NULL,
+				    MMCAM_CAMERA_WIDTH, 1280,
+				    MMCAM_CAMERA_HEIGHT, 720,
+				    NULL);
+	mm_camcorder_set_attributes((MMHandleType)hcam, NULL,
+				    MMCAM_DISPLAY_ROTATION, MM_DISPLAY_ROTATION_90,
+				    NULL);
+
+	//Preview is restarted only once here
+	err = mm_camcorder_commit_attributes((MMHandleType)hcam);
+	if (err < 0)
+		return FALSE;
+
+	return TRUE;
+}
+
+ *	@endcode
+ */
+int mm_camcorder_begin_attributes(MMHandleType camcorder);
+
+
+/**
+ *    mm_camcorder_commit_attributes:\n
+ *  Commit attribute transaction which is begun by mm_camcorder_begin_attributes().
+ *  Stored changes are applied at once, so the caps of video source is set only once
+ *  and preview is restarted only once even though several attributes are changed.
+ *
+ *	@param[in]	camcorder	Specifies the camcorder  handle.
+ *	@return		This function returns zero(MM_ERROR_NONE) on success, or negative value with error code.\n
+ *			Please refer 'mm_error.h' to know the exact meaning of the error.
+ *	@pre		mm_camcorder_begin_attributes() should be called before calling this function.
+ *	@post		None
+ *	@remarks	The transaction is ended even if applying stored changes fails.
+ *	@see		mm_camcorder_begin_attributes, mm_camcorder_set_attributes
+ */
+int mm_camcorder_commit_attributes(MMHandleType camcorder);
+
+
 /**
  *    mm_camcorder_get_attribute_info:\n
  *  Get detail information of the attribute. To manager attributes, an user may want to know the exact character of the attribute,
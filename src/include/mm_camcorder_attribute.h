@@ -198,6 +198,17 @@ typedef enum {
 ========================================================================================*/
 typedef bool (*mmf_cam_commit_func_t)(MMHandleType handle, int attr_idx, const MMAttrsValue *value);
 
+/**
+ * Changes recorded by commit functions while attribute transaction is begun
+ */
+typedef enum {
+	_MMCAMCORDER_ATTR_PENDING_NONE = 0,
+	_MMCAMCORDER_ATTR_PENDING_CAPS = (1 << 0),      /* camera resolution or rotation - caps of video source */
+	_MMCAMCORDER_ATTR_PENDING_RESTART = (1 << 1),   /* preview restart for resolution change in PREPARE state */
+	_MMCAMCORDER_ATTR_PENDING_SENSOR = (1 << 2),    /* camera flip */
+	_MMCAMCORDER_ATTR_PENDING_DISPLAY = (1 << 3),   /* display rotation or flip */
+} _MMCamcorderAttrPending;
+
 /*=======================================================================================
 | STRUCTURE DEFINITIONS									|
 ========================================================================================*/
@@ -227,6 +238,38 @@ typedef struct {
 	mmf_cam_commit_func_t attr_commit;
 } mm_cam_attr_construct_info;
 
+/**
+ * Structure of attribute transaction
+ */
+typedef struct {
+	gboolean active;              /**< transaction is begun */
+	unsigned int pending;         /**< _MMCamcorderAttrPending flags */
+} _MMCamcorderAttrTransaction;
+
+/**
+ * Typed copy of attributes which are read in streaming threads
+ */
+typedef struct {
+	double audio_volume;          /**< MMCAM_AUDIO_VOLUME */
+	int audio_format;             /**< MMCAM_AUDIO_FORMAT */
+	int audio_channel;            /**< MMCAM_AUDIO_CHANNEL */
+	int image_encoder;            /**< MMCAM_IMAGE_ENCODER */
+	int image_encoder_quality;    /**< MMCAM_IMAGE_ENCODER_QUALITY */
+	int tag_enable;               /**< MMCAM_TAG_ENABLE */
+	int capture_break_cont_shot;  /**< MMCAM_CAPTURE_BREAK_CONTINUOUS_SHOT */
+} _MMCamcorderAttrSnapshot;
+
+/**
+ * Structure of published attribute snapshot.
+ * Published snapshot is not modified, new one replaces it when attribute is committed.
+ */
+typedef struct {
+	_MMCamcorderAttrSnapshot *current;  /**< published snapshot */
+	gint readers;                       /**< count of readers which are copying snapshot */
+	GSList *retired;                    /**< replaced snapshots, freed when there is no reader */
+	GMutex lock;                        /**< lock for writers */
+} _MMCamcorderAttrSnapshotInfo;
+
 /*=======================================================================================
 | CONSTANT DEFINITIONS									|
 ========================================================================================*/
@@ -306,6 +349,59 @@ int _mmcamcorder_set_attributes(MMHandleType handle, char **err_attr_name, const
  */
 int _mmcamcorder_get_attribute_info(MMHandleType handle, const char *attr_name, MMCamAttrsInfo *info);
 
+/**
+ * This function begins attribute transaction.
+ * Until it's committed, commit functions of resolution, rotation and flip record the change
+ * instead of applying it to pipeline.
+ *
+ * @param[in]	handle		Handle of camcorder.
+ * @return	This function returns MM_ERROR_NONE on Success, minus on Failure.
+ * @remarks
+ * @see		_mmcamcorder_commit_attributes
+ */
+int _mmcamcorder_begin_attributes(MMHandleType handle);
+
+/**
+ * This function ends attribute transaction and applies recorded changes at once.
+ * Video source caps is set once, and preview is restarted once if resolution is changed.
+ *
+ * @param[in]	handle		Handle of camcorder.
+ * @return	This function returns MM_ERROR_NONE on Success, minus on Failure.
+ * @remarks
+ * @see		_mmcamcorder_begin_attributes
+ */
+int _mmcamcorder_commit_attributes(MMHandleType handle);
+
+/**
+ * This function copies published attribute snapshot without name lookup and lock.
+ * It's for streaming threads which read attributes for every buffer.
+ *
+ * @param[in]	handle		Handle of camcorder.
+ * @param[out]	snapshot	Copy of published snapshot.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_refresh_attr_snapshot
+ */
+void _mmcamcorder_get_attr_snapshot(MMHandleType handle, _MMCamcorderAttrSnapshot *snapshot);
+
+/**
+ * This function publishes attribute snapshot with current values of attributes.
+ *
+ * @param[in]	handle		Handle of camcorder.
+ * @return	void
+ * @remarks	Snapshot is updated by commit of attribute after this.
+ * @see		_mmcamcorder_get_attr_snapshot
+ */
+void _mmcamcorder_refresh_attr_snapshot(MMHandleType handle);
+
+/**
+ * This function releases published and replaced attribute snapshots.
+ *
+ * @param[in]	handle		Handle of camcorder.
+ * @return	void
+ */
+void _mmcamcorder_clear_attr_snapshot(MMHandleType handle);
+
 /*=======================================================================================
 | CAMCORDER INTERNAL LOCAL								|
 ========================================================================================*/
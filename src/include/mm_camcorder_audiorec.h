@@ -48,6 +48,7 @@ typedef struct {
 	guint64 max_size;		/**< max recording size */
 	guint64 max_time;		/**< max recording time */
 	int fileformat;			/**< recording file format */
+	int level_per_channel;		/**< report the loudest channel level instead of whole channels */
 } _MMCamcorderAudioInfo;
 
 /*=======================================================================================
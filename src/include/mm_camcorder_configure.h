@@ -187,10 +187,47 @@ struct _conf_info_table {
 	};
 };
 
+typedef struct _conf_index_item conf_index_item;
+struct _conf_index_item {
+	const conf_info_table *table;   /* default value in matching table */
+	void *detail;                   /* value from ini file, NULL if it's not set */
+};
+
 typedef struct _camera_conf camera_conf;
 struct _camera_conf {
 	int type;
 	conf_detail **info;
+	GHashTable **index;             /* name to conf_index_item for each category */
+	void *cache_addr;               /* mapped cache, details are placed in it if it's not NULL */
+	size_t cache_size;
+	int ref_count;                  /* number of handles which share it */
+	char *store_key;                /* key in shared configure store, NULL if it's not stored */
+	gint64 source_mtime;            /* ini file status to check update */
+	guint64 source_size;
+	guint64 source_inode;
+};
+
+/* header of binary cache file, pointers in cache are saved as offset from the start of file */
+typedef struct _conf_cache_header conf_cache_header;
+struct _conf_cache_header {
+	guint32 magic;
+	guint32 version;
+	guint32 pointer_size;
+	guint32 type;
+	guint32 table_hash;             /* hash of matching table to check library update */
+	guint32 reloc_count;            /* number of pointers to be fixed up */
+	guint64 reloc_offset;           /* offset of pointer offset array */
+	guint64 total_size;
+	gint64 source_mtime;            /* ini file mtime in nanoseconds */
+	guint64 source_size;
+	guint64 source_inode;
+	guint64 category[CONFIGURE_CATEGORY_MAIN_NUM]; /* offset of conf_detail, 0 if it's not set */
+};
+
+typedef struct _conf_cache_builder conf_cache_builder;
+struct _conf_cache_builder {
+	GByteArray *data;
+	GArray *reloc;                  /* offsets of pointer to be fixed up */
 };
 
 /*=======================================================================================
@@ -223,6 +260,17 @@ int _mmcamcorder_conf_get_info(MMHandleType handle, int type, const char *ConfFi
  */
 void _mmcamcorder_conf_release_info(MMHandleType handle, camera_conf **configure_info);
 
+/**
+ * This function invalidates configure info which is shared by handles.
+ * Handle created after this reads ini file again, and handles which already have it keep using it.
+ *
+ * @return	None
+ * @remarks
+ * @see		_mmcamcorder_conf_get_info()
+ *
+ */
+void _mmcamcorder_conf_invalidate(void);
+
 /**
  * This function gets integer type value from configure info.
  *
@@ -397,6 +445,7 @@ int _mmcamcorder_conf_get_default_value_int(MMHandleType handle, int type, int c
 int _mmcamcorder_conf_get_default_value_string(MMHandleType handle, int type, int category, const char *name, const char **value);
 int _mmcamcorder_conf_get_default_element(MMHandleType handle, int type, int category, const char *name, type_element **element);
 int _mmcamcorder_conf_get_category_size(MMHandleType handle, int type, int category, int *size);
+conf_index_item *_mmcamcorder_conf_find_index(camera_conf *configure_info, int category, const char *name);
 
 #ifdef __cplusplus
 }
@@ -29,11 +29,19 @@
 #include <libexif/exif-tag.h>
 #include <libexif/exif-format.h>
 #include <libexif/exif-data.h>
+#include <sys/uio.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*=======================================================================================
+| MACRO DEFINITIONS									|
+========================================================================================*/
+#define MM_EXIF_JPEG_HEADER_LENGTH      6       /* SOI + APP1 marker + length of APP1 */
+#define MM_EXIF_JPEG_SEGMENT_MAX        4
+#define MM_EXIF_TEMPLATE_ENTRY_MAX      64
+
 /*=======================================================================================
 | STRUCTURE DEFINITIONS									|
 ========================================================================================*/
@@ -45,6 +53,55 @@ typedef struct {
 	unsigned int size;		/**< size of saved exif data*/
 } mm_exif_info_t;
 
+/**
+ * Structure for JPEG with exif as segment list.
+ * Exif and JPEG data are referred, not copied, so they should be kept while the segments are used.
+ */
+typedef struct {
+	unsigned char header[MM_EXIF_JPEG_HEADER_LENGTH];  /**< SOI, APP1 marker and length of APP1 */
+	struct iovec segment[MM_EXIF_JPEG_SEGMENT_MAX];     /**< header, exif and JPEG data except SOI and old exif */
+	int count;                                          /**< number of segment */
+	unsigned int length;                                /**< total length of segments */
+} mm_exif_jpeg_segments_t;
+
+/**
+ * State of exif template.
+ */
+typedef enum {
+	MM_EXIF_TEMPLATE_STATE_NONE = 0,    /**< no template */
+	MM_EXIF_TEMPLATE_STATE_RECORD,      /**< recording entries while exif is made */
+	MM_EXIF_TEMPLATE_STATE_READY,       /**< template is ready to be patched */
+	MM_EXIF_TEMPLATE_STATE_PATCH,       /**< patching entries of template */
+	MM_EXIF_TEMPLATE_STATE_MISMATCH,    /**< entries are not matched with template while patching */
+} mm_exif_template_state_e;
+
+/**
+ * Structure for entry of exif template.
+ */
+typedef struct {
+	ExifIfd ifd;                /**< ifd of entry */
+	ExifTag tag;                /**< exif tag */
+	ExifFormat format;          /**< exif format */
+	unsigned long components;   /**< number of components */
+	unsigned int offset;        /**< offset of value in serialized exif, 0 if tag is set again later */
+} mm_exif_template_entry_t;
+
+/**
+ * Structure for serialized exif which is reused by patching values of entries in place.
+ * Entries should be set in same order with same format and components to be patched,
+ * otherwise the template is dropped and exif should be made again.
+ */
+typedef struct {
+	mm_exif_template_state_e state;                          /**< state of template */
+	unsigned char *data;                                     /**< serialized exif */
+	unsigned int size;                                       /**< size of serialized exif */
+	unsigned char *patch;                                    /**< copy of data being patched */
+	ExifByteOrder order;                                     /**< byte order of serialized exif */
+	mm_exif_template_entry_t entry[MM_EXIF_TEMPLATE_ENTRY_MAX]; /**< entries in order of setting */
+	int count;                                               /**< number of entries */
+	int cursor;                                              /**< index of entry to be patched next */
+} mm_exif_template_t;
+
 /*=======================================================================================
 | GLOBAL FUNCTION PROTOTYPES								|
 ========================================================================================*/
@@ -125,6 +182,19 @@ int mm_exif_write_exif_jpeg_to_memory(void **mem, unsigned int *length,
 				      mm_exif_info_t *info, unsigned char *jpeg,
 				      unsigned int jpeg_len);
 
+/**
+ * Get segment list of jpeg with exif info, without copying image data.
+ * First segment refers header in segments structure, so it should not be moved while it's used.
+ * @param[out] segments segment list.
+ * @param[in] info exif info.
+ * @param[in] jpeg jpeg image data.
+ * @param[in] length length of jpeg image.
+ * @return return int.
+ */
+int mm_exif_get_exif_jpeg_segments(mm_exif_jpeg_segments_t *segments,
+				   mm_exif_info_t *info, unsigned char *jpeg,
+				   unsigned int jpeg_len);
+
 /**
  * Load exif info from a jpeg memory buffer.
  * @param[out] info exif info.
@@ -134,6 +204,59 @@ int mm_exif_write_exif_jpeg_to_memory(void **mem, unsigned int *length,
  */
 int mm_exif_load_exif_info(mm_exif_info_t **info, void *jpeg_data, int jpeg_length);
 
+/**
+ * Start recording entries to make exif template.
+ * @param[in] tmpl exif template.
+ * @return void
+ */
+void mm_exif_template_record_begin(mm_exif_template_t *tmpl);
+
+/**
+ * Finish recording and keep serialized exif info as template.
+ * @param[in] tmpl exif template.
+ * @param[in] info exif info which is made with recorded entries.
+ * @return return int.
+ */
+int mm_exif_template_record_end(mm_exif_template_t *tmpl, mm_exif_info_t *info);
+
+/**
+ * Start patching entries of exif template.
+ * @param[in] tmpl exif template.
+ * @return return int. error is returned if template is not ready.
+ */
+int mm_exif_template_patch_begin(mm_exif_template_t *tmpl);
+
+/**
+ * Finish patching and move patched exif to exif info.
+ * @param[in] tmpl exif template.
+ * @param[in/out] info exif info.
+ * @return return int. error is returned if entries are not matched with template.
+ */
+int mm_exif_template_patch_end(mm_exif_template_t *tmpl, mm_exif_info_t *info);
+
+/**
+ * Set one tag information.
+ * Value is patched in template while patching, otherwise it's added into exif and recorded if recording.
+ * @param[in] tmpl exif template.
+ * @param[in] exif exif data. it's not used while patching.
+ * @param[in] ifd tag content category.
+ * @param[in] tag exif tag.
+ * @param[in] format tag format.
+ * @param[in] components the number of the component.
+ * @param[in] data the pointer of the tag data.
+ * @return return int.
+ */
+int mm_exif_template_set_entry(mm_exif_template_t *tmpl, ExifData *exif, ExifIfd ifd, ExifTag tag,
+			       ExifFormat format, unsigned long components,
+			       const char *data);
+
+/**
+ * Release exif template.
+ * @param[in] tmpl exif template.
+ * @return void
+ */
+void mm_exif_template_clear(mm_exif_template_t *tmpl);
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,71 @@ typedef struct {
 	char *name;			/**< gstreamer element name*/
 } _MMCamcorderElementName;
 
+/**
+ * Muxed buffer waiting for delivery
+ */
+typedef struct {
+	GstBuffer *buffer;		/**< reference of muxed buffer */
+	guint64 offset;			/**< offset of buffer in muxed stream */
+} _MMCamcorderMstreamItem;
+
+/**
+ * Delivery thread of muxed stream callback.
+ * Contiguous muxed buffers are delivered as a chunk by size or time threshold, then muxer is not blocked by application
+ * until queue is full.
+ */
+typedef struct {
+	GThread *thread;		/**< delivery thread, NULL if muxed stream is delivered in muxer thread */
+	GMutex lock;
+	GCond cond;
+	GQueue queue;			/**< muxed buffers waiting for delivery */
+	guint64 queued_size;		/**< total size of queued buffers */
+	guint64 queue_max;		/**< maximum size of queued buffers */
+	gsize chunk_size;		/**< chunk is delivered when its size reaches it */
+	gint64 chunk_time;		/**< chunk is delivered when it's kept longer than it (usec) */
+	guint dropped;			/**< dropped buffer count because recording is canceled */
+	guint blocked;			/**< count of muxer waiting because queue is full */
+	gboolean cancel;		/**< drop muxed data until reset */
+	gboolean discard;		/**< discard chunk which is not delivered */
+	gboolean flush;			/**< deliver all remained data */
+	gboolean exit;
+} _MMCamcorderMstreamDelivery;
+
+/**
+ * Policy of video stream delivery when queue is full
+ */
+typedef enum {
+	_MMCAMCORDER_VSTREAM_DROP_NEWEST = 0,	/**< Drop the frame which is just arrived */
+	_MMCAMCORDER_VSTREAM_DROP_OLDEST,	/**< Drop the oldest frame in queue */
+} _MMCamcorderVstreamDropPolicy;
+
+/**
+ * Preview buffer waiting for delivery
+ */
+typedef struct {
+	GstBuffer *buffer;		/**< reference of preview buffer */
+	int width;			/**< width of preview buffer */
+	int height;			/**< height of preview buffer */
+	int format;			/**< MMPixelFormatType of preview buffer */
+} _MMCamcorderVstreamItem;
+
+/**
+ * Delivery thread of video stream callback.
+ * Preview buffer is queued in the probe, then the streaming thread of camera source is not blocked by application.
+ */
+typedef struct {
+	GThread *thread;		/**< delivery thread, NULL if video stream is delivered in streaming thread */
+	GMutex lock;
+	GCond cond;
+	GQueue queue;			/**< preview buffers waiting for delivery */
+	int depth;			/**< maximum count of queued preview buffers */
+	int drop_policy;		/**< _MMCamcorderVstreamDropPolicy */
+	gint delivered;			/**< delivered frame count */
+	gint dropped;			/**< dropped frame count because queue is full */
+	gboolean flush;			/**< deliver all queued buffers */
+	gboolean exit;
+} _MMCamcorderVstreamDelivery;
+
 /*=======================================================================================
 | CONSTANT DEFINITIONS									|
 ========================================================================================*/
@@ -180,8 +245,125 @@ bool _mmcamcorder_set_camera_resolution(MMHandleType handle, int width, int heig
 bool _mmcamcorder_set_encoded_preview_bitrate(MMHandleType handle, int bitrate);
 bool _mmcamcorder_set_encoded_preview_gop_interval(MMHandleType handle, int gop_interval);
 bool _mmcamcorder_set_sound_stream_info(GstElement *element, char *stream_type, int stream_index);
+
+/**
+ * This function makes a buffer of silence which has same size and metadata with given buffer.
+ * Memory of silence is shared by the buffers, so it costs no copy and no memset for muted audio.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	buffer		Audio buffer to be muted.
+ * @return	This function returns new buffer on success, or NULL on failure.
+ * @remarks	Memory of returned buffer is read-only.
+ */
+GstBuffer *_mmcamcorder_get_silence_buffer(MMHandleType handle, GstBuffer *buffer);
 void _mmcamcorder_set_encoder_bitrate(MMCamcorderEncoderType type, int codec, int bitrate, GstElement *element);
 GstPadProbeReturn __mmcamcorder_muxed_dataprobe(GstPad *pad, GstPadProbeInfo *info, gpointer u_data);
+
+/**
+ * This function creates delivery thread of muxed stream callback.
+ * It's not created if chunk size in configuration is 0, then muxed stream is delivered in muxer thread.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ * @see		_mmcamcorder_mstream_delivery_destroy()
+ */
+int _mmcamcorder_mstream_delivery_create(MMHandleType handle);
+
+/**
+ * This function creates delivery thread of muxed stream callback with given settings.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	chunk_size	Chunk is delivered when its size reaches it.
+ * @param[in]	chunk_time	Chunk is delivered when it's kept longer than it (msec).
+ * @param[in]	queue_size	Maximum size of queued data, muxer waits if it's full.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ * @see		_mmcamcorder_mstream_delivery_create()
+ */
+int _mmcamcorder_mstream_delivery_start(MMHandleType handle, int chunk_size, int chunk_time, int queue_size);
+
+/**
+ * This function waits until all queued muxed data is delivered to application.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_mstream_delivery_flush(MMHandleType handle);
+
+/**
+ * This function drops all queued muxed data, and muxed data after this is dropped until reset.
+ * Muxer which waits for space is released.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_mstream_delivery_reset()
+ */
+void _mmcamcorder_mstream_delivery_cancel(MMHandleType handle);
+
+/**
+ * This function makes muxed data delivered again after cancel. It's called when recording starts.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_mstream_delivery_cancel()
+ */
+void _mmcamcorder_mstream_delivery_reset(MMHandleType handle);
+
+/**
+ * This function delivers remained muxed data and destroys delivery thread.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_mstream_delivery_create()
+ */
+void _mmcamcorder_mstream_delivery_destroy(MMHandleType handle);
+
+/**
+ * This function creates delivery thread of video stream callback.
+ * It's not created if queue depth in configuration is 0, then video stream is delivered in streaming thread.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ * @see		_mmcamcorder_vstream_delivery_destroy()
+ */
+int _mmcamcorder_vstream_delivery_create(MMHandleType handle);
+
+/**
+ * This function creates delivery thread of video stream callback with given queue depth and drop policy.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	depth		Maximum count of queued preview buffers, 0 means delivery in streaming thread.
+ * @param[in]	drop_policy	_MMCamcorderVstreamDropPolicy when queue is full.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks	Delivered and dropped counts are reset. Thread should not exist, call _mmcamcorder_vstream_delivery_destroy() before restarting.
+ * @see		_mmcamcorder_vstream_delivery_create()
+ */
+int _mmcamcorder_vstream_delivery_start(MMHandleType handle, int depth, int drop_policy);
+
+/**
+ * This function waits until all queued preview buffers are delivered to application.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_vstream_delivery_flush(MMHandleType handle);
+
+/**
+ * This function delivers queued preview buffers and destroys delivery thread.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_vstream_delivery_create()
+ */
+void _mmcamcorder_vstream_delivery_destroy(MMHandleType handle);
 GstPadProbeReturn __mmcamcorder_eventprobe_monitor(GstPad *pad, GstPadProbeInfo *info, gpointer u_data);
 #ifdef __cplusplus
 }
@@ -440,6 +440,11 @@ do { \
 #define _MMCAMCORDER_TRYLOCK_MSTREAM_CALLBACK(handle)       _MMCAMCORDER_TRYLOCK_FUNC(_MMCAMCORDER_GET_MSTREAM_CALLBACK_LOCK(handle))
 #define _MMCAMCORDER_UNLOCK_MSTREAM_CALLBACK(handle)        _MMCAMCORDER_UNLOCK_FUNC(_MMCAMCORDER_GET_MSTREAM_CALLBACK_LOCK(handle))
 
+#define _MMCAMCORDER_GET_SEGMENT_CALLBACK_LOCK(handle)      (_MMCAMCORDER_CAST_MTSAFE(handle).segment_cb_lock)
+#define _MMCAMCORDER_LOCK_SEGMENT_CALLBACK(handle)          _MMCAMCORDER_LOCK_FUNC(_MMCAMCORDER_GET_SEGMENT_CALLBACK_LOCK(handle))
+#define _MMCAMCORDER_TRYLOCK_SEGMENT_CALLBACK(handle)       _MMCAMCORDER_TRYLOCK_FUNC(_MMCAMCORDER_GET_SEGMENT_CALLBACK_LOCK(handle))
+#define _MMCAMCORDER_UNLOCK_SEGMENT_CALLBACK(handle)        _MMCAMCORDER_UNLOCK_FUNC(_MMCAMCORDER_GET_SEGMENT_CALLBACK_LOCK(handle))
+
 #ifdef _MMCAMCORDER_MM_RM_SUPPORT
 /* for resource conflict */
 #define _MMCAMCORDER_GET_RESOURCE_LOCK(handle)              (_MMCAMCORDER_CAST_MTSAFE(handle).resource_lock)
@@ -599,6 +604,7 @@ typedef enum {
 	_MMCAMCORDER_TASK_THREAD_STATE_SOUND_SOLO_PLAY_START,
 	_MMCAMCORDER_TASK_THREAD_STATE_ENCODE_PIPE_CREATE,
 	_MMCAMCORDER_TASK_THREAD_STATE_CHECK_CAPTURE_IN_RECORDING,
+	_MMCAMCORDER_TASK_THREAD_STATE_ENCODE_PIPE_WARM,
 	_MMCAMCORDER_TASK_THREAD_STATE_EXIT,
 } _MMCamcorderTaskThreadState;
 
@@ -636,6 +642,15 @@ typedef struct {
 	struct timeval last_video_time;	/**< last measurement time */
 } _MMCamcorderKPIMeasure;
 
+/**
+ * MMCamcorder information for latency profiling of preview buffer
+ */
+typedef struct {
+	gint enable;                            /**< whether profiling is enabled (accessed atomically) */
+	GMutex lock;                            /**< mutex for profile data */
+	MMCamcorderPreviewProfileType data;     /**< collected profile data */
+} _MMCamcorderPreviewProfile;
+
 /**
  * MMCamcorder information for Multi-Thread Safe
  */
@@ -653,6 +668,7 @@ typedef struct {
 	GMutex vstream_cb_lock;         /**< Mutex (for video stream callback) */
 	GMutex astream_cb_lock;         /**< Mutex (for audio stream callback) */
 	GMutex mstream_cb_lock;         /**< Mutex (for muxed stream callback) */
+	GMutex segment_cb_lock;         /**< Mutex (for recording segment callback) */
 #ifdef _MMCAMCORDER_MM_RM_SUPPORT
 	GMutex resource_lock;           /**< Mutex (for resource check) */
 #endif /* _MMCAMCORDER_MM_RM_SUPPORT */
@@ -690,6 +706,10 @@ typedef struct {
 	gboolean audio_disable;                 /**< whether audio is disabled or not when record */
 	int videosrc_rotate;                    /**< rotate of videosrc */
 	unsigned long long muxed_stream_offset; /**< current offset for muxed stream data */
+	_MMCamcorderMuxIndex mux_index;         /**< atom index of muxed stream for writing metadata */
+	GstMemory *silence_memory;              /**< zero-filled memory shared by muted audio buffers */
+	gboolean encode_pipe_parked;            /**< encoding pipeline is kept in READY for next recording */
+	_MMCamcorderEncodeSettings encode_settings;     /**< settings which encoding pipeline is built with */
 
 	/* For dropping video frame when start recording */
 	int drop_vframe;                        /**< When this value is bigger than zero and pass_first_vframe is zero, MSL will drop video frame though cam_stability count is bigger then zero. */
@@ -729,11 +749,12 @@ typedef struct mmf_camcorder {
 	MMHandleType attributes;               /**< Attribute handle */
 	_MMCamcorderSubContext *sub_context;   /**< sub context */
 	mm_exif_info_t *exif_info;             /**< EXIF */
+	mm_exif_template_t exif_template;      /**< EXIF of previous capture to be patched for next one */
 	GList *buffer_probes;                  /**< a list of buffer probe handle */
 	GList *event_probes;                   /**< a list of event probe handle */
 	GList *signals;                        /**< a list of signal handle */
 #ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-	GList *msg_data;                       /**< a list of msg data */
+	GSource *msg_source;                   /**< message ring source */
 #endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 	camera_conf *conf_main;                /**< Camera configure Main structure */
 	camera_conf *conf_ctrl;                /**< Camera configure Control structure */
@@ -754,6 +775,8 @@ typedef struct mmf_camcorder {
 	void *astream_cb_param;                                 /**< Audio stream callback parameter */
 	mm_camcorder_muxed_stream_callback mstream_cb;          /**< Muxed stream callback */
 	void *mstream_cb_param;                                 /**< Muxed stream callback parameter */
+	mm_camcorder_recording_segment_callback segment_cb;     /**< Recording segment callback */
+	void *segment_cb_param;                                 /**< Recording segment callback parameter */
 	mm_camcorder_video_capture_callback vcapture_cb;        /**< Video capture callback */
 	void *vcapture_cb_param;                                /**< Video capture callback parameter */
 	int (*command)(MMHandleType, int);                      /**< camcorder's command */
@@ -780,8 +803,23 @@ typedef struct mmf_camcorder {
 	int capture_sound_count;                                /**< count for capture sound */
 	char *root_directory;                                   /**< Root directory for device */
 	int resolution_changed;                                 /**< Flag for preview resolution change */
+	_MMCamcorderAttrTransaction attr_transaction;           /**< Attribute transaction */
+	_MMCamcorderAttrSnapshotInfo attr_snapshot;             /**< Attribute snapshot for streaming threads */
 	int interrupt_code;                                     /**< Interrupt code */
 	int recreate_decoder;                                   /**< Flag of decoder element recreation for encoded preview format */
+	_MMCamcorderPreviewProfile preview_profile;             /**< Latency profiling of preview buffer */
+	_MMCamcorderBufferPool buffer_pool;                     /**< Buffer pool for color conversion of capture */
+	_MMCamcorderBurstArena burst_arena;                     /**< Arena for intermediate buffers of burst capture */
+	GThreadPool *stripe_pool;                               /**< Worker pool for stripe color conversion */
+	int stripe_thread_num;                                  /**< Thread number for stripe including caller thread */
+	_MMCamcorderCapturePipeline capture_pipeline;           /**< Worker threads for capture post-processing */
+	_MMCamcorderMstreamDelivery mstream_delivery;           /**< Delivery thread of muxed stream callback */
+	_MMCamcorderVstreamDelivery vstream_delivery;           /**< Delivery thread of video stream callback */
+	_MMCamcorderPreRecord pre_record;                       /**< Ring of encoded preview frames before record start */
+	gint warm_record;                                       /**< Build encoding pipeline during preview and keep it after recording */
+	_MMCamcorderSegment segment;                            /**< Segmented recording */
+	gint jpeg_direct_unsupported;                           /**< Bit mask of formats which are not supported for direct JPEG encoding */
+	gint jpeg_fallback_count;                               /**< Count of JPEG encoding with color conversion */
 
 	_MMCamcorderInfoConverting caminfo_convert[CAMINFO_CONVERT_NUM];        /**< converting structure of camera info */
 	_MMCamcorderEnumConvert enum_conv[ENUM_CONVERT_NUM];                    /**< enum converting list that is modified by ini info */
@@ -817,6 +855,8 @@ typedef struct mmf_camcorder {
 
 	/* Storage */
 	_MMCamcorderStorageInfo storage_info;                   /**< Storage information */
+	_MMCamcorderFreeSpaceTracker free_space_tracker;        /**< Free space tracker for recording */
+	_MMCamcorderRecordingStats recording_stats;             /**< Statistics of recording */
 
 #ifdef _MMCAMCORDER_RM_SUPPORT
 	rm_category_request_s request_resources;
@@ -1076,6 +1116,20 @@ int _mmcamcorder_set_muxed_stream_callback(MMHandleType handle,
 					   mm_camcorder_muxed_stream_callback callback,
 					   void *user_data);
 
+/**
+ *	This function is to set callback for finished segment of segmented recording.
+ *
+ *	@param[in]	handle		Specifies the camcorder  handle
+ *	@param[in]	callback	Specifies the function pointer of callback function
+ *	@param[in]	user_data	Specifies the user poiner for passing to callback function
+ *
+ *	@return		This function returns zero on success, or negative value with error code.
+ *	@see		mmcamcorder_error_type
+ */
+int _mmcamcorder_set_recording_segment_callback(MMHandleType handle,
+					mm_camcorder_recording_segment_callback callback,
+					void *user_data);
+
 /**
  *	This function is to set callback for video capture.
  *
@@ -1283,6 +1337,11 @@ int _mmcamcorder_read_vidsrc_info(int videodevidx, camera_conf **configure_info)
 void _mmcamcorder_video_current_framerate_init(MMHandleType handle);
 int _mmcamcorder_video_current_framerate(MMHandleType handle);
 int _mmcamcorder_video_average_framerate(MMHandleType handle);
+int _mmcamcorder_set_preview_profile(MMHandleType handle, int enable);
+int _mmcamcorder_get_preview_profile(MMHandleType handle, MMCamcorderPreviewProfileType *profile);
+int _mmcamcorder_get_jpeg_fallback_count(MMHandleType handle, int *count);
+int _mmcamcorder_get_video_stream_delivery_count(MMHandleType handle, int *delivered, int *dropped);
+void _mmcamcorder_update_preview_profile(MMHandleType handle, gint64 *stage_time);
 
 /* for stopping forcedly */
 void __mmcamcorder_force_stop(mmf_camcorder_t *hcamcorder, int state_change_by_system);
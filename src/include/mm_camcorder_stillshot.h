@@ -45,9 +45,21 @@ extern "C" {
 #define _MNOTE_VALUE_NONE				0
 #define _SOUND_STATUS_INIT				-1
 
+#define _MMCAMCORDER_CAPTURE_QUEUE_DEPTH_MAX		16
+
 /*=======================================================================================
 | ENUM DEFINITIONS									|
 ========================================================================================*/
+/**
+ * Stages of capture post-processing
+ */
+typedef enum {
+	_MMCAMCORDER_CAPTURE_STAGE_CONVERT = 0,		/**< Buffer mapping and thumbnail making */
+	_MMCAMCORDER_CAPTURE_STAGE_ENCODE,		/**< Main image encoding */
+	_MMCAMCORDER_CAPTURE_STAGE_EXIF,		/**< EXIF making */
+	_MMCAMCORDER_CAPTURE_STAGE_DELIVER,		/**< Capture callback and message */
+	_MMCAMCORDER_CAPTURE_STAGE_NUM
+} _MMCamcorderCaptureStage;
 
 
 /*=======================================================================================
@@ -75,6 +87,51 @@ typedef struct {
 	gboolean played_capture_sound;			/**< whether play capture sound when capture starts */
 } _MMCamcorderImageInfo;
 
+/**
+ * Captured image which is processed through capture stages
+ */
+typedef struct {
+	GstSample *sample1;				/**< Main image (owned) */
+	GstSample *sample2;				/**< Thumbnail (owned) */
+	GstSample *sample3;				/**< Screennail (owned) */
+	GstMapInfo mapinfo1;
+	GstMapInfo mapinfo2;
+	GstMapInfo mapinfo3;
+	MMCamcorderStateType current_state;		/**< State when image is captured */
+	gboolean failed;				/**< Skip remained stages except releasing */
+	int pixtype_main;				/**< Pixel format of main image */
+	unsigned int stride_main;			/**< Stride of main image from video meta or caps, 0 if unknown */
+	int provide_exif;				/**< Whether source provides EXIF */
+	int tag_enable;					/**< Whether EXIF is added to JPEG */
+	gboolean set_exif_attr;				/**< Whether EXIF raw data attribute is set */
+	MMCamcorderCaptureDataType dest;		/**< Main image for application */
+	MMCamcorderCaptureDataType thumb;		/**< Thumbnail for application */
+	MMCamcorderCaptureDataType scrnail;		/**< Screennail for application */
+	unsigned char *internal_main_data;		/**< Main image encoded in MSL */
+	unsigned int internal_main_length;
+	unsigned char *internal_thumb_data;		/**< Thumbnail encoded in MSL */
+	unsigned int internal_thumb_length;
+	unsigned char *exif_raw_data;			/**< Copy of EXIF for attribute */
+	unsigned int exif_raw_size;
+	int arena_slot;					/**< Slot of burst arena, -1 if not used */
+	_MMCamcorderAttrSnapshot attrs;			/**< Attributes at the time of capture */
+} _MMCamcorderCaptureJob;
+
+/**
+ * Worker threads for capture post-processing off the streaming thread.
+ * Each stage has its own thread and queue, so captured images are delivered in order.
+ */
+typedef struct {
+	GThread *thread[_MMCAMCORDER_CAPTURE_STAGE_NUM];	/**< Worker thread of stage */
+	GQueue queue[_MMCAMCORDER_CAPTURE_STAGE_NUM];		/**< Jobs waiting for stage */
+	GMutex lock;
+	GCond cond;
+	int depth;						/**< Maximum jobs waiting for a stage, 0 means synchronous */
+	int in_flight;						/**< Jobs not released yet */
+	int flushing;						/**< Flush is waiting, capture callback does not wait for command lock */
+	gboolean exit;
+} _MMCamcorderCapturePipeline;
+
 /*=======================================================================================
 | CONSTANT DEFINITIONS									|
 ========================================================================================*/
@@ -139,10 +196,52 @@ int __mmcamcorder_update_exif_info(MMHandleType handle, void *imagedata, int img
 void __mmcamcorder_init_stillshot_info(MMHandleType handle);
 void __mmcamcorder_get_capture_data_from_buffer(MMCamcorderCaptureDataType *capture_data, int pixtype, GstSample *sample);
 void __mmcamcorder_release_jpeg_data(MMHandleType handle, MMCamcorderCaptureDataType *dest, int tag_enable, int provide_exif);
-int __mmcamcorder_capture_save_exifinfo(MMHandleType handle, MMCamcorderCaptureDataType *original, MMCamcorderCaptureDataType *thumbnail, int provide_exif);
-int __mmcamcorder_set_jpeg_data(MMHandleType handle, MMCamcorderCaptureDataType *dest, MMCamcorderCaptureDataType *thumbnail, int provide_exif);
+int __mmcamcorder_capture_save_exifinfo(MMHandleType handle, MMCamcorderCaptureDataType *original, MMCamcorderCaptureDataType *thumbnail, int provide_exif, int arena_slot);
+int __mmcamcorder_set_jpeg_data(MMHandleType handle, MMCamcorderCaptureDataType *dest, MMCamcorderCaptureDataType *thumbnail, int provide_exif, int arena_slot);
 gboolean __mmcamcorder_handoff_callback(GstElement *fakesink, GstBuffer *buffer, GstPad *pad, gpointer u_data);
 
+/**
+ * This function creates worker threads for capture post-processing.
+ * It's not created if queue depth in configuration is 0, then captured image is processed in streaming thread.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ * @see		_mmcamcorder_capture_pipeline_destroy()
+ */
+int _mmcamcorder_capture_pipeline_create(MMHandleType handle);
+
+/**
+ * This function creates worker threads for capture post-processing with given queue depth.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	depth		Maximum jobs waiting for a stage, 0 means synchronous.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks	Worker threads should not exist, call _mmcamcorder_capture_pipeline_destroy() before restarting.
+ * @see		_mmcamcorder_capture_pipeline_create()
+ */
+int _mmcamcorder_capture_pipeline_start(MMHandleType handle, int depth);
+
+/**
+ * This function waits until all captured images in capture stages are released.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks	Capture callback does not wait for command lock while flushing,
+ *		so it can be called with command lock.
+ */
+void _mmcamcorder_capture_pipeline_flush(MMHandleType handle);
+
+/**
+ * This function delivers all captured images in capture stages and destroys worker threads for capture post-processing.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_capture_pipeline_create()
+ */
+void _mmcamcorder_capture_pipeline_destroy(MMHandleType handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -168,6 +168,24 @@ do {\
 	_mmcamcorder_send_message((MMHandleType)handle, &msg);\
 } while (0)
 
+#define _MMCAMCORDER_MSG_RING_SIZE              128     /* should be power of 2 */
+#define _MMCAMCORDER_MSG_DISPATCH_BATCH         16
+#define _MMCAMCORDER_MSG_COALESCED_NUM          2       /* CURRENT_VOLUME, RECORDING_STATUS */
+#define _MMCAMCORDER_MSG_OVERFLOW_SIZE          512
+#define _MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX    2
+#define _MMCAMCORDER_BUFFER_POOL_SIZE           2
+#define _MMCAMCORDER_BUFFER_POOL_ALIGN          64
+#define _MMCAMCORDER_BURST_ARENA_SLOT_MAX       4
+#define _MMCAMCORDER_BURST_ARENA_ALIGN          64
+#define _MMCAMCORDER_STRIPE_THREAD_MAX          8
+#define _MMCAMCORDER_STRIPE_MIN_UNIT            64      /* minimum rows for a stripe */
+#define _MMCAMCORDER_FREE_SPACE_SAMPLE_INTERVAL (G_TIME_SPAN_SECOND)   /* re-sample free space after it */
+#define _MMCAMCORDER_FREE_SPACE_SAMPLE_BYTES    (16 * 1024 * 1024)     /* re-sample free space after writing it */
+#define _MMCAMCORDER_TRAILER_SIZE_INTERVAL      (200 * G_TIME_SPAN_MILLISECOND)  /* query trailer size of muxer again after it */
+#define _MMCAMCORDER_MUX_INDEX_ATOM_MAX         8       /* top level atoms in index */
+#define _MMCAMCORDER_MUX_METADATA_MAX           512     /* metadata written in place */
+#define _MMCAMCORDER_ATOM_WINDOW_SIZE           (64 * 1024)     /* minimum size of mapped window for atom index */
+
 
 /*=======================================================================================
 | ENUM DEFINITIONS									|
@@ -226,6 +244,118 @@ typedef struct {
 	GMutex lock;                /**< mutex for item */
 } _MMCamcorderMsgItem;
 
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+/**
+ * Structure of message ring slot
+ */
+typedef struct {
+	gint sequence;              /**< slot sequence for ring position */
+	gint coalesced;             /**< index of coalesced message + 1, or 0 for message in item */
+	_MMCamcorderMsgItem item;   /**< message item */
+} _MMCamcorderMsgSlot;
+
+/**
+ * Structure of coalesced message
+ * Only the latest one is kept, and it's delivered at the position of marker in ring.
+ */
+typedef struct {
+	gint sequence;              /**< odd while writing, even when stable */
+	gint pending;               /**< marker is in ring and not delivered yet */
+	gint delivered;             /**< sequence of the last delivered one */
+	_MMCamcorderMsgItem item;   /**< latest message item */
+} _MMCamcorderMsgCoalesced;
+
+/**
+ * Structure of message source
+ * Messages are pushed to bounded ring by any thread without lock,
+ * and they are delivered in batch by this source in main loop.
+ * When ring is full, messages are kept in bounded overflow queue until it's drained,
+ * and they are dropped if overflow queue is also full.
+ */
+typedef struct {
+	GSource source;                                                 /**< base source */
+	void *hcamcorder;                                               /**< camcorder handle */
+	gint consumer;                                                  /**< ownership of ring read side */
+	GThread *consumer_thread;                                       /**< thread which is delivering messages */
+	gint wakeup;                                                    /**< main context wakeup requested */
+	gint tail;                                                      /**< write position */
+	gint head;                                                      /**< read position */
+	_MMCamcorderMsgSlot slot[_MMCAMCORDER_MSG_RING_SIZE];           /**< message ring */
+	_MMCamcorderMsgCoalesced coalesced[_MMCAMCORDER_MSG_COALESCED_NUM]; /**< coalesced messages */
+	GMutex overflow_lock;                                           /**< lock for overflow queue */
+	_MMCamcorderMsgSlot *overflow;                                  /**< messages not pushed to full ring, allocated at first overflow */
+	gint overflow_head;                                             /**< read position of overflow queue */
+	gint overflow_count;                                            /**< length of overflow queue */
+	gint overflow_total;                                            /**< total count of overflow */
+	gint overflow_dropped;                                          /**< count of messages dropped when overflow queue is full */
+} _MMCamcorderMsgSource;
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+
+/**
+ * Structure of buffer pool for color conversion
+ */
+typedef struct {
+	GMutex lock;                                                    /**< lock for pool */
+	unsigned char *data[_MMCAMCORDER_BUFFER_POOL_SIZE];             /**< aligned buffer */
+	unsigned int size[_MMCAMCORDER_BUFFER_POOL_SIZE];               /**< allocated size */
+	gboolean in_use[_MMCAMCORDER_BUFFER_POOL_SIZE];                 /**< buffer is in use */
+} _MMCamcorderBufferPool;
+
+/**
+ * Structure of arena for intermediate buffers of burst capture
+ */
+typedef struct {
+	GMutex lock;                                                    /**< lock for arena */
+	unsigned char *data;                                            /**< aligned memory for all slots */
+	unsigned int size;                                              /**< allocated size */
+	unsigned int slot_size;                                         /**< size of a slot */
+	int slot_num;                                                   /**< number of slot for current burst */
+	unsigned int used[_MMCAMCORDER_BURST_ARENA_SLOT_MAX];           /**< used size of slot */
+	gboolean in_use[_MMCAMCORDER_BURST_ARENA_SLOT_MAX];             /**< slot is owned by a captured image */
+	int fallback_count;                                             /**< allocation count out of arena */
+} _MMCamcorderBurstArena;
+
+/**
+ * Function type for stripe processing : [start, end) of total units
+ */
+typedef void (*_MMCamcorderStripeFunc)(void *data, unsigned int start, unsigned int end);
+
+/**
+ * Structure of stripe synchronization
+ */
+typedef struct {
+	GMutex lock;                /**< lock for remained count */
+	GCond cond;                 /**< signaled when a stripe is done */
+	int remained;               /**< remained stripe count */
+} _MMCamcorderStripeSync;
+
+/**
+ * Structure of stripe task
+ */
+typedef struct {
+	_MMCamcorderStripeFunc func;        /**< stripe function */
+	void *data;                         /**< data for stripe function */
+	unsigned int start;                 /**< start unit */
+	unsigned int end;                   /**< end unit (not included) */
+	_MMCamcorderStripeSync *sync;       /**< synchronization */
+} _MMCamcorderStripeTask;
+
+/**
+ * Structure of color conversion information for stripe
+ */
+typedef struct {
+	unsigned char *src;         /**< source data */
+	unsigned char *dst;         /**< destination data */
+	unsigned int width;         /**< source width */
+	unsigned int height;        /**< source height */
+	unsigned int src_stride;    /**< source stride in bytes */
+	gboolean is_uyvy;           /**< UYVY or YUYV for YUV422 source */
+	unsigned int ratio_height;  /**< line step for downscale */
+	unsigned int line_width;    /**< source line width in bytes for downscale */
+	unsigned int jump_width;    /**< source pixel step in bytes for downscale */
+	unsigned int dst_line_size; /**< destination line size in bytes for downscale */
+} _MMCamcorderConvertInfo;
+
 /**
  * Structure of storage information
  */
@@ -234,6 +364,61 @@ typedef struct {
 	int id;
 } _MMCamcorderStorageInfo;
 
+/**
+ * Structure of free space tracker
+ * Free space is estimated by subtracting written bytes from the last sampled one.
+ */
+typedef struct {
+	GMutex lock;                /**< lock for tracker */
+	gboolean valid;             /**< sampled free space is valid */
+	guint64 free_space;         /**< sampled free space */
+	guint64 written;            /**< written bytes after sampling */
+	gint64 sample_time;         /**< monotonic time of sampling */
+} _MMCamcorderFreeSpaceTracker;
+
+/**
+ * Structure of recording statistics
+ * Probes in streaming threads write it with sequence lock, so it's read on demand without blocking them.
+ */
+typedef struct {
+	gint sequence;                          /**< sequence lock : odd while it's written */
+	MMCamcorderRecordingStatsType data;     /**< statistics of current recording */
+	gint64 trailer_time;                    /**< monotonic time of querying trailer size */
+	guint64 status_time;                    /**< recording time(msec) of the last status message */
+	gboolean status_sent;                   /**< whether status message is sent in current recording */
+	gint status_interval;                   /**< minimum interval(msec) of status message, 0 means every buffer */
+} _MMCamcorderRecordingStats;
+
+/**
+ * Structure of atom index of muxed stream
+ * It's recorded while muxed data is written, then metadata can be written without scanning file.
+ */
+typedef struct {
+	gint64 atom_pos[_MMCAMCORDER_MUX_INDEX_ATOM_MAX];   /**< position of top level atoms */
+	int atom_num;               /**< number of top level atoms */
+	gint64 next_pos;            /**< position of next top level atom, -1 if unknown */
+	gint64 file_size;           /**< end of written data */
+	gint64 moov_pos;            /**< position of moov, 0 if not found */
+	guint32 moov_size;          /**< size of moov */
+	gint64 udta_pos;            /**< position of udta in moov, 0 if not found */
+	guint32 udta_size;          /**< size of udta */
+	gint64 free_pos;            /**< position of free(skip) in moov which is reserved by muxer, 0 if not found */
+	guint32 free_size;          /**< size of free */
+	gint64 matrix_pos;          /**< position of composition matrix in tkhd of first trak, 0 if not found */
+} _MMCamcorderMuxIndex;
+
+/**
+ * Structure of mapped window for making atom index from file
+ */
+typedef struct {
+	int fd;                     /**< file descriptor */
+	gint64 file_size;           /**< size of file */
+	long page_size;             /**< page size for offset of mmap */
+	gint64 pos;                 /**< file position of mapped window */
+	gsize size;                 /**< size of mapped window */
+	guchar *data;               /**< mapped window */
+} _MMCamcorderAtomWindow;
+
 
 /*=======================================================================================
 | CONSTANT DEFINITIONS									|
@@ -260,7 +445,8 @@ gboolean _mmcamcorder_link_elements(GList *element_list);
 
 /* Message */
 #ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-gboolean _mmcamcorder_msg_callback(void *data);
+GSource *_mmcamcorder_msg_source_new(MMHandleType handle);
+void _mmcamcorder_msg_source_destroy(MMHandleType handle);
 #endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 gboolean _mmcamcorder_send_message(MMHandleType handle, _MMCamcorderMsgItem *data);
 void _mmcamcorder_remove_message_all(MMHandleType handle);
@@ -271,14 +457,30 @@ int _mmcamcorder_get_pixtype(unsigned int fourcc);
 unsigned int _mmcamcorder_get_fourcc(int pixtype, int codectype, int use_zero_copy_format);
 
 /* JPEG encode */
-gboolean _mmcamcorder_encode_jpeg(void *src_data, unsigned int src_width, unsigned int src_height,
-	int src_format, unsigned int src_length, unsigned int jpeg_quality,
+unsigned int _mmcamcorder_get_sample_stride(GstSample *sample);
+gboolean _mmcamcorder_get_src_stride(int src_format, unsigned int src_width, unsigned int src_height,
+	unsigned int src_length, unsigned int stride_hint, unsigned int *src_stride);
+gboolean _mmcamcorder_encode_jpeg(MMHandleType handle, void *src_data, unsigned int src_width, unsigned int src_height,
+	int src_format, unsigned int src_length, unsigned int stride_hint, unsigned int jpeg_quality,
 	void **result_data, unsigned int *result_length);
+unsigned char *_mmcamcorder_buffer_pool_get(MMHandleType handle, unsigned int size);
+void _mmcamcorder_buffer_pool_put(MMHandleType handle, unsigned char *data);
+void _mmcamcorder_buffer_pool_flush(MMHandleType handle);
+/* burst arena */
+gboolean _mmcamcorder_burst_arena_prepare(MMHandleType handle, int slot_num, unsigned int slot_size);
+int _mmcamcorder_burst_arena_acquire(MMHandleType handle);
+void *_mmcamcorder_burst_arena_alloc(MMHandleType handle, int slot, unsigned int size);
+void _mmcamcorder_burst_arena_free(MMHandleType handle, void *data);
+void _mmcamcorder_burst_arena_release(MMHandleType handle, int slot);
+void _mmcamcorder_burst_arena_flush(MMHandleType handle);
+/* stripe */
+GThreadPool *_mmcamcorder_stripe_pool_new(MMHandleType handle, int *thread_num);
+void _mmcamcorder_stripe_run(MMHandleType handle, _MMCamcorderStripeFunc func, void *data, unsigned int total);
 /* resize */
 gboolean _mmcamcorder_resize_frame(unsigned char *src_data, unsigned int src_width, unsigned int src_height, unsigned int src_length, int src_format,
 	unsigned char **dst_data, unsigned int *dst_width, unsigned int *dst_height, size_t *dst_length);
-gboolean _mmcamcorder_downscale_UYVYorYUYV(unsigned char *src, unsigned int src_width, unsigned int src_height,
-	unsigned char **dst, unsigned int dst_width, unsigned int dst_height);
+gboolean _mmcamcorder_downscale_UYVYorYUYV(MMHandleType handle, unsigned char *src, unsigned int src_width, unsigned int src_height,
+	unsigned char **dst, unsigned int dst_width, unsigned int dst_height, int arena_slot);
 
 /* Recording */
 /* find top level tag only, do not use this function for finding sub level tags.
@@ -293,12 +495,29 @@ gboolean _mmcamcorder_write_udta(FILE *f, int gps_enable, _MMCamcorderLocationIn
 guint64 _mmcamcorder_get_container_size(const guchar *size);
 guint64 _mmcamcorder_get_container_size64(const guchar *size);
 gboolean _mmcamcorder_update_composition_matrix(FILE *f, int orientation);
+void _mmcamcorder_mux_index_reset(_MMCamcorderMuxIndex *index);
+void _mmcamcorder_mux_index_add_data(_MMCamcorderMuxIndex *index, guint64 offset, const guchar *data, gsize size);
+/* write location and orientation(-1 to skip) with atom index, or with index made from mapped file if it's not available.
+   MM_ERROR_CAMCORDER_NOT_SUPPORTED means that file should be scanned */
+int _mmcamcorder_write_metadata_in_place(const char *filename, _MMCamcorderMuxIndex *index,
+	int gps_enable, _MMCamcorderLocationInfo info, _MMCamcorderLocationInfo geotag, int orientation);
 void _mmcamcorder_adjust_recording_max_size(const char *filename, guint64 *max_size);
 
 /* File system */
 int _mmcamcorder_get_storage_validity(MMHandleType handle, const char *filename, guint64 min_space, gboolean *storage_validity);
 int _mmcamcorder_get_storage_info(const gchar *path, const gchar *root_directory, _MMCamcorderStorageInfo *storage_info);
 int _mmcamcorder_get_freespace(storage_type_e type, guint64 *free_space);
+void _mmcamcorder_free_space_tracker_reset(MMHandleType handle);
+int _mmcamcorder_free_space_tracker_get(MMHandleType handle, guint64 write_size, guint64 margin, guint64 *free_space);
+void _mmcamcorder_recording_stats_reset(MMHandleType handle);
+guint64 _mmcamcorder_recording_stats_get_trailer_size(MMHandleType handle, GstElement *muxer);
+void _mmcamcorder_recording_stats_set_queue_level(MMHandleType handle, guint video_level, guint audio_level);
+void _mmcamcorder_recording_stats_set_start_latency(MMHandleType handle, guint start_latency);
+void _mmcamcorder_recording_stats_add_dropped(MMHandleType handle);
+/* returns TRUE if status message should be sent by the interval */
+gboolean _mmcamcorder_recording_stats_update(MMHandleType handle, guint64 elapsed, guint64 filesize, guint64 remained_time);
+int _mmcamcorder_get_recording_stats(MMHandleType handle, MMCamcorderRecordingStatsType *stats);
+int _mmcamcorder_set_recording_status_interval(MMHandleType handle, int interval);
 int _mmcamcorder_get_file_size(const char *filename, guint64 *size);
 int _mmcamcorder_get_file_system_type(const gchar *path, int *file_system_type);
 
@@ -321,6 +540,14 @@ void _mmcamcorder_emit_dbus_signal(GDBusConnection *conn, const char *object_nam
 
 /* audio buffer */
 int _mmcamcorder_get_audiosrc_blocksize(int samplerate, int format, int channel, int interval, int *blocksize);
+gboolean _mmcamcorder_get_audio_square_sum(unsigned char *data, int size, int format, int channel,
+	guint64 *square_sum, int *count);
+gboolean _mmcamcorder_get_audio_square_sum_ref(unsigned char *data, int size, int format, int channel,
+	guint64 *square_sum, int *count);
+void _mmcamcorder_split_yuv422_row(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy);
+void _mmcamcorder_split_yuv422_row_ref(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy);
 
 #ifdef __cplusplus
 }
@@ -38,6 +38,8 @@ extern "C" {
 /*=======================================================================================
 | MACRO DEFINITIONS									|
 ========================================================================================*/
+#define _MMCAMCORDER_SEGMENT_EOS_TIMEOUT	(3 * G_TIME_SPAN_SECOND)
+#define _MMCAMCORDER_SEGMENT_LOCK_INTERVAL	(10*1000)
 
 /*=======================================================================================
 | ENUM DEFINITIONS									|
@@ -48,6 +50,15 @@ enum {
 	PUSH_ENCODING_BUFFER_STOP,
 };
 
+/**
+ * States of segmented recording
+ */
+typedef enum {
+	_MMCAMCORDER_SEGMENT_STATE_NONE = 0,	/**< Recording current segment */
+	_MMCAMCORDER_SEGMENT_STATE_REQUESTED,	/**< Limit is reached, waiting for keyframe */
+	_MMCAMCORDER_SEGMENT_STATE_SPLITTING,	/**< Current segment is being finished from the keyframe */
+} _MMCamcorderSegmentState;
+
 /*=======================================================================================
 | STRUCTURE DEFINITIONS									|
 ========================================================================================*/
@@ -80,8 +91,82 @@ typedef struct {
 	gboolean record_dual_stream;    /**< record with dual stream flag */
 	gboolean restart_preview;       /**< flag for whether restart preview or not when start recording */
 	GMutex size_check_lock;         /**< mutex for checking recording size */
+	gint64 record_start_time;       /**< monotonic time when recording is requested (usec) */
+	gint wait_pre_record;           /**< drop audio until pre-recorded frames are pushed */
+	GstClockTime pre_record_offset; /**< duration of pre-recorded frames which is added to audio timestamp */
 } _MMCamcorderVideoInfo;
 
+/**
+ * Settings which encoding pipeline is built with.
+ * Kept encoding pipeline is reused only if they are not changed.
+ */
+typedef struct {
+	int video_encoder;
+	int audio_encoder;
+	int file_format;
+	int video_width;
+	int video_height;
+	int camera_width;
+	int camera_height;
+	int camera_fps;
+	int video_bitrate;
+	int audio_bitrate;
+	int audio_disable;
+	int audio_device;
+	int audio_samplerate;
+	int audio_format;
+	int audio_channel;
+	int sound_stream_index;
+	int preview_format;
+	int is_modified_rate;
+} _MMCamcorderEncodeSettings;
+
+/**
+ * Segmented recording which rolls over to next file on a keyframe.
+ * Video and audio of current segment are finished by EOS on each pad of muxer,
+ * then segment thread restarts muxer and sink with next file while streaming threads wait at the split point.
+ */
+typedef struct {
+	GMutex lock;
+	GCond cond;
+	GThread *thread;                /**< Thread which closes current file and opens next one */
+	gboolean exit;                  /**< Segment thread should be finished */
+	gint failed;                    /**< Next file is not opened, buffers are dropped until recording is finished */
+	gboolean enable;                /**< Roll over to next file at the limit of recording */
+	gchar *filename_template;       /**< Template of segment file name, NULL to make it from target file name */
+	gboolean active;                /**< Whether segmented recording is used for current recording */
+	gboolean closed;                /**< Current file is already finished and reported, but next one is not opened */
+	gint state;                     /**< _MMCamcorderSegmentState */
+	guint index;                    /**< Number of current segment, it starts from 1 */
+	gint key_requested;             /**< Keyframe for next segment is requested to encoder */
+	GstClockTime start_time;        /**< Running time which current segment starts from */
+	GstClockTime split_time;        /**< Running time of keyframe which next segment starts from */
+	gboolean video_done;            /**< EOS is sent to video pad of muxer */
+	gboolean audio_done;            /**< EOS is sent to audio pad of muxer */
+	gboolean eos_received;          /**< EOS of current segment reached sink */
+} _MMCamcorderSegment;
+
+/**
+ * Frames from a keyframe to the next keyframe in pre-record ring
+ */
+typedef struct {
+	GQueue frames;                  /**< Copied frames, the first one is keyframe */
+	gsize size;                     /**< Total bytes of frames */
+} _MMCamcorderPreRecordGop;
+
+/**
+ * Ring of encoded preview frames kept before record start.
+ * The oldest GOP is evicted as a whole, so the ring always starts with keyframe.
+ */
+typedef struct {
+	GMutex lock;
+	GQueue gops;                    /**< Queue of _MMCamcorderPreRecordGop */
+	gsize size;                     /**< Total bytes of kept frames */
+	gsize max_size;                 /**< Maximum bytes of kept frames */
+	GstClockTime duration;          /**< Duration to keep, 0 means disabled */
+	GstClockTime last_pts;          /**< Timestamp of the newest frame */
+} _MMCamcorderPreRecord;
+
 /*=======================================================================================
 | CONSTANT DEFINITIONS									|
 ========================================================================================*/
@@ -158,6 +243,128 @@ int _mmcamcorder_video_handle_eos(MMHandleType handle);
  */
 int _mmcamcorder_video_prepare_record(MMHandleType handle);
 
+/**
+ * This function builds encoding pipeline and keeps it in READY until recording starts.
+ * It's called in task thread during preview.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ * @see		_mmcamcorder_video_prepare_record()
+ */
+int _mmcamcorder_video_warm_record(MMHandleType handle);
+
+/**
+ * This function requests task thread to build encoding pipeline, if warm record is enabled.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_video_request_warm_record(MMHandleType handle);
+
+/**
+ * This function keeps encoding pipeline in READY after recording if warm record is enabled,
+ * otherwise it removes encoding pipeline.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ * @see		_mmcamcorder_remove_recorder_pipeline()
+ */
+int _mmcamcorder_video_park_record(MMHandleType handle);
+
+/**
+ * This function removes encoding pipeline kept by warm record and cancels the request to build it.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ * @see		_mmcamcorder_video_park_record()
+ */
+void _mmcamcorder_video_remove_parked_record(MMHandleType handle);
+
+/**
+ * This function enables or disables warm record.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	enable		Whether encoding pipeline is built during preview and kept after recording.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ */
+int _mmcamcorder_video_set_warm_record(MMHandleType handle, int enable);
+
+/**
+ * This function enables segmented recording which rolls over to next file at the limit of recording.
+ *
+ * @param[in]	handle			Handle of camcorder context.
+ * @param[in]	enable			Whether segmented recording is enabled.
+ * @param[in]	filename_template	Template of segment file name, or NULL.
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks
+ */
+int _mmcamcorder_video_set_recording_segment(MMHandleType handle, int enable, const char *filename_template);
+
+/**
+ * This function is called for EOS on sink of encoding pipeline.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	TRUE if EOS finishes a segment and it should be dropped, otherwise FALSE.
+ * @remarks
+ */
+gboolean _mmcamcorder_video_segment_eos(MMHandleType handle);
+
+/**
+ * This function wakes up streaming threads which wait for next segment before encoding pipeline is stopped,
+ * and finishes segment thread.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_video_segment_abort(MMHandleType handle);
+
+/**
+ * This function sets duration and maximum size of pre-record ring.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	duration	Duration to keep before record start (msec), 0 disables pre-record.
+ * @param[in]	max_size	Maximum size of kept frames (KB).
+ * @return	This function returns MM_ERROR_NONE on success, or the other values on error.
+ * @remarks	Kept frames are discarded.
+ */
+int _mmcamcorder_video_set_pre_record(MMHandleType handle, int duration, int max_size);
+
+/**
+ * This function keeps a copy of encoded preview frame in pre-record ring.
+ * Delta frames are ignored until the first keyframe comes.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[in]	buffer		Encoded preview frame.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_video_pre_record_push(MMHandleType handle, GstBuffer *buffer);
+
+/**
+ * This function moves all frames in pre-record ring to the queue in order.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @param[out]	frames		Queue which frames are appended to. Caller owns the frames.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_video_pre_record_take(MMHandleType handle, GQueue *frames);
+
+/**
+ * This function discards all frames in pre-record ring.
+ *
+ * @param[in]	handle		Handle of camcorder context.
+ * @return	void
+ * @remarks
+ */
+void _mmcamcorder_video_pre_record_flush(MMHandleType handle);
+
 
 #ifdef __cplusplus
 }
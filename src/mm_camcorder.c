@@ -360,6 +360,101 @@ int mm_camcorder_get_state2(MMHandleType camcorder, MMCamcorderStateType *state,
 }
 
 
+int mm_camcorder_set_preview_profile(MMHandleType camcorder, int enable)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_set_preview_profile(camcorder, enable);
+}
+
+
+int mm_camcorder_get_preview_profile(MMHandleType camcorder, MMCamcorderPreviewProfileType *profile)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail((void *)profile, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_get_preview_profile(camcorder, profile);
+}
+
+
+int mm_camcorder_get_jpeg_fallback_count(MMHandleType camcorder, int *count)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail((void *)count, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_get_jpeg_fallback_count(camcorder, count);
+}
+
+
+int mm_camcorder_get_video_stream_delivery_count(MMHandleType camcorder, int *delivered, int *dropped)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail((void *)delivered, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail((void *)dropped, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_get_video_stream_delivery_count(camcorder, delivered, dropped);
+}
+
+
+int mm_camcorder_get_recording_stats(MMHandleType camcorder, MMCamcorderRecordingStatsType *stats)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail((void *)stats, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_get_recording_stats(camcorder, stats);
+}
+
+
+int mm_camcorder_set_recording_status_interval(MMHandleType camcorder, int interval)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail(interval >= 0, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_set_recording_status_interval(camcorder, interval);
+}
+
+
+int mm_camcorder_set_pre_record(MMHandleType camcorder, int duration, int max_size)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail(duration >= 0 && max_size >= 0, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_video_set_pre_record(camcorder, duration, max_size);
+}
+
+
+int mm_camcorder_set_warm_record(MMHandleType camcorder, int enable)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_video_set_warm_record(camcorder, enable);
+}
+
+
+int mm_camcorder_set_recording_segment(MMHandleType camcorder, int enable, const char *filename_template)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_video_set_recording_segment(camcorder, enable, filename_template);
+}
+
+
+int mm_camcorder_set_recording_segment_callback(MMHandleType camcorder, mm_camcorder_recording_segment_callback callback, void *user_data)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_set_recording_segment_callback(camcorder, callback, user_data);
+}
+
+
+int mm_camcorder_invalidate_configure(void)
+{
+	_mmcamcorder_conf_invalidate();
+
+	return MM_ERROR_NONE;
+}
+
+
 int mm_camcorder_get_attributes(MMHandleType camcorder, char **err_attr_name, const char *attribute_name, ...)
 {
 	va_list var_args;
@@ -390,6 +485,22 @@ int mm_camcorder_set_attributes(MMHandleType camcorder,  char **err_attr_name, c
 }
 
 
+int mm_camcorder_begin_attributes(MMHandleType camcorder)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_begin_attributes(camcorder);
+}
+
+
+int mm_camcorder_commit_attributes(MMHandleType camcorder)
+{
+	mmf_return_val_if_fail((void *)camcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	return _mmcamcorder_commit_attributes(camcorder);
+}
+
+
 int mm_camcorder_get_attribute_info(MMHandleType camcorder, const char *attribute_name, MMCamAttrsInfo *info)
 {
 	return _mmcamcorder_get_attribute_info(camcorder, attribute_name, info);
@@ -70,6 +70,10 @@ static int readonly_attributes[] = {
 -----------------------------------------------------------------------*/
 /* STATIC INTERNAL FUNCTION */
 static bool __mmcamcorder_set_capture_resolution(MMHandleType handle, int width, int height);
+static bool __mmcamcorder_set_camera_caps(MMHandleType handle, int width, int height, int rotate, gboolean restart);
+static void __mmcamcorder_add_pending_resolution(mmf_camcorder_t *hcamcorder, int current_state);
+static void __mmcamcorder_publish_attr_snapshot(mmf_camcorder_t *hcamcorder, _MMCamcorderAttrSnapshot *snapshot);
+static void __mmcamcorder_update_attr_snapshot(mmf_camcorder_t *hcamcorder, int attr_idx, const MMAttrsValue *value);
 static int  __mmcamcorder_set_conf_to_valid_info(MMHandleType handle);
 static int  __mmcamcorder_release_conf_valid_info(MMHandleType handle);
 static int  __mmcamcorder_check_valid_pair(MMHandleType handle, char **err_attr_name, const char *attribute_name, va_list var_args);
@@ -1902,6 +1906,116 @@ _mmcamcorder_get_attribute_info(MMHandleType handle, const char *attr_name, MMCa
 }
 
 
+int _mmcamcorder_begin_attributes(MMHandleType handle)
+{
+	int ret = MM_ERROR_NONE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	if (!_MMCAMCORDER_TRYLOCK_CMD(handle)) {
+		_mmcam_dbg_err("Another command is running.");
+		return MM_ERROR_CAMCORDER_CMD_IS_RUNNING;
+	}
+
+	if (hcamcorder->attr_transaction.active) {
+		_mmcam_dbg_err("attribute transaction is already begun");
+		ret = MM_ERROR_CAMCORDER_INVALID_STATE;
+	} else {
+		_mmcam_dbg_log("begin attribute transaction");
+		hcamcorder->attr_transaction.active = TRUE;
+		hcamcorder->attr_transaction.pending = _MMCAMCORDER_ATTR_PENDING_NONE;
+	}
+
+	_MMCAMCORDER_UNLOCK_CMD(handle);
+
+	return ret;
+}
+
+
+int _mmcamcorder_commit_attributes(MMHandleType handle)
+{
+	int ret = MM_ERROR_NONE;
+	int width = 0;
+	int height = 0;
+	int camera_rotate = 0;
+	int camera_flip = 0;
+	int display_rotate = 0;
+	int display_flip = 0;
+	unsigned int pending = _MMCAMCORDER_ATTR_PENDING_NONE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderSubContext *sc = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	if (!_MMCAMCORDER_TRYLOCK_CMD(handle)) {
+		_mmcam_dbg_err("Another command is running.");
+		return MM_ERROR_CAMCORDER_CMD_IS_RUNNING;
+	}
+
+	if (!hcamcorder->attr_transaction.active) {
+		_mmcam_dbg_err("attribute transaction is not begun");
+		ret = MM_ERROR_CAMCORDER_INVALID_STATE;
+		goto _COMMIT_DONE;
+	}
+
+	pending = hcamcorder->attr_transaction.pending;
+
+	hcamcorder->attr_transaction.active = FALSE;
+	hcamcorder->attr_transaction.pending = _MMCAMCORDER_ATTR_PENDING_NONE;
+
+	_mmcam_dbg_log("commit attribute transaction - pending 0x%x", pending);
+
+	/* recorded changes are applied when pipeline is created */
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	if (!sc || pending == _MMCAMCORDER_ATTR_PENDING_NONE)
+		goto _COMMIT_DONE;
+
+	mm_camcorder_get_attributes(handle, NULL,
+		MMCAM_CAMERA_WIDTH, &width,
+		MMCAM_CAMERA_HEIGHT, &height,
+		MMCAM_CAMERA_ROTATION, &camera_rotate,
+		MMCAM_CAMERA_FLIP, &camera_flip,
+		MMCAM_DISPLAY_ROTATION, &display_rotate,
+		MMCAM_DISPLAY_FLIP, &display_flip,
+		NULL);
+
+	/* one caps change for resolution, format and rotation */
+	if (pending & _MMCAMCORDER_ATTR_PENDING_CAPS) {
+		sc->info_video->preview_width = width;
+		sc->info_video->preview_height = height;
+
+		if (!__mmcamcorder_set_camera_caps(handle, width, height, camera_rotate,
+			(pending & _MMCAMCORDER_ATTR_PENDING_RESTART) ? TRUE : FALSE)) {
+			_mmcam_dbg_err("failed to set camera caps");
+			ret = MM_ERROR_CAMCORDER_INTERNAL;
+			goto _COMMIT_DONE;
+		}
+	}
+
+	if (pending & _MMCAMCORDER_ATTR_PENDING_SENSOR) {
+		if (!_mmcamcorder_set_videosrc_flip(handle, camera_flip)) {
+			_mmcam_dbg_err("failed to set camera flip");
+			ret = MM_ERROR_CAMCORDER_INTERNAL;
+			goto _COMMIT_DONE;
+		}
+	}
+
+	if (pending & _MMCAMCORDER_ATTR_PENDING_DISPLAY) {
+		if (!_mmcamcorder_set_display_rotation(handle, display_rotate, _MMCAMCORDER_VIDEOSINK_SINK) ||
+			!_mmcamcorder_set_display_flip(handle, display_flip, _MMCAMCORDER_VIDEOSINK_SINK)) {
+			_mmcam_dbg_err("failed to set display");
+			ret = MM_ERROR_CAMCORDER_INTERNAL;
+		}
+	}
+
+_COMMIT_DONE:
+	_MMCAMCORDER_UNLOCK_CMD(handle);
+
+	return ret;
+}
+
+
 bool
 _mmcamcorder_commit_camcorder_attrs(int attr_idx, const char *attr_name, const MMAttrsValue *value, void *commit_param)
 {
@@ -1920,10 +2034,76 @@ _mmcamcorder_commit_camcorder_attrs(int attr_idx, const char *attr_name, const M
 	else
 		bret = TRUE;
 
+	if (bret)
+		__mmcamcorder_update_attr_snapshot(hcamcorder, attr_idx, value);
+
 	return bret;
 }
 
 
+void _mmcamcorder_get_attr_snapshot(MMHandleType handle, _MMCamcorderAttrSnapshot *snapshot)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderAttrSnapshot *current = NULL;
+
+	mmf_return_if_fail(hcamcorder && snapshot);
+
+	/* published snapshot is not freed while readers is not 0 */
+	g_atomic_int_inc(&hcamcorder->attr_snapshot.readers);
+
+	current = (_MMCamcorderAttrSnapshot *)g_atomic_pointer_get(&hcamcorder->attr_snapshot.current);
+	if (current)
+		*snapshot = *current;
+	else
+		memset(snapshot, 0x0, sizeof(_MMCamcorderAttrSnapshot));
+
+	g_atomic_int_dec_and_test(&hcamcorder->attr_snapshot.readers);
+}
+
+
+void _mmcamcorder_refresh_attr_snapshot(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderAttrSnapshot *snapshot = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	snapshot = g_new0(_MMCamcorderAttrSnapshot, 1);
+
+	mm_camcorder_get_attributes(handle, NULL,
+		MMCAM_AUDIO_VOLUME, &snapshot->audio_volume,
+		MMCAM_AUDIO_FORMAT, &snapshot->audio_format,
+		MMCAM_AUDIO_CHANNEL, &snapshot->audio_channel,
+		MMCAM_IMAGE_ENCODER, &snapshot->image_encoder,
+		MMCAM_IMAGE_ENCODER_QUALITY, &snapshot->image_encoder_quality,
+		MMCAM_TAG_ENABLE, &snapshot->tag_enable,
+		MMCAM_CAPTURE_BREAK_CONTINUOUS_SHOT, &snapshot->capture_break_cont_shot,
+		NULL);
+
+	g_mutex_lock(&hcamcorder->attr_snapshot.lock);
+	__mmcamcorder_publish_attr_snapshot(hcamcorder, snapshot);
+	g_mutex_unlock(&hcamcorder->attr_snapshot.lock);
+}
+
+
+void _mmcamcorder_clear_attr_snapshot(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	g_mutex_lock(&hcamcorder->attr_snapshot.lock);
+
+	g_free(g_atomic_pointer_get(&hcamcorder->attr_snapshot.current));
+	g_atomic_pointer_set(&hcamcorder->attr_snapshot.current, NULL);
+
+	g_slist_free_full(hcamcorder->attr_snapshot.retired, g_free);
+	hcamcorder->attr_snapshot.retired = NULL;
+
+	g_mutex_unlock(&hcamcorder->attr_snapshot.lock);
+}
+
+
 int __mmcamcorder_set_conf_to_valid_info(MMHandleType handle)
 {
 	int *format = NULL;
@@ -2102,10 +2282,12 @@ bool _mmcamcorder_commit_capture_break_cont_shot(MMHandleType handle, int attr_i
 	}
 
 	if (ivalue && current_state == MM_CAMCORDER_STATE_CAPTURING) {
+		g_mutex_lock(&hcamcorder->capture_pipeline.lock);
 		if (info->capture_send_count > 0) {
 			info->capturing = FALSE;
 			_mmcam_dbg_warn("capturing -> FALSE and skip capture callback since now");
 		}
+		g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
 
 		if (!GST_IS_CAMERA_CONTROL(sc->element[_MMCAMCORDER_VIDEOSRC_SRC].gst)) {
 			_mmcam_dbg_warn("Can't cast Video source into camera control.");
@@ -2319,7 +2501,6 @@ bool _mmcamcorder_commit_camera_width(MMHandleType handle, int attr_idx, const M
 {
 	MMHandleType attr = 0;
 	int current_state = MM_CAMCORDER_STATE_NONE;
-	int ret = 0;
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 	_MMCamcorderSubContext *sc = NULL;
 
@@ -2348,15 +2529,16 @@ bool _mmcamcorder_commit_camera_width(MMHandleType handle, int attr_idx, const M
 		if (!(flags & MM_ATTRS_FLAG_MODIFIED)) {
 			int width = value->value.i_val;
 			int height = 0;
-			int preview_format = MM_PIXEL_FORMAT_NV12;
-			int codec_type = MM_IMAGE_CODEC_JPEG;
 
 			mm_camcorder_get_attributes(handle, NULL,
 				MMCAM_CAMERA_HEIGHT, &height,
-				MMCAM_CAMERA_FORMAT, &preview_format,
-				MMCAM_IMAGE_ENCODER, &codec_type,
 				NULL);
 
+			if (hcamcorder->attr_transaction.active) {
+				__mmcamcorder_add_pending_resolution(hcamcorder, current_state);
+				return TRUE;
+			}
+
 			if (current_state == MM_CAMCORDER_STATE_PREPARE) {
 				if (hcamcorder->resolution_changed == FALSE) {
 					_mmcam_dbg_log("no need to restart preview");
@@ -2365,45 +2547,10 @@ bool _mmcamcorder_commit_camera_width(MMHandleType handle, int attr_idx, const M
 
 				hcamcorder->resolution_changed = FALSE;
 
-				if (g_mutex_trylock(&hcamcorder->restart_preview_lock)) {
-					_mmcam_dbg_log("restart preview");
-
-					MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", TRUE);
-					MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", TRUE);
-
-					_mmcamcorder_gst_set_state(handle, sc->element[_MMCAMCORDER_MAIN_PIPE].gst, GST_STATE_READY);
-
-					/* check decoder recreation */
-					if (!_mmcamcorder_recreate_decoder_for_encoded_preview(handle)) {
-						_mmcam_dbg_err("_mmcamcorder_recreate_decoder_for_encoded_preview failed");
-						g_mutex_unlock(&hcamcorder->restart_preview_lock);
-						return FALSE;
-					}
-
-					/* get preview format */
-					sc->info_image->preview_format = preview_format;
-					sc->fourcc = _mmcamcorder_get_fourcc(sc->info_image->preview_format, codec_type, hcamcorder->use_zero_copy_format);
-					ret = _mmcamcorder_set_camera_resolution(handle, width, height);
-
-					MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", FALSE);
-					MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", FALSE);
-
-					_mmcamcorder_gst_set_state(handle, sc->element[_MMCAMCORDER_MAIN_PIPE].gst, GST_STATE_PLAYING);
-
-					/* unlock */
-					g_mutex_unlock(&hcamcorder->restart_preview_lock);
-				} else {
-					_mmcam_dbg_err("currently locked for preview restart");
-					return FALSE;
-				}
-			} else {
-				/* get preview format */
-				sc->info_image->preview_format = preview_format;
-				sc->fourcc = _mmcamcorder_get_fourcc(sc->info_image->preview_format, codec_type, hcamcorder->use_zero_copy_format);
-				ret = _mmcamcorder_set_camera_resolution(handle, width, height);
+				return __mmcamcorder_set_camera_caps(handle, width, height, sc->videosrc_rotate, TRUE);
 			}
 
-			return ret;
+			return __mmcamcorder_set_camera_caps(handle, width, height, sc->videosrc_rotate, FALSE);
 		}
 
 		return TRUE;
@@ -2413,7 +2560,6 @@ bool _mmcamcorder_commit_camera_width(MMHandleType handle, int attr_idx, const M
 
 bool _mmcamcorder_commit_camera_height(MMHandleType handle, int attr_idx, const MMAttrsValue *value)
 {
-	int ret = 0;
 	int current_state = MM_CAMCORDER_STATE_NONE;
 	MMHandleType attr = 0;
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
@@ -2438,20 +2584,19 @@ bool _mmcamcorder_commit_camera_height(MMHandleType handle, int attr_idx, const
 	} else {
 		int width = 0;
 		int height = value->value.i_val;
-		int preview_format = MM_PIXEL_FORMAT_NV12;
-		int codec_type = MM_IMAGE_CODEC_JPEG;
-		int video_stabilization = 0;
 
 		mm_camcorder_get_attributes(handle, NULL,
 			MMCAM_CAMERA_WIDTH, &width,
-			MMCAM_CAMERA_FORMAT, &preview_format,
-			MMCAM_IMAGE_ENCODER, &codec_type,
-			MMCAM_CAMERA_VIDEO_STABILIZATION, &video_stabilization,
 			NULL);
 
 		sc->info_video->preview_width = width;
 		sc->info_video->preview_height = height;
 
+		if (hcamcorder->attr_transaction.active) {
+			__mmcamcorder_add_pending_resolution(hcamcorder, current_state);
+			return TRUE;
+		}
+
 		if (current_state == MM_CAMCORDER_STATE_PREPARE) {
 			if (hcamcorder->resolution_changed == FALSE) {
 				_mmcam_dbg_log("no need to restart preview");
@@ -2460,48 +2605,10 @@ bool _mmcamcorder_commit_camera_height(MMHandleType handle, int attr_idx, const
 
 			hcamcorder->resolution_changed = FALSE;
 
-			if (g_mutex_trylock(&hcamcorder->restart_preview_lock)) {
-				_mmcam_dbg_log("restart preview");
-
-				_mmcam_dbg_log("set empty buffers");
-
-				MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", TRUE);
-				MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", TRUE);
-
-				_mmcamcorder_gst_set_state(handle, sc->element[_MMCAMCORDER_MAIN_PIPE].gst, GST_STATE_READY);
-
-				/* check decoder recreation */
-				if (!_mmcamcorder_recreate_decoder_for_encoded_preview(handle)) {
-					_mmcam_dbg_err("_mmcamcorder_recreate_decoder_for_encoded_preview failed");
-					g_mutex_unlock(&hcamcorder->restart_preview_lock);
-					return FALSE;
-				}
-
-				/* get preview format */
-				sc->info_image->preview_format = preview_format;
-				sc->fourcc = _mmcamcorder_get_fourcc(sc->info_image->preview_format, codec_type, hcamcorder->use_zero_copy_format);
-
-				ret = _mmcamcorder_set_camera_resolution(handle, width, height);
-
-				MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", FALSE);
-				MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", FALSE);
-
-				_mmcamcorder_gst_set_state(handle, sc->element[_MMCAMCORDER_MAIN_PIPE].gst, GST_STATE_PLAYING);
-
-				/* unlock */
-				g_mutex_unlock(&hcamcorder->restart_preview_lock);
-			} else {
-				_mmcam_dbg_err("currently locked for preview restart");
-				return FALSE;
-			}
-		} else {
-			/* get preview format */
-			sc->info_image->preview_format = preview_format;
-			sc->fourcc = _mmcamcorder_get_fourcc(sc->info_image->preview_format, codec_type, hcamcorder->use_zero_copy_format);
-			ret = _mmcamcorder_set_camera_resolution(handle, width, height);
+			return __mmcamcorder_set_camera_caps(handle, width, height, sc->videosrc_rotate, TRUE);
 		}
 
-		return ret;
+		return __mmcamcorder_set_camera_caps(handle, width, height, sc->videosrc_rotate, FALSE);
 	}
 }
 
@@ -3419,6 +3526,9 @@ bool _mmcamcorder_commit_camera_rotate(MMHandleType handle, int attr_idx, const
 		_mmcam_dbg_err("camera rotation setting failed.(state=%d)", current_state);
 		hcamcorder->error_code = MM_ERROR_CAMCORDER_INVALID_STATE;
 		return FALSE;
+	} else if (hcamcorder->attr_transaction.active) {
+		hcamcorder->attr_transaction.pending |= _MMCAMCORDER_ATTR_PENDING_CAPS;
+		return TRUE;
 	} else {
 		return _mmcamcorder_set_videosrc_rotation(handle, value->value.i_val);
 	}
@@ -3894,6 +4004,11 @@ bool _mmcamcorder_commit_display_rotation(MMHandleType handle, int attr_idx, con
 		return TRUE;
 	}
 
+	if (hcamcorder->attr_transaction.active) {
+		hcamcorder->attr_transaction.pending |= _MMCAMCORDER_ATTR_PENDING_DISPLAY;
+		return TRUE;
+	}
+
 	return _mmcamcorder_set_display_rotation(handle, value->value.i_val, _MMCAMCORDER_VIDEOSINK_SINK);
 }
 
@@ -3919,6 +4034,11 @@ bool _mmcamcorder_commit_display_flip(MMHandleType handle, int attr_idx, const M
 		return TRUE;
 	}
 
+	if (hcamcorder->attr_transaction.active) {
+		hcamcorder->attr_transaction.pending |= _MMCAMCORDER_ATTR_PENDING_DISPLAY;
+		return TRUE;
+	}
+
 	return _mmcamcorder_set_display_flip(handle, value->value.i_val, _MMCAMCORDER_VIDEOSINK_SINK);
 }
 
@@ -4352,6 +4472,11 @@ bool _mmcamcorder_commit_camera_flip(MMHandleType handle, int attr_idx, const MM
 		return TRUE;
 	}
 
+	if (hcamcorder->attr_transaction.active) {
+		hcamcorder->attr_transaction.pending |= _MMCAMCORDER_ATTR_PENDING_SENSOR;
+		return TRUE;
+	}
+
 	ret = _mmcamcorder_set_videosrc_flip(handle, value->value.i_val);
 
 	_mmcam_dbg_log("ret %d", ret);
@@ -4891,6 +5016,170 @@ static bool __mmcamcorder_set_capture_resolution(MMHandleType handle, int width,
 }
 
 
+static bool __mmcamcorder_set_camera_caps(MMHandleType handle, int width, int height, int rotate, gboolean restart)
+{
+	int ret = 0;
+	int fps = 0;
+	int preview_format = MM_PIXEL_FORMAT_NV12;
+	int codec_type = MM_IMAGE_CODEC_JPEG;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderSubContext *sc = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, FALSE);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	if (!sc)
+		return TRUE;
+
+	mm_camcorder_get_attributes(handle, NULL,
+		MMCAM_CAMERA_FORMAT, &preview_format,
+		MMCAM_IMAGE_ENCODER, &codec_type,
+		MMCAM_CAMERA_FPS, &fps,
+		NULL);
+
+	if (!restart) {
+		/* get preview format */
+		sc->info_image->preview_format = preview_format;
+		sc->fourcc = _mmcamcorder_get_fourcc(sc->info_image->preview_format, codec_type, hcamcorder->use_zero_copy_format);
+
+		_mmcam_dbg_log("set %dx%d, rotate %d", width, height, rotate);
+
+		return _mmcamcorder_set_videosrc_caps(handle, sc->fourcc, width, height, fps, rotate);
+	}
+
+	if (!g_mutex_trylock(&hcamcorder->restart_preview_lock)) {
+		_mmcam_dbg_err("currently locked for preview restart");
+		return FALSE;
+	}
+
+	_mmcam_dbg_log("restart preview");
+
+	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", TRUE);
+	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", TRUE);
+
+	_mmcamcorder_gst_set_state(handle, sc->element[_MMCAMCORDER_MAIN_PIPE].gst, GST_STATE_READY);
+
+	/* check decoder recreation */
+	if (!_mmcamcorder_recreate_decoder_for_encoded_preview(handle)) {
+		_mmcam_dbg_err("_mmcamcorder_recreate_decoder_for_encoded_preview failed");
+		g_mutex_unlock(&hcamcorder->restart_preview_lock);
+		return FALSE;
+	}
+
+	/* get preview format */
+	sc->info_image->preview_format = preview_format;
+	sc->fourcc = _mmcamcorder_get_fourcc(sc->info_image->preview_format, codec_type, hcamcorder->use_zero_copy_format);
+
+	_mmcam_dbg_log("set %dx%d, rotate %d", width, height, rotate);
+
+	ret = _mmcamcorder_set_videosrc_caps(handle, sc->fourcc, width, height, fps, rotate);
+
+	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", FALSE);
+	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", FALSE);
+
+	_mmcamcorder_gst_set_state(handle, sc->element[_MMCAMCORDER_MAIN_PIPE].gst, GST_STATE_PLAYING);
+
+	/* unlock */
+	g_mutex_unlock(&hcamcorder->restart_preview_lock);
+
+	return ret;
+}
+
+
+static void __mmcamcorder_add_pending_resolution(mmf_camcorder_t *hcamcorder, int current_state)
+{
+	hcamcorder->attr_transaction.pending |= _MMCAMCORDER_ATTR_PENDING_CAPS;
+
+	/* resolution_changed is updated by every set_attributes call, so keep it in transaction */
+	if (current_state == MM_CAMCORDER_STATE_PREPARE && hcamcorder->resolution_changed) {
+		hcamcorder->attr_transaction.pending |= _MMCAMCORDER_ATTR_PENDING_RESTART;
+		hcamcorder->resolution_changed = FALSE;
+	}
+
+	_mmcam_dbg_log("pending 0x%x", hcamcorder->attr_transaction.pending);
+}
+
+
+static void __mmcamcorder_publish_attr_snapshot(mmf_camcorder_t *hcamcorder, _MMCamcorderAttrSnapshot *snapshot)
+{
+	_MMCamcorderAttrSnapshotInfo *info = &hcamcorder->attr_snapshot;
+	_MMCamcorderAttrSnapshot *old = NULL;
+
+	/* should be called with lock of snapshot */
+	old = (_MMCamcorderAttrSnapshot *)g_atomic_pointer_get(&info->current);
+	g_atomic_pointer_set(&info->current, snapshot);
+
+	if (old)
+		info->retired = g_slist_prepend(info->retired, old);
+
+	/* readers after replacement get new one, so old ones are not used if there is no reader now */
+	if (info->retired && g_atomic_int_get(&info->readers) == 0) {
+		g_slist_free_full(info->retired, g_free);
+		info->retired = NULL;
+	}
+}
+
+
+static void __mmcamcorder_update_attr_snapshot(mmf_camcorder_t *hcamcorder, int attr_idx, const MMAttrsValue *value)
+{
+	_MMCamcorderAttrSnapshot *current = NULL;
+	_MMCamcorderAttrSnapshot *snapshot = NULL;
+
+	switch (attr_idx) {
+	case MM_CAM_AUDIO_VOLUME:
+	case MM_CAM_AUDIO_FORMAT:
+	case MM_CAM_AUDIO_CHANNEL:
+	case MM_CAM_IMAGE_ENCODER:
+	case MM_CAM_IMAGE_ENCODER_QUALITY:
+	case MM_CAM_TAG_ENABLE:
+	case MM_CAM_CAPTURE_BREAK_CONTINUOUS_SHOT:
+		break;
+	default:
+		return;
+	}
+
+	g_mutex_lock(&hcamcorder->attr_snapshot.lock);
+
+	/* not published yet, it will be done with all values */
+	current = (_MMCamcorderAttrSnapshot *)g_atomic_pointer_get(&hcamcorder->attr_snapshot.current);
+	if (!current) {
+		g_mutex_unlock(&hcamcorder->attr_snapshot.lock);
+		return;
+	}
+
+	snapshot = g_new(_MMCamcorderAttrSnapshot, 1);
+	*snapshot = *current;
+
+	switch (attr_idx) {
+	case MM_CAM_AUDIO_VOLUME:
+		snapshot->audio_volume = value->value.d_val;
+		break;
+	case MM_CAM_AUDIO_FORMAT:
+		snapshot->audio_format = value->value.i_val;
+		break;
+	case MM_CAM_AUDIO_CHANNEL:
+		snapshot->audio_channel = value->value.i_val;
+		break;
+	case MM_CAM_IMAGE_ENCODER:
+		snapshot->image_encoder = value->value.i_val;
+		break;
+	case MM_CAM_IMAGE_ENCODER_QUALITY:
+		snapshot->image_encoder_quality = value->value.i_val;
+		break;
+	case MM_CAM_TAG_ENABLE:
+		snapshot->tag_enable = value->value.i_val;
+		break;
+	default:
+		snapshot->capture_break_cont_shot = value->value.i_val;
+		break;
+	}
+
+	__mmcamcorder_publish_attr_snapshot(hcamcorder, snapshot);
+
+	g_mutex_unlock(&hcamcorder->attr_snapshot.lock);
+}
+
+
 static int __mmcamcorder_check_valid_pair(MMHandleType handle, char **err_attr_name, const char *attribute_name, va_list var_args)
 {
 	#define INIT_VALUE            -1
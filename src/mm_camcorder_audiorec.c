@@ -38,7 +38,6 @@
 #define _MMCAMCORDER_AUDIO_MINIMUM_SPACE        ((100*1024) + (5*1024))
 #define _MMCAMCORDER_RETRIAL_COUNT              10
 #define _MMCAMCORDER_FRAME_WAIT_TIME            200000 /* micro second */
-#define _MMCAMCORDER_FREE_SPACE_CHECK_INTERVAL  10
 
 /*---------------------------------------------------------------------------------------
 |    LOCAL FUNCTION PROTOTYPES:								|
@@ -90,6 +89,13 @@ static int __mmcamcorder_create_audiop_with_encodebin(MMHandleType handle)
 
 	_mmcam_dbg_log("");
 
+	/* audio level : whole channels or the loudest channel */
+	info->level_per_channel = FALSE;
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_AUDIO_INPUT,
+		"AudioLevelPerChannel",
+		&info->level_per_channel);
+
 	mux_elem = _mmcamcorder_get_type_element(handle, MM_CAM_FILE_FORMAT);
 	err = _mmcamcorder_conf_get_value_element_name(mux_elem, &mux_name);
 
@@ -402,7 +408,11 @@ _mmcamcorder_audio_command(MMHandleType handle, int command)
 			sc->ferror_count = 0;
 			sc->bget_eos = FALSE;
 			sc->muxed_stream_offset = 0;
+			_mmcamcorder_mux_index_reset(&sc->mux_index);
+			_mmcamcorder_mstream_delivery_reset(handle);
 			info->filesize = 0;
+			_mmcamcorder_free_space_tracker_reset((MMHandleType)hcamcorder);
+			_mmcamcorder_recording_stats_reset((MMHandleType)hcamcorder);
 
 			/* set max size */
 			if (imax_size <= 0)
@@ -472,6 +482,9 @@ _mmcamcorder_audio_command(MMHandleType handle, int command)
 			return MM_ERROR_CAMCORDER_CMD_IS_RUNNING;
 		}
 
+		/* muxed data of canceled file is not delivered, and muxer is not blocked by delivery */
+		_mmcamcorder_mstream_delivery_cancel(handle);
+
 		ret = _mmcamcorder_gst_set_state(handle, pipeline, GST_STATE_READY);
 		if (ret != MM_ERROR_NONE)
 			goto _ERR_CAMCORDER_AUDIO_COMMAND;
@@ -608,6 +621,9 @@ int _mmcamcorder_audio_handle_eos(MMHandleType handle)
 	if (err != MM_ERROR_NONE)
 		_mmcam_dbg_warn("Failed:_MMCamcorder_CMD_COMMIT:GST_STATE_READY. err[%x]", err);
 
+	/* all muxed data is passed at EOS */
+	_mmcamcorder_mstream_delivery_flush(handle);
+
 	/* Send recording report message to application */
 	msg.id = MM_MESSAGE_CAMCORDER_AUDIO_CAPTURED;
 	report = (MMCamRecordingReport*) g_malloc(sizeof(MMCamRecordingReport));
@@ -650,52 +666,49 @@ int _mmcamcorder_audio_handle_eos(MMHandleType handle)
 
 
 static float
-__mmcamcorder_get_decibel(unsigned char* raw, int size, MMCamcorderAudioFormat format)
+__mmcamcorder_get_decibel(unsigned char* raw, int size, MMCamcorderAudioFormat format, int channel, gboolean per_channel)
 {
 	#define MAX_AMPLITUDE_MEAN_16BIT (23170.115738161934)
 	#define MAX_AMPLITUDE_MEAN_08BIT (89.803909382810)
 	#define DEFAULT_DECIBEL          (-80.0)
 
 	int i = 0;
-	int depthByte = 0;
 	int count = 0;
-
-	short* pcm16 = 0;
-	char* pcm8 = 0;
+	double max_amplitude = MAX_AMPLITUDE_MEAN_08BIT;
 
 	float db = DEFAULT_DECIBEL;
+	float channel_db = DEFAULT_DECIBEL;
 	float rms = 0.0;
-	unsigned long long square_sum = 0;
+	guint64 square_sum[_MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX] = {0, };
 
 	if (format == MM_CAMCORDER_AUDIO_FORMAT_PCM_S16_LE)
-		depthByte = 2;
-	else		/*MM_CAMCORDER_AUDIO_FORMAT_PCM_U8*/
-		depthByte = 1;
-
-	for ( ; i < size ; i += (depthByte<<1)) {
-		if (depthByte == 1) {
-			pcm8 = (char *)(raw + i);
-			square_sum += (*pcm8) * (*pcm8);
-		} else { /*2byte*/
-			pcm16 = (short*)(raw + i);
-			square_sum += (*pcm16) * (*pcm16);
-		}
+		max_amplitude = MAX_AMPLITUDE_MEAN_16BIT;
 
-		count++;
-	}
+	if (channel < 1 || channel > _MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX)
+		channel = 1;
 
-	if (count > 0) {
-		rms = sqrt((double)square_sum/(double)count);
+	if (!_mmcamcorder_get_audio_square_sum(raw, size, format, channel, square_sum, &count) || count <= 0)
+		return db;
 
-		if (depthByte == 1)
-			db = 20 * log10(rms/MAX_AMPLITUDE_MEAN_08BIT);
-		else
-			db = 20 * log10(rms/MAX_AMPLITUDE_MEAN_16BIT);
+	if (per_channel && channel > 1) {
+		/* the loudest channel is reported */
+		for (i = 0 ; i < channel ; i++) {
+			rms = sqrt((double)square_sum[i]/(double)count);
+			channel_db = 20 * log10(rms/max_amplitude);
+			if (i == 0 || channel_db > db)
+				db = channel_db;
+		}
+	} else {
+		for (i = 1 ; i < channel ; i++)
+			square_sum[0] += square_sum[i];
+
+		rms = sqrt((double)square_sum[0]/((double)count * channel));
+		db = 20 * log10(rms/max_amplitude);
 	}
 
 	/*
-	_mmcam_dbg_log("size[%d],depthByte[%d],count[%d],rms[%f],db[%f]",
-					size, depthByte, count, rms, db);
+	_mmcam_dbg_log("size[%d],channel[%d],count[%d],rms[%f],db[%f]",
+					size, channel, count, rms, db);
 	*/
 
 	return db;
@@ -705,19 +718,19 @@ __mmcamcorder_get_decibel(unsigned char* raw, int size, MMCamcorderAudioFormat f
 static GstPadProbeReturn __mmcamcorder_audio_dataprobe_voicerecorder(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
 {
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
-	double volume = 0.0;
+	_MMCamcorderSubContext *sc = NULL;
+	_MMCamcorderAttrSnapshot attrs;
 	int current_state = MM_CAMCORDER_STATE_NONE;
-	int format = 0;
-	int channel = 0;
 	float curdcb = 0.0;
 	_MMCamcorderMsgItem msg;
-	int err = MM_ERROR_UNKNOWN;
-	char *err_name = NULL;
 	GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+	GstBuffer *silence = NULL;
 	GstMapInfo mapinfo;
 
 	mmf_return_val_if_fail(hcamcorder, GST_PAD_PROBE_OK);
 
+	sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+
 	current_state = _mmcamcorder_get_state((MMHandleType)hcamcorder);
 	if (current_state < MM_CAMCORDER_STATE_PREPARE) {
 		_mmcam_dbg_warn("Not ready for stream callback");
@@ -727,25 +740,28 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_voicerecorder(GstPad *pad
 	memset(&mapinfo, 0x0, sizeof(GstMapInfo));
 
 	/* Set volume to audio input */
-	err = mm_camcorder_get_attributes((MMHandleType)hcamcorder, &err_name,
-		MMCAM_AUDIO_VOLUME, &volume,
-		MMCAM_AUDIO_FORMAT, &format,
-		MMCAM_AUDIO_CHANNEL, &channel,
-		NULL);
+	_mmcamcorder_get_attr_snapshot((MMHandleType)hcamcorder, &attrs);
 
-	if (err < 0) {
-		_mmcam_dbg_warn("Get attrs fail. (%s:%x)", err_name, err);
-		SAFE_FREE(err_name);
-		return err;
-	}
+	/* replace muted buffer with shared silence instead of writing it */
+	if (attrs.audio_volume == 0)
+		silence = _mmcamcorder_get_silence_buffer((MMHandleType)hcamcorder, buffer);
 
-	gst_buffer_map(buffer, &mapinfo, GST_MAP_READWRITE);
+	if (silence) {
+		gst_buffer_unref(buffer);
+		buffer = silence;
+		GST_PAD_PROBE_INFO_DATA(info) = buffer;
+
+		gst_buffer_map(buffer, &mapinfo, GST_MAP_READ);
+	} else {
+		gst_buffer_map(buffer, &mapinfo, GST_MAP_READWRITE);
 
-	if (volume == 0)
-		memset(mapinfo.data, 0, mapinfo.size);
+		if (attrs.audio_volume == 0)
+			memset(mapinfo.data, 0, mapinfo.size);
+	}
 
 	/* Get current volume level of real input stream */
-	curdcb = __mmcamcorder_get_decibel(mapinfo.data, mapinfo.size, format);
+	curdcb = __mmcamcorder_get_decibel(mapinfo.data, mapinfo.size, attrs.audio_format, attrs.audio_channel,
+		(sc && sc->info_audio) ? sc->info_audio->level_per_channel : FALSE);
 
 	msg.id = MM_MESSAGE_CAMCORDER_CURRENT_VOLUME;
 	msg.param.rec_volume_dB = curdcb;
@@ -759,12 +775,12 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_voicerecorder(GstPad *pad
 
 		/*
 		_mmcam_dbg_log("Call audio steramCb, data[%p], format[%d], channel[%d], length[%d], volume_dB[%f]",
-			GST_BUFFER_DATA(buffer), format, channel, GST_BUFFER_SIZE(buffer), curdcb);
+			GST_BUFFER_DATA(buffer), attrs.audio_format, attrs.audio_channel, GST_BUFFER_SIZE(buffer), curdcb);
 		*/
 
 		stream.data = (void *)mapinfo.data;
-		stream.format = format;
-		stream.channel = channel;
+		stream.format = attrs.audio_format;
+		stream.channel = attrs.audio_channel;
 		stream.length = mapinfo.size;
 		stream.timestamp = (unsigned int)(GST_BUFFER_PTS(buffer)/1000000);	/* nano -> msecond */
 		stream.volume_dB = curdcb;
@@ -782,7 +798,6 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_voicerecorder(GstPad *pad
 
 static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
 {
-	static int count = 0;
 	guint64 rec_pipe_time = 0;
 	guint64 free_space = 0;
 	guint64 buffer_size = 0;
@@ -806,6 +821,7 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 	if (sc->isMaxtimePausing || sc->isMaxsizePausing) {
 		_mmcam_dbg_warn("isMaxtimePausing[%d],isMaxsizePausing[%d]",
 			sc->isMaxtimePausing, sc->isMaxsizePausing);
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
 		return GST_PAD_PROBE_DROP;
 	}
 
@@ -823,6 +839,7 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 
 	if (sc->ferror_send) {
 		_mmcam_dbg_warn("file write error, drop frames");
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
 		return GST_PAD_PROBE_DROP;
 	}
 
@@ -832,20 +849,20 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 		audioinfo->fileformat == MM_FILE_FORMAT_MP4 ||
 		audioinfo->fileformat == MM_FILE_FORMAT_AAC) ? TRUE : FALSE;
 	if (get_trailer_size) {
-		MMCAMCORDER_G_OBJECT_GET(sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst, "expected-trailer-size", &trailer_size);
+		trailer_size = _mmcamcorder_recording_stats_get_trailer_size((MMHandleType)hcamcorder, sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst);
 		/*_mmcam_dbg_log("trailer_size %d", trailer_size);*/
 	} else {
 		trailer_size = 0; /* no trailer */
 	}
 
-	/* to minimizing free space check overhead */
-	count = count % _MMCAMCORDER_FREE_SPACE_CHECK_INTERVAL;
-	if (count++ == 0) {
+	/* free space is sampled by tracker, and estimated between samples */
+	{
 		gint free_space_ret = 0;
 		storage_state_e storage_state = STORAGE_STATE_UNMOUNTABLE;
 
 		/* check free space */
-		free_space_ret = _mmcamcorder_get_freespace(hcamcorder->storage_info.type, &free_space);
+		free_space_ret = _mmcamcorder_free_space_tracker_get((MMHandleType)hcamcorder, buffer_size,
+			_MMCAMCORDER_AUDIO_MINIMUM_SPACE + buffer_size + trailer_size, &free_space);
 		if (free_space_ret != 0) {
 			_mmcam_dbg_err("Error occured. [%d]", free_space_ret);
 			if (sc->ferror_count == 2 && sc->ferror_send == FALSE) {
@@ -859,6 +876,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 				sc->ferror_count++;
 			}
 
+			_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 			return GST_PAD_PROBE_DROP; /* skip this buffer */
 		}
 
@@ -890,6 +909,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 					_mmcam_dbg_warn("error was already sent");
 				}
 
+				_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 				return GST_PAD_PROBE_DROP;
 			}
 		}
@@ -908,6 +929,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 			msg.id = MM_MESSAGE_CAMCORDER_NO_FREE_SPACE;
 			_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
 
+			_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 			return GST_PAD_PROBE_DROP; /* skip this buffer */
 		}
 	}
@@ -944,6 +967,9 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 		else
 			MMCAMCORDER_G_OBJECT_SET(sc->encode_element[_MMCAMCORDER_ENCSINK_AQUE].gst, "empty-buffers", TRUE);
 
+		_mmcamcorder_recording_stats_update((MMHandleType)hcamcorder, rec_pipe_time,
+			(audioinfo->filesize + trailer_size) >> 10, 0);
+
 		msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
 		msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
 		msg.param.recording_status.filesize = (unsigned long long)((audioinfo->filesize + trailer_size) >> 10);
@@ -956,6 +982,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 		msg.id = MM_MESSAGE_CAMCORDER_MAX_SIZE;
 		_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		/* skip this buffer */
 		return GST_PAD_PROBE_DROP;
 	}
@@ -974,6 +1002,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 		msg.id = MM_MESSAGE_CAMCORDER_TIME_LIMIT;
 		_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		/* skip this buffer */
 		return GST_PAD_PROBE_DROP;
 	}
@@ -982,11 +1012,15 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_record(GstPad *pad, GstPa
 	if (audioinfo->b_commiting == FALSE) {
 		audioinfo->filesize += buffer_size;
 
-		msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
-		msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
-		msg.param.recording_status.filesize = (unsigned long long)((audioinfo->filesize + trailer_size) >> 10);
-		msg.param.recording_status.remained_time = remained_time;
-		_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+		/* statistics is updated for every buffer, but message is sent by the interval */
+		if (_mmcamcorder_recording_stats_update((MMHandleType)hcamcorder, rec_pipe_time,
+			(audioinfo->filesize + trailer_size) >> 10, remained_time)) {
+			msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
+			msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
+			msg.param.recording_status.filesize = (unsigned long long)((audioinfo->filesize + trailer_size) >> 10);
+			msg.param.recording_status.remained_time = remained_time;
+			_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+		}
 
 		return GST_PAD_PROBE_OK;
 	} else {
@@ -1004,6 +1038,7 @@ static gboolean __mmcamcorder_audio_add_metadata_info_m4a(MMHandleType handle)
 	gint64 current_pos = 0;
 	gint64 moov_pos = 0;
 	gint64 udta_pos = 0;
+	int ret = MM_ERROR_NONE;
 	/* supporting audio geo tag for mobile */
 	int gps_enable = 0;
 	gdouble longitude = 0;
@@ -1043,6 +1078,16 @@ static gboolean __mmcamcorder_audio_add_metadata_info_m4a(MMHandleType handle)
 		geo_info.altitude = altitude *10000;
 	}
 
+	/* write with atom index which is recorded while muxing */
+	ret = _mmcamcorder_write_metadata_in_place(info->filename, &sc->mux_index,
+		gps_enable, loc_info, geo_info, -1);
+	if (ret == MM_ERROR_NONE)
+		return TRUE;
+	else if (ret != MM_ERROR_CAMCORDER_NOT_SUPPORTED)
+		return FALSE;
+
+	_mmcam_dbg_log("scan file to write metadata");
+
 	f = fopen64(info->filename, "rb+");
 	if (f == NULL) {
 		strerror_r(errno, err_msg, 128);
@@ -26,6 +26,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "mm_camcorder_internal.h"
 #include "mm_camcorder_configure.h"
@@ -33,6 +36,10 @@
 /*-----------------------------------------------------------------------
 |    MACRO DEFINITIONS:							|
 -----------------------------------------------------------------------*/
+#define CONF_CACHE_MAGIC                0x434d4d43      /* "CMMC" */
+#define CONF_CACHE_VERSION              1
+#define CONF_CACHE_DIR                  "libmm-camcorder"
+#define CONF_CACHE_ALIGN                8
 
 /*-----------------------------------------------------------------------
 |    GLOBAL VARIABLE DEFINITIONS					|
@@ -43,20 +50,80 @@
 -----------------------------------------------------------------------*/
 #define DEFAULT_AUDIO_BUFFER_INTERVAL   50
 
+/* configure info shared by handles in process, "type:ini file" to camera_conf */
+static GMutex g_conf_store_lock;
+static GHashTable *g_conf_store;
+
+/*-----------------------------------------------------------------------
+|    LOCAL FUNCTION PROTOTYPES						|
+-----------------------------------------------------------------------*/
+static void __mmcamcorder_conf_free_info(MMHandleType handle, camera_conf **configure_info);
+
 
 char *get_new_string(char* src_string)
 {
 	return g_strdup(src_string);
 }
 
+static void __mmcamcorder_conf_update_index(camera_conf *configure_info, int category)
+{
+	int i = 0;
+	gpointer value = NULL;
+	GHashTableIter iter;
+	conf_detail *info = NULL;
+	conf_index_item *item = NULL;
+
+	mmf_return_if_fail(configure_info && configure_info->index && configure_info->index[category]);
+
+	/* the category could be added again, then the last one is used */
+	g_hash_table_iter_init(&iter, configure_info->index[category]);
+	while (g_hash_table_iter_next(&iter, NULL, &value))
+		((conf_index_item *)value)->detail = NULL;
+
+	info = configure_info->info[category];
+	if (!info)
+		return;
+
+	/* keep the first one for duplicated name as linear search did */
+	for (i = 0 ; i < info->count ; i++) {
+		if (info->detail_info[i] == NULL)
+			continue;
+
+		item = g_hash_table_lookup(configure_info->index[category], ((type_element *)(info->detail_info[i]))->name);
+		if (item && !item->detail)
+			item->detail = info->detail_info[i];
+	}
+}
+
+conf_index_item *_mmcamcorder_conf_find_index(camera_conf *configure_info, int category, const char *name)
+{
+	int category_num = 0;
+
+	mmf_return_val_if_fail(configure_info && configure_info->index && name, NULL);
+
+	if (configure_info->type == CONFIGURE_TYPE_MAIN)
+		category_num = CONFIGURE_CATEGORY_MAIN_NUM;
+	else
+		category_num = CONFIGURE_CATEGORY_CTRL_NUM;
+
+	mmf_return_val_if_fail(category >= 0 && category < category_num, NULL);
+
+	return (conf_index_item *)g_hash_table_lookup(configure_info->index[category], name);
+}
+
 int _mmcamcorder_conf_init(MMHandleType handle, int type, camera_conf *configure_info)
 {
+	int i = 0;
+	int j = 0;
 	int category_num = 0;
+	int table_size = 0;
 	int info_table_size = sizeof(conf_info_table);
+	conf_info_table *table = NULL;
+	conf_index_item *item = NULL;
 
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 
-	mmf_return_val_if_fail(hcamcorder && configure_info, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
 
 	/* Videosrc element default value */
 	static type_element _videosrc_element_default = {
@@ -636,6 +703,8 @@ int _mmcamcorder_conf_init(MMHandleType handle, int type, camera_conf *configure
 		{ "DeviceCount",        CONFIGURE_VALUE_INT,            {.value_int = MM_VIDEO_DEVICE_NUM} },
 		{ "SupportMediaPacketPreviewCb",  CONFIGURE_VALUE_INT,  {.value_int = 0} },
 		{ "SupportUserBuffer",  CONFIGURE_VALUE_INT,            {.value_int = 0} },
+		{ "VideoStreamQueueDepth",  CONFIGURE_VALUE_INT,        {.value_int = 0} },
+		{ "VideoStreamDropPolicy",  CONFIGURE_VALUE_INT,        {.value_int = 0} },
 	};
 
 	/* [AudioInput] matching table */
@@ -644,6 +713,7 @@ int _mmcamcorder_conf_init(MMHandleType handle, int type, camera_conf *configure
 		{ "AudiosrcElement",      CONFIGURE_VALUE_ELEMENT, {&_audiosrc_element_default} },
 		{ "AudiomodemsrcElement", CONFIGURE_VALUE_ELEMENT, {&_audiomodemsrc_element_default} },
 		{ "AudioBufferInterval",  CONFIGURE_VALUE_INT,     {.value_int = DEFAULT_AUDIO_BUFFER_INTERVAL} },
+		{ "AudioLevelPerChannel", CONFIGURE_VALUE_INT,     {.value_int = 0} },
 	};
 
 	/* [VideoOutput] matching table */
@@ -670,6 +740,8 @@ int _mmcamcorder_conf_init(MMHandleType handle, int type, camera_conf *configure
 		{ "UseCaptureMode",         CONFIGURE_VALUE_INT,     {.value_int = 0} },
 		{ "VideoscaleElement",      CONFIGURE_VALUE_ELEMENT, {&_videoscale_element_default} },
 		{ "PlayCaptureSound",       CONFIGURE_VALUE_INT,     {.value_int = 1} },
+		{ "ConvertThreadNum",       CONFIGURE_VALUE_INT,     {.value_int = 0} },
+		{ "PostProcessQueueDepth",  CONFIGURE_VALUE_INT,     {.value_int = 0} },
 	};
 
 	/* [Record] matching table */
@@ -693,6 +765,9 @@ int _mmcamcorder_conf_init(MMHandleType handle, int type, camera_conf *configure
 		{ "DropVideoFrame",         CONFIGURE_VALUE_INT,     {.value_int = 0} },
 		{ "PassFirstVideoFrame",    CONFIGURE_VALUE_INT,     {.value_int = 0} },
 		{ "SupportDualStream",      CONFIGURE_VALUE_INT,     {.value_int = FALSE} },
+		{ "MuxedStreamChunkSize",   CONFIGURE_VALUE_INT,     {.value_int = 0} },
+		{ "MuxedStreamChunkTime",   CONFIGURE_VALUE_INT,     {.value_int = 100} },
+		{ "MuxedStreamQueueSize",   CONFIGURE_VALUE_INT,     {.value_int = 8388608} },
 	};
 
 	/* [VideoEncoder] matching table */
@@ -896,23 +971,709 @@ int _mmcamcorder_conf_init(MMHandleType handle, int type, camera_conf *configure
 		category_num = CONFIGURE_CATEGORY_CTRL_NUM;
 	}
 
+	/* only matching table is set for shared configure info */
+	if (!configure_info)
+		return MM_ERROR_NONE;
+
 	configure_info->info = (conf_detail **)g_malloc0(sizeof(conf_detail *) * category_num);
 	if (configure_info->info == NULL) {
 		_mmcam_dbg_err("category info alloc failed : type %d", type);
 		return MM_ERROR_CAMCORDER_LOW_MEMORY;
 	}
 
+	/* index by name for each category, it's filled with ini value while parsing */
+	configure_info->index = (GHashTable **)g_malloc0(sizeof(GHashTable *) * category_num);
+
+	for (i = 0 ; i < category_num ; i++) {
+		if (type == CONFIGURE_TYPE_MAIN) {
+			table = hcamcorder->conf_main_info_table[i];
+			table_size = hcamcorder->conf_main_category_size[i];
+		} else {
+			table = hcamcorder->conf_ctrl_info_table[i];
+			table_size = hcamcorder->conf_ctrl_category_size[i];
+		}
+
+		configure_info->index[i] = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+
+		for (j = 0 ; j < table_size ; j++) {
+			if (g_hash_table_contains(configure_info->index[i], table[j].name))
+				continue;
+
+			item = g_new0(conf_index_item, 1);
+			item->table = &table[j];
+			g_hash_table_insert(configure_info->index[i], (gpointer)table[j].name, item);
+		}
+	}
+
 	_mmcam_dbg_log("Done.");
 
 	return MM_ERROR_NONE;
 }
 
 
+static guint64 __mmcamcorder_conf_cache_append(conf_cache_builder *builder, gconstpointer data, gsize size)
+{
+	guint64 length = builder->data->len;
+	guint64 offset = 0;
+
+	/* keep alignment for pointer and integer in structure */
+	offset = (length + CONF_CACHE_ALIGN - 1) & ~((guint64)CONF_CACHE_ALIGN - 1);
+
+	g_byte_array_set_size(builder->data, offset + size);
+	memset(builder->data->data + length, 0x0, offset + size - length);
+
+	if (data && size > 0)
+		memcpy(builder->data->data + offset, data, size);
+
+	return offset;
+}
+
+
+static guint64 __mmcamcorder_conf_cache_append_string(conf_cache_builder *builder, const char *string)
+{
+	if (!string)
+		return 0;
+
+	return __mmcamcorder_conf_cache_append(builder, string, strlen(string) + 1);
+}
+
+
+static void __mmcamcorder_conf_cache_set_pointer(conf_cache_builder *builder, guint64 field, guint64 target)
+{
+	gpointer value = (gpointer)(gsize)target;
+
+	/* offset 0 is header, so it's used for NULL */
+	memcpy(builder->data->data + field, &value, sizeof(gpointer));
+
+	if (target != 0)
+		g_array_append_val(builder->reloc, field);
+}
+
+
+static guint64 __mmcamcorder_conf_cache_append_detail(conf_cache_builder *builder, int value_type, void *detail)
+{
+	int i = 0;
+	guint64 offset = 0;
+	guint64 array = 0;
+	guint64 item = 0;
+
+	switch (value_type) {
+	case CONFIGURE_VALUE_INT:
+	{
+		type_int2 *src = (type_int2 *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_int2));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_int2, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+		break;
+	}
+	case CONFIGURE_VALUE_INT_RANGE:
+	{
+		type_int_range *src = (type_int_range *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_int_range));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_int_range, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+		break;
+	}
+	case CONFIGURE_VALUE_INT_ARRAY:
+	{
+		type_int_array *src = (type_int_array *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_int_array));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_int_array, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+
+		if (src->value && src->count > 0)
+			array = __mmcamcorder_conf_cache_append(builder, src->value, sizeof(int) * src->count);
+
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_int_array, value), array);
+		break;
+	}
+	case CONFIGURE_VALUE_INT_PAIR_ARRAY:
+	{
+		type_int_pair_array *src = (type_int_pair_array *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_int_pair_array));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_int_pair_array, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+
+		for (i = 0 ; i < 2 ; i++) {
+			array = 0;
+			if (src->value[i] && src->count > 0)
+				array = __mmcamcorder_conf_cache_append(builder, src->value[i], sizeof(int) * src->count);
+
+			__mmcamcorder_conf_cache_set_pointer(builder,
+				offset + G_STRUCT_OFFSET(type_int_pair_array, value) + sizeof(int *) * i, array);
+		}
+		break;
+	}
+	case CONFIGURE_VALUE_STRING:
+	{
+		type_string2 *src = (type_string2 *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_string2));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_string2, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_string2, value),
+			__mmcamcorder_conf_cache_append_string(builder, src->value));
+		break;
+	}
+	case CONFIGURE_VALUE_STRING_ARRAY:
+	{
+		type_string_array *src = (type_string_array *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_string_array));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_string_array, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_string_array, default_value),
+			__mmcamcorder_conf_cache_append_string(builder, src->default_value));
+
+		if (src->value && src->count > 0) {
+			array = __mmcamcorder_conf_cache_append(builder, NULL, sizeof(char *) * src->count);
+			for (i = 0 ; i < src->count ; i++) {
+				__mmcamcorder_conf_cache_set_pointer(builder, array + sizeof(char *) * i,
+					__mmcamcorder_conf_cache_append_string(builder, src->value[i]));
+			}
+		}
+
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_string_array, value), array);
+		break;
+	}
+	case CONFIGURE_VALUE_ELEMENT:
+	{
+		type_element2 *src = (type_element2 *)detail;
+
+		offset = __mmcamcorder_conf_cache_append(builder, src, sizeof(type_element2));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_element2, name),
+			__mmcamcorder_conf_cache_append_string(builder, src->name));
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_element2, element_name),
+			__mmcamcorder_conf_cache_append_string(builder, src->element_name));
+
+		if (src->value_int && src->count_int > 0) {
+			array = __mmcamcorder_conf_cache_append(builder, NULL, sizeof(type_int2 *) * src->count_int);
+			for (i = 0 ; i < src->count_int ; i++) {
+				if (!src->value_int[i])
+					continue;
+
+				item = __mmcamcorder_conf_cache_append(builder, src->value_int[i], sizeof(type_int2));
+				__mmcamcorder_conf_cache_set_pointer(builder, item + G_STRUCT_OFFSET(type_int2, name),
+					__mmcamcorder_conf_cache_append_string(builder, src->value_int[i]->name));
+				__mmcamcorder_conf_cache_set_pointer(builder, array + sizeof(type_int2 *) * i, item);
+			}
+		}
+
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_element2, value_int), array);
+
+		array = 0;
+		if (src->value_string && src->count_string > 0) {
+			array = __mmcamcorder_conf_cache_append(builder, NULL, sizeof(type_string2 *) * src->count_string);
+			for (i = 0 ; i < src->count_string ; i++) {
+				if (!src->value_string[i])
+					continue;
+
+				item = __mmcamcorder_conf_cache_append(builder, src->value_string[i], sizeof(type_string2));
+				__mmcamcorder_conf_cache_set_pointer(builder, item + G_STRUCT_OFFSET(type_string2, name),
+					__mmcamcorder_conf_cache_append_string(builder, src->value_string[i]->name));
+				__mmcamcorder_conf_cache_set_pointer(builder, item + G_STRUCT_OFFSET(type_string2, value),
+					__mmcamcorder_conf_cache_append_string(builder, src->value_string[i]->value));
+				__mmcamcorder_conf_cache_set_pointer(builder, array + sizeof(type_string2 *) * i, item);
+			}
+		}
+
+		__mmcamcorder_conf_cache_set_pointer(builder, offset + G_STRUCT_OFFSET(type_element2, value_string), array);
+		break;
+	}
+	default:
+		_mmcam_dbg_warn("unknown type %d", value_type);
+		break;
+	}
+
+	return offset;
+}
+
+
+static guint32 __mmcamcorder_conf_get_table_hash(MMHandleType handle, int type)
+{
+	int i = 0;
+	int j = 0;
+	int category_num = 0;
+	int table_size = 0;
+	guint32 hash = 5381;
+	conf_info_table *table = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	if (type == CONFIGURE_TYPE_MAIN)
+		category_num = CONFIGURE_CATEGORY_MAIN_NUM;
+	else
+		category_num = CONFIGURE_CATEGORY_CTRL_NUM;
+
+	for (i = 0 ; i < category_num ; i++) {
+		if (type == CONFIGURE_TYPE_MAIN) {
+			table = hcamcorder->conf_main_info_table[i];
+			table_size = hcamcorder->conf_main_category_size[i];
+		} else {
+			table = hcamcorder->conf_ctrl_info_table[i];
+			table_size = hcamcorder->conf_ctrl_category_size[i];
+		}
+
+		for (j = 0 ; j < table_size ; j++)
+			hash = (hash * 33) ^ g_str_hash(table[j].name) ^ (guint32)table[j].value_type;
+
+		hash = (hash * 33) ^ (guint32)table_size;
+	}
+
+	return hash;
+}
+
+
+static gint64 __mmcamcorder_conf_get_mtime(struct stat *file_stat)
+{
+	return (gint64)file_stat->st_mtim.tv_sec * G_GINT64_CONSTANT(1000000000) + file_stat->st_mtim.tv_nsec;
+}
+
+
+static gchar *__mmcamcorder_conf_get_cache_path(const char *ConfFile)
+{
+	return g_strdup_printf("%s/%s/%s.cache", g_get_user_cache_dir(), CONF_CACHE_DIR, ConfFile);
+}
+
+
+static void __mmcamcorder_conf_save_cache(MMHandleType handle, camera_conf *configure_info, const char *cache_path, struct stat *source_stat)
+{
+	int i = 0;
+	int j = 0;
+	int category_num = 0;
+	guint64 offset = 0;
+	guint64 array = 0;
+	gchar *cache_dir = NULL;
+	GError *error = NULL;
+	conf_detail *info = NULL;
+	conf_index_item *item = NULL;
+	conf_cache_header header;
+	conf_cache_builder builder;
+
+	mmf_return_if_fail(configure_info && cache_path && source_stat);
+
+	memset(&header, 0x0, sizeof(conf_cache_header));
+
+	builder.data = g_byte_array_new();
+	builder.reloc = g_array_new(FALSE, FALSE, sizeof(guint64));
+
+	/* reserve header */
+	__mmcamcorder_conf_cache_append(&builder, NULL, sizeof(conf_cache_header));
+
+	if (configure_info->type == CONFIGURE_TYPE_MAIN)
+		category_num = CONFIGURE_CATEGORY_MAIN_NUM;
+	else
+		category_num = CONFIGURE_CATEGORY_CTRL_NUM;
+
+	for (i = 0 ; i < category_num ; i++) {
+		info = configure_info->info[i];
+		if (!info)
+			continue;
+
+		offset = __mmcamcorder_conf_cache_append(&builder, NULL, sizeof(conf_detail));
+		((conf_detail *)(builder.data->data + offset))->count = info->count;
+
+		array = __mmcamcorder_conf_cache_append(&builder, NULL, sizeof(void *) * info->count);
+		__mmcamcorder_conf_cache_set_pointer(&builder, offset + G_STRUCT_OFFSET(conf_detail, detail_info), array);
+
+		for (j = 0 ; j < info->count ; j++) {
+			if (!info->detail_info[j])
+				continue;
+
+			item = _mmcamcorder_conf_find_index(configure_info, i, ((type_element *)(info->detail_info[j]))->name);
+			if (!item)
+				continue;
+
+			__mmcamcorder_conf_cache_set_pointer(&builder, array + sizeof(void *) * j,
+				__mmcamcorder_conf_cache_append_detail(&builder, item->table->value_type, info->detail_info[j]));
+		}
+
+		header.category[i] = offset;
+	}
+
+	header.magic = CONF_CACHE_MAGIC;
+	header.version = CONF_CACHE_VERSION;
+	header.pointer_size = sizeof(gpointer);
+	header.type = configure_info->type;
+	header.table_hash = __mmcamcorder_conf_get_table_hash(handle, configure_info->type);
+	header.reloc_count = builder.reloc->len;
+	header.reloc_offset = __mmcamcorder_conf_cache_append(&builder, builder.reloc->data, sizeof(guint64) * builder.reloc->len);
+	header.total_size = builder.data->len;
+	header.source_mtime = __mmcamcorder_conf_get_mtime(source_stat);
+	header.source_size = source_stat->st_size;
+	header.source_inode = source_stat->st_ino;
+
+	memcpy(builder.data->data, &header, sizeof(conf_cache_header));
+
+	cache_dir = g_path_get_dirname(cache_path);
+	g_mkdir_with_parents(cache_dir, 0700);
+	g_free(cache_dir);
+
+	/* it's written to temporary file and renamed, so other process does not see partial one */
+	if (!g_file_set_contents(cache_path, (const gchar *)builder.data->data, builder.data->len, &error)) {
+		_mmcam_dbg_warn("failed to save cache [%s] : %s", cache_path, error ? error->message : "unknown");
+		g_clear_error(&error);
+	} else {
+		_mmcam_dbg_log("cache saved [%s], size %u, reloc %u", cache_path, builder.data->len, header.reloc_count);
+	}
+
+	g_array_free(builder.reloc, TRUE);
+	g_byte_array_free(builder.data, TRUE);
+}
+
+
+static gboolean __mmcamcorder_conf_cache_check_range(guint8 *base, guint64 total_size, const void *ptr, guint64 size)
+{
+	guint64 offset = 0;
+
+	if ((const guint8 *)ptr < base)
+		return FALSE;
+
+	offset = (guint64)((const guint8 *)ptr - base);
+
+	/* everything is appended with alignment */
+	if (offset % CONF_CACHE_ALIGN)
+		return FALSE;
+
+	return offset <= total_size && size <= total_size - offset;
+}
+
+
+static gboolean __mmcamcorder_conf_cache_check_string(guint8 *base, guint64 total_size, const char *string)
+{
+	guint64 offset = 0;
+
+	/* NULL string is saved as 0 */
+	if (!string)
+		return TRUE;
+
+	if (!__mmcamcorder_conf_cache_check_range(base, total_size, string, 1))
+		return FALSE;
+
+	offset = (guint64)((const guint8 *)string - base);
+
+	return memchr(string, '\0', total_size - offset) != NULL;
+}
+
+
+static gboolean __mmcamcorder_conf_cache_check_array(guint8 *base, guint64 total_size, const void *array, int count, gsize size)
+{
+	if (count < 0)
+		return FALSE;
+
+	/* array is not saved if it's NULL or count is 0 */
+	if (!array)
+		return TRUE;
+
+	return __mmcamcorder_conf_cache_check_range(base, total_size, array, (guint64)count * size);
+}
+
+
+static gboolean __mmcamcorder_conf_cache_check_detail(guint8 *base, guint64 total_size, int value_type, void *detail)
+{
+	int i = 0;
+
+	switch (value_type) {
+	case CONFIGURE_VALUE_INT:
+		return __mmcamcorder_conf_cache_check_range(base, total_size, detail, sizeof(type_int2));
+	case CONFIGURE_VALUE_INT_RANGE:
+		return __mmcamcorder_conf_cache_check_range(base, total_size, detail, sizeof(type_int_range));
+	case CONFIGURE_VALUE_INT_ARRAY:
+	{
+		type_int_array *src = (type_int_array *)detail;
+
+		return __mmcamcorder_conf_cache_check_range(base, total_size, src, sizeof(type_int_array)) &&
+			__mmcamcorder_conf_cache_check_array(base, total_size, src->value, src->count, sizeof(int));
+	}
+	case CONFIGURE_VALUE_INT_PAIR_ARRAY:
+	{
+		type_int_pair_array *src = (type_int_pair_array *)detail;
+
+		return __mmcamcorder_conf_cache_check_range(base, total_size, src, sizeof(type_int_pair_array)) &&
+			__mmcamcorder_conf_cache_check_array(base, total_size, src->value[0], src->count, sizeof(int)) &&
+			__mmcamcorder_conf_cache_check_array(base, total_size, src->value[1], src->count, sizeof(int));
+	}
+	case CONFIGURE_VALUE_STRING:
+	{
+		type_string2 *src = (type_string2 *)detail;
+
+		return __mmcamcorder_conf_cache_check_range(base, total_size, src, sizeof(type_string2)) &&
+			__mmcamcorder_conf_cache_check_string(base, total_size, src->value);
+	}
+	case CONFIGURE_VALUE_STRING_ARRAY:
+	{
+		type_string_array *src = (type_string_array *)detail;
+
+		if (!__mmcamcorder_conf_cache_check_range(base, total_size, src, sizeof(type_string_array)) ||
+			!__mmcamcorder_conf_cache_check_string(base, total_size, src->default_value) ||
+			!__mmcamcorder_conf_cache_check_array(base, total_size, src->value, src->count, sizeof(char *)))
+			return FALSE;
+
+		for (i = 0 ; src->value && i < src->count ; i++) {
+			if (!__mmcamcorder_conf_cache_check_string(base, total_size, src->value[i]))
+				return FALSE;
+		}
+
+		return TRUE;
+	}
+	case CONFIGURE_VALUE_ELEMENT:
+	{
+		type_element2 *src = (type_element2 *)detail;
+
+		if (!__mmcamcorder_conf_cache_check_range(base, total_size, src, sizeof(type_element2)) ||
+			!__mmcamcorder_conf_cache_check_string(base, total_size, src->element_name) ||
+			!__mmcamcorder_conf_cache_check_array(base, total_size, src->value_int, src->count_int, sizeof(type_int2 *)) ||
+			!__mmcamcorder_conf_cache_check_array(base, total_size, src->value_string, src->count_string, sizeof(type_string2 *)))
+			return FALSE;
+
+		for (i = 0 ; src->value_int && i < src->count_int ; i++) {
+			if (!src->value_int[i])
+				continue;
+
+			if (!__mmcamcorder_conf_cache_check_range(base, total_size, src->value_int[i], sizeof(type_int2)) ||
+				!__mmcamcorder_conf_cache_check_string(base, total_size, src->value_int[i]->name))
+				return FALSE;
+		}
+
+		for (i = 0 ; src->value_string && i < src->count_string ; i++) {
+			if (!src->value_string[i])
+				continue;
+
+			if (!__mmcamcorder_conf_cache_check_range(base, total_size, src->value_string[i], sizeof(type_string2)) ||
+				!__mmcamcorder_conf_cache_check_string(base, total_size, src->value_string[i]->name) ||
+				!__mmcamcorder_conf_cache_check_string(base, total_size, src->value_string[i]->value))
+				return FALSE;
+		}
+
+		return TRUE;
+	}
+	default:
+		return FALSE;
+	}
+}
+
+
+static gboolean __mmcamcorder_conf_cache_check_category(camera_conf *configure_info, int category,
+	guint8 *base, guint64 total_size, conf_detail *info)
+{
+	int i = 0;
+	type_element *detail = NULL;
+	conf_index_item *item = NULL;
+
+	if (!__mmcamcorder_conf_cache_check_range(base, total_size, info, sizeof(conf_detail)) ||
+		!__mmcamcorder_conf_cache_check_array(base, total_size, info->detail_info, info->count, sizeof(void *)) ||
+		(info->count > 0 && !info->detail_info))
+		return FALSE;
+
+	for (i = 0 ; i < info->count ; i++) {
+		detail = (type_element *)info->detail_info[i];
+		if (!detail)
+			continue;
+
+		/* name is the first member of all types, and type is found by name */
+		if (!__mmcamcorder_conf_cache_check_range(base, total_size, detail, sizeof(char *)) ||
+			!detail->name ||
+			!__mmcamcorder_conf_cache_check_string(base, total_size, detail->name))
+			return FALSE;
+
+		item = _mmcamcorder_conf_find_index(configure_info, category, detail->name);
+		if (!item || !__mmcamcorder_conf_cache_check_detail(base, total_size, item->table->value_type, detail)) {
+			_mmcam_dbg_err("invalid detail[%d] [%s] in category %d", i, detail->name, category);
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_conf_load_cache(MMHandleType handle, int type, const char *cache_path, struct stat *source_stat, camera_conf **configure_info)
+{
+	int fd = -1;
+	int i = 0;
+	int category_num = 0;
+	guint64 target = 0;
+	guint64 total_size = 0;
+	guint64 *reloc = NULL;
+	guint8 *base = NULL;
+	struct stat cache_stat;
+	conf_cache_header *header = NULL;
+	camera_conf *new_conf = NULL;
+
+	mmf_return_val_if_fail(cache_path && source_stat && configure_info, FALSE);
+
+	fd = open(cache_path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return FALSE;
+
+	if (fstat(fd, &cache_stat) != 0 || cache_stat.st_size < (off_t)sizeof(conf_cache_header)) {
+		close(fd);
+		return FALSE;
+	}
+
+	/* private writable mapping for pointer fix up */
+	base = mmap(NULL, cache_stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (base == MAP_FAILED) {
+		_mmcam_dbg_warn("mmap failed [%s] errno %d", cache_path, errno);
+		return FALSE;
+	}
+
+	if (type == CONFIGURE_TYPE_MAIN)
+		category_num = CONFIGURE_CATEGORY_MAIN_NUM;
+	else
+		category_num = CONFIGURE_CATEGORY_CTRL_NUM;
+
+	new_conf = (camera_conf *)g_malloc0(sizeof(camera_conf));
+	new_conf->type = type;
+
+	/* matching table is set to handle in here */
+	if (_mmcamcorder_conf_init(handle, type, new_conf) != MM_ERROR_NONE) {
+		g_free(new_conf);
+		munmap(base, cache_stat.st_size);
+		return FALSE;
+	}
+
+	header = (conf_cache_header *)base;
+	total_size = (guint64)cache_stat.st_size;
+
+	if (header->magic != CONF_CACHE_MAGIC ||
+		header->version != CONF_CACHE_VERSION ||
+		header->pointer_size != sizeof(gpointer) ||
+		header->type != (guint32)type ||
+		header->total_size != total_size ||
+		header->source_mtime != __mmcamcorder_conf_get_mtime(source_stat) ||
+		header->source_size != (guint64)source_stat->st_size ||
+		header->source_inode != (guint64)source_stat->st_ino ||
+		header->table_hash != __mmcamcorder_conf_get_table_hash(handle, type) ||
+		header->reloc_offset > total_size ||
+		header->reloc_count > (total_size - header->reloc_offset) / sizeof(guint64)) {
+		_mmcam_dbg_log("cache is not matched with [type %d] ini file, ignore it", type);
+		goto _LOAD_FAILED;
+	}
+
+	/* fix up pointers */
+	reloc = (guint64 *)(base + header->reloc_offset);
+
+	for (i = 0 ; i < (int)header->reloc_count ; i++) {
+		if (reloc[i] > total_size - sizeof(gpointer) || reloc[i] % sizeof(gpointer)) {
+			_mmcam_dbg_err("invalid reloc[%d] %"G_GUINT64_FORMAT, i, reloc[i]);
+			goto _LOAD_FAILED;
+		}
+
+		target = (guint64)(gsize)*(gpointer *)(base + reloc[i]);
+		if (target == 0 || target >= total_size) {
+			_mmcam_dbg_err("invalid target %"G_GUINT64_FORMAT" for reloc[%d]", target, i);
+			goto _LOAD_FAILED;
+		}
+
+		*(gpointer *)(base + reloc[i]) = base + target;
+	}
+
+	for (i = 0 ; i < category_num ; i++) {
+		if (header->category[i] == 0)
+			continue;
+
+		/* all arrays and strings should be in cache, or ini file is parsed again */
+		if (header->category[i] > total_size ||
+			!__mmcamcorder_conf_cache_check_category(new_conf, i, base, total_size, (conf_detail *)(base + header->category[i]))) {
+			_mmcam_dbg_err("invalid category[%d] offset %"G_GUINT64_FORMAT, i, header->category[i]);
+			goto _LOAD_FAILED;
+		}
+
+		new_conf->info[i] = (conf_detail *)(base + header->category[i]);
+		__mmcamcorder_conf_update_index(new_conf, i);
+	}
+
+	new_conf->cache_addr = base;
+	new_conf->cache_size = cache_stat.st_size;
+
+	*configure_info = new_conf;
+
+	return TRUE;
+
+_LOAD_FAILED:
+	/* details in mapped cache should not be freed */
+	for (i = 0 ; i < category_num ; i++)
+		new_conf->info[i] = NULL;
+
+	__mmcamcorder_conf_free_info(handle, &new_conf);
+
+	munmap(base, cache_stat.st_size);
+
+	return FALSE;
+}
+
+
+static camera_conf *__mmcamcorder_conf_store_ref(const char *store_key, struct stat *source_stat)
+{
+	camera_conf *configure_info = NULL;
+
+	if (!g_conf_store)
+		return NULL;
+
+	configure_info = (camera_conf *)g_hash_table_lookup(g_conf_store, store_key);
+	if (!configure_info)
+		return NULL;
+
+	if (configure_info->source_mtime != __mmcamcorder_conf_get_mtime(source_stat) ||
+		configure_info->source_size != (guint64)source_stat->st_size ||
+		configure_info->source_inode != (guint64)source_stat->st_ino) {
+		/* ini file is changed, handles which have old one keep using it */
+		_mmcam_dbg_warn("[%s] is changed, remove it from store", store_key);
+		g_hash_table_remove(g_conf_store, store_key);
+		return NULL;
+	}
+
+	configure_info->ref_count++;
+
+	return configure_info;
+}
+
+
+static void __mmcamcorder_conf_store_add(const char *store_key, struct stat *source_stat, camera_conf *configure_info)
+{
+	if (!g_conf_store)
+		g_conf_store = g_hash_table_new(g_str_hash, g_str_equal);
+
+	configure_info->ref_count = 1;
+	configure_info->store_key = g_strdup(store_key);
+	configure_info->source_mtime = __mmcamcorder_conf_get_mtime(source_stat);
+	configure_info->source_size = source_stat->st_size;
+	configure_info->source_inode = source_stat->st_ino;
+
+	/* key is owned by configure info */
+	g_hash_table_replace(g_conf_store, configure_info->store_key, configure_info);
+}
+
+
+void _mmcamcorder_conf_invalidate(void)
+{
+	g_mutex_lock(&g_conf_store_lock);
+
+	if (g_conf_store) {
+		_mmcam_dbg_log("invalidate %u shared configure", g_hash_table_size(g_conf_store));
+		g_hash_table_remove_all(g_conf_store);
+	}
+
+	g_mutex_unlock(&g_conf_store_lock);
+}
+
+
 int _mmcamcorder_conf_get_info(MMHandleType handle, int type, const char *ConfFile, camera_conf **configure_info)
 {
 	int ret = MM_ERROR_NONE;
 	FILE *fp = NULL;
 	char conf_path[60] = {'\0',};
+	gboolean stat_done = FALSE;
+	gboolean cache_loaded = FALSE;
+	gchar *cache_path = NULL;
+	gchar *store_key = NULL;
+	struct stat source_stat;
 
 	_mmcam_dbg_log("Opening...[%s]", ConfFile);
 
@@ -935,7 +1696,44 @@ int _mmcamcorder_conf_get_info(MMHandleType handle, int type, const char *ConfFi
 	}
 
 	if (fp) {
-		ret = _mmcamcorder_conf_parse_info(handle, type, fp, configure_info);
+		*configure_info = NULL;
+
+		g_mutex_lock(&g_conf_store_lock);
+
+		stat_done = (fstat(fileno(fp), &source_stat) == 0);
+		if (stat_done) {
+			/* borrow one which is made from same ini file by other handle */
+			store_key = g_strdup_printf("%d:%s", type, ConfFile);
+			*configure_info = __mmcamcorder_conf_store_ref(store_key, &source_stat);
+		}
+
+		if (*configure_info) {
+			/* matching table is still set to handle */
+			_mmcamcorder_conf_init(handle, type, NULL);
+			_mmcam_dbg_log("shared configure [%s], ref count %d", store_key, (*configure_info)->ref_count);
+		} else {
+			/* use binary cache if it's made from current ini file */
+			if (stat_done) {
+				cache_path = __mmcamcorder_conf_get_cache_path(ConfFile);
+				cache_loaded = __mmcamcorder_conf_load_cache(handle, type, cache_path, &source_stat, configure_info);
+			}
+
+			if (cache_loaded) {
+				_mmcam_dbg_log("loaded from cache [%s]", cache_path);
+			} else {
+				ret = _mmcamcorder_conf_parse_info(handle, type, fp, configure_info);
+				if (ret == MM_ERROR_NONE && cache_path)
+					__mmcamcorder_conf_save_cache(handle, *configure_info, cache_path, &source_stat);
+			}
+
+			if (ret == MM_ERROR_NONE && *configure_info && stat_done)
+				__mmcamcorder_conf_store_add(store_key, &source_stat, *configure_info);
+		}
+
+		g_mutex_unlock(&g_conf_store_lock);
+
+		g_free(store_key);
+		g_free(cache_path);
 		fclose(fp);
 	}
 
@@ -1118,6 +1916,7 @@ int _mmcamcorder_conf_parse_info(MMHandleType handle, int type, FILE *fp, camera
 			if (category != -1) {
 				_mmcamcorder_conf_add_info(handle, type, &(new_conf->info[category]),
 											buffer_details, category, count_details);
+				__mmcamcorder_conf_update_index(new_conf, category);
 			} else {
 				_mmcam_dbg_warn("No matched category[%s],type[%d]... check it.", category_name, type);
 			}
@@ -1141,6 +1940,35 @@ int _mmcamcorder_conf_parse_info(MMHandleType handle, int type, FILE *fp, camera
 
 
 void _mmcamcorder_conf_release_info(MMHandleType handle, camera_conf **configure_info)
+{
+	camera_conf *temp_conf = NULL;
+
+	mmf_return_if_fail(configure_info && *configure_info);
+
+	temp_conf = *configure_info;
+
+	g_mutex_lock(&g_conf_store_lock);
+
+	if (temp_conf->ref_count > 1) {
+		temp_conf->ref_count--;
+		_mmcam_dbg_log("[%s] is still used, ref count %d", temp_conf->store_key, temp_conf->ref_count);
+		g_mutex_unlock(&g_conf_store_lock);
+		*configure_info = NULL;
+		return;
+	}
+
+	/* it could be already removed by invalidation or update of ini file */
+	if (temp_conf->store_key && g_conf_store &&
+		g_hash_table_lookup(g_conf_store, temp_conf->store_key) == temp_conf)
+		g_hash_table_remove(g_conf_store, temp_conf->store_key);
+
+	g_mutex_unlock(&g_conf_store_lock);
+
+	__mmcamcorder_conf_free_info(handle, configure_info);
+}
+
+
+static void __mmcamcorder_conf_free_info(MMHandleType handle, camera_conf **configure_info)
 {
 	int i = 0;
 	int j = 0;
@@ -1168,7 +1996,8 @@ void _mmcamcorder_conf_release_info(MMHandleType handle, camera_conf **configure
 		category_num = CONFIGURE_CATEGORY_CTRL_NUM;
 
 	for (i = 0 ; i < category_num ; i++) {
-		if (temp_conf->info[i]) {
+		/* details in mapped cache are released by munmap */
+		if (temp_conf->info[i] && !temp_conf->cache_addr) {
 			for (j = 0 ; j < temp_conf->info[i]->count ; j++) {
 				if (temp_conf->info[i]->detail_info[j] == NULL)
 					continue;
@@ -1252,6 +2081,22 @@ void _mmcamcorder_conf_release_info(MMHandleType handle, camera_conf **configure
 		}
 	}
 
+	if (temp_conf->index) {
+		for (i = 0 ; i < category_num ; i++) {
+			if (temp_conf->index[i])
+				g_hash_table_destroy(temp_conf->index[i]);
+		}
+
+		SAFE_G_FREE(temp_conf->index);
+	}
+
+	if (temp_conf->cache_addr) {
+		munmap(temp_conf->cache_addr, temp_conf->cache_size);
+		temp_conf->cache_addr = NULL;
+	}
+
+	SAFE_G_FREE(temp_conf->store_key);
+
 	SAFE_G_FREE((*configure_info)->info);
 	SAFE_G_FREE((*configure_info));
 
@@ -1649,32 +2494,21 @@ int _mmcamcorder_conf_add_info(MMHandleType handle, int type, conf_detail **info
 
 int _mmcamcorder_conf_get_value_int(MMHandleType handle, camera_conf* configure_info, int category, const char* name, int* value)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/* _mmcam_dbg_log("Entered... category[%d],name[%s]", category, name); */
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count = configure_info->info[category]->count;
-		info = configure_info->info[category];
-
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_int*)(info->detail_info[i]))->name , name)) {
-				*value = ((type_int*)(info->detail_info[i]))->value;
-				/* _mmcam_dbg_log("Get[%s] int[%d]", name, *value); */
-				return TRUE;
-			}
-		}
-	}
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item) {
+		if (item->detail)
+			*value = ((type_int*)(item->detail))->value;
+		else
+			*value = item->table->value_int;
 
-	if (_mmcamcorder_conf_get_default_value_int(handle, configure_info->type, category, name, value)) {
-		 /*_mmcam_dbg_log("Get[%s] int[%d]", name, *value);*/
+		/* _mmcam_dbg_log("Get[%s] int[%d]", name, *value); */
 		return TRUE;
 	}
 
@@ -1686,31 +2520,21 @@ int _mmcamcorder_conf_get_value_int(MMHandleType handle, camera_conf* configure_
 int
 _mmcamcorder_conf_get_value_int_range(camera_conf* configure_info, int category, const char* name, type_int_range** value)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/* _mmcam_dbg_log("Entered... category[%d],name[%s]", category, name); */
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count = configure_info->info[category]->count;
-		info = configure_info->info[category];
-
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_int_range*)(info->detail_info[i]))->name , name)) {
-				*value = (type_int_range*)(info->detail_info[i]);
-				/*
-				_mmcam_dbg_log("Get[%s] int range - min[%d],max[%d],default[%d]",
-					name, (*value)->min, (*value)->max, (*value)->default_value);
-				*/
-				return TRUE;
-			}
-		}
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item && item->detail) {
+		*value = (type_int_range*)(item->detail);
+		/*
+		_mmcam_dbg_log("Get[%s] int range - min[%d],max[%d],default[%d]",
+			name, (*value)->min, (*value)->max, (*value)->default_value);
+		*/
+		return TRUE;
 	}
 
 	*value = NULL;
@@ -1723,31 +2547,21 @@ _mmcamcorder_conf_get_value_int_range(camera_conf* configure_info, int category,
 int
 _mmcamcorder_conf_get_value_int_array(camera_conf* configure_info, int category, const char* name, type_int_array** value)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/*_mmcam_dbg_log("Entered... category[%d],name[%s]", category, name);*/
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count	= configure_info->info[category]->count;
-		info	= configure_info->info[category];
-
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_int_array*)(info->detail_info[i]))->name , name)) {
-				*value = (type_int_array*)(info->detail_info[i]);
-				/*
-				_mmcam_dbg_log("Get[%s] int array - [%x],count[%d],default[%d]",
-					name, (*value)->value, (*value)->count, (*value)->default_value);
-				*/
-				return TRUE;
-			}
-		}
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item && item->detail) {
+		*value = (type_int_array*)(item->detail);
+		/*
+		_mmcam_dbg_log("Get[%s] int array - [%x],count[%d],default[%d]",
+			name, (*value)->value, (*value)->count, (*value)->default_value);
+		*/
+		return TRUE;
 	}
 
 	*value = NULL;
@@ -1760,32 +2574,22 @@ _mmcamcorder_conf_get_value_int_array(camera_conf* configure_info, int category,
 int
 _mmcamcorder_conf_get_value_int_pair_array(camera_conf* configure_info, int category, const char* name, type_int_pair_array** value)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/* _mmcam_dbg_log("Entered... category[%d],name[%s]", category, name); */
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count = configure_info->info[category]->count;
-		info = configure_info->info[category];
-
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_int_pair_array*)(info->detail_info[i]))->name , name)) {
-				*value = (type_int_pair_array*)(info->detail_info[i]);
-				/*
-				_mmcam_dbg_log("Get[%s] int pair array - [%x][%x],count[%d],default[%d][%d]",
-					name, (*value)->value[0], (*value)->value[1], (*value)->count,
-					(*value)->default_value[0], (*value)->default_value[1]);
-				*/
-				return TRUE;
-			}
-		}
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item && item->detail) {
+		*value = (type_int_pair_array*)(item->detail);
+		/*
+		_mmcam_dbg_log("Get[%s] int pair array - [%x][%x],count[%d],default[%d][%d]",
+			name, (*value)->value[0], (*value)->value[1], (*value)->count,
+			(*value)->default_value[0], (*value)->default_value[1]);
+		*/
+		return TRUE;
 	}
 
 	*value = NULL;
@@ -1797,31 +2601,20 @@ _mmcamcorder_conf_get_value_int_pair_array(camera_conf* configure_info, int cate
 
 int _mmcamcorder_conf_get_value_string(MMHandleType handle, camera_conf* configure_info, int category, const char* name, const char** value)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/* _mmcam_dbg_log("Entered... category[%d],name[%s]", category, name); */
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count = configure_info->info[category]->count;
-		info = configure_info->info[category];
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item) {
+		if (item->detail)
+			*value = ((type_string*)(item->detail))->value;
+		else
+			*value = item->table->value_string;
 
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_string*)(info->detail_info[i]))->name , name)) {
-				*value = ((type_string*)(info->detail_info[i]))->value;
-				 /*_mmcam_dbg_log( "Get[%s] string[%s]", name, *value ? *value : "NULL" );*/
-				return TRUE;
-			}
-		}
-	}
-
-	if (_mmcamcorder_conf_get_default_value_string(handle, configure_info->type, category, name, value)) {
 		/*_mmcam_dbg_log( "Get[%s] string[%s]", name, *value ? *value : "NULL" );*/
 		return TRUE;
 	}
@@ -1834,31 +2627,21 @@ int _mmcamcorder_conf_get_value_string(MMHandleType handle, camera_conf* configu
 int
 _mmcamcorder_conf_get_value_string_array(camera_conf* configure_info, int category, const char* name, type_string_array** value)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/* _mmcam_dbg_log("Entered... category[%d],name[%s]", category, name); */
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count = configure_info->info[category]->count;
-		info = configure_info->info[category];
-
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_string_array*)(info->detail_info[i]))->name , name)) {
-				*value = (type_string_array*)(info->detail_info[i]);
-				/*
-				_mmcam_dbg_log("Get[%s] string array - [%x],count[%d],default[%s]",
-					name, (*value)->value, (*value)->count, (*value)->default_value);
-				*/
-				return TRUE;
-			}
-		}
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item && item->detail) {
+		*value = (type_string_array*)(item->detail);
+		/*
+		_mmcam_dbg_log("Get[%s] string array - [%x],count[%d],default[%s]",
+			name, (*value)->value, (*value)->count, (*value)->default_value);
+		*/
+		return TRUE;
 	}
 
 	*value = NULL;
@@ -1870,31 +2653,20 @@ _mmcamcorder_conf_get_value_string_array(camera_conf* configure_info, int catego
 
 int _mmcamcorder_conf_get_element(MMHandleType handle, camera_conf* configure_info, int category, const char* name, type_element** element)
 {
-	int i, count;
-	conf_detail* info;
+	conf_index_item *item = NULL;
 
 	/* _mmcam_dbg_log("Entered... category[%d], ame[%s]", category, name); */
 
 	mmf_return_val_if_fail(configure_info, FALSE);
 	mmf_return_val_if_fail(name, FALSE);
 
-	if (configure_info->info[category]) {
-		count = configure_info->info[category]->count;
-		info = configure_info->info[category];
-
-		for (i = 0 ; i < count ; i++) {
-			if (info->detail_info[i] == NULL)
-				continue;
-
-			if (!strcmp(((type_element*)(info->detail_info[i]))->name , name)) {
-				*element = (type_element*)(info->detail_info[i]);
-				/* _mmcam_dbg_log("Get[%s] element[%x]", name, *element); */
-				return TRUE;
-			}
-		}
-	}
+	item = _mmcamcorder_conf_find_index(configure_info, category, name);
+	if (item) {
+		if (item->detail)
+			*element = (type_element*)(item->detail);
+		else
+			*element = item->table->value_element;
 
-	if (_mmcamcorder_conf_get_default_element(handle, configure_info->type, category, name, element)) {
 		/* _mmcam_dbg_log("Get[%s] element[%x]", name, *element); */
 		return TRUE;
 	}
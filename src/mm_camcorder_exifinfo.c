@@ -35,11 +35,12 @@
 #define MM_EXIFINFO_USE_BINARY_EXIFDATA         1
 #define JPEG_MAX_SIZE                           20000000
 #define JPEG_THUMBNAIL_MAX_SIZE                 (128*1024)
-#define JPEG_DATA_OFFSET                        2
-#define JPEG_EXIF_OFFSET                        4
 #define EXIF_MARKER_SOI_LENGTH                  2
 #define EXIF_MARKER_APP1_LENGTH                 2
 #define EXIF_APP1_LENGTH                        2
+#define EXIF_HEADER_LENGTH                      6	/* "Exif\0\0" */
+#define EXIF_TIFF_HEADER_LENGTH                 8
+#define EXIF_IFD_ENTRY_LENGTH                   12
 
 
 #if MM_EXIFINFO_USE_BINARY_EXIFDATA
@@ -78,19 +79,6 @@ typedef struct  _mm_exif_entry_t {
 /**
  * local functions.
  */
-static void
-_exif_set_uint16(int is_motorola, void * out, unsigned short in)
-{
-	if (is_motorola) {
-		((unsigned char *)out)[0] = in & 0x00ff;
-		((unsigned char *)out)[1] = in >> 8;
-	} else {
-		((unsigned char *)out)[0] = in >> 8;
-		((unsigned char *)out)[1] = in & 0x00ff;
-	}
-}
-
-
 #ifdef _MMCAMCORDER_EXIF_GET_JPEG_MARKER_OFFSET
 static unsigned long
 _exif_get_jpeg_marker_offset(void *jpeg, int jpeg_size, unsigned short marker)
@@ -409,24 +397,69 @@ exit:
 }
 
 
-int
-mm_exif_write_exif_jpeg_to_memory(void **mem, unsigned int *length, mm_exif_info_t *info,  unsigned char *jpeg, unsigned int jpeg_len)
+/* find exif APP1 segment in APPn segments after SOI, it's O(number of segments) */
+static int
+_exif_find_jpeg_exif_segment(unsigned char *jpeg, unsigned int jpeg_len, unsigned int *start, unsigned int *end)
 {
-	unsigned short head[2] = {0,};
-	unsigned short head_len = 0;
-	unsigned char *eb = NULL;
-	unsigned int ebs;
-	int jpeg_offset = JPEG_DATA_OFFSET;
-	mm_exif_info_t *test_exif_info = NULL;
+	unsigned int offset = EXIF_MARKER_SOI_LENGTH;
+	unsigned int segment_len = 0;
+	unsigned char marker = 0;
 
-	/*output*/
-	unsigned char *m = NULL;
-	int m_len = 0;
+	if (jpeg_len < EXIF_MARKER_SOI_LENGTH || jpeg[0] != 0xff || jpeg[1] != 0xd8) {
+		_mmcam_dbg_err("invalid JPEG - no SOI");
+		return MM_ERROR_CAMCORDER_DEVICE_WRONG_JPEG;
+	}
 
-	_mmcam_dbg_log("");
+	/* no exif : new one is placed right after SOI */
+	*start = EXIF_MARKER_SOI_LENGTH;
+	*end = EXIF_MARKER_SOI_LENGTH;
+
+	while (offset + EXIF_MARKER_APP1_LENGTH + EXIF_APP1_LENGTH <= jpeg_len) {
+		if (jpeg[offset] != 0xff)
+			break;
+
+		marker = jpeg[offset + 1];
+		if (marker == 0xff) {
+			/* fill byte */
+			offset++;
+			continue;
+		}
+
+		/* exif is in APPn segments only */
+		if (marker < 0xe0 || marker > 0xef)
+			break;
+
+		segment_len = (jpeg[offset + 2] << 8) | jpeg[offset + 3];
+		if (segment_len < EXIF_APP1_LENGTH || segment_len > jpeg_len - offset - EXIF_MARKER_APP1_LENGTH) {
+			_mmcam_dbg_warn("invalid segment length %u at %u", segment_len, offset);
+			break;
+		}
 
-	if (info == NULL || jpeg == NULL) {
-		_mmcam_dbg_err("MM_ERROR_CAMCORDER_INVALID_ARGUMENT info=%p, jpeg=%p", info, jpeg);
+		if (marker == 0xe1 && segment_len >= EXIF_APP1_LENGTH + 6 &&
+			!memcmp(jpeg + offset + EXIF_MARKER_APP1_LENGTH + EXIF_APP1_LENGTH, "Exif\0\0", 6)) {
+			*start = offset;
+			*end = offset + EXIF_MARKER_APP1_LENGTH + segment_len;
+			_mmcam_dbg_log("exif found [%u ~ %u]", *start, *end);
+			break;
+		}
+
+		offset += EXIF_MARKER_APP1_LENGTH + segment_len;
+	}
+
+	return MM_ERROR_NONE;
+}
+
+
+int
+mm_exif_get_exif_jpeg_segments(mm_exif_jpeg_segments_t *segments, mm_exif_info_t *info, unsigned char *jpeg, unsigned int jpeg_len)
+{
+	int ret = MM_ERROR_NONE;
+	unsigned int exif_start = 0;
+	unsigned int exif_end = 0;
+	unsigned int app1_len = 0;
+
+	if (segments == NULL || info == NULL || jpeg == NULL) {
+		_mmcam_dbg_err("MM_ERROR_CAMCORDER_INVALID_ARGUMENT segments=%p, info=%p, jpeg=%p", segments, info, jpeg);
 		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
 	}
 
@@ -435,66 +468,89 @@ mm_exif_write_exif_jpeg_to_memory(void **mem, unsigned int *length, mm_exif_info
 		return MM_ERROR_CAMCORDER_DEVICE_WRONG_JPEG;
 	}
 
-	eb = info->data;
-	ebs = info->size;
+	/* length of APP1 includes length field itself */
+	app1_len = info->size + EXIF_APP1_LENGTH;
+	if (app1_len > 0xffff) {
+		_mmcam_dbg_err("too large exif size %u", info->size);
+		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
+	}
 
 	/* check EXIF in JPEG */
-	if (mm_exif_load_exif_info(&test_exif_info, jpeg, jpeg_len) == MM_ERROR_NONE) {
-		if (test_exif_info) {
-			jpeg_offset = test_exif_info->size + JPEG_EXIF_OFFSET;
-			if (test_exif_info->data) {
-				free(test_exif_info->data);
-				test_exif_info->data = NULL;
-			}
-			free(test_exif_info);
-			test_exif_info = NULL;
-		} else {
-			_mmcam_dbg_err("test_exif_info is NULL");
-		}
-	} else {
-		_mmcam_dbg_warn("no EXIF in JPEG");
+	ret = _exif_find_jpeg_exif_segment(jpeg, jpeg_len, &exif_start, &exif_end);
+	if (ret != MM_ERROR_NONE)
+		return ret;
+
+	/*set SOI, APP1 and length of APP1*/
+	segments->header[0] = 0xff;
+	segments->header[1] = 0xd8;
+	segments->header[2] = 0xff;
+	segments->header[3] = 0xe1;
+	segments->header[4] = (app1_len >> 8) & 0xff;
+	segments->header[5] = app1_len & 0xff;
+
+	segments->count = 0;
+
+	segments->segment[segments->count].iov_base = segments->header;
+	segments->segment[segments->count++].iov_len = MM_EXIF_JPEG_HEADER_LENGTH;
+
+	segments->segment[segments->count].iov_base = info->data;
+	segments->segment[segments->count++].iov_len = info->size;
+
+	/* APPn segments before old exif */
+	if (exif_start > EXIF_MARKER_SOI_LENGTH) {
+		segments->segment[segments->count].iov_base = jpeg + EXIF_MARKER_SOI_LENGTH;
+		segments->segment[segments->count++].iov_len = exif_start - EXIF_MARKER_SOI_LENGTH;
 	}
 
-	/*length of output image*/
-	/*SOI + APP1 + length of APP1 + length of EXIF + IMAGE*/
-	m_len = EXIF_MARKER_SOI_LENGTH + EXIF_MARKER_APP1_LENGTH + EXIF_APP1_LENGTH + ebs + (jpeg_len - jpeg_offset);
+	/*IMAGE*/
+	segments->segment[segments->count].iov_base = jpeg + exif_end;
+	segments->segment[segments->count++].iov_len = jpeg_len - exif_end;
+
+	segments->length = MM_EXIF_JPEG_HEADER_LENGTH + info->size + (jpeg_len - (exif_end - exif_start)) - EXIF_MARKER_SOI_LENGTH;
+
+	_mmcam_dbg_log("segment count %d, length %u (original:%u, old exif:%u)",
+		segments->count, segments->length, jpeg_len, exif_end - exif_start);
+
+	return MM_ERROR_NONE;
+}
+
+
+int
+mm_exif_write_exif_jpeg_to_memory(void **mem, unsigned int *length, mm_exif_info_t *info,  unsigned char *jpeg, unsigned int jpeg_len)
+{
+	int i = 0;
+	int ret = MM_ERROR_NONE;
+	mm_exif_jpeg_segments_t segments;
+
+	/*output*/
+	unsigned char *m = NULL;
+	unsigned int m_len = 0;
+
+	_mmcam_dbg_log("");
+
+	if (mem == NULL || length == NULL) {
+		_mmcam_dbg_err("MM_ERROR_CAMCORDER_INVALID_ARGUMENT mem=%p, length=%p", mem, length);
+		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
+	}
+
+	ret = mm_exif_get_exif_jpeg_segments(&segments, info, jpeg, jpeg_len);
+	if (ret != MM_ERROR_NONE)
+		return ret;
+
 	/*alloc output image*/
-	m = malloc(m_len);
+	m = malloc(segments.length);
 	if (!m) {
 		_mmcam_dbg_err("malloc() failed.");
 		return MM_ERROR_CAMCORDER_LOW_MEMORY;
 	}
 
-	/*set SOI, APP1*/
-	_exif_set_uint16(0, &head[0], 0xffd8);
-	_exif_set_uint16(0, &head[1], 0xffe1);
-	/*set header length*/
-	_exif_set_uint16(0, &head_len, (unsigned short)(ebs + 2));
-	if (head[0] == 0 || head[1] == 0 || head_len == 0) {
-		_mmcam_dbg_err("setting error");
-		free(m);
-		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
-	}
-
 	/* Complete JPEG+EXIF */
-	/*SOI marker*/
-	memcpy(m, &head[0], EXIF_MARKER_SOI_LENGTH);
-
-	/*APP1 marker*/
-	memcpy(m + EXIF_MARKER_SOI_LENGTH, &head[1], EXIF_MARKER_APP1_LENGTH);
-
-	/*length of APP1*/
-	memcpy(m + EXIF_MARKER_SOI_LENGTH + EXIF_MARKER_APP1_LENGTH, &head_len, EXIF_APP1_LENGTH);
-
-	/*EXIF*/
-	memcpy(m + EXIF_MARKER_SOI_LENGTH + EXIF_MARKER_APP1_LENGTH + EXIF_APP1_LENGTH, eb, ebs);
-
-	/*IMAGE*/
-	memcpy(m + EXIF_MARKER_SOI_LENGTH + EXIF_MARKER_APP1_LENGTH + EXIF_APP1_LENGTH + ebs,
-		jpeg + jpeg_offset, jpeg_len - jpeg_offset);
+	for (i = 0 ; i < segments.count ; i++) {
+		memcpy(m + m_len, segments.segment[i].iov_base, segments.segment[i].iov_len);
+		m_len += segments.segment[i].iov_len;
+	}
 
-	_mmcam_dbg_log("JPEG+EXIF Copy DONE(original:%d, offset:%d, copied:%d)",
-		jpeg_len, jpeg_offset, jpeg_len - jpeg_offset);
+	_mmcam_dbg_log("JPEG+EXIF Copy DONE(original:%d, output:%d)", jpeg_len, m_len);
 
 	/*set ouput param*/
 	*mem = m;
@@ -552,3 +608,310 @@ int mm_exif_load_exif_info(mm_exif_info_t **info, void *jpeg_data, int jpeg_leng
 	else
 		return MM_ERROR_CAMCORDER_INTERNAL;
 }
+
+
+/* find IFD entry with tag in serialized TIFF, return offset of entry or 0 */
+static unsigned int
+_exif_template_find_ifd_entry(unsigned char *tiff, unsigned int tiff_len, ExifByteOrder order, unsigned int ifd_offset, ExifTag tag)
+{
+	unsigned int i = 0;
+	unsigned int count = 0;
+	unsigned int entry = 0;
+
+	if (ifd_offset < EXIF_TIFF_HEADER_LENGTH || ifd_offset > tiff_len - 2)
+		return 0;
+
+	count = exif_get_short(tiff + ifd_offset, order);
+	if (count > (tiff_len - ifd_offset - 2) / EXIF_IFD_ENTRY_LENGTH)
+		return 0;
+
+	for (i = 0, entry = ifd_offset + 2 ; i < count ; i++, entry += EXIF_IFD_ENTRY_LENGTH) {
+		if (exif_get_short(tiff + entry, order) == tag)
+			return entry;
+	}
+
+	return 0;
+}
+
+
+/* get offset of IFD in serialized TIFF, return 0 if it's not found */
+static unsigned int
+_exif_template_find_ifd(unsigned char *tiff, unsigned int tiff_len, ExifByteOrder order, ExifIfd ifd)
+{
+	unsigned int ifd0 = exif_get_long(tiff + 4, order);
+	unsigned int entry = 0;
+	unsigned int count = 0;
+
+	switch (ifd) {
+	case EXIF_IFD_0:
+		return ifd0;
+	case EXIF_IFD_1:
+		if (ifd0 < EXIF_TIFF_HEADER_LENGTH || ifd0 > tiff_len - 2)
+			return 0;
+		count = exif_get_short(tiff + ifd0, order);
+		entry = ifd0 + 2 + count * EXIF_IFD_ENTRY_LENGTH;
+		if (entry > tiff_len - 4)
+			return 0;
+		return exif_get_long(tiff + entry, order);
+	case EXIF_IFD_EXIF:
+		entry = _exif_template_find_ifd_entry(tiff, tiff_len, order, ifd0, EXIF_TAG_EXIF_IFD_POINTER);
+		break;
+	case EXIF_IFD_GPS:
+		entry = _exif_template_find_ifd_entry(tiff, tiff_len, order, ifd0, EXIF_TAG_GPS_INFO_IFD_POINTER);
+		break;
+	case EXIF_IFD_INTEROPERABILITY:
+		entry = _exif_template_find_ifd(tiff, tiff_len, order, EXIF_IFD_EXIF);
+		entry = _exif_template_find_ifd_entry(tiff, tiff_len, order, entry, EXIF_TAG_INTEROPERABILITY_IFD_POINTER);
+		break;
+	default:
+		return 0;
+	}
+
+	if (entry == 0)
+		return 0;
+
+	return exif_get_long(tiff + entry + 8, order);
+}
+
+
+/* get offset of value in serialized TIFF, value is in entry if it's not bigger than 4 bytes */
+static int
+_exif_template_find_value(unsigned char *tiff, unsigned int tiff_len, ExifByteOrder order, mm_exif_template_entry_t *e, unsigned int *offset)
+{
+	unsigned int entry = 0;
+	unsigned int size = exif_format_get_size(e->format) * e->components;
+	unsigned int value = 0;
+
+	entry = _exif_template_find_ifd(tiff, tiff_len, order, e->ifd);
+	entry = _exif_template_find_ifd_entry(tiff, tiff_len, order, entry, e->tag);
+	if (entry == 0) {
+		_mmcam_dbg_warn("tag [%x] in ifd [%d] is not found", e->tag, e->ifd);
+		return MM_ERROR_CAMCORDER_INTERNAL;
+	}
+
+	if (exif_get_short(tiff + entry + 2, order) != e->format ||
+		exif_get_long(tiff + entry + 4, order) != e->components) {
+		_mmcam_dbg_warn("tag [%x] is changed while saving", e->tag);
+		return MM_ERROR_CAMCORDER_INTERNAL;
+	}
+
+	if (size > 4)
+		value = exif_get_long(tiff + entry + 8, order);
+	else
+		value = entry + 8;
+
+	if (value > tiff_len || size > tiff_len - value) {
+		_mmcam_dbg_warn("invalid value offset [%u] of tag [%x]", value, e->tag);
+		return MM_ERROR_CAMCORDER_INTERNAL;
+	}
+
+	*offset = value;
+
+	return MM_ERROR_NONE;
+}
+
+
+void
+mm_exif_template_record_begin(mm_exif_template_t *tmpl)
+{
+	mm_exif_template_clear(tmpl);
+
+	tmpl->state = MM_EXIF_TEMPLATE_STATE_RECORD;
+}
+
+
+int
+mm_exif_template_record_end(mm_exif_template_t *tmpl, mm_exif_info_t *info)
+{
+	int i = 0;
+	int j = 0;
+	unsigned char *tiff = NULL;
+	unsigned int tiff_len = 0;
+	unsigned int offset = 0;
+
+	if (tmpl == NULL || info == NULL || info->data == NULL) {
+		_mmcam_dbg_err("NULL parameter %p, %p", tmpl, info);
+		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
+	}
+
+	if (tmpl->state != MM_EXIF_TEMPLATE_STATE_RECORD)
+		goto _RECORD_FAILED;
+
+	if (info->size < EXIF_HEADER_LENGTH + EXIF_TIFF_HEADER_LENGTH ||
+		memcmp(info->data, "Exif\0\0", EXIF_HEADER_LENGTH)) {
+		_mmcam_dbg_warn("no exif header");
+		goto _RECORD_FAILED;
+	}
+
+	tiff = (unsigned char *)info->data + EXIF_HEADER_LENGTH;
+	tiff_len = info->size - EXIF_HEADER_LENGTH;
+
+	if (tiff[0] == 'I' && tiff[1] == 'I') {
+		tmpl->order = EXIF_BYTE_ORDER_INTEL;
+	} else if (tiff[0] == 'M' && tiff[1] == 'M') {
+		tmpl->order = EXIF_BYTE_ORDER_MOTOROLA;
+	} else {
+		_mmcam_dbg_warn("invalid byte order");
+		goto _RECORD_FAILED;
+	}
+
+	for (i = 0 ; i < tmpl->count ; i++) {
+		/* serialized exif has the last value of tag which is set several times */
+		for (j = i + 1 ; j < tmpl->count ; j++) {
+			if (tmpl->entry[j].ifd == tmpl->entry[i].ifd && tmpl->entry[j].tag == tmpl->entry[i].tag)
+				break;
+		}
+
+		if (j < tmpl->count) {
+			tmpl->entry[i].offset = 0;
+			continue;
+		}
+
+		if (_exif_template_find_value(tiff, tiff_len, tmpl->order, &tmpl->entry[i], &offset) != MM_ERROR_NONE)
+			goto _RECORD_FAILED;
+
+		tmpl->entry[i].offset = offset + EXIF_HEADER_LENGTH;
+	}
+
+	tmpl->data = malloc(info->size);
+	if (tmpl->data == NULL) {
+		_mmcam_dbg_err("failed to alloc template, size %u", info->size);
+		goto _RECORD_FAILED;
+	}
+
+	memcpy(tmpl->data, info->data, info->size);
+	tmpl->size = info->size;
+	tmpl->state = MM_EXIF_TEMPLATE_STATE_READY;
+
+	_mmcam_dbg_log("exif template ready - size %u, entry count %d", tmpl->size, tmpl->count);
+
+	return MM_ERROR_NONE;
+
+_RECORD_FAILED:
+	mm_exif_template_clear(tmpl);
+
+	return MM_ERROR_CAMCORDER_INTERNAL;
+}
+
+
+int
+mm_exif_template_patch_begin(mm_exif_template_t *tmpl)
+{
+	if (tmpl == NULL || tmpl->state != MM_EXIF_TEMPLATE_STATE_READY)
+		return MM_ERROR_CAMCORDER_NOT_INITIALIZED;
+
+	tmpl->patch = malloc(tmpl->size);
+	if (tmpl->patch == NULL) {
+		_mmcam_dbg_err("failed to alloc patch, size %u", tmpl->size);
+		return MM_ERROR_CAMCORDER_LOW_MEMORY;
+	}
+
+	memcpy(tmpl->patch, tmpl->data, tmpl->size);
+	tmpl->cursor = 0;
+	tmpl->state = MM_EXIF_TEMPLATE_STATE_PATCH;
+
+	return MM_ERROR_NONE;
+}
+
+
+int
+mm_exif_template_patch_end(mm_exif_template_t *tmpl, mm_exif_info_t *info)
+{
+	if (tmpl == NULL || info == NULL) {
+		_mmcam_dbg_err("NULL parameter %p, %p", tmpl, info);
+		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
+	}
+
+	if (tmpl->state != MM_EXIF_TEMPLATE_STATE_PATCH || tmpl->cursor != tmpl->count) {
+		_mmcam_dbg_log("entries are changed [state %d, cursor %d, count %d]",
+			tmpl->state, tmpl->cursor, tmpl->count);
+		mm_exif_template_clear(tmpl);
+		return MM_ERROR_CAMCORDER_INTERNAL;
+	}
+
+	if (info->data)
+		free(info->data);
+
+	info->data = tmpl->patch;
+	info->size = tmpl->size;
+
+	tmpl->patch = NULL;
+	tmpl->state = MM_EXIF_TEMPLATE_STATE_READY;
+
+	return MM_ERROR_NONE;
+}
+
+
+int
+mm_exif_template_set_entry(mm_exif_template_t *tmpl, ExifData *exif, ExifIfd ifd, ExifTag tag, ExifFormat format, unsigned long components, const char *data)
+{
+	int ret = MM_ERROR_NONE;
+	mm_exif_template_entry_t *e = NULL;
+
+	if (tmpl == NULL)
+		return mm_exif_set_add_entry(exif, ifd, tag, format, components, data);
+
+	if (tmpl->state == MM_EXIF_TEMPLATE_STATE_PATCH) {
+		if (data == NULL)
+			return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
+
+		e = &tmpl->entry[tmpl->cursor];
+		if (tmpl->cursor >= tmpl->count || e->ifd != ifd || e->tag != tag ||
+			e->format != format || e->components != components) {
+			tmpl->state = MM_EXIF_TEMPLATE_STATE_MISMATCH;
+			return MM_ERROR_NONE;
+		}
+
+		if (e->offset > 0)
+			memcpy(tmpl->patch + e->offset, data, exif_format_get_size(format) * components);
+
+		tmpl->cursor++;
+
+		return MM_ERROR_NONE;
+	}
+
+	if (tmpl->state == MM_EXIF_TEMPLATE_STATE_MISMATCH)
+		return MM_ERROR_NONE;
+
+	ret = mm_exif_set_add_entry(exif, ifd, tag, format, components, data);
+	if (ret != MM_ERROR_NONE || tmpl->state != MM_EXIF_TEMPLATE_STATE_RECORD)
+		return ret;
+
+	if (tmpl->count >= MM_EXIF_TEMPLATE_ENTRY_MAX) {
+		_mmcam_dbg_warn("too many entries, stop recording");
+		tmpl->state = MM_EXIF_TEMPLATE_STATE_NONE;
+		return ret;
+	}
+
+	e = &tmpl->entry[tmpl->count++];
+	e->ifd = ifd;
+	e->tag = tag;
+	e->format = format;
+	e->components = components;
+	e->offset = 0;
+
+	return ret;
+}
+
+
+void
+mm_exif_template_clear(mm_exif_template_t *tmpl)
+{
+	if (tmpl == NULL)
+		return;
+
+	if (tmpl->data) {
+		free(tmpl->data);
+		tmpl->data = NULL;
+	}
+
+	if (tmpl->patch) {
+		free(tmpl->patch);
+		tmpl->patch = NULL;
+	}
+
+	tmpl->size = 0;
+	tmpl->count = 0;
+	tmpl->cursor = 0;
+	tmpl->state = MM_EXIF_TEMPLATE_STATE_NONE;
+}
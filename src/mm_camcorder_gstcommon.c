@@ -133,6 +133,19 @@ gboolean	videocodec_fileformat_compatibility_table[MM_VIDEO_CODEC_NUM][MM_FILE_F
 #define _MMCAMCORDER_NANOSEC_PER_1SEC             1000000000
 #define _MMCAMCORDER_NANOSEC_PER_1MILISEC         1000
 
+/* latency measurement for preview profile */
+#define _MMCAMCORDER_PREVIEW_PROFILE_BEGIN(x_enable, x_begin_time) \
+do { \
+	if (x_enable) \
+		x_begin_time = g_get_monotonic_time(); \
+} while (0)
+
+#define _MMCAMCORDER_PREVIEW_PROFILE_END(x_enable, x_begin_time, x_stage_time) \
+do { \
+	if (x_enable) \
+		x_stage_time = g_get_monotonic_time() - x_begin_time; \
+} while (0)
+
 
 /*-----------------------------------------------------------------------
 |    LOCAL FUNCTION PROTOTYPES:						|
@@ -154,6 +167,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_preview(GstPad *pad, GstP
 static GstPadProbeReturn __mmcamcorder_video_dataprobe_push_buffer_to_record(GstPad *pad, GstPadProbeInfo *info, gpointer u_data);
 static int __mmcamcorder_get_amrnb_bitrate_mode(int bitrate);
 static guint32 _mmcamcorder_convert_fourcc_string_to_value(const gchar* format_name);
+static void __mmcamcorder_mstream_delivery_push(mmf_camcorder_t *hcamcorder, GstBuffer *buffer, guint64 offset);
+static void __mmcamcorder_vstream_delivery_push(mmf_camcorder_t *hcamcorder, GstBuffer *buffer, MMCamcorderVideoStreamDataType *stream);
 
 #ifdef _MMCAMCORDER_PRODUCT_TV
 static bool __mmcamcorder_find_max_resolution(MMHandleType handle, gint *max_width, gint *max_height);
@@ -1638,10 +1653,238 @@ static guint32 _mmcamcorder_convert_fourcc_string_to_value(const gchar* format_n
 	return format_name[0] | (format_name[1] << 8) | (format_name[2] << 16) | (format_name[3] << 24);
 }
 
+static void __mmcamcorder_vstream_send(mmf_camcorder_t *hcamcorder, GstBuffer *buffer,
+	MMCamcorderVideoStreamDataType *stream, gboolean do_profile, gint64 *stage_time)
+{
+	int i = 0;
+	int num_bos = 0;
+	gint64 begin_time = 0;
+
+	tbm_surface_h t_surface = NULL;
+	tbm_surface_info_s t_info;
+
+	GstMemory *memory = NULL;
+	GstMapInfo mapinfo;
+
+	memset(&mapinfo, 0x0, sizeof(GstMapInfo));
+
+	_MMCAMCORDER_PREVIEW_PROFILE_BEGIN(do_profile, begin_time);
+
+	/* set size and timestamp */
+	if (stream->format == MM_PIXEL_FORMAT_ENCODED_H264)
+		memory = gst_buffer_get_all_memory(buffer);
+	else
+		memory = gst_buffer_peek_memory(buffer, 0);
+	if (!memory) {
+		_mmcam_dbg_err("GstMemory get failed from buffer %p", buffer);
+		return;
+	}
+
+	if (hcamcorder->use_zero_copy_format) {
+		t_surface = (tbm_surface_h)gst_tizen_memory_get_surface(memory);
+
+		if (tbm_surface_get_info(t_surface, &t_info) != TBM_SURFACE_ERROR_NONE) {
+			_mmcam_dbg_err("failed to get tbm surface[%p] info", t_surface);
+			return;
+		}
+
+		stream->length_total = t_info.size;
+
+		/* set bo, stride and elevation */
+		num_bos = gst_tizen_memory_get_num_bos(memory);
+		for (i = 0 ; i < num_bos ; i++)
+			stream->bo[i] = gst_tizen_memory_get_bos(memory, i);
+
+		for (i = 0 ; i < t_info.num_planes ; i++) {
+			stream->stride[i] = t_info.planes[i].stride;
+			stream->elevation[i] = t_info.planes[i].size / t_info.planes[i].stride;
+			/*_mmcam_dbg_log("[%d] %dx%d", i, stream->stride[i], stream->elevation[i]);*/
+		}
+
+		/* set gst buffer */
+		stream->internal_buffer = buffer;
+	} else {
+		stream->length_total = gst_memory_get_sizes(memory, NULL, NULL);
+	}
+
+	stream->timestamp = (unsigned int)(GST_BUFFER_PTS(buffer)/1000000); /* nano sec -> mili sec */
+
+	/* set data pointers */
+	if (stream->format == MM_PIXEL_FORMAT_NV12 ||
+		stream->format == MM_PIXEL_FORMAT_NV21 ||
+		stream->format == MM_PIXEL_FORMAT_I420) {
+		if (hcamcorder->use_zero_copy_format) {
+			if (stream->format == MM_PIXEL_FORMAT_NV12 ||
+			    stream->format == MM_PIXEL_FORMAT_NV21) {
+				stream->data_type = MM_CAM_STREAM_DATA_YUV420SP;
+				stream->num_planes = 2;
+				stream->data.yuv420sp.y = t_info.planes[0].ptr;
+				stream->data.yuv420sp.length_y = t_info.planes[0].size;
+				stream->data.yuv420sp.uv = t_info.planes[1].ptr;
+				stream->data.yuv420sp.length_uv = t_info.planes[1].size;
+				/*
+				_mmcam_dbg_log("format[%d][num_planes:%d] [Y]p:%p,size:%d [UV]p:%p,size:%d",
+					stream->format, stream->num_planes,
+					stream->data.yuv420sp.y, stream->data.yuv420sp.length_y,
+					stream->data.yuv420sp.uv, stream->data.yuv420sp.length_uv);
+				*/
+			} else {
+				stream->data_type = MM_CAM_STREAM_DATA_YUV420P;
+				stream->num_planes = 3;
+				stream->data.yuv420p.y = t_info.planes[0].ptr;
+				stream->data.yuv420p.length_y = t_info.planes[0].size;
+				stream->data.yuv420p.u = t_info.planes[1].ptr;
+				stream->data.yuv420p.length_u = t_info.planes[1].size;
+				stream->data.yuv420p.v = t_info.planes[2].ptr;
+				stream->data.yuv420p.length_v = t_info.planes[2].size;
+				/*
+				_mmcam_dbg_log("S420[num_planes:%d] [Y]p:%p,size:%d [U]p:%p,size:%d [V]p:%p,size:%d",
+					stream->num_planes,
+					stream->data.yuv420p.y, stream->data.yuv420p.length_y,
+					stream->data.yuv420p.u, stream->data.yuv420p.length_u,
+					stream->data.yuv420p.v, stream->data.yuv420p.length_v);
+				*/
+			}
+		} else {
+			gst_memory_map(memory, &mapinfo, GST_MAP_READWRITE);
+			if (stream->format == MM_PIXEL_FORMAT_NV12 ||
+				stream->format == MM_PIXEL_FORMAT_NV21) {
+				stream->data_type = MM_CAM_STREAM_DATA_YUV420SP;
+				stream->num_planes = 2;
+				stream->data.yuv420sp.y = mapinfo.data;
+				stream->data.yuv420sp.length_y = stream->width * stream->height;
+				stream->data.yuv420sp.uv = stream->data.yuv420sp.y + stream->data.yuv420sp.length_y;
+				stream->data.yuv420sp.length_uv = stream->data.yuv420sp.length_y >> 1;
+				stream->stride[0] = stream->width;
+				stream->elevation[0] = stream->height;
+				stream->stride[1] = stream->width;
+				stream->elevation[1] = stream->height >> 1;
+				/*
+				_mmcam_dbg_log("format[%d][num_planes:%d] [Y]p:%p,size:%d [UV]p:%p,size:%d",
+					stream->format, stream->num_planes,
+					stream->data.yuv420sp.y, stream->data.yuv420sp.length_y,
+					stream->data.yuv420sp.uv, stream->data.yuv420sp.length_uv);
+				*/
+			} else {
+				stream->data_type = MM_CAM_STREAM_DATA_YUV420P;
+				stream->num_planes = 3;
+				stream->data.yuv420p.y = mapinfo.data;
+				stream->data.yuv420p.length_y = stream->width * stream->height;
+				stream->data.yuv420p.u = stream->data.yuv420p.y + stream->data.yuv420p.length_y;
+				stream->data.yuv420p.length_u = stream->data.yuv420p.length_y >> 2;
+				stream->data.yuv420p.v = stream->data.yuv420p.u + stream->data.yuv420p.length_u;
+				stream->data.yuv420p.length_v = stream->data.yuv420p.length_u;
+				stream->stride[0] = stream->width;
+				stream->elevation[0] = stream->height;
+				stream->stride[1] = stream->width >> 1;
+				stream->elevation[1] = stream->height >> 1;
+				stream->stride[2] = stream->width >> 1;
+				stream->elevation[2] = stream->height >> 1;
+				/*
+				_mmcam_dbg_log("I420[num_planes:%d] [Y]p:%p,size:%d [U]p:%p,size:%d [V]p:%p,size:%d",
+					stream->num_planes,
+					stream->data.yuv420p.y, stream->data.yuv420p.length_y,
+					stream->data.yuv420p.u, stream->data.yuv420p.length_u,
+					stream->data.yuv420p.v, stream->data.yuv420p.length_v);
+				*/
+			}
+		}
+	} else {
+		gst_memory_map(memory, &mapinfo, GST_MAP_READWRITE);
+
+		switch (stream->format) {
+		case MM_PIXEL_FORMAT_YUYV:
+		case MM_PIXEL_FORMAT_UYVY:
+		case MM_PIXEL_FORMAT_422P:
+		case MM_PIXEL_FORMAT_ITLV_JPEG_UYVY:
+			stream->data_type = MM_CAM_STREAM_DATA_YUV422;
+			stream->data.yuv422.yuv = mapinfo.data;
+			stream->data.yuv422.length_yuv = stream->length_total;
+			stream->stride[0] = stream->width << 1;
+			stream->elevation[0] = stream->height;
+			break;
+		case MM_PIXEL_FORMAT_ENCODED_H264:
+			stream->data_type = MM_CAM_STREAM_DATA_ENCODED;
+			stream->data.encoded.data = mapinfo.data;
+			stream->data.encoded.length_data = stream->length_total;
+			/*
+			_mmcam_dbg_log("H264[num_planes:%d] [0]p:%p,size:%d",
+				stream->num_planes, stream->data.encoded.data, stream->data.encoded.length_data);
+			*/
+			break;
+		case MM_PIXEL_FORMAT_INVZ:
+			stream->data_type = MM_CAM_STREAM_DATA_DEPTH;
+			stream->data.depth.data = mapinfo.data;
+			stream->data.depth.length_data = stream->length_total;
+			stream->stride[0] = stream->width << 1;
+			stream->elevation[0] = stream->height;
+			break;
+		case MM_PIXEL_FORMAT_RGBA:
+		case MM_PIXEL_FORMAT_ARGB:
+			stream->data_type = MM_CAM_STREAM_DATA_RGB;
+			stream->data.rgb.data = mapinfo.data;
+			stream->data.rgb.length_data = stream->length_total;
+			stream->stride[0] = stream->width << 2;
+			stream->elevation[0] = stream->height;
+			break;
+		default:
+			stream->data_type = MM_CAM_STREAM_DATA_YUV420;
+			stream->data.yuv420.yuv = mapinfo.data;
+			stream->data.yuv420.length_yuv = stream->length_total;
+			stream->stride[0] = (stream->width * 3) >> 1;
+			stream->elevation[0] = stream->height;
+			break;
+		}
+
+		stream->num_planes = 1;
+		/*
+		_mmcam_dbg_log("%c%c%c%c[num_planes:%d] [0]p:%p,size:%d",
+			fourcc, fourcc>>8, fourcc>>16, fourcc>>24,
+			stream->num_planes, stream->data.yuv420.yuv, stream->data.yuv420.length_yuv);
+		*/
+	}
+
+	_MMCAMCORDER_PREVIEW_PROFILE_END(do_profile, begin_time, stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_MAP]);
+
+	/* call application callback */
+	_MMCAMCORDER_PREVIEW_PROFILE_BEGIN(do_profile, begin_time);
+	_MMCAMCORDER_LOCK_VSTREAM_CALLBACK(hcamcorder);
+	_MMCAMCORDER_PREVIEW_PROFILE_END(do_profile, begin_time, stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_LOCK]);
+
+	if (hcamcorder->vstream_cb) {
+		_MMCAMCORDER_PREVIEW_PROFILE_BEGIN(do_profile, begin_time);
+		hcamcorder->vstream_cb(stream, hcamcorder->vstream_cb_param);
+		_MMCAMCORDER_PREVIEW_PROFILE_END(do_profile, begin_time, stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_CALLBACK]);
+
+		g_atomic_int_inc(&hcamcorder->vstream_delivery.delivered);
+
+		_MMCAMCORDER_PREVIEW_PROFILE_BEGIN(do_profile, begin_time);
+		for (i = 0 ; i < TBM_SURF_PLANE_MAX && stream->bo[i] ; i++) {
+			tbm_bo_map(stream->bo[i], TBM_DEVICE_CPU, TBM_OPTION_READ|TBM_OPTION_WRITE);
+			tbm_bo_unmap(stream->bo[i]);
+		}
+		_MMCAMCORDER_PREVIEW_PROFILE_END(do_profile, begin_time, stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_BO_SYNC]);
+	}
+
+	_MMCAMCORDER_UNLOCK_VSTREAM_CALLBACK(hcamcorder);
+
+	/* unmap memory */
+	_MMCAMCORDER_PREVIEW_PROFILE_BEGIN(do_profile, begin_time);
+	if (mapinfo.data)
+		gst_memory_unmap(memory, &mapinfo);
+	if (stream->format == MM_PIXEL_FORMAT_ENCODED_H264)
+		gst_memory_unref(memory);
+	_MMCAMCORDER_PREVIEW_PROFILE_END(do_profile, begin_time, stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_UNMAP]);
+}
+
 static GstPadProbeReturn __mmcamcorder_video_dataprobe_preview(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
 {
 	int current_state = MM_CAMCORDER_STATE_NONE;
 	int i = 0;
+	gboolean do_profile = FALSE;
+	gint64 probe_time = 0;
+	gint64 begin_time = 0;
+	gint64 stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM];
 
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
 	_MMCamcorderSubContext *sc = NULL;
@@ -1655,6 +1898,13 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_preview(GstPad *pad, GstP
 	sc = MMF_CAMCORDER_SUBCONTEXT(u_data);
 	mmf_return_val_if_fail(sc, GST_PAD_PROBE_DROP);
 
+	do_profile = g_atomic_int_get(&hcamcorder->preview_profile.enable);
+	if (do_profile) {
+		probe_time = g_get_monotonic_time();
+		for (i = 0 ; i < MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM ; i++)
+			stage_time[i] = -1;
+	}
+
 	current_state = hcamcorder->state;
 
 	if (sc->drop_vframe > 0) {
@@ -1711,18 +1961,13 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_preview(GstPad *pad, GstP
 	/* video stream callback */
 	if (hcamcorder->vstream_cb && buffer) {
 		int state = MM_CAMCORDER_STATE_NULL;
-		int num_bos = 0;
 		unsigned int fourcc = 0;
 		const gchar *string_format = NULL;
 
 		MMCamcorderVideoStreamDataType stream;
-		tbm_surface_h t_surface = NULL;
-		tbm_surface_info_s t_info;
 
 		GstCaps *caps = NULL;
 		GstStructure *structure = NULL;
-		GstMemory *memory = NULL;
-		GstMapInfo mapinfo;
 
 		if (sc->info_image->preview_format != MM_PIXEL_FORMAT_ENCODED_H264) {
 			state = _mmcamcorder_get_state((MMHandleType)hcamcorder);
@@ -1739,7 +1984,6 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_preview(GstPad *pad, GstP
 		}
 
 		/* clear data structure */
-		memset(&mapinfo, 0x0, sizeof(GstMapInfo));
 		memset(&stream, 0x0, sizeof(MMCamcorderVideoStreamDataType));
 
 		structure = gst_caps_get_structure(caps, 0);
@@ -1774,198 +2018,17 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_preview(GstPad *pad, GstP
 			return GST_PAD_PROBE_OK;
 		}
 
-		/* set size and timestamp */
-		if (sc->info_image->preview_format == MM_PIXEL_FORMAT_ENCODED_H264)
-			memory = gst_buffer_get_all_memory(buffer);
-		else
-			memory = gst_buffer_peek_memory(buffer, 0);
-		if (!memory) {
-			_mmcam_dbg_err("GstMemory get failed from buffer %p", buffer);
-			return GST_PAD_PROBE_OK;
-		}
-
-		if (hcamcorder->use_zero_copy_format) {
-			t_surface = (tbm_surface_h)gst_tizen_memory_get_surface(memory);
-
-			if (tbm_surface_get_info(t_surface, &t_info) != TBM_SURFACE_ERROR_NONE) {
-				_mmcam_dbg_err("failed to get tbm surface[%p] info", t_surface);
-				return GST_PAD_PROBE_OK;
-			}
-
-			stream.length_total = t_info.size;
-
-			/* set bo, stride and elevation */
-			num_bos = gst_tizen_memory_get_num_bos(memory);
-			for (i = 0 ; i < num_bos ; i++)
-				stream.bo[i] = gst_tizen_memory_get_bos(memory, i);
-
-			for (i = 0 ; i < t_info.num_planes ; i++) {
-				stream.stride[i] = t_info.planes[i].stride;
-				stream.elevation[i] = t_info.planes[i].size / t_info.planes[i].stride;
-				/*_mmcam_dbg_log("[%d] %dx%d", i, stream.stride[i], stream.elevation[i]);*/
-			}
-
-			/* set gst buffer */
-			stream.internal_buffer = buffer;
-		} else {
-			stream.length_total = gst_memory_get_sizes(memory, NULL, NULL);
-		}
-
-		stream.timestamp = (unsigned int)(GST_BUFFER_PTS(buffer)/1000000); /* nano sec -> mili sec */
-
-		/* set data pointers */
-		if (stream.format == MM_PIXEL_FORMAT_NV12 ||
-			stream.format == MM_PIXEL_FORMAT_NV21 ||
-			stream.format == MM_PIXEL_FORMAT_I420) {
-			if (hcamcorder->use_zero_copy_format) {
-				if (stream.format == MM_PIXEL_FORMAT_NV12 ||
-				    stream.format == MM_PIXEL_FORMAT_NV21) {
-					stream.data_type = MM_CAM_STREAM_DATA_YUV420SP;
-					stream.num_planes = 2;
-					stream.data.yuv420sp.y = t_info.planes[0].ptr;
-					stream.data.yuv420sp.length_y = t_info.planes[0].size;
-					stream.data.yuv420sp.uv = t_info.planes[1].ptr;
-					stream.data.yuv420sp.length_uv = t_info.planes[1].size;
-					/*
-					_mmcam_dbg_log("format[%d][num_planes:%d] [Y]p:%p,size:%d [UV]p:%p,size:%d",
-						stream.format, stream.num_planes,
-						stream.data.yuv420sp.y, stream.data.yuv420sp.length_y,
-						stream.data.yuv420sp.uv, stream.data.yuv420sp.length_uv);
-					*/
-				} else {
-					stream.data_type = MM_CAM_STREAM_DATA_YUV420P;
-					stream.num_planes = 3;
-					stream.data.yuv420p.y = t_info.planes[0].ptr;
-					stream.data.yuv420p.length_y = t_info.planes[0].size;
-					stream.data.yuv420p.u = t_info.planes[1].ptr;
-					stream.data.yuv420p.length_u = t_info.planes[1].size;
-					stream.data.yuv420p.v = t_info.planes[2].ptr;
-					stream.data.yuv420p.length_v = t_info.planes[2].size;
-					/*
-					_mmcam_dbg_log("S420[num_planes:%d] [Y]p:%p,size:%d [U]p:%p,size:%d [V]p:%p,size:%d",
-						stream.num_planes,
-						stream.data.yuv420p.y, stream.data.yuv420p.length_y,
-						stream.data.yuv420p.u, stream.data.yuv420p.length_u,
-						stream.data.yuv420p.v, stream.data.yuv420p.length_v);
-					*/
-				}
-			} else {
-				gst_memory_map(memory, &mapinfo, GST_MAP_READWRITE);
-				if (stream.format == MM_PIXEL_FORMAT_NV12 ||
-					stream.format == MM_PIXEL_FORMAT_NV21) {
-					stream.data_type = MM_CAM_STREAM_DATA_YUV420SP;
-					stream.num_planes = 2;
-					stream.data.yuv420sp.y = mapinfo.data;
-					stream.data.yuv420sp.length_y = stream.width * stream.height;
-					stream.data.yuv420sp.uv = stream.data.yuv420sp.y + stream.data.yuv420sp.length_y;
-					stream.data.yuv420sp.length_uv = stream.data.yuv420sp.length_y >> 1;
-					stream.stride[0] = stream.width;
-					stream.elevation[0] = stream.height;
-					stream.stride[1] = stream.width;
-					stream.elevation[1] = stream.height >> 1;
-					/*
-					_mmcam_dbg_log("format[%d][num_planes:%d] [Y]p:%p,size:%d [UV]p:%p,size:%d",
-						stream.format, stream.num_planes,
-						stream.data.yuv420sp.y, stream.data.yuv420sp.length_y,
-						stream.data.yuv420sp.uv, stream.data.yuv420sp.length_uv);
-					*/
-				} else {
-					stream.data_type = MM_CAM_STREAM_DATA_YUV420P;
-					stream.num_planes = 3;
-					stream.data.yuv420p.y = mapinfo.data;
-					stream.data.yuv420p.length_y = stream.width * stream.height;
-					stream.data.yuv420p.u = stream.data.yuv420p.y + stream.data.yuv420p.length_y;
-					stream.data.yuv420p.length_u = stream.data.yuv420p.length_y >> 2;
-					stream.data.yuv420p.v = stream.data.yuv420p.u + stream.data.yuv420p.length_u;
-					stream.data.yuv420p.length_v = stream.data.yuv420p.length_u;
-					stream.stride[0] = stream.width;
-					stream.elevation[0] = stream.height;
-					stream.stride[1] = stream.width >> 1;
-					stream.elevation[1] = stream.height >> 1;
-					stream.stride[2] = stream.width >> 1;
-					stream.elevation[2] = stream.height >> 1;
-					/*
-					_mmcam_dbg_log("I420[num_planes:%d] [Y]p:%p,size:%d [U]p:%p,size:%d [V]p:%p,size:%d",
-						stream.num_planes,
-						stream.data.yuv420p.y, stream.data.yuv420p.length_y,
-						stream.data.yuv420p.u, stream.data.yuv420p.length_u,
-						stream.data.yuv420p.v, stream.data.yuv420p.length_v);
-					*/
-				}
-			}
+		if (hcamcorder->vstream_delivery.thread) {
+			/* delivered in delivery thread with reference of buffer */
+			__mmcamcorder_vstream_delivery_push(hcamcorder, buffer, &stream);
 		} else {
-			gst_memory_map(memory, &mapinfo, GST_MAP_READWRITE);
-
-			switch (stream.format) {
-			case MM_PIXEL_FORMAT_YUYV:
-			case MM_PIXEL_FORMAT_UYVY:
-			case MM_PIXEL_FORMAT_422P:
-			case MM_PIXEL_FORMAT_ITLV_JPEG_UYVY:
-				stream.data_type = MM_CAM_STREAM_DATA_YUV422;
-				stream.data.yuv422.yuv = mapinfo.data;
-				stream.data.yuv422.length_yuv = stream.length_total;
-				stream.stride[0] = stream.width << 1;
-				stream.elevation[0] = stream.height;
-				break;
-			case MM_PIXEL_FORMAT_ENCODED_H264:
-				stream.data_type = MM_CAM_STREAM_DATA_ENCODED;
-				stream.data.encoded.data = mapinfo.data;
-				stream.data.encoded.length_data = stream.length_total;
-				/*
-				_mmcam_dbg_log("H264[num_planes:%d] [0]p:%p,size:%d",
-					stream.num_planes, stream.data.encoded.data, stream.data.encoded.length_data);
-				*/
-				break;
-			case MM_PIXEL_FORMAT_INVZ:
-				stream.data_type = MM_CAM_STREAM_DATA_DEPTH;
-				stream.data.depth.data = mapinfo.data;
-				stream.data.depth.length_data = stream.length_total;
-				stream.stride[0] = stream.width << 1;
-				stream.elevation[0] = stream.height;
-				break;
-			case MM_PIXEL_FORMAT_RGBA:
-			case MM_PIXEL_FORMAT_ARGB:
-				stream.data_type = MM_CAM_STREAM_DATA_RGB;
-				stream.data.rgb.data = mapinfo.data;
-				stream.data.rgb.length_data = stream.length_total;
-				stream.stride[0] = stream.width << 2;
-				stream.elevation[0] = stream.height;
-				break;
-			default:
-				stream.data_type = MM_CAM_STREAM_DATA_YUV420;
-				stream.data.yuv420.yuv = mapinfo.data;
-				stream.data.yuv420.length_yuv = stream.length_total;
-				stream.stride[0] = (stream.width * 3) >> 1;
-				stream.elevation[0] = stream.height;
-				break;
-			}
-
-			stream.num_planes = 1;
-			/*
-			_mmcam_dbg_log("%c%c%c%c[num_planes:%d] [0]p:%p,size:%d",
-				fourcc, fourcc>>8, fourcc>>16, fourcc>>24,
-				stream.num_planes, stream.data.yuv420.yuv, stream.data.yuv420.length_yuv);
-			*/
+			__mmcamcorder_vstream_send(hcamcorder, buffer, &stream, do_profile, stage_time);
 		}
+	}
 
-		/* call application callback */
-		_MMCAMCORDER_LOCK_VSTREAM_CALLBACK(hcamcorder);
-		if (hcamcorder->vstream_cb) {
-			hcamcorder->vstream_cb(&stream, hcamcorder->vstream_cb_param);
-
-			for (i = 0 ; i < TBM_SURF_PLANE_MAX && stream.bo[i] ; i++) {
-				tbm_bo_map(stream.bo[i], TBM_DEVICE_CPU, TBM_OPTION_READ|TBM_OPTION_WRITE);
-				tbm_bo_unmap(stream.bo[i]);
-			}
-		}
-
-		_MMCAMCORDER_UNLOCK_VSTREAM_CALLBACK(hcamcorder);
-
-		/* unmap memory */
-		if (mapinfo.data)
-			gst_memory_unmap(memory, &mapinfo);
-		if (sc->info_image->preview_format == MM_PIXEL_FORMAT_ENCODED_H264)
-			gst_memory_unref(memory);
+	if (do_profile) {
+		stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_PROBE] = g_get_monotonic_time() - probe_time;
+		_mmcamcorder_update_preview_profile((MMHandleType)hcamcorder, stage_time);
 	}
 
 	return GST_PAD_PROBE_OK;
@@ -1991,17 +2054,32 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_push_buffer_to_record(Gst
 		return GST_PAD_PROBE_DROP;
 	}
 
+	/* keep encoded frames before record start */
+	if (sc->info_video->push_encoding_buffer != PUSH_ENCODING_BUFFER_RUN &&
+	    sc->info_video->support_dual_stream == FALSE &&
+	    sc->info_image->preview_format == MM_PIXEL_FORMAT_ENCODED_H264)
+		_mmcamcorder_video_pre_record_push((MMHandleType)hcamcorder, buffer);
+
 	if (sc->info_video->push_encoding_buffer == PUSH_ENCODING_BUFFER_RUN &&
 	    sc->info_video->record_dual_stream == FALSE &&
 	    sc->encode_element[_MMCAMCORDER_ENCSINK_SRC].gst) {
 		int ret = 0;
 		GstClock *clock = NULL;
+		GstBuffer *frame = NULL;
+		GQueue pre_frames = G_QUEUE_INIT;
 
 		/*
 		_mmcam_dbg_log("GST_BUFFER_FLAG_DELTA_UNIT is set : %d",
 			GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT));
 		*/
 
+		/* frames kept before record start begin with keyframe */
+		if (sc->info_video->is_firstframe) {
+			_mmcamcorder_video_pre_record_take((MMHandleType)hcamcorder, &pre_frames);
+			if (!g_queue_is_empty(&pre_frames))
+				sc->info_video->get_first_I_frame = TRUE;
+		}
+
 		/* check first I frame */
 		if (sc->info_image->preview_format == MM_PIXEL_FORMAT_ENCODED_H264 &&
 		    sc->info_video->get_first_I_frame == FALSE) {
@@ -2036,6 +2114,29 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_push_buffer_to_record(Gst
 				sc->info_video->base_video_ts = GST_BUFFER_PTS(buffer);
 			}
 		}
+
+		/* push kept frames first, and audio is delayed as long as they are */
+		if (!g_queue_is_empty(&pre_frames)) {
+			frame = g_queue_peek_head(&pre_frames);
+			if (sc->info_video->base_video_ts > GST_BUFFER_PTS(frame)) {
+				sc->info_video->pre_record_offset = sc->info_video->base_video_ts - GST_BUFFER_PTS(frame);
+				sc->info_video->base_video_ts = GST_BUFFER_PTS(frame);
+			}
+
+			_mmcam_dbg_warn("push %u pre-recorded frames, audio offset %"GST_TIME_FORMAT,
+				g_queue_get_length(&pre_frames), GST_TIME_ARGS(sc->info_video->pre_record_offset));
+
+			while ((frame = g_queue_pop_head(&pre_frames)) != NULL) {
+				GST_BUFFER_PTS(frame) = GST_BUFFER_PTS(frame) - sc->info_video->base_video_ts;
+				GST_BUFFER_DTS(frame) = GST_BUFFER_PTS(frame);
+				g_signal_emit_by_name(sc->encode_element[_MMCAMCORDER_ENCSINK_SRC].gst, "push-buffer", frame, &ret);
+				gst_buffer_unref(frame);
+			}
+		}
+
+		if (sc->info_video->is_firstframe)
+			g_atomic_int_set(&sc->info_video->wait_pre_record, FALSE);
+
 		GST_BUFFER_PTS(buffer) = GST_BUFFER_PTS(buffer) - sc->info_video->base_video_ts;
 		GST_BUFFER_DTS(buffer) = GST_BUFFER_PTS(buffer);
 
@@ -2064,6 +2165,9 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_push_buffer_to_record(Gst
 		if (sc->info_video->is_firstframe) {
 			sc->info_video->is_firstframe = FALSE;
 
+			_mmcamcorder_recording_stats_set_start_latency((MMHandleType)hcamcorder,
+				(guint)((g_get_monotonic_time() - sc->info_video->record_start_time) / 1000));
+
 			/* drop buffer if it's from tizen allocator */
 			if (gst_is_tizen_memory(gst_buffer_peek_memory(buffer, 0))) {
 				_mmcam_dbg_warn("drop first buffer from tizen allocator to avoid copy in basesrc");
@@ -2111,27 +2215,587 @@ GstPadProbeReturn __mmcamcorder_muxed_dataprobe(GstPad *pad, GstPadProbeInfo *in
 		return GST_PAD_PROBE_OK;
 	}
 
-	/* call application callback */
+	if (hcamcorder->mstream_delivery.thread) {
+		/* delivered in delivery thread with reference of buffer */
+		if (hcamcorder->mstream_cb)
+			__mmcamcorder_mstream_delivery_push(hcamcorder, buffer, sc->muxed_stream_offset);
+	} else {
+		/* call application callback */
+		_MMCAMCORDER_LOCK_MSTREAM_CALLBACK(hcamcorder);
+
+		if (hcamcorder->mstream_cb) {
+			stream.data = (void *)mapinfo.data;
+			stream.length = mapinfo.size;
+			stream.offset = sc->muxed_stream_offset;
+			hcamcorder->mstream_cb(&stream, hcamcorder->mstream_cb_param);
+		}
+
+		_MMCAMCORDER_UNLOCK_MSTREAM_CALLBACK(hcamcorder);
+	}
+
+	/* record atom index for writing metadata */
+	_mmcamcorder_mux_index_add_data(&sc->mux_index, sc->muxed_stream_offset, mapinfo.data, mapinfo.size);
+
+	/* calculate current offset */
+	sc->muxed_stream_offset += mapinfo.size;
+
+	gst_buffer_unmap(buffer, &mapinfo);
+
+	return GST_PAD_PROBE_OK;
+}
+
+
+static void __mmcamcorder_mstream_delivery_push(mmf_camcorder_t *hcamcorder, GstBuffer *buffer, guint64 offset)
+{
+	gsize size = gst_buffer_get_size(buffer);
+	_MMCamcorderMstreamItem *item = NULL;
+	_MMCamcorderMstreamDelivery *delivery = &hcamcorder->mstream_delivery;
+
+	g_mutex_lock(&delivery->lock);
+
+	/* muxed data can not be dropped, muxer waits for space if application is slow */
+	while (!delivery->cancel && !delivery->exit &&
+		delivery->queued_size > 0 && delivery->queued_size + size > delivery->queue_max) {
+		if (delivery->blocked++ == 0)
+			_mmcam_dbg_warn("queue is full[%"G_GUINT64_FORMAT"], wait for delivery", delivery->queued_size);
+
+		g_cond_wait(&delivery->cond, &delivery->lock);
+	}
+
+	/* recording is canceled, it's not delivered anymore */
+	if (delivery->cancel) {
+		delivery->dropped++;
+		g_mutex_unlock(&delivery->lock);
+		return;
+	}
+
+	item = g_new0(_MMCamcorderMstreamItem, 1);
+	item->buffer = gst_buffer_ref(buffer);
+	item->offset = offset;
+
+	g_queue_push_tail(&delivery->queue, item);
+	delivery->queued_size += size;
+
+	g_cond_broadcast(&delivery->cond);
+
+	g_mutex_unlock(&delivery->lock);
+}
+
+
+static void __mmcamcorder_mstream_delivery_send(mmf_camcorder_t *hcamcorder, GstBuffer *chunk, guint64 offset)
+{
+	MMCamcorderMuxedStreamDataType stream;
+	GstMapInfo mapinfo;
+
+	/* buffers in chunk are merged here, not in muxer thread */
+	if (!gst_buffer_map(chunk, &mapinfo, GST_MAP_READ)) {
+		_mmcam_dbg_warn("map failed : chunk %p", chunk);
+		gst_buffer_unref(chunk);
+		return;
+	}
+
 	_MMCAMCORDER_LOCK_MSTREAM_CALLBACK(hcamcorder);
 
 	if (hcamcorder->mstream_cb) {
 		stream.data = (void *)mapinfo.data;
 		stream.length = mapinfo.size;
-		stream.offset = sc->muxed_stream_offset;
+		stream.offset = offset;
 		hcamcorder->mstream_cb(&stream, hcamcorder->mstream_cb_param);
 	}
 
 	_MMCAMCORDER_UNLOCK_MSTREAM_CALLBACK(hcamcorder);
 
-	/* calculate current offset */
-	sc->muxed_stream_offset += mapinfo.size;
+	gst_buffer_unmap(chunk, &mapinfo);
+	gst_buffer_unref(chunk);
+}
 
-	gst_buffer_unmap(buffer, &mapinfo);
 
-	return GST_PAD_PROBE_OK;
+static gpointer __mmcamcorder_mstream_delivery_thread(gpointer data)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(data);
+	_MMCamcorderMstreamDelivery *delivery = NULL;
+	_MMCamcorderMstreamItem *item = NULL;
+	GstBuffer *chunk = NULL;
+	guint64 chunk_offset = 0;
+	gint64 chunk_end_time = 0;
+
+	mmf_return_val_if_fail(hcamcorder, NULL);
+
+	delivery = &hcamcorder->mstream_delivery;
+
+	_mmcam_dbg_log("muxed stream delivery thread start");
+
+	g_mutex_lock(&delivery->lock);
+
+	while (TRUE) {
+		/* queue is already flushed by cancel, chunk which is not delivered is discarded */
+		if (delivery->discard) {
+			if (chunk) {
+				gst_buffer_unref(chunk);
+				chunk = NULL;
+			}
+
+			delivery->discard = FALSE;
+			g_cond_broadcast(&delivery->cond);
+			continue;
+		}
+
+		item = g_queue_pop_head(&delivery->queue);
+		if (item) {
+			delivery->queued_size -= gst_buffer_get_size(item->buffer);
+
+			/* notify muxer that queue has space */
+			g_cond_broadcast(&delivery->cond);
+
+			g_mutex_unlock(&delivery->lock);
+
+			/* data which is not contiguous(ex. header updated at the end) is delivered in another chunk */
+			if (chunk && item->offset != chunk_offset + gst_buffer_get_size(chunk)) {
+				__mmcamcorder_mstream_delivery_send(hcamcorder, chunk, chunk_offset);
+				chunk = NULL;
+			}
+
+			if (chunk) {
+				chunk = gst_buffer_append(chunk, item->buffer);
+			} else {
+				chunk = item->buffer;
+				chunk_offset = item->offset;
+				chunk_end_time = g_get_monotonic_time() + delivery->chunk_time;
+			}
+
+			g_free(item);
+			item = NULL;
+
+			if (gst_buffer_get_size(chunk) >= delivery->chunk_size) {
+				__mmcamcorder_mstream_delivery_send(hcamcorder, chunk, chunk_offset);
+				chunk = NULL;
+			}
+
+			g_mutex_lock(&delivery->lock);
+			continue;
+		}
+
+		if (chunk && (delivery->flush || delivery->exit || g_get_monotonic_time() >= chunk_end_time)) {
+			g_mutex_unlock(&delivery->lock);
+
+			__mmcamcorder_mstream_delivery_send(hcamcorder, chunk, chunk_offset);
+			chunk = NULL;
+
+			g_mutex_lock(&delivery->lock);
+			continue;
+		}
+
+		/* all data is delivered */
+		if (delivery->flush) {
+			delivery->flush = FALSE;
+			g_cond_broadcast(&delivery->cond);
+		}
+
+		if (delivery->exit)
+			break;
+
+		if (chunk)
+			g_cond_wait_until(&delivery->cond, &delivery->lock, chunk_end_time);
+		else
+			g_cond_wait(&delivery->cond, &delivery->lock);
+	}
+
+	g_mutex_unlock(&delivery->lock);
+
+	_mmcam_dbg_log("muxed stream delivery thread exit");
+
+	return NULL;
+}
+
+
+int _mmcamcorder_mstream_delivery_create(MMHandleType handle)
+{
+	int chunk_size = 0;
+	int chunk_time = 0;
+	int queue_size = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	/* 0 : deliver muxed stream in muxer thread */
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_RECORD,
+		"MuxedStreamChunkSize",
+		&chunk_size);
+
+	if (chunk_size <= 0)
+		return MM_ERROR_NONE;
+
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_RECORD,
+		"MuxedStreamChunkTime",
+		&chunk_time);
+
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_RECORD,
+		"MuxedStreamQueueSize",
+		&queue_size);
+
+	return _mmcamcorder_mstream_delivery_start(handle, chunk_size, chunk_time, queue_size);
+}
+
+
+int _mmcamcorder_mstream_delivery_start(MMHandleType handle, int chunk_size, int chunk_time, int queue_size)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderMstreamDelivery *delivery = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(chunk_size > 0, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	delivery = &hcamcorder->mstream_delivery;
+	if (delivery->thread) {
+		_mmcam_dbg_err("delivery thread is already started");
+		return MM_ERROR_CAMCORDER_INVALID_CONDITION;
+	}
+
+	delivery->chunk_size = (gsize)chunk_size;
+	delivery->chunk_time = (gint64)MAX(chunk_time, 0) * G_TIME_SPAN_MILLISECOND;
+	delivery->queue_max = (guint64)MAX(queue_size, chunk_size);
+
+	_mmcam_dbg_log("muxed stream chunk size %d, time %d ms, queue size %"G_GUINT64_FORMAT,
+		chunk_size, chunk_time, delivery->queue_max);
+
+	delivery->thread = g_thread_try_new("MMCAM_MSTREAM",
+		__mmcamcorder_mstream_delivery_thread, (gpointer)hcamcorder, NULL);
+	if (!delivery->thread) {
+		_mmcam_dbg_err("failed to create muxed stream delivery thread");
+		return MM_ERROR_CAMCORDER_RESOURCE_CREATION;
+	}
+
+	return MM_ERROR_NONE;
+}
+
+
+void _mmcamcorder_mstream_delivery_flush(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderMstreamDelivery *delivery = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	delivery = &hcamcorder->mstream_delivery;
+	if (!delivery->thread)
+		return;
+
+	g_mutex_lock(&delivery->lock);
+
+	delivery->flush = TRUE;
+	g_cond_broadcast(&delivery->cond);
+
+	while (delivery->flush)
+		g_cond_wait(&delivery->cond, &delivery->lock);
+
+	if (delivery->blocked > 0) {
+		_mmcam_dbg_warn("muxer waited for delivery %u times", delivery->blocked);
+		delivery->blocked = 0;
+	}
+
+	g_mutex_unlock(&delivery->lock);
+}
+
+
+void _mmcamcorder_mstream_delivery_cancel(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderMstreamDelivery *delivery = NULL;
+	_MMCamcorderMstreamItem *item = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	delivery = &hcamcorder->mstream_delivery;
+	if (!delivery->thread)
+		return;
+
+	g_mutex_lock(&delivery->lock);
+
+	/* muxer which is waiting for space is released, and new data is dropped until reset */
+	delivery->cancel = TRUE;
+
+	while ((item = g_queue_pop_head(&delivery->queue))) {
+		gst_buffer_unref(item->buffer);
+		g_free(item);
+		delivery->dropped++;
+	}
+
+	delivery->queued_size = 0;
+
+	/* wait until delivery thread discards the chunk which is not delivered */
+	delivery->discard = TRUE;
+	g_cond_broadcast(&delivery->cond);
+
+	while (delivery->discard)
+		g_cond_wait(&delivery->cond, &delivery->lock);
+
+	_mmcam_dbg_log("canceled, dropped muxed buffer count %u", delivery->dropped);
+
+	g_mutex_unlock(&delivery->lock);
+}
+
+
+void _mmcamcorder_mstream_delivery_reset(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderMstreamDelivery *delivery = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	delivery = &hcamcorder->mstream_delivery;
+	if (!delivery->thread)
+		return;
+
+	g_mutex_lock(&delivery->lock);
+
+	delivery->cancel = FALSE;
+	delivery->dropped = 0;
+	delivery->blocked = 0;
+
+	g_mutex_unlock(&delivery->lock);
+}
+
+
+void _mmcamcorder_mstream_delivery_destroy(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderMstreamDelivery *delivery = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	delivery = &hcamcorder->mstream_delivery;
+	if (!delivery->thread)
+		return;
+
+	/* remained data is delivered before thread exits */
+	g_mutex_lock(&delivery->lock);
+	delivery->exit = TRUE;
+	g_cond_broadcast(&delivery->cond);
+	g_mutex_unlock(&delivery->lock);
+
+	g_thread_join(delivery->thread);
+	delivery->thread = NULL;
+	delivery->exit = FALSE;
+}
+
+
+static void __mmcamcorder_vstream_delivery_push(mmf_camcorder_t *hcamcorder, GstBuffer *buffer, MMCamcorderVideoStreamDataType *stream)
+{
+	_MMCamcorderVstreamItem *item = NULL;
+	_MMCamcorderVstreamDelivery *delivery = &hcamcorder->vstream_delivery;
+
+	g_mutex_lock(&delivery->lock);
+
+	/* streaming thread is not blocked by application */
+	if ((int)g_queue_get_length(&delivery->queue) >= delivery->depth) {
+		if (g_atomic_int_add(&delivery->dropped, 1) == 0)
+			_mmcam_dbg_warn("queue is full[%d], drop preview frame", delivery->depth);
+
+		if (delivery->drop_policy != _MMCAMCORDER_VSTREAM_DROP_OLDEST) {
+			g_mutex_unlock(&delivery->lock);
+			return;
+		}
+
+		item = g_queue_pop_head(&delivery->queue);
+		gst_buffer_unref(item->buffer);
+		g_free(item);
+	}
+
+	item = g_new0(_MMCamcorderVstreamItem, 1);
+	item->buffer = gst_buffer_ref(buffer);
+	item->width = stream->width;
+	item->height = stream->height;
+	item->format = stream->format;
+
+	g_queue_push_tail(&delivery->queue, item);
+
+	g_cond_broadcast(&delivery->cond);
+
+	g_mutex_unlock(&delivery->lock);
+}
+
+
+static gpointer __mmcamcorder_vstream_delivery_thread(gpointer data)
+{
+	int i = 0;
+	gboolean do_profile = FALSE;
+	gint64 stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM];
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(data);
+	_MMCamcorderVstreamDelivery *delivery = NULL;
+	_MMCamcorderVstreamItem *item = NULL;
+	MMCamcorderVideoStreamDataType stream;
+
+	mmf_return_val_if_fail(hcamcorder, NULL);
+
+	delivery = &hcamcorder->vstream_delivery;
+
+	_mmcam_dbg_log("video stream delivery thread start");
+
+	g_mutex_lock(&delivery->lock);
+
+	while (TRUE) {
+		item = g_queue_pop_head(&delivery->queue);
+		if (item) {
+			g_mutex_unlock(&delivery->lock);
+
+			memset(&stream, 0x0, sizeof(MMCamcorderVideoStreamDataType));
+			stream.width = item->width;
+			stream.height = item->height;
+			stream.format = item->format;
+
+			/* frame is counted by probe, only stages after the probe are measured here */
+			do_profile = g_atomic_int_get(&hcamcorder->preview_profile.enable);
+			if (do_profile) {
+				for (i = 0 ; i < MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM ; i++)
+					stage_time[i] = -1;
+			}
+
+			__mmcamcorder_vstream_send(hcamcorder, item->buffer, &stream, do_profile, stage_time);
+
+			if (do_profile)
+				_mmcamcorder_update_preview_profile((MMHandleType)hcamcorder, stage_time);
+
+			gst_buffer_unref(item->buffer);
+			g_free(item);
+			item = NULL;
+
+			g_mutex_lock(&delivery->lock);
+			continue;
+		}
+
+		/* all queued buffers are delivered */
+		if (delivery->flush) {
+			delivery->flush = FALSE;
+			g_cond_broadcast(&delivery->cond);
+		}
+
+		if (delivery->exit)
+			break;
+
+		g_cond_wait(&delivery->cond, &delivery->lock);
+	}
+
+	g_mutex_unlock(&delivery->lock);
+
+	_mmcam_dbg_log("video stream delivery thread exit");
+
+	return NULL;
 }
 
 
+int _mmcamcorder_vstream_delivery_create(MMHandleType handle)
+{
+	int depth = 0;
+	int drop_policy = _MMCAMCORDER_VSTREAM_DROP_NEWEST;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	/* 0 : deliver video stream in streaming thread */
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_VIDEO_INPUT,
+		"VideoStreamQueueDepth",
+		&depth);
+
+	if (depth <= 0)
+		return MM_ERROR_NONE;
+
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_VIDEO_INPUT,
+		"VideoStreamDropPolicy",
+		&drop_policy);
+
+	return _mmcamcorder_vstream_delivery_start(handle, depth, drop_policy);
+}
+
+
+int _mmcamcorder_vstream_delivery_start(MMHandleType handle, int depth, int drop_policy)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderVstreamDelivery *delivery = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	delivery = &hcamcorder->vstream_delivery;
+
+	if (depth <= 0)
+		return MM_ERROR_NONE;
+
+	if (delivery->thread) {
+		_mmcam_dbg_err("video stream delivery thread is already started");
+		return MM_ERROR_CAMCORDER_INVALID_STATE;
+	}
+
+	delivery->depth = depth;
+	delivery->drop_policy = drop_policy;
+	g_atomic_int_set(&delivery->delivered, 0);
+	g_atomic_int_set(&delivery->dropped, 0);
+
+	_mmcam_dbg_log("video stream queue depth %d, drop %s", depth,
+		drop_policy == _MMCAMCORDER_VSTREAM_DROP_OLDEST ? "oldest" : "newest");
+
+	delivery->thread = g_thread_try_new("MMCAM_VSTREAM",
+		__mmcamcorder_vstream_delivery_thread, (gpointer)hcamcorder, NULL);
+	if (!delivery->thread) {
+		_mmcam_dbg_err("failed to create video stream delivery thread");
+		return MM_ERROR_CAMCORDER_RESOURCE_CREATION;
+	}
+
+	return MM_ERROR_NONE;
+}
+
+
+void _mmcamcorder_vstream_delivery_flush(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderVstreamDelivery *delivery = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	delivery = &hcamcorder->vstream_delivery;
+	if (!delivery->thread)
+		return;
+
+	g_mutex_lock(&delivery->lock);
+
+	delivery->flush = TRUE;
+	g_cond_broadcast(&delivery->cond);
+
+	while (delivery->flush)
+		g_cond_wait(&delivery->cond, &delivery->lock);
+
+	_mmcam_dbg_log("video stream delivered %d, dropped %d",
+		g_atomic_int_get(&delivery->delivered), g_atomic_int_get(&delivery->dropped));
+
+	g_mutex_unlock(&delivery->lock);
+}
+
+
+void _mmcamcorder_vstream_delivery_destroy(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderVstreamDelivery *delivery = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	delivery = &hcamcorder->vstream_delivery;
+	if (!delivery->thread)
+		return;
+
+	/* queued buffers are delivered before thread exits */
+	g_mutex_lock(&delivery->lock);
+	delivery->exit = TRUE;
+	g_cond_broadcast(&delivery->cond);
+	g_mutex_unlock(&delivery->lock);
+
+	g_thread_join(delivery->thread);
+	delivery->thread = NULL;
+	delivery->exit = FALSE;
+}
+
 GstPadProbeReturn __mmcamcorder_eventprobe_monitor(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
 {
 	GstEvent *event = GST_PAD_PROBE_INFO_EVENT(info);
@@ -2238,6 +2902,30 @@ GstPadProbeReturn __mmcamcorder_eventprobe_monitor(GstPad *pad, GstPadProbeInfo
 		break;
 	case GST_EVENT_EOS:
 		_mmcam_dbg_warn("[%s:%s] gots %s", GST_DEBUG_PAD_NAME(pad), GST_EVENT_TYPE_NAME(event));
+
+		hcamcorder = MMF_CAMCORDER(u_data);
+		if (!hcamcorder || hcamcorder->type != MM_CAMCORDER_MODE_VIDEO_CAPTURE)
+			break;
+
+		sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+		if (!sc || !sc->encode_element[_MMCAMCORDER_ENCSINK_SINK].gst)
+			break;
+
+		parent = gst_pad_get_parent(pad);
+		if (!parent) {
+			_mmcam_dbg_warn("get parent failed");
+			break;
+		}
+
+		/* EOS which finishes a segment of recording doesn't reach sink */
+		if (parent == (GstObject *)sc->encode_element[_MMCAMCORDER_ENCSINK_SINK].gst &&
+		    _mmcamcorder_video_segment_eos((MMHandleType)hcamcorder)) {
+			gst_object_unref(parent);
+			return GST_PAD_PROBE_DROP;
+		}
+
+		gst_object_unref(parent);
+		parent = NULL;
 		break;
 	/* bidirectional events */
 	case GST_EVENT_FLUSH_START:
@@ -3037,6 +3725,45 @@ bool _mmcamcorder_set_sound_stream_info(GstElement *element, char *stream_type,
 }
 
 
+GstBuffer *_mmcamcorder_get_silence_buffer(MMHandleType handle, GstBuffer *buffer)
+{
+	gsize size = 0;
+	guint8 *data = NULL;
+	GstBuffer *silence = NULL;
+	_MMCamcorderSubContext *sc = NULL;
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	mmf_return_val_if_fail(sc && buffer, NULL);
+
+	size = gst_buffer_get_size(buffer);
+	if (size == 0)
+		return NULL;
+
+	/* silence memory is grown if it's smaller than buffer, buffers sharing old one keep it */
+	if (!sc->silence_memory || sc->silence_memory->size < size) {
+		if (sc->silence_memory)
+			gst_memory_unref(sc->silence_memory);
+
+		data = g_malloc0(size);
+		sc->silence_memory = gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY, data, size, 0, size, data, g_free);
+
+		_mmcam_dbg_log("silence memory %p, size %"G_GSIZE_FORMAT, sc->silence_memory, size);
+	}
+
+	/* timestamp and duration of buffer are kept, then recording stays sample-accurate */
+	silence = gst_buffer_new();
+	if (!gst_buffer_copy_into(silence, buffer, GST_BUFFER_COPY_METADATA, 0, -1)) {
+		_mmcam_dbg_warn("failed to copy metadata of buffer %p", buffer);
+		gst_buffer_unref(silence);
+		return NULL;
+	}
+
+	gst_buffer_append_memory(silence, gst_memory_share(sc->silence_memory, 0, size));
+
+	return silence;
+}
+
+
 bool _mmcamcorder_recreate_decoder_for_encoded_preview(MMHandleType handle)
 {
 	int ret = MM_ERROR_NONE;
@@ -135,12 +135,37 @@ static gint __mmcamcorder_init_handle(mmf_camcorder_t **hcamcorder, int device_t
 	g_mutex_init(&(new_handle->mtsafe).vstream_cb_lock);
 	g_mutex_init(&(new_handle->mtsafe).astream_cb_lock);
 	g_mutex_init(&(new_handle->mtsafe).mstream_cb_lock);
+	g_mutex_init(&(new_handle->mtsafe).segment_cb_lock);
 #ifdef _MMCAMCORDER_MM_RM_SUPPORT
 	g_mutex_init(&(new_handle->mtsafe).resource_lock);
 #endif /* _MMCAMCORDER_MM_RM_SUPPORT */
 
 	g_mutex_init(&new_handle->restart_preview_lock);
 
+	g_mutex_init(&new_handle->preview_profile.lock);
+
+	g_mutex_init(&new_handle->buffer_pool.lock);
+
+	g_mutex_init(&new_handle->burst_arena.lock);
+
+	g_mutex_init(&new_handle->attr_snapshot.lock);
+
+	g_mutex_init(&new_handle->free_space_tracker.lock);
+
+	g_mutex_init(&new_handle->capture_pipeline.lock);
+	g_cond_init(&new_handle->capture_pipeline.cond);
+
+	g_mutex_init(&new_handle->mstream_delivery.lock);
+	g_cond_init(&new_handle->mstream_delivery.cond);
+
+	g_mutex_init(&new_handle->vstream_delivery.lock);
+	g_cond_init(&new_handle->vstream_delivery.cond);
+
+	g_mutex_init(&new_handle->pre_record.lock);
+
+	g_mutex_init(&new_handle->segment.lock);
+	g_cond_init(&new_handle->segment.cond);
+
 	g_mutex_init(&new_handle->snd_info.open_mutex);
 	g_cond_init(&new_handle->snd_info.open_cond);
 	g_mutex_init(&new_handle->snd_info.play_mutex);
@@ -160,6 +185,16 @@ static gint __mmcamcorder_init_handle(mmf_camcorder_t **hcamcorder, int device_t
 		g_cond_init(&new_handle->gdbus_info_solo_sound.sync_cond);
 	}
 
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+	/* create message source */
+	new_handle->msg_source = _mmcamcorder_msg_source_new((MMHandleType)new_handle);
+	if (new_handle->msg_source == NULL) {
+		_mmcam_dbg_err("_mmcamcorder_create::failed to create message source");
+		ret = MM_ERROR_CAMCORDER_RESOURCE_CREATION;
+		goto _INIT_HANDLE_FAILED;
+	}
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+
 	/* create task thread */
 	new_handle->task_thread = g_thread_try_new("MMCAM_TASK_THREAD",
 		(GThreadFunc)_mmcamcorder_util_task_thread_func, (gpointer)new_handle, NULL);
@@ -176,6 +211,28 @@ static gint __mmcamcorder_init_handle(mmf_camcorder_t **hcamcorder, int device_t
 		goto _INIT_HANDLE_FAILED;
 	}
 
+	/* create worker pool for color conversion of capture */
+	new_handle->stripe_thread_num = 1;
+	if (device_type != MM_VIDEO_DEVICE_NONE)
+		new_handle->stripe_pool = _mmcamcorder_stripe_pool_new((MMHandleType)new_handle, &new_handle->stripe_thread_num);
+
+	/* create worker threads for capture post-processing */
+	if (device_type != MM_VIDEO_DEVICE_NONE) {
+		ret = _mmcamcorder_capture_pipeline_create((MMHandleType)new_handle);
+		if (ret != MM_ERROR_NONE)
+			goto _INIT_HANDLE_FAILED;
+	}
+
+	/* create delivery thread for muxed stream callback */
+	ret = _mmcamcorder_mstream_delivery_create((MMHandleType)new_handle);
+	if (ret != MM_ERROR_NONE)
+		goto _INIT_HANDLE_FAILED;
+
+	/* create delivery thread for video stream callback */
+	ret = _mmcamcorder_vstream_delivery_create((MMHandleType)new_handle);
+	if (ret != MM_ERROR_NONE)
+		goto _INIT_HANDLE_FAILED;
+
 	/* allocate attribute */
 	new_handle->attributes = _mmcamcorder_alloc_attribute((MMHandleType)new_handle);
 	if (!new_handle->attributes) {
@@ -202,12 +259,24 @@ static void __mmcamcorder_deinit_handle(mmf_camcorder_t *hcamcorder)
 		return;
 	}
 
+	/* remove worker threads for capture post-processing */
+	_mmcamcorder_capture_pipeline_destroy((MMHandleType)hcamcorder);
+
+	/* remove delivery thread for muxed stream callback */
+	_mmcamcorder_mstream_delivery_destroy((MMHandleType)hcamcorder);
+
+	/* remove delivery thread for video stream callback */
+	_mmcamcorder_vstream_delivery_destroy((MMHandleType)hcamcorder);
+
 	/* Remove exif info */
 	if (hcamcorder->exif_info) {
 		mm_exif_destory_exif_info(hcamcorder->exif_info);
 		hcamcorder->exif_info = NULL;
 	}
 
+	/* Remove exif template */
+	mm_exif_template_clear(&hcamcorder->exif_template);
+
 	/* remove attributes */
 	if (hcamcorder->attributes) {
 		_mmcamcorder_dealloc_attribute((MMHandleType)hcamcorder, hcamcorder->attributes);
@@ -228,6 +297,17 @@ static void __mmcamcorder_deinit_handle(mmf_camcorder_t *hcamcorder)
 		hcamcorder->task_thread = NULL;
 	}
 
+	/* remove worker pool for color conversion */
+	if (hcamcorder->stripe_pool) {
+		g_thread_pool_free(hcamcorder->stripe_pool, FALSE, TRUE);
+		hcamcorder->stripe_pool = NULL;
+	}
+
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+	/* remove message source */
+	_mmcamcorder_msg_source_destroy((MMHandleType)hcamcorder);
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+
 	/* Release lock, cond */
 	g_mutex_clear(&(hcamcorder->mtsafe).lock);
 	g_cond_clear(&(hcamcorder->mtsafe).cond);
@@ -242,6 +322,7 @@ static void __mmcamcorder_deinit_handle(mmf_camcorder_t *hcamcorder)
 	g_mutex_clear(&(hcamcorder->mtsafe).vstream_cb_lock);
 	g_mutex_clear(&(hcamcorder->mtsafe).astream_cb_lock);
 	g_mutex_clear(&(hcamcorder->mtsafe).mstream_cb_lock);
+	g_mutex_clear(&(hcamcorder->mtsafe).segment_cb_lock);
 #ifdef _MMCAMCORDER_MM_RM_SUPPORT
 	g_mutex_clear(&(hcamcorder->mtsafe).resource_lock);
 #endif /* _MMCAMCORDER_MM_RM_SUPPORT */
@@ -249,6 +330,35 @@ static void __mmcamcorder_deinit_handle(mmf_camcorder_t *hcamcorder)
 	g_mutex_clear(&hcamcorder->snd_info.open_mutex);
 	g_cond_clear(&hcamcorder->snd_info.open_cond);
 	g_mutex_clear(&hcamcorder->restart_preview_lock);
+	g_mutex_clear(&hcamcorder->preview_profile.lock);
+
+	_mmcamcorder_buffer_pool_flush((MMHandleType)hcamcorder);
+	g_mutex_clear(&hcamcorder->buffer_pool.lock);
+
+	_mmcamcorder_burst_arena_flush((MMHandleType)hcamcorder);
+	g_mutex_clear(&hcamcorder->burst_arena.lock);
+
+	_mmcamcorder_clear_attr_snapshot((MMHandleType)hcamcorder);
+	g_mutex_clear(&hcamcorder->attr_snapshot.lock);
+
+	g_mutex_clear(&hcamcorder->free_space_tracker.lock);
+
+	g_mutex_clear(&hcamcorder->capture_pipeline.lock);
+	g_cond_clear(&hcamcorder->capture_pipeline.cond);
+
+	g_mutex_clear(&hcamcorder->mstream_delivery.lock);
+	g_cond_clear(&hcamcorder->mstream_delivery.cond);
+
+	g_mutex_clear(&hcamcorder->vstream_delivery.lock);
+	g_cond_clear(&hcamcorder->vstream_delivery.cond);
+
+	_mmcamcorder_video_pre_record_flush((MMHandleType)hcamcorder);
+	g_mutex_clear(&hcamcorder->pre_record.lock);
+
+	_mmcamcorder_video_segment_abort((MMHandleType)hcamcorder);
+	SAFE_G_FREE(hcamcorder->segment.filename_template);
+	g_mutex_clear(&hcamcorder->segment.lock);
+	g_cond_clear(&hcamcorder->segment.cond);
 
 	if (hcamcorder->device_type != MM_VIDEO_DEVICE_NONE) {
 		g_mutex_clear(&hcamcorder->gdbus_info_sound.sync_mutex);
@@ -622,6 +732,9 @@ int _mmcamcorder_create(MMHandleType *handle, MMCamPreset *info)
 	/* Disable attributes in each model */
 	_mmcamcorder_set_disabled_attributes((MMHandleType)hcamcorder);
 
+	/* publish attributes for streaming threads */
+	_mmcamcorder_refresh_attr_snapshot((MMHandleType)hcamcorder);
+
 	/* get system information */
 	__mmcamcorder_get_system_info(hcamcorder);
 
@@ -1120,6 +1233,12 @@ int _mmcamcorder_unrealize(MMHandleType handle)
 		hcamcorder->sub_context = NULL;
 	}
 
+	/* release buffers for color conversion */
+	_mmcamcorder_buffer_pool_flush(handle);
+
+	/* release arena for burst capture */
+	_mmcamcorder_burst_arena_flush(handle);
+
 #ifdef _MMCAMCORDER_MM_RM_SUPPORT
 	_MMCAMCORDER_LOCK_RESOURCE(hcamcorder);
 	_mmcam_dbg_warn("lock resource - cb calling %d", hcamcorder->is_release_cb_calling);
@@ -1291,6 +1410,10 @@ int _mmcamcorder_stop(MMHandleType handle)
 		return ret;
 	}
 
+	/* deliver captured images in capture stages before command lock,
+	   capture callback waits for command lock before it's queued */
+	_mmcamcorder_capture_pipeline_flush(handle);
+
 	if (!_MMCAMCORDER_TRYLOCK_CMD(hcamcorder)) {
 		_mmcam_dbg_err("Another command is running.");
 		ret = MM_ERROR_CAMCORDER_CMD_IS_RUNNING;
@@ -1833,6 +1956,31 @@ int _mmcamcorder_set_muxed_stream_callback(MMHandleType handle, mm_camcorder_mux
 }
 
 
+int _mmcamcorder_set_recording_segment_callback(MMHandleType handle, mm_camcorder_recording_segment_callback callback, void *user_data)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	_mmcam_dbg_log("");
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	if (callback == NULL)
+		_mmcam_dbg_warn("Recording Segment Callback is disabled, because application sets it to NULL");
+
+	if (!_MMCAMCORDER_TRYLOCK_SEGMENT_CALLBACK(hcamcorder)) {
+		_mmcam_dbg_warn("Application's recording segment callback is running now");
+		return MM_ERROR_CAMCORDER_INVALID_CONDITION;
+	}
+
+	hcamcorder->segment_cb = callback;
+	hcamcorder->segment_cb_param = user_data;
+
+	_MMCAMCORDER_UNLOCK_SEGMENT_CALLBACK(hcamcorder);
+
+	return MM_ERROR_NONE;
+}
+
+
 int _mmcamcorder_set_video_capture_callback(MMHandleType handle, mm_camcorder_video_capture_callback callback, void *user_data)
 {
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
@@ -2473,6 +2621,11 @@ void _mmcamcorder_dealloc_subcontext(_MMCamcorderSubContext *sc)
 			sc->info_audio = NULL;
 		}
 
+		if (sc->silence_memory) {
+			gst_memory_unref(sc->silence_memory);
+			sc->silence_memory = NULL;
+		}
+
 		free(sc);
 		sc = NULL;
 	}
@@ -3364,6 +3517,127 @@ void _mmcamcorder_video_current_framerate_init(MMHandleType handle)
 }
 
 
+int _mmcamcorder_set_preview_profile(MMHandleType handle, int enable)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	_mmcam_dbg_log("preview profile %d -> %d", g_atomic_int_get(&hcamcorder->preview_profile.enable), enable);
+
+	g_mutex_lock(&hcamcorder->preview_profile.lock);
+
+	/* clear collected data when it's enabled */
+	if (enable)
+		memset(&hcamcorder->preview_profile.data, 0x0, sizeof(MMCamcorderPreviewProfileType));
+
+	g_atomic_int_set(&hcamcorder->preview_profile.enable, enable ? TRUE : FALSE);
+
+	g_mutex_unlock(&hcamcorder->preview_profile.lock);
+
+	return MM_ERROR_NONE;
+}
+
+
+int _mmcamcorder_get_preview_profile(MMHandleType handle, MMCamcorderPreviewProfileType *profile)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(profile, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	g_mutex_lock(&hcamcorder->preview_profile.lock);
+
+	memcpy(profile, &hcamcorder->preview_profile.data, sizeof(MMCamcorderPreviewProfileType));
+
+	g_mutex_unlock(&hcamcorder->preview_profile.lock);
+
+	return MM_ERROR_NONE;
+}
+
+
+int _mmcamcorder_get_jpeg_fallback_count(MMHandleType handle, int *count)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(count, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	*count = g_atomic_int_get(&hcamcorder->jpeg_fallback_count);
+
+	_mmcam_dbg_log("jpeg fallback count %d", *count);
+
+	return MM_ERROR_NONE;
+}
+
+
+int _mmcamcorder_get_video_stream_delivery_count(MMHandleType handle, int *delivered, int *dropped)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(delivered && dropped, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	*delivered = g_atomic_int_get(&hcamcorder->vstream_delivery.delivered);
+	*dropped = g_atomic_int_get(&hcamcorder->vstream_delivery.dropped);
+
+	_mmcam_dbg_log("video stream delivered %d, dropped %d", *delivered, *dropped);
+
+	return MM_ERROR_NONE;
+}
+
+
+void _mmcamcorder_update_preview_profile(MMHandleType handle, gint64 *stage_time)
+{
+	int i = 0;
+	int bucket = 0;
+	guint64 elapsed = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	MMCamcorderPreviewProfileStageType *stage = NULL;
+
+	mmf_return_if_fail(hcamcorder && stage_time);
+
+	g_mutex_lock(&hcamcorder->preview_profile.lock);
+
+	/* profiling could be disabled while the frame is measured */
+	if (!g_atomic_int_get(&hcamcorder->preview_profile.enable)) {
+		g_mutex_unlock(&hcamcorder->preview_profile.lock);
+		return;
+	}
+
+	/* frame is counted by the probe, not by the delivery thread of video stream */
+	if (stage_time[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_PROBE] >= 0)
+		hcamcorder->preview_profile.data.frame_count++;
+
+	for (i = 0 ; i < MM_CAMCORDER_PREVIEW_PROFILE_STAGE_NUM ; i++) {
+		/* negative value means that the stage is not passed */
+		if (stage_time[i] < 0)
+			continue;
+
+		elapsed = (guint64)stage_time[i];
+		stage = &hcamcorder->preview_profile.data.stage[i];
+
+		if (stage->count == 0 || elapsed < stage->min)
+			stage->min = (unsigned int)elapsed;
+		if (elapsed > stage->max)
+			stage->max = (unsigned int)elapsed;
+
+		stage->count++;
+		stage->total += elapsed;
+
+		/* bucket N : [2^(N-1), 2^N) usec */
+		for (bucket = 0 ; elapsed > 0 && bucket < MM_CAMCORDER_PREVIEW_PROFILE_BUCKET_NUM - 1 ; bucket++)
+			elapsed >>= 1;
+
+		stage->histogram[bucket]++;
+	}
+
+	g_mutex_unlock(&hcamcorder->preview_profile.lock);
+
+	return;
+}
+
+
 void __mmcamcorder_force_stop(mmf_camcorder_t *hcamcorder, int state_change_by_system)
 {
 	int i = 0;
@@ -3935,6 +4209,10 @@ static int __mmcamcorder_resource_release_cb(mm_resource_manager_h rm,
 			_mmcam_dbg_err("commit failed, cancel it");
 			_mmcamcorder_cancel((MMHandleType)hcamcorder);
 		}
+
+		/* encoding pipeline can not be kept without encoder */
+		if (hcamcorder->type == MM_CAMCORDER_MODE_VIDEO_CAPTURE)
+			_mmcamcorder_video_remove_parked_record((MMHandleType)hcamcorder);
 	} else {
 		/* Stop camera */
 		__mmcamcorder_force_stop(hcamcorder, _MMCAMCORDER_STATE_CHANGE_BY_RM);
@@ -51,6 +51,7 @@ do { \
 #define THUMBNAIL_WIDTH         320
 #define THUMBNAIL_HEIGHT        240
 #define THUMBNAIL_JPEG_QUALITY  90
+#define BURST_ARENA_EXIF_SIZE   0x10000         /* maximum size of APP1 segment */
 #define TRY_LOCK_MAX_COUNT      100
 #define TRY_LOCK_TIME           20000   /* ms */
 #define _MMCAMCORDER_MAKE_THUMBNAIL_INTERNAL_ENCODE
@@ -65,6 +66,7 @@ int _mmcamcorder_image_cmd_capture(MMHandleType handle);
 int _mmcamcorder_image_cmd_preview_start(MMHandleType handle);
 int _mmcamcorder_image_cmd_preview_stop(MMHandleType handle);
 static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sample1, GstSample *sample2, GstSample *sample3, gpointer u_data);
+static void __mmcamcorder_capture_pipeline_push(mmf_camcorder_t *hcamcorder, int stage, _MMCamcorderCaptureJob *job);
 
 /* sound status changed callback */
 static void __sound_status_changed_cb(keynode_t* node, void *data);
@@ -97,6 +99,9 @@ int _mmcamcorder_create_stillshot_pipeline(MMHandleType handle)
 	/* Create gstreamer element */
 	_mmcam_dbg_log("Using Encodebin for capturing");
 
+	/* capture pipeline uses same slot with encoding pipeline kept by warm record */
+	_mmcamcorder_video_remove_parked_record(handle);
+
 	/* Create capture pipeline */
 	_MMCAMCORDER_PIPELINE_MAKE(sc, sc->encode_element, _MMCAMCORDER_ENCODE_MAIN_PIPE, "capture_pipeline", err);
 
@@ -324,11 +329,22 @@ int _mmcamcorder_image_cmd_capture(MMHandleType handle)
 
 	info = sc->info_image;
 
+	/* capture state is shared with capture callback and deliver stage */
+	g_mutex_lock(&hcamcorder->capture_pipeline.lock);
+
 	if (info->capturing) {
+		g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
 		_mmcam_dbg_err("already capturing");
 		return MM_ERROR_CAMCORDER_DEVICE_BUSY;
 	}
 
+	/* set capture flag */
+	info->capturing = TRUE;
+	info->capture_cur_count = 0;
+	info->capture_send_count = 0;
+
+	g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
+
 	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
 		CONFIGURE_CATEGORY_MAIN_CAPTURE,
 		"UseCaptureMode",
@@ -344,9 +360,6 @@ int _mmcamcorder_image_cmd_capture(MMHandleType handle)
 	/* get current state */
 	mm_camcorder_get_state(handle, &current_state);
 
-	/* set capture flag */
-	info->capturing = TRUE;
-
 	ret = mm_camcorder_get_attributes(handle, &err_name,
 		MMCAM_IMAGE_ENCODER, &image_encoder,
 		MMCAM_CAMERA_WIDTH, &width,
@@ -418,8 +431,12 @@ int _mmcamcorder_image_cmd_capture(MMHandleType handle)
 		}
 	}
 
-	info->capture_cur_count = 0;
-	info->capture_send_count = 0;
+	/* intermediate buffers of burst capture : JPEG+EXIF, EXIF copy and thumbnail */
+	if (info->type == _MMCamcorder_MULTI_SHOT) {
+		_mmcamcorder_burst_arena_prepare(handle,
+			hcamcorder->capture_pipeline.depth > 0 ? info->count : 1,
+			(((unsigned int)info->width * info->height) >> 1) + (BURST_ARENA_EXIF_SIZE * 3) + ((THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT) << 1));
+	}
 
 	sc->internal_encode = FALSE;
 
@@ -596,7 +613,9 @@ int _mmcamcorder_image_cmd_capture(MMHandleType handle)
 
 cmd_done:
 	if (ret != MM_ERROR_NONE) {
+		g_mutex_lock(&hcamcorder->capture_pipeline.lock);
 		info->capturing = FALSE;
+		g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
 
 		/* sound finalize */
 		if (info->type == _MMCamcorder_MULTI_SHOT)
@@ -671,7 +690,10 @@ int _mmcamcorder_image_cmd_preview_start(MMHandleType handle)
 	/* Image info */
 	info->next_shot_time = 0;
 	info->multi_shot_stop = TRUE;
+
+	g_mutex_lock(&hcamcorder->capture_pipeline.lock);
 	info->capturing = FALSE;
+	g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
 
 	current_state = _mmcamcorder_get_state(handle);
 	_mmcam_dbg_log("current state [%d]", current_state);
@@ -857,6 +879,10 @@ int _mmcamcorder_image_cmd_preview_start(MMHandleType handle)
 
 			_mmcam_dbg_log("sound status %d", info->sound_status);
 		}
+
+		/* build encoding pipeline in advance to start recording quickly */
+		if (hcamcorder->type == MM_CAMCORDER_MODE_VIDEO_CAPTURE)
+			_mmcamcorder_video_request_warm_record(handle);
 	}
 
 cmd_error:
@@ -909,6 +935,10 @@ int _mmcamcorder_image_cmd_preview_stop(MMHandleType handle)
 
 	pipeline = sc->element[_MMCAMCORDER_MAIN_PIPE].gst;
 
+	/* encoding pipeline kept by warm record is not reused after preview restart */
+	if (hcamcorder->type == MM_CAMCORDER_MODE_VIDEO_CAPTURE)
+		_mmcamcorder_video_remove_parked_record(handle);
+
 	if (sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst) {
 		_mmcam_dbg_log("pipeline is exist so need to remove pipeline and sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst=%p",
 			sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst);
@@ -923,6 +953,9 @@ int _mmcamcorder_image_cmd_preview_stop(MMHandleType handle)
 
 	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_SINK].gst, "keep-camera-preview", display_reuse_hint);
 
+	/* captured images in capture stages should be released before buffers of source are released */
+	_mmcamcorder_capture_pipeline_flush(handle);
+
 	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", TRUE);
 	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", TRUE);
 
@@ -932,6 +965,12 @@ int _mmcamcorder_image_cmd_preview_stop(MMHandleType handle)
 
 	traceEnd(TTRACE_TAG_CAMERA);
 
+	/* preview frames queued until source is stopped are delivered before returning */
+	_mmcamcorder_vstream_delivery_flush(handle);
+
+	/* frames kept for pre-record are not continuous with next preview */
+	_mmcamcorder_video_pre_record_flush(handle);
+
 	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSINK_QUE].gst, "empty-buffers", FALSE);
 	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_QUE].gst, "empty-buffers", FALSE);
 
@@ -1007,6 +1046,8 @@ void __mmcamcorder_init_stillshot_info(MMHandleType handle)
 
 	info = sc->info_image;
 
+	g_mutex_lock(&hcamcorder->capture_pipeline.lock);
+
 	_mmcam_dbg_log("capture type[%d], capture send count[%d]", info->type, info->capture_send_count);
 
 	if (info->type == _MMCamcorder_SINGLE_SHOT || info->capture_send_count == info->count) {
@@ -1019,13 +1060,19 @@ void __mmcamcorder_init_stillshot_info(MMHandleType handle)
 		info->capturing = FALSE;
 	}
 
+	g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
+
 	return;
 }
 
 
-int __mmcamcorder_capture_save_exifinfo(MMHandleType handle, MMCamcorderCaptureDataType *original, MMCamcorderCaptureDataType *thumbnail, int provide_exif)
+int __mmcamcorder_capture_save_exifinfo(MMHandleType handle, MMCamcorderCaptureDataType *original, MMCamcorderCaptureDataType *thumbnail, int provide_exif, int arena_slot)
 {
+	int i = 0;
 	int ret = MM_ERROR_NONE;
+	unsigned char *m = NULL;
+	unsigned int m_len = 0;
+	mm_exif_jpeg_segments_t segments;
 	unsigned char *data = NULL;
 	unsigned int datalen = 0;
 	_MMCamcorderSubContext *sc = NULL;
@@ -1073,11 +1120,32 @@ int __mmcamcorder_capture_save_exifinfo(MMHandleType handle, MMCamcorderCaptureD
 		ret = MM_ERROR_NONE;
 	}
 
-	if (ret == MM_ERROR_NONE) {
+	if (ret == MM_ERROR_NONE && arena_slot < 0) {
 		/* write jpeg with exif */
 		ret = mm_exif_write_exif_jpeg_to_memory(&original->data, &original->length, hcamcorder->exif_info, data, datalen);
 		if (ret != MM_ERROR_NONE)
 			_mmcam_dbg_err("mm_exif_write_exif_jpeg_to_memory error! [0x%x]", ret);
+	} else if (ret == MM_ERROR_NONE) {
+		/* write jpeg with exif to slot of burst arena */
+		ret = mm_exif_get_exif_jpeg_segments(&segments, hcamcorder->exif_info, data, datalen);
+		if (ret != MM_ERROR_NONE) {
+			_mmcam_dbg_err("mm_exif_get_exif_jpeg_segments error! [0x%x]", ret);
+			return ret;
+		}
+
+		m = _mmcamcorder_burst_arena_alloc(handle, arena_slot, segments.length);
+		if (!m) {
+			_mmcam_dbg_err("failed to alloc JPEG+EXIF size %u", segments.length);
+			return MM_ERROR_CAMCORDER_LOW_MEMORY;
+		}
+
+		for (i = 0 ; i < segments.count ; i++) {
+			memcpy(m + m_len, segments.segment[i].iov_base, segments.segment[i].iov_len);
+			m_len += segments.segment[i].iov_len;
+		}
+
+		original->data = m;
+		original->length = m_len;
 	}
 
 	_mmcam_dbg_log("END ret 0x%x", ret);
@@ -1130,7 +1198,7 @@ GET_FAILED:
 }
 
 
-int __mmcamcorder_set_jpeg_data(MMHandleType handle, MMCamcorderCaptureDataType *dest, MMCamcorderCaptureDataType *thumbnail, int provide_exif)
+int __mmcamcorder_set_jpeg_data(MMHandleType handle, MMCamcorderCaptureDataType *dest, MMCamcorderCaptureDataType *thumbnail, int provide_exif, int arena_slot)
 {
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 	_MMCamcorderSubContext *sc = NULL;
@@ -1145,9 +1213,9 @@ int __mmcamcorder_set_jpeg_data(MMHandleType handle, MMCamcorderCaptureDataType
 	/* if tag enable and doesn't provide exif, we make it */
 	_mmcam_dbg_log("Add exif information if existed(thumbnail[%p])", thumbnail);
 	if (thumbnail && thumbnail->data)
-		return __mmcamcorder_capture_save_exifinfo(handle, dest, thumbnail, provide_exif);
+		return __mmcamcorder_capture_save_exifinfo(handle, dest, thumbnail, provide_exif, arena_slot);
 	else
-		return __mmcamcorder_capture_save_exifinfo(handle, dest, NULL, provide_exif);
+		return __mmcamcorder_capture_save_exifinfo(handle, dest, NULL, provide_exif, arena_slot);
 }
 
 
@@ -1167,7 +1235,7 @@ void __mmcamcorder_release_jpeg_data(MMHandleType handle, MMCamcorderCaptureData
 	/* if dest->data is allocated in MSL, release it */
 	if (tag_enable && !provide_exif) {
 		if (dest->data) {
-			free(dest->data);
+			_mmcamcorder_burst_arena_free(handle, dest->data);
 			dest->length = 0;
 			dest->data = NULL;
 			_mmcam_dbg_log("Jpeg is released!");
@@ -1180,190 +1248,77 @@ void __mmcamcorder_release_jpeg_data(MMHandleType handle, MMCamcorderCaptureData
 }
 
 
-static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sample1, GstSample *sample2, GstSample *sample3, gpointer u_data)
+static void __mmcamcorder_capture_stage_convert(mmf_camcorder_t *hcamcorder, _MMCamcorderCaptureJob *job)
 {
 	int ret = MM_ERROR_NONE;
-	int pixtype_main = MM_PIXEL_FORMAT_INVALID;
 	int pixtype_thumb = MM_PIXEL_FORMAT_INVALID;
 	int pixtype_scrnl = MM_PIXEL_FORMAT_INVALID;
-	int codectype = MM_IMAGE_CODEC_JPEG;
-	int count = 0;
-	int stop_cont_shot = FALSE;
-	int tag_enable = FALSE;
-	int provide_exif = FALSE;
-	int capture_quality = 0;
-	int try_lock_count = 0;
-	gboolean send_captured_message = FALSE;
-	unsigned char *exif_raw_data = NULL;
-	unsigned char *internal_main_data = NULL;
-	unsigned int internal_main_length = 0;
-	unsigned char *internal_thumb_data = NULL;
-	unsigned int internal_thumb_length = 0;
-	unsigned char *compare_data = NULL;
-
-	MMCamcorderStateType current_state = MM_CAMCORDER_STATE_NONE;
-	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
-	_MMCamcorderImageInfo *info = NULL;
-	_MMCamcorderSubContext *sc = NULL;
-	MMCamcorderCaptureDataType dest = {0,};
-	MMCamcorderCaptureDataType thumb = {0,};
-	MMCamcorderCaptureDataType scrnail = {0,};
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
 	MMCamcorderCaptureDataType encode_src = {0,};
-	GstMapInfo mapinfo1;
-	GstMapInfo mapinfo2;
-	GstMapInfo mapinfo3;
-
-	MMHandleType attrs;
-	int attr_index_for_screennail = 0;
-	int attr_index_for_exif = 0;
-
-	mmf_return_if_fail(hcamcorder);
-
-	sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
-	mmf_return_if_fail(sc && sc->info_image);
-
-	info = sc->info_image;
-
-	memset(&mapinfo1, 0x0, sizeof(GstMapInfo));
-	memset(&mapinfo2, 0x0, sizeof(GstMapInfo));
-	memset(&mapinfo3, 0x0, sizeof(GstMapInfo));
-
-	/* get current state */
-	current_state = _mmcamcorder_get_state((MMHandleType)hcamcorder);
-
-	_mmcam_dbg_err("START - current state %d", current_state);
-
-	/* check capture state */
-	if (info->type == _MMCamcorder_MULTI_SHOT && info->capture_send_count > 0)
-		mm_camcorder_get_attributes((MMHandleType)hcamcorder, NULL,
-			MMCAM_CAPTURE_BREAK_CONTINUOUS_SHOT, &stop_cont_shot,
-			NULL);
-
-	if (!info->capturing || stop_cont_shot) {
-		_mmcam_dbg_warn("stop command[%d] or not capturing state[%d]. skip this...", stop_cont_shot, info->capturing);
-
-		/* set FALSE here for the case that info->capturing is still FALSE
-			(== capture_send_count is 0 at the time _mmcamcorder_commit_capture_break_cont_shot is called) */
-		info->capturing = FALSE;
-
-		/*free GstBuffer*/
-		if (sample1)
-			gst_sample_unref(sample1);
-
-		if (sample2)
-			gst_sample_unref(sample2);
-
-		if (sample3)
-			gst_sample_unref(sample3);
-
-		return;
-	}
-
-	/* check command lock to block capture callback if capture start API is not returned
-	   wait for 2 seconds at worst case */
-	try_lock_count = 0;
-	do {
-		_mmcam_dbg_log("Try command LOCK");
-		if (_MMCAMCORDER_TRYLOCK_CMD(hcamcorder)) {
-			_mmcam_dbg_log("command LOCK OK");
-			_MMCAMCORDER_UNLOCK_CMD(hcamcorder);
-			break;
-		}
-
-		if (try_lock_count++ < TRY_LOCK_MAX_COUNT) {
-			_mmcam_dbg_warn("command LOCK Failed, retry...[count %d]", try_lock_count);
-			usleep(TRY_LOCK_TIME);
-		} else {
-			_mmcam_dbg_err("failed to lock command LOCK");
-			break;
-		}
-	} while (TRUE);
-
-	if (current_state < MM_CAMCORDER_STATE_RECORDING) {
-		/* play capture sound here if multi capture
-		   or preview format is ITLV(because of AF and flash control in plugin) */
-		if (info->type == _MMCamcorder_MULTI_SHOT) {
-			g_mutex_lock(&hcamcorder->task_thread_lock);
-			_mmcam_dbg_log("send signal for sound play");
-			hcamcorder->task_thread_state = _MMCAMCORDER_TASK_THREAD_STATE_SOUND_PLAY_START;
-			g_cond_signal(&hcamcorder->task_thread_cond);
-			g_mutex_unlock(&hcamcorder->task_thread_lock);
-		} else if (!info->played_capture_sound) {
-			_mmcamcorder_sound_solo_play((MMHandleType)hcamcorder, _MMCAMCORDER_SAMPLE_SOUND_NAME_CAPTURE01, FALSE);
-		}
-	}
+	unsigned int encode_src_stride = 0;
 
 	/* init capture data */
-	memset((void *)&dest, 0x0, sizeof(MMCamcorderCaptureDataType));
-	memset((void *)&thumb, 0x0, sizeof(MMCamcorderCaptureDataType));
-	memset((void *)&scrnail, 0x0, sizeof(MMCamcorderCaptureDataType));
+	memset((void *)&job->dest, 0x0, sizeof(MMCamcorderCaptureDataType));
+	memset((void *)&job->thumb, 0x0, sizeof(MMCamcorderCaptureDataType));
+	memset((void *)&job->scrnail, 0x0, sizeof(MMCamcorderCaptureDataType));
 
 	/* Prepare main, thumbnail buffer */
-	pixtype_main = _mmcamcorder_get_pixel_format(gst_sample_get_caps(sample1));
-	if (pixtype_main == MM_PIXEL_FORMAT_INVALID) {
+	job->pixtype_main = _mmcamcorder_get_pixel_format(gst_sample_get_caps(job->sample1));
+	if (job->pixtype_main == MM_PIXEL_FORMAT_INVALID) {
 		_mmcam_dbg_err("Unsupported pixel type");
 		MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_ERROR, MM_ERROR_CAMCORDER_INTERNAL);
-		goto error;
+		goto _CONVERT_FAILED;
 	}
 
 	/* Main image buffer */
-	if (!sample1 || !gst_buffer_map(gst_sample_get_buffer(sample1), &mapinfo1, GST_MAP_READ)) {
-		_mmcam_dbg_err("sample1[%p] is NULL or gst_buffer_map failed", sample1);
+	if (!job->sample1 || !gst_buffer_map(gst_sample_get_buffer(job->sample1), &job->mapinfo1, GST_MAP_READ)) {
+		_mmcam_dbg_err("sample1[%p] is NULL or gst_buffer_map failed", job->sample1);
 		MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_ERROR, MM_ERROR_CAMCORDER_INTERNAL);
-		goto error;
+		goto _CONVERT_FAILED;
 	} else {
-		if ((mapinfo1.data == NULL) && (mapinfo1.size == 0)) {
-			_mmcam_dbg_err("mapinfo1 is wrong (%p, size %zu)", mapinfo1.data, mapinfo1.size);
+		if ((job->mapinfo1.data == NULL) && (job->mapinfo1.size == 0)) {
+			_mmcam_dbg_err("mapinfo1 is wrong (%p, size %zu)", job->mapinfo1.data, job->mapinfo1.size);
 			MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_ERROR, MM_ERROR_CAMCORDER_INTERNAL);
-			gst_buffer_unmap(gst_sample_get_buffer(sample1), &mapinfo1);
-			goto error;
+			gst_buffer_unmap(gst_sample_get_buffer(job->sample1), &job->mapinfo1);
+			memset(&job->mapinfo1, 0x0, sizeof(GstMapInfo));
+			goto _CONVERT_FAILED;
 		} else {
-			__mmcamcorder_get_capture_data_from_buffer(&dest, pixtype_main, sample1);
+			__mmcamcorder_get_capture_data_from_buffer(&job->dest, job->pixtype_main, job->sample1);
+			job->stride_main = _mmcamcorder_get_sample_stride(job->sample1);
 		}
 	}
 
-	if (!sample2 || !gst_buffer_map(gst_sample_get_buffer(sample2), &mapinfo2, GST_MAP_READ))
-		_mmcam_dbg_log("sample2[%p] is NULL or gst_buffer_map failed. Not Error.", sample2);
-
-	if (!sample3 || !gst_buffer_map(gst_sample_get_buffer(sample3), &mapinfo3, GST_MAP_READ))
-		_mmcam_dbg_log("sample3[%p] is NULL or gst_buffer_map failed. Not Error.", sample3);
+	if (!job->sample2 || !gst_buffer_map(gst_sample_get_buffer(job->sample2), &job->mapinfo2, GST_MAP_READ))
+		_mmcam_dbg_log("sample2[%p] is NULL or gst_buffer_map failed. Not Error.", job->sample2);
 
-	/* Screennail image buffer */
-	attrs = MMF_CAMCORDER_ATTRS(hcamcorder);
-	mm_attrs_get_index(attrs, MMCAM_CAPTURED_SCREENNAIL, &attr_index_for_screennail);
+	if (!job->sample3 || !gst_buffer_map(gst_sample_get_buffer(job->sample3), &job->mapinfo3, GST_MAP_READ))
+		_mmcam_dbg_log("sample3[%p] is NULL or gst_buffer_map failed. Not Error.", job->sample3);
 
-	if (sample3 && mapinfo3.data && mapinfo3.size != 0) {
-		_mmcam_dbg_log("Screennail (sample3=%p,size=%zu)", sample3, mapinfo3.size);
+	/* Screennail image buffer, it's set to attribute when it's delivered */
+	if (job->sample3 && job->mapinfo3.data && job->mapinfo3.size != 0) {
+		_mmcam_dbg_log("Screennail (sample3=%p,size=%zu)", job->sample3, job->mapinfo3.size);
 
-		pixtype_scrnl = _mmcamcorder_get_pixel_format(gst_sample_get_caps(sample3));
-		__mmcamcorder_get_capture_data_from_buffer(&scrnail, pixtype_scrnl, sample3);
-
-		/* Set screennail attribute for application */
-		ret = mm_attrs_set_data(attrs, attr_index_for_screennail, &scrnail, sizeof(scrnail));
-		_mmcam_dbg_log("Screennail set attribute data %p, size %zu, ret %x", &scrnail, sizeof(scrnail), ret);
+		pixtype_scrnl = _mmcamcorder_get_pixel_format(gst_sample_get_caps(job->sample3));
+		__mmcamcorder_get_capture_data_from_buffer(&job->scrnail, pixtype_scrnl, job->sample3);
 	} else {
-		_mmcam_dbg_log("Sample3 has wrong pointer. Not Error. (sample3=%p)", sample3);
-		mm_attrs_set_data(attrs, attr_index_for_screennail, NULL, 0);
+		_mmcam_dbg_log("Sample3 has wrong pointer. Not Error. (sample3=%p)", job->sample3);
 	}
 
-	/* commit screennail data */
-	mm_attrs_commit(attrs, attr_index_for_screennail);
-
 	/* init thumb data */
 	memset(&encode_src, 0x0, sizeof(MMCamcorderCaptureDataType));
 
 	/* get provide-exif */
-	MMCAMCORDER_G_OBJECT_GET(sc->element[_MMCAMCORDER_VIDEOSRC_SRC].gst, "provide-exif", &provide_exif);
+	MMCAMCORDER_G_OBJECT_GET(sc->element[_MMCAMCORDER_VIDEOSRC_SRC].gst, "provide-exif", &job->provide_exif);
 
 	/* Thumbnail image buffer */
-	if (sample2 && mapinfo2.data && (mapinfo2.size != 0)) {
-		_mmcam_dbg_log("Thumbnail (buffer2=%p)", gst_sample_get_buffer(sample2));
-		pixtype_thumb = _mmcamcorder_get_pixel_format(gst_sample_get_caps(sample2));
-		__mmcamcorder_get_capture_data_from_buffer(&thumb, pixtype_thumb, sample2);
+	if (job->sample2 && job->mapinfo2.data && (job->mapinfo2.size != 0)) {
+		_mmcam_dbg_log("Thumbnail (buffer2=%p)", gst_sample_get_buffer(job->sample2));
+		pixtype_thumb = _mmcamcorder_get_pixel_format(gst_sample_get_caps(job->sample2));
+		__mmcamcorder_get_capture_data_from_buffer(&job->thumb, pixtype_thumb, job->sample2);
 	} else {
-		_mmcam_dbg_log("Sample2 has wrong pointer. Not Error. (sample2 %p)", sample2);
+		_mmcam_dbg_log("Sample2 has wrong pointer. Not Error. (sample2 %p)", job->sample2);
 
-		if (pixtype_main == MM_PIXEL_FORMAT_ENCODED && provide_exif) {
+		if (job->pixtype_main == MM_PIXEL_FORMAT_ENCODED && job->provide_exif) {
 			ExifLoader *l;
 			/* get thumbnail from EXIF */
 			l = exif_loader_new();
@@ -1373,7 +1328,7 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 				char  height[10];
 				ExifEntry *entry = NULL;
 
-				exif_loader_write(l, dest.data, dest.length);
+				exif_loader_write(l, job->dest.data, job->dest.length);
 
 				/* Get a pointer to the EXIF data */
 				ed = exif_loader_get_data(l);
@@ -1394,14 +1349,14 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 					entry = NULL;
 					/* Make sure the image had a thumbnail before trying to write it */
 					if (ed->data && ed->size) {
-						thumb.data = malloc(ed->size);
-						if (thumb.data) {
-							memcpy(thumb.data, ed->data, ed->size);
-							thumb.length = ed->size;
-							thumb.format = MM_PIXEL_FORMAT_ENCODED;
-							thumb.width = atoi(width);
-							thumb.height = atoi(height);
-							internal_thumb_data = thumb.data;
+						job->thumb.data = _mmcamcorder_burst_arena_alloc((MMHandleType)hcamcorder, job->arena_slot, ed->size);
+						if (job->thumb.data) {
+							memcpy(job->thumb.data, ed->data, ed->size);
+							job->thumb.length = ed->size;
+							job->thumb.format = MM_PIXEL_FORMAT_ENCODED;
+							job->thumb.width = atoi(width);
+							job->thumb.height = atoi(height);
+							job->internal_thumb_data = job->thumb.data;
 						} else {
 							_mmcam_dbg_err("failed to alloc thumbnail data");
 						}
@@ -1416,14 +1371,16 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 			}
 		}
 
-		if (thumb.data == NULL) {
-			if (pixtype_main == MM_PIXEL_FORMAT_ENCODED &&
-			    scrnail.data && scrnail.length != 0) {
+		if (job->thumb.data == NULL) {
+			if (job->pixtype_main == MM_PIXEL_FORMAT_ENCODED &&
+			    job->scrnail.data && job->scrnail.length != 0) {
 				/* make thumbnail image with screennail data */
-				memcpy(&encode_src, &scrnail, sizeof(MMCamcorderCaptureDataType));
+				memcpy(&encode_src, &job->scrnail, sizeof(MMCamcorderCaptureDataType));
+				encode_src_stride = _mmcamcorder_get_sample_stride(job->sample3);
 			} else if (sc->internal_encode) {
 				/* make thumbnail image with main data, this is raw data */
-				memcpy(&encode_src, &dest, sizeof(MMCamcorderCaptureDataType));
+				memcpy(&encode_src, &job->dest, sizeof(MMCamcorderCaptureDataType));
+				encode_src_stride = job->stride_main;
 			}
 		}
 
@@ -1451,8 +1408,8 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 				     encode_src.format == MM_PIXEL_FORMAT_YUYV) &&
 				     encode_src.width % thumb_width == 0 &&
 				     encode_src.height % thumb_height == 0) {
-					if (!_mmcamcorder_downscale_UYVYorYUYV(encode_src.data, encode_src.width, encode_src.height,
-						&thumb_raw_data, thumb_width, thumb_height)) {
+					if (!_mmcamcorder_downscale_UYVYorYUYV((MMHandleType)hcamcorder, encode_src.data, encode_src.width, encode_src.height,
+						&thumb_raw_data, thumb_width, thumb_height, job->arena_slot)) {
 						thumb_raw_data = NULL;
 						_mmcam_dbg_warn("_mmcamcorder_downscale_UYVYorYUYV failed. skip thumbnail making...");
 					}
@@ -1475,24 +1432,26 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 			}
 
 			if (thumb_raw_data) {
-				ret = _mmcamcorder_encode_jpeg(thumb_raw_data, thumb_width, thumb_height,
-					encode_src.format, thumb_length, THUMBNAIL_JPEG_QUALITY,
-					(void **)&internal_thumb_data, &internal_thumb_length);
+				/* resized thumbnail is not padded */
+				ret = _mmcamcorder_encode_jpeg((MMHandleType)hcamcorder, thumb_raw_data, thumb_width, thumb_height,
+					encode_src.format, thumb_length, thumb_raw_data == encode_src.data ? encode_src_stride : 0,
+					THUMBNAIL_JPEG_QUALITY,
+					(void **)&job->internal_thumb_data, &job->internal_thumb_length);
 				if (ret) {
-					_mmcam_dbg_log("encode THUMBNAIL done - data %p, length %d", internal_thumb_data, internal_thumb_length);
+					_mmcam_dbg_log("encode THUMBNAIL done - data %p, length %d", job->internal_thumb_data, job->internal_thumb_length);
 
-					thumb.data = internal_thumb_data;
-					thumb.length = internal_thumb_length;
-					thumb.width = thumb_width;
-					thumb.height = thumb_height;
-					thumb.format = MM_PIXEL_FORMAT_ENCODED;
+					job->thumb.data = job->internal_thumb_data;
+					job->thumb.length = job->internal_thumb_length;
+					job->thumb.width = thumb_width;
+					job->thumb.height = thumb_height;
+					job->thumb.format = MM_PIXEL_FORMAT_ENCODED;
 				} else {
 					_mmcam_dbg_warn("failed to encode THUMBNAIL");
 				}
 
 				/* release allocated raw data memory */
 				if (thumb_raw_data != encode_src.data) {
-					free(thumb_raw_data);
+					_mmcamcorder_burst_arena_free((MMHandleType)hcamcorder, thumb_raw_data);
 					thumb_raw_data = NULL;
 					_mmcam_dbg_log("release thumb_raw_data");
 				}
@@ -1505,45 +1464,76 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 		}
 	}
 
+	return;
+
+_CONVERT_FAILED:
+	job->failed = TRUE;
+
+	return;
+}
+
+
+static void __mmcamcorder_capture_stage_encode(mmf_camcorder_t *hcamcorder, _MMCamcorderCaptureJob *job)
+{
+	int ret = MM_ERROR_NONE;
+	int capture_quality = 0;
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+
+	if (job->failed)
+		return;
+
 	/* Encode JPEG */
-	if (sc->internal_encode && pixtype_main != MM_PIXEL_FORMAT_ENCODED) {
-		mm_camcorder_get_attributes((MMHandleType)hcamcorder, NULL,
-			MMCAM_IMAGE_ENCODER_QUALITY, &capture_quality,
-			NULL);
+	if (sc->internal_encode && job->pixtype_main != MM_PIXEL_FORMAT_ENCODED) {
+		capture_quality = job->attrs.image_encoder_quality;
 		_mmcam_dbg_log("Start Internal Encode - capture_quality %d", capture_quality);
 
-		ret = _mmcamcorder_encode_jpeg(mapinfo1.data, dest.width, dest.height,
-			pixtype_main, dest.length, capture_quality,
-			(void **)&internal_main_data, &internal_main_length);
+		ret = _mmcamcorder_encode_jpeg((MMHandleType)hcamcorder, job->mapinfo1.data, job->dest.width, job->dest.height,
+			job->pixtype_main, job->dest.length, job->stride_main, capture_quality,
+			(void **)&job->internal_main_data, &job->internal_main_length);
 		if (!ret) {
 			_mmcam_dbg_err("_mmcamcorder_encode_jpeg failed");
 
 			MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_ERROR, MM_ERROR_CAMCORDER_INTERNAL);
 
-			goto error;
+			job->failed = TRUE;
+			return;
 		}
 
 		/* set format */
-		dest.data = internal_main_data;
-		dest.length = internal_main_length;
-		dest.format = MM_PIXEL_FORMAT_ENCODED;
+		job->dest.data = job->internal_main_data;
+		job->dest.length = job->internal_main_length;
+		job->dest.format = MM_PIXEL_FORMAT_ENCODED;
 
-		_mmcam_dbg_log("Done Internal Encode - data %p, length %d", dest.data, dest.length);
+		_mmcam_dbg_log("Done Internal Encode - data %p, length %d", job->dest.data, job->dest.length);
 	}
 
+	return;
+}
+
+
+static void __mmcamcorder_capture_stage_exif(mmf_camcorder_t *hcamcorder, _MMCamcorderCaptureJob *job)
+{
+	int ret = MM_ERROR_NONE;
+	int codectype = job->attrs.image_encoder;
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	_MMCamcorderImageInfo *info = sc->info_image;
+
+	if (job->failed)
+		return;
+
 	if (info->capture_format != MM_PIXEL_FORMAT_ENCODED) {
 		_mmcam_dbg_log("not encoded format, skip exif related sequence");
-		goto _CAPTURE_CB_EXIF_DONE;
+		return;
 	}
 
 	/* create EXIF info */
-	if (!provide_exif) {	/* make new exif */
+	if (!job->provide_exif) {	/* make new exif */
 		ret = mm_exif_create_exif_info(&(hcamcorder->exif_info));
 	} else {	/* load from jpeg buffer dest.data */
-		ret = mm_exif_load_exif_info(&(hcamcorder->exif_info), dest.data, dest.length);
+		ret = mm_exif_load_exif_info(&(hcamcorder->exif_info), job->dest.data, job->dest.length);
 		if (ret != MM_ERROR_NONE) {
 			_mmcam_dbg_err("Failed to load exif_info [%x], try to create EXIF", ret);
-			provide_exif = FALSE;
+			job->provide_exif = FALSE;
 			ret = mm_exif_create_exif_info(&(hcamcorder->exif_info));
 		}
 	}
@@ -1551,12 +1541,12 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 		_mmcam_dbg_err("Failed to create exif_info [%x], but keep going...", ret);
 	} else {
 		/* add basic exif info */
-		if (!provide_exif) {
+		if (!job->provide_exif) {
 			_mmcam_dbg_log("add basic exif info");
-			ret = __mmcamcorder_set_exif_basic_info((MMHandleType)hcamcorder, dest.width, dest.height);
+			ret = __mmcamcorder_set_exif_basic_info((MMHandleType)hcamcorder, job->dest.width, job->dest.height);
 		} else {
 			_mmcam_dbg_log("update exif info");
-			ret = __mmcamcorder_update_exif_info((MMHandleType)hcamcorder, dest.data, dest.length);
+			ret = __mmcamcorder_update_exif_info((MMHandleType)hcamcorder, job->dest.data, job->dest.length);
 		}
 
 		if (ret != MM_ERROR_NONE) {
@@ -1565,66 +1555,101 @@ static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sampl
 		}
 	}
 
-	/* get attribute item for EXIF data */
-	mm_attrs_get_index((MMHandleType)attrs, MMCAM_CAPTURED_EXIF_RAW_DATA, &attr_index_for_exif);
-
-	/* set EXIF data to attribute */
+	/* copy EXIF data for attribute, it's set to attribute when it's delivered */
+	job->set_exif_attr = TRUE;
 	if (hcamcorder->exif_info && hcamcorder->exif_info->data) {
-		exif_raw_data = (unsigned char *)malloc(hcamcorder->exif_info->size);
-		if (exif_raw_data) {
-			memcpy(exif_raw_data, hcamcorder->exif_info->data, hcamcorder->exif_info->size);
-			mm_attrs_set_data(attrs, attr_index_for_exif, exif_raw_data, hcamcorder->exif_info->size);
-			_mmcam_dbg_log("set EXIF raw data %p, size %d", exif_raw_data, hcamcorder->exif_info->size);
+		job->exif_raw_data = (unsigned char *)_mmcamcorder_burst_arena_alloc((MMHandleType)hcamcorder,
+			job->arena_slot, hcamcorder->exif_info->size);
+		if (job->exif_raw_data) {
+			memcpy(job->exif_raw_data, hcamcorder->exif_info->data, hcamcorder->exif_info->size);
+			job->exif_raw_size = hcamcorder->exif_info->size;
+			_mmcam_dbg_log("copy EXIF raw data %p, size %d", job->exif_raw_data, job->exif_raw_size);
 		} else {
 			_mmcam_dbg_warn("failed to alloc for EXIF, size %d", hcamcorder->exif_info->size);
 		}
 	} else {
 		_mmcam_dbg_warn("failed to create EXIF. set EXIF as NULL");
-		mm_attrs_set_data(attrs, attr_index_for_exif, NULL, 0);
 	}
 
-	/* commit EXIF data */
-	mm_attrs_commit(attrs, attr_index_for_exif);
-
 	/* get tag-enable */
-	mm_camcorder_get_attributes((MMHandleType)hcamcorder, NULL, MMCAM_TAG_ENABLE, &tag_enable, NULL);
+	job->tag_enable = job->attrs.tag_enable;
 
 	/* Set extra data for JPEG if tag enabled and doesn't provide EXIF */
-	if (tag_enable) {
-		mm_camcorder_get_attributes((MMHandleType)hcamcorder, NULL,
-			MMCAM_IMAGE_ENCODER, &codectype,
-			NULL);
+	if (job->tag_enable) {
 		_mmcam_dbg_log("codectype %d", codectype);
 
 		switch (codectype) {
 		case MM_IMAGE_CODEC_JPEG:
 		case MM_IMAGE_CODEC_SRW:
 		case MM_IMAGE_CODEC_JPEG_SRW:
-			ret = __mmcamcorder_set_jpeg_data((MMHandleType)hcamcorder, &dest, &thumb, provide_exif);
+			ret = __mmcamcorder_set_jpeg_data((MMHandleType)hcamcorder, &job->dest, &job->thumb, job->provide_exif, job->arena_slot);
 			if (ret != MM_ERROR_NONE) {
 				_mmcam_dbg_err("Error on setting extra data to jpeg");
 				MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_ERROR, ret);
-				goto error;
+				job->failed = TRUE;
 			}
 			break;
 		default:
 			_mmcam_dbg_err("The codectype is not supported. (%d)", codectype);
 			MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_ERROR, MM_ERROR_CAMCORDER_INTERNAL);
-			goto error;
+			job->failed = TRUE;
+			break;
 		}
 	}
 
-_CAPTURE_CB_EXIF_DONE:
+	/* destroy exif info, EXIF is already written to JPEG and copied for attribute */
+	mm_exif_destory_exif_info(hcamcorder->exif_info);
+	hcamcorder->exif_info = NULL;
+
+	return;
+}
+
+
+static void __mmcamcorder_capture_stage_deliver(mmf_camcorder_t *hcamcorder, _MMCamcorderCaptureJob *job)
+{
+	int ret = MM_ERROR_NONE;
+	int count = 0;
+	gboolean send_captured_message = FALSE;
+	unsigned char *compare_data = NULL;
+	MMHandleType attrs;
+	int attr_index_for_screennail = 0;
+	int attr_index_for_exif = 0;
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	_MMCamcorderImageInfo *info = sc->info_image;
+
+	if (job->failed)
+		goto error;
+
+	/* Set screennail attribute for application */
+	attrs = MMF_CAMCORDER_ATTRS(hcamcorder);
+	mm_attrs_get_index(attrs, MMCAM_CAPTURED_SCREENNAIL, &attr_index_for_screennail);
+
+	if (job->scrnail.data) {
+		ret = mm_attrs_set_data(attrs, attr_index_for_screennail, &job->scrnail, sizeof(job->scrnail));
+		_mmcam_dbg_log("Screennail set attribute data %p, size %zu, ret %x", &job->scrnail, sizeof(job->scrnail), ret);
+	} else {
+		mm_attrs_set_data(attrs, attr_index_for_screennail, NULL, 0);
+	}
+
+	/* commit screennail data */
+	mm_attrs_commit(attrs, attr_index_for_screennail);
+
+	/* set EXIF data to attribute */
+	if (job->set_exif_attr) {
+		mm_attrs_get_index(attrs, MMCAM_CAPTURED_EXIF_RAW_DATA, &attr_index_for_exif);
+		mm_attrs_set_data(attrs, attr_index_for_exif, job->exif_raw_data, job->exif_raw_size);
+		mm_attrs_commit(attrs, attr_index_for_exif);
+	}
 
 	/* Handle Capture Callback */
 	_MMCAMCORDER_LOCK_VCAPTURE_CALLBACK(hcamcorder);
 
 	if (hcamcorder->vcapture_cb) {
 		_mmcam_dbg_log("APPLICATION CALLBACK START");
-		if (thumb.data)
-			ret = hcamcorder->vcapture_cb(&dest, &thumb, hcamcorder->vcapture_cb_param);
+		if (job->thumb.data)
+			ret = hcamcorder->vcapture_cb(&job->dest, &job->thumb, hcamcorder->vcapture_cb_param);
 		else
-			ret = hcamcorder->vcapture_cb(&dest, NULL, hcamcorder->vcapture_cb_param);
+			ret = hcamcorder->vcapture_cb(&job->dest, NULL, hcamcorder->vcapture_cb_param);
 
 		_mmcam_dbg_log("APPLICATION CALLBACK END");
 	} else {
@@ -1636,7 +1661,9 @@ _CAPTURE_CB_EXIF_DONE:
 	}
 
 	/* Set capture count */
+	g_mutex_lock(&hcamcorder->capture_pipeline.lock);
 	count = ++(info->capture_send_count);
+	g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
 	send_captured_message = TRUE;
 
 err_release_exif:
@@ -1645,17 +1672,14 @@ err_release_exif:
 	/* init screennail and EXIF raw data */
 	mm_attrs_set_data(attrs, attr_index_for_screennail, NULL, 0);
 	mm_attrs_commit(attrs, attr_index_for_screennail);
-	if (exif_raw_data) {
-		free(exif_raw_data);
-		exif_raw_data = NULL;
-
+	if (job->exif_raw_data) {
 		mm_attrs_set_data(attrs, attr_index_for_exif, NULL, 0);
 		mm_attrs_commit(attrs, attr_index_for_exif);
 	}
 
 	/* Release jpeg data */
-	if (pixtype_main == MM_PIXEL_FORMAT_ENCODED)
-		__mmcamcorder_release_jpeg_data((MMHandleType)hcamcorder, &dest, tag_enable, provide_exif);
+	if (job->pixtype_main == MM_PIXEL_FORMAT_ENCODED)
+		__mmcamcorder_release_jpeg_data((MMHandleType)hcamcorder, &job->dest, job->tag_enable, job->provide_exif);
 
 error:
 	/* Check end condition and set proper value */
@@ -1666,54 +1690,58 @@ error:
 
 	/* release internal allocated data */
 	if (sc->internal_encode)
-		compare_data = internal_main_data;
+		compare_data = job->internal_main_data;
 	else
-		compare_data = mapinfo1.data;
+		compare_data = job->mapinfo1.data;
 
-	if (dest.data && compare_data &&
-	    dest.data != compare_data) {
-		_mmcam_dbg_log("release internal allocated data %p", dest.data);
-		free(dest.data);
-		dest.data = NULL;
-		dest.length = 0;
+	if (job->dest.data && compare_data &&
+	    job->dest.data != compare_data) {
+		_mmcam_dbg_log("release internal allocated data %p", job->dest.data);
+		_mmcamcorder_burst_arena_free((MMHandleType)hcamcorder, job->dest.data);
+		job->dest.data = NULL;
+		job->dest.length = 0;
 	}
-	if (internal_main_data) {
-		_mmcam_dbg_log("release internal main data %p", internal_main_data);
-		free(internal_main_data);
-		internal_main_data = NULL;
+	if (job->internal_main_data) {
+		_mmcam_dbg_log("release internal main data %p", job->internal_main_data);
+		_mmcamcorder_burst_arena_free((MMHandleType)hcamcorder, job->internal_main_data);
+		job->internal_main_data = NULL;
 	}
-	if (internal_thumb_data) {
-		_mmcam_dbg_log("release internal thumb data %p", internal_thumb_data);
-		free(internal_thumb_data);
-		internal_thumb_data = NULL;
+	if (job->internal_thumb_data) {
+		_mmcam_dbg_log("release internal thumb data %p", job->internal_thumb_data);
+		_mmcamcorder_burst_arena_free((MMHandleType)hcamcorder, job->internal_thumb_data);
+		job->internal_thumb_data = NULL;
 	}
 
 	/* reset compare_data */
 	compare_data = NULL;
 
+	if (job->exif_raw_data) {
+		_mmcamcorder_burst_arena_free((MMHandleType)hcamcorder, job->exif_raw_data);
+		job->exif_raw_data = NULL;
+	}
+
+	/* all intermediate buffers of this image are released */
+	_mmcamcorder_burst_arena_release((MMHandleType)hcamcorder, job->arena_slot);
+
 	/*free GstBuffer*/
-	if (sample1) {
-		gst_buffer_unmap(gst_sample_get_buffer(sample1), &mapinfo1);
-		gst_sample_unref(sample1);
+	if (job->sample1) {
+		gst_buffer_unmap(gst_sample_get_buffer(job->sample1), &job->mapinfo1);
+		gst_sample_unref(job->sample1);
 	}
-	if (sample2) {
-		gst_buffer_unmap(gst_sample_get_buffer(sample2), &mapinfo2);
-		gst_sample_unref(sample2);
+	if (job->sample2) {
+		gst_buffer_unmap(gst_sample_get_buffer(job->sample2), &job->mapinfo2);
+		gst_sample_unref(job->sample2);
 	}
-	if (sample3) {
-		gst_buffer_unmap(gst_sample_get_buffer(sample3), &mapinfo3);
-		gst_sample_unref(sample3);
+	if (job->sample3) {
+		gst_buffer_unmap(gst_sample_get_buffer(job->sample3), &job->mapinfo3);
+		gst_sample_unref(job->sample3);
 	}
 
-	/* destroy exif info */
-	mm_exif_destory_exif_info(hcamcorder->exif_info);
-	hcamcorder->exif_info = NULL;
-
 	/* send captured message */
 	if (send_captured_message) {
 		if (info->hdr_capture_mode != MM_CAMCORDER_HDR_ON_AND_ORIGINAL) {
 			/* Send CAPTURED message and count - capture success */
-			if (current_state >= MM_CAMCORDER_STATE_RECORDING)
+			if (job->current_state >= MM_CAMCORDER_STATE_RECORDING)
 				MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_VIDEO_SNAPSHOT_CAPTURED, count);
 			else
 				MMCAM_SEND_MESSAGE(hcamcorder, MM_MESSAGE_CAMCORDER_CAPTURED, count);
@@ -1723,7 +1751,7 @@ error:
 		}
 	}
 
-	if (current_state >= MM_CAMCORDER_STATE_RECORDING) {
+	if (job->current_state >= MM_CAMCORDER_STATE_RECORDING) {
 		/* Handle capture in recording case */
 		hcamcorder->capture_in_recording = FALSE;
 
@@ -1741,12 +1769,363 @@ error:
 		_MMCAMCORDER_CMD_SIGNAL(hcamcorder);
 	}
 
+	g_free(job);
+
 	_mmcam_dbg_err("END");
 
 	return;
 }
 
 
+static void __mmcamcorder_image_capture_cb(GstElement *element, GstSample *sample1, GstSample *sample2, GstSample *sample3, gpointer u_data)
+{
+	int try_lock_count = 0;
+	gboolean in_pipeline = FALSE;
+	_MMCamcorderAttrSnapshot attrs;
+
+	MMCamcorderStateType current_state = MM_CAMCORDER_STATE_NONE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
+	_MMCamcorderImageInfo *info = NULL;
+	_MMCamcorderSubContext *sc = NULL;
+	_MMCamcorderCaptureJob *job = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	mmf_return_if_fail(sc && sc->info_image);
+
+	info = sc->info_image;
+
+	/* get current state */
+	current_state = _mmcamcorder_get_state((MMHandleType)hcamcorder);
+
+	_mmcam_dbg_err("START - current state %d", current_state);
+
+	/* attributes for this capture */
+	_mmcamcorder_get_attr_snapshot((MMHandleType)hcamcorder, &attrs);
+
+	/* check capture state, deliver stage updates it in another thread */
+	g_mutex_lock(&hcamcorder->capture_pipeline.lock);
+
+	if (info->type != _MMCamcorder_MULTI_SHOT || info->capture_send_count == 0)
+		attrs.capture_break_cont_shot = FALSE;
+
+	/* images more than capture count are not delivered */
+	if (!info->capturing || attrs.capture_break_cont_shot ||
+	    (info->type == _MMCamcorder_MULTI_SHOT && info->capture_cur_count >= info->count)) {
+		_mmcam_dbg_warn("stop command[%d] or not capturing state[%d] or count[%d/%d]. skip this...",
+			attrs.capture_break_cont_shot, info->capturing, info->capture_cur_count, info->count);
+
+		/* set FALSE here for the case that info->capturing is still FALSE
+			(== capture_send_count is 0 at the time _mmcamcorder_commit_capture_break_cont_shot is called) */
+		if (!info->capturing || attrs.capture_break_cont_shot)
+			info->capturing = FALSE;
+
+		g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
+
+		/*free GstBuffer*/
+		if (sample1)
+			gst_sample_unref(sample1);
+
+		if (sample2)
+			gst_sample_unref(sample2);
+
+		if (sample3)
+			gst_sample_unref(sample3);
+
+		return;
+	}
+
+	info->capture_cur_count++;
+
+	/* count it before waiting for command lock, then flush waits for this image too */
+	in_pipeline = (hcamcorder->capture_pipeline.depth > 0);
+	if (in_pipeline)
+		hcamcorder->capture_pipeline.in_flight++;
+	g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
+
+	/* check command lock to block capture callback if capture start API is not returned
+	   wait for 2 seconds at worst case */
+	try_lock_count = 0;
+	do {
+		_mmcam_dbg_log("Try command LOCK");
+		if (_MMCAMCORDER_TRYLOCK_CMD(hcamcorder)) {
+			_mmcam_dbg_log("command LOCK OK");
+			_MMCAMCORDER_UNLOCK_CMD(hcamcorder);
+			break;
+		}
+
+		/* command lock is held by flush which waits for this image */
+		if (g_atomic_int_get(&hcamcorder->capture_pipeline.flushing)) {
+			_mmcam_dbg_warn("capture pipeline is flushing, do not wait for command LOCK");
+			break;
+		}
+
+		if (try_lock_count++ < TRY_LOCK_MAX_COUNT) {
+			_mmcam_dbg_warn("command LOCK Failed, retry...[count %d]", try_lock_count);
+			usleep(TRY_LOCK_TIME);
+		} else {
+			_mmcam_dbg_err("failed to lock command LOCK");
+			break;
+		}
+	} while (TRUE);
+
+	if (current_state < MM_CAMCORDER_STATE_RECORDING) {
+		/* play capture sound here if multi capture
+		   or preview format is ITLV(because of AF and flash control in plugin) */
+		if (info->type == _MMCamcorder_MULTI_SHOT) {
+			g_mutex_lock(&hcamcorder->task_thread_lock);
+			_mmcam_dbg_log("send signal for sound play");
+			hcamcorder->task_thread_state = _MMCAMCORDER_TASK_THREAD_STATE_SOUND_PLAY_START;
+			g_cond_signal(&hcamcorder->task_thread_cond);
+			g_mutex_unlock(&hcamcorder->task_thread_lock);
+		} else if (!info->played_capture_sound) {
+			_mmcamcorder_sound_solo_play((MMHandleType)hcamcorder, _MMCAMCORDER_SAMPLE_SOUND_NAME_CAPTURE01, FALSE);
+		}
+	}
+
+	/* samples are owned by job, and released when it's delivered */
+	job = g_new0(_MMCamcorderCaptureJob, 1);
+	job->sample1 = sample1;
+	job->sample2 = sample2;
+	job->sample3 = sample3;
+	job->current_state = current_state;
+	job->arena_slot = -1;
+	job->attrs = attrs;
+
+	if (info->type == _MMCamcorder_MULTI_SHOT)
+		job->arena_slot = _mmcamcorder_burst_arena_acquire((MMHandleType)hcamcorder);
+
+	if (in_pipeline) {
+		__mmcamcorder_capture_pipeline_push(hcamcorder, _MMCAMCORDER_CAPTURE_STAGE_CONVERT, job);
+		return;
+	}
+
+	__mmcamcorder_capture_stage_convert(hcamcorder, job);
+	__mmcamcorder_capture_stage_encode(hcamcorder, job);
+	__mmcamcorder_capture_stage_exif(hcamcorder, job);
+	__mmcamcorder_capture_stage_deliver(hcamcorder, job);
+
+	return;
+}
+
+
+static void __mmcamcorder_capture_pipeline_push(mmf_camcorder_t *hcamcorder, int stage, _MMCamcorderCaptureJob *job)
+{
+	_MMCamcorderCapturePipeline *pipeline = &hcamcorder->capture_pipeline;
+
+	/* in_flight is already counted by capture callback */
+	g_mutex_lock(&pipeline->lock);
+
+	/* wait for next stage if queue is full, it holds streaming thread for first stage */
+	while (!pipeline->exit && (int)g_queue_get_length(&pipeline->queue[stage]) >= pipeline->depth) {
+		_mmcam_dbg_warn("queue of stage %d is full, wait...", stage);
+		g_cond_wait(&pipeline->cond, &pipeline->lock);
+	}
+
+	g_queue_push_tail(&pipeline->queue[stage], job);
+	g_cond_broadcast(&pipeline->cond);
+
+	g_mutex_unlock(&pipeline->lock);
+}
+
+
+static gpointer __mmcamcorder_capture_pipeline_thread(gpointer data)
+{
+	int stage = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(data);
+	_MMCamcorderCapturePipeline *pipeline = NULL;
+	_MMCamcorderCaptureJob *job = NULL;
+	GThread *self = g_thread_self();
+
+	mmf_return_val_if_fail(hcamcorder, NULL);
+
+	pipeline = &hcamcorder->capture_pipeline;
+
+	g_mutex_lock(&pipeline->lock);
+
+	/* find stage of this thread */
+	while (stage < _MMCAMCORDER_CAPTURE_STAGE_NUM && pipeline->thread[stage] != self)
+		stage++;
+
+	_mmcam_dbg_log("capture stage %d thread start", stage);
+
+	while (stage < _MMCAMCORDER_CAPTURE_STAGE_NUM) {
+		job = g_queue_pop_head(&pipeline->queue[stage]);
+		if (!job) {
+			if (pipeline->exit)
+				break;
+
+			g_cond_wait(&pipeline->cond, &pipeline->lock);
+			continue;
+		}
+
+		/* notify that queue has space */
+		g_cond_broadcast(&pipeline->cond);
+
+		g_mutex_unlock(&pipeline->lock);
+
+		switch (stage) {
+		case _MMCAMCORDER_CAPTURE_STAGE_CONVERT:
+			__mmcamcorder_capture_stage_convert(hcamcorder, job);
+			break;
+		case _MMCAMCORDER_CAPTURE_STAGE_ENCODE:
+			__mmcamcorder_capture_stage_encode(hcamcorder, job);
+			break;
+		case _MMCAMCORDER_CAPTURE_STAGE_EXIF:
+			__mmcamcorder_capture_stage_exif(hcamcorder, job);
+			break;
+		default:
+			__mmcamcorder_capture_stage_deliver(hcamcorder, job);
+			break;
+		}
+
+		if (stage < _MMCAMCORDER_CAPTURE_STAGE_DELIVER) {
+			__mmcamcorder_capture_pipeline_push(hcamcorder, stage + 1, job);
+			g_mutex_lock(&pipeline->lock);
+		} else {
+			g_mutex_lock(&pipeline->lock);
+			pipeline->in_flight--;
+			g_cond_broadcast(&pipeline->cond);
+		}
+	}
+
+	g_mutex_unlock(&pipeline->lock);
+
+	_mmcam_dbg_log("capture stage %d thread exit", stage);
+
+	return NULL;
+}
+
+
+static void __mmcamcorder_capture_pipeline_join(_MMCamcorderCapturePipeline *pipeline)
+{
+	int i = 0;
+
+	g_mutex_lock(&pipeline->lock);
+	pipeline->exit = TRUE;
+	g_cond_broadcast(&pipeline->cond);
+	g_mutex_unlock(&pipeline->lock);
+
+	for (i = 0 ; i < _MMCAMCORDER_CAPTURE_STAGE_NUM ; i++) {
+		if (pipeline->thread[i]) {
+			g_thread_join(pipeline->thread[i]);
+			pipeline->thread[i] = NULL;
+		}
+	}
+
+	pipeline->depth = 0;
+	pipeline->exit = FALSE;
+}
+
+
+int _mmcamcorder_capture_pipeline_create(MMHandleType handle)
+{
+	int depth = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	/* 0 : process captured image in streaming thread */
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_CAPTURE,
+		"PostProcessQueueDepth",
+		&depth);
+
+	return _mmcamcorder_capture_pipeline_start(handle, depth);
+}
+
+
+int _mmcamcorder_capture_pipeline_start(MMHandleType handle, int depth)
+{
+	int i = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderCapturePipeline *pipeline = NULL;
+	static const char *thread_name[_MMCAMCORDER_CAPTURE_STAGE_NUM] = {
+		"MMCAM_CAP_CONVERT", "MMCAM_CAP_ENCODE", "MMCAM_CAP_EXIF", "MMCAM_CAP_DELIVER"
+	};
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	pipeline = &hcamcorder->capture_pipeline;
+
+	depth = CLAMP(depth, 0, _MMCAMCORDER_CAPTURE_QUEUE_DEPTH_MAX);
+
+	_mmcam_dbg_log("capture post-processing queue depth %d", depth);
+
+	if (depth == 0)
+		return MM_ERROR_NONE;
+
+	if (pipeline->depth > 0) {
+		_mmcam_dbg_err("capture pipeline is already started");
+		return MM_ERROR_CAMCORDER_INVALID_STATE;
+	}
+
+	/* lock until all threads are created, thread finds its stage with thread handle */
+	g_mutex_lock(&pipeline->lock);
+
+	for (i = 0 ; i < _MMCAMCORDER_CAPTURE_STAGE_NUM ; i++) {
+		pipeline->thread[i] = g_thread_try_new(thread_name[i],
+			__mmcamcorder_capture_pipeline_thread, (gpointer)hcamcorder, NULL);
+		if (!pipeline->thread[i]) {
+			_mmcam_dbg_err("failed to create capture stage %d thread", i);
+			g_mutex_unlock(&pipeline->lock);
+			__mmcamcorder_capture_pipeline_join(pipeline);
+			return MM_ERROR_CAMCORDER_RESOURCE_CREATION;
+		}
+	}
+
+	pipeline->depth = depth;
+
+	g_mutex_unlock(&pipeline->lock);
+
+	return MM_ERROR_NONE;
+}
+
+
+void _mmcamcorder_capture_pipeline_flush(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderCapturePipeline *pipeline = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	pipeline = &hcamcorder->capture_pipeline;
+	if (pipeline->depth == 0)
+		return;
+
+	g_mutex_lock(&pipeline->lock);
+
+	/* counted, flush can be called in several threads at the same time */
+	g_atomic_int_inc(&pipeline->flushing);
+
+	while (pipeline->in_flight > 0) {
+		_mmcam_dbg_warn("wait for %d captured image", pipeline->in_flight);
+		g_cond_wait(&pipeline->cond, &pipeline->lock);
+	}
+
+	g_atomic_int_dec_and_test(&pipeline->flushing);
+
+	g_mutex_unlock(&pipeline->lock);
+}
+
+
+void _mmcamcorder_capture_pipeline_destroy(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	if (hcamcorder->capture_pipeline.depth == 0)
+		return;
+
+	/* remained captured images are delivered before threads exit */
+	_mmcamcorder_capture_pipeline_flush(handle);
+
+	__mmcamcorder_capture_pipeline_join(&hcamcorder->capture_pipeline);
+}
+
+
 gboolean __mmcamcorder_handoff_callback(GstElement *fakesink, GstBuffer *buffer, GstPad *pad, gpointer u_data)
 {
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
@@ -1772,6 +2151,30 @@ gboolean __mmcamcorder_handoff_callback(GstElement *fakesink, GstBuffer *buffer,
 }
 
 
+static int __mmcamcorder_exif_set_entry(MMHandleType handle, ExifData *ed, ExifIfd ifd, ExifTag tag,
+	ExifFormat format, unsigned long components, const char *data)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	if (hcamcorder == NULL)
+		return mm_exif_set_add_entry(ed, ifd, tag, format, components, data);
+
+	return mm_exif_template_set_entry(&hcamcorder->exif_template, ed, ifd, tag, format, components, data);
+}
+
+
+static ExifByteOrder __mmcamcorder_exif_byte_order(MMHandleType handle, ExifData *ed)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	if (ed)
+		return exif_data_get_byte_order(ed);
+
+	/* patching EXIF template */
+	return hcamcorder->exif_template.order;
+}
+
+
 static ExifData *__mmcamcorder_update_exif_orientation(MMHandleType handle, ExifData *ed)
 {
 	int value = 0;
@@ -1783,8 +2186,8 @@ static ExifData *__mmcamcorder_update_exif_orientation(MMHandleType handle, Exif
 	if (value == 0)
 		value = MM_EXIF_ORIENTATION;
 
-	exif_set_short((unsigned char *)&eshort, exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_ORIENTATION,
+	exif_set_short((unsigned char *)&eshort, __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_ORIENTATION,
 		EXIF_FORMAT_SHORT, 1, (const char *)&eshort);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_MAKER_NOTE);
@@ -1801,7 +2204,7 @@ static ExifData *__mmcamcorder_update_exif_make(MMHandleType handle, ExifData *e
 
 	if (make) {
 		_mmcam_dbg_log("maker [%s]", make);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_MAKE,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_MAKE,
 			EXIF_FORMAT_ASCII, strlen(make)+1, (const char *)make);
 		free(make);
 		if (ret != MM_ERROR_NONE)
@@ -1820,13 +2223,14 @@ static ExifData *__mmcamcorder_update_exif_software(MMHandleType handle, ExifDat
 	int ret = MM_ERROR_NONE;
 	mmf_camcorder_t *hcamcorder = (mmf_camcorder_t *)handle;
 
-	if (hcamcorder == NULL || ed == NULL) {
-		_mmcam_dbg_err("NULL parameter %p,%p", hcamcorder, ed);
+	/* ed is NULL while patching EXIF template */
+	if (hcamcorder == NULL) {
+		_mmcam_dbg_err("NULL handle");
 		return NULL;
 	}
 
 	if (hcamcorder->software_version) {
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_SOFTWARE, EXIF_FORMAT_ASCII,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_SOFTWARE, EXIF_FORMAT_ASCII,
 			strlen(hcamcorder->software_version)+1, (const char *)hcamcorder->software_version);
 
 		_mmcam_dbg_log("set software_version[%s] ret[0x%x]",
@@ -1844,13 +2248,14 @@ static ExifData *__mmcamcorder_update_exif_model(MMHandleType handle, ExifData *
 	int ret = MM_ERROR_NONE;
 	mmf_camcorder_t *hcamcorder = (mmf_camcorder_t *)handle;
 
-	if (hcamcorder == NULL || ed == NULL) {
-		_mmcam_dbg_err("NULL parameter %p,%p", hcamcorder, ed);
+	/* ed is NULL while patching EXIF template */
+	if (hcamcorder == NULL) {
+		_mmcam_dbg_err("NULL handle");
 		return NULL;
 	}
 
 	if (hcamcorder->model_name) {
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_MODEL, EXIF_FORMAT_ASCII,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_MODEL, EXIF_FORMAT_ASCII,
 			strlen(hcamcorder->model_name)+1, (const char *)hcamcorder->model_name);
 
 		_mmcam_dbg_err("set model name[%s] ret[0x%x]",
@@ -1877,7 +2282,7 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 
 		_mmcam_dbg_log("Tag for GPS is ENABLED.");
 
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_VERSION_ID,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_VERSION_ID,
 			EXIF_FORMAT_BYTE, 4, (const char *)&GpsVersion);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_GPS_VERSION_ID);
@@ -1901,14 +2306,14 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 			ExifRational rData;
 
 			if (latitude < 0) {
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LATITUDE_REF,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LATITUDE_REF,
 					EXIF_FORMAT_ASCII, 2, "S");
 				if (ret != MM_ERROR_NONE)
 					EXIF_SET_ERR(ret, EXIF_TAG_GPS_LATITUDE_REF);
 
 				latitude = -latitude;
 			} else if (latitude > 0) {
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LATITUDE_REF,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LATITUDE_REF,
 					EXIF_FORMAT_ASCII, 2, "N");
 				if (ret != MM_ERROR_NONE)
 					EXIF_SET_ERR(ret, EXIF_TAG_GPS_LATITUDE_REF);
@@ -1923,13 +2328,13 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 			if (b) {
 				rData.numerator = deg;
 				rData.denominator = 1;
-				exif_set_rational(b, exif_data_get_byte_order(ed), rData);
+				exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
 				rData.numerator = min;
-				exif_set_rational(b + 8, exif_data_get_byte_order(ed), rData);
+				exif_set_rational(b + 8, __mmcamcorder_exif_byte_order(handle, ed), rData);
 				rData.numerator = sec;
-				exif_set_rational(b + 16, exif_data_get_byte_order(ed), rData);
+				exif_set_rational(b + 16, __mmcamcorder_exif_byte_order(handle, ed), rData);
 
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LATITUDE,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LATITUDE,
 					EXIF_FORMAT_RATIONAL, 3, (const char *)b);
 				free(b);
 				if (ret != MM_ERROR_NONE)
@@ -1948,14 +2353,14 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 			ExifRational rData;
 
 			if (longitude < 0) {
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LONGITUDE_REF,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LONGITUDE_REF,
 					EXIF_FORMAT_ASCII, 2, "W");
 				if (ret != MM_ERROR_NONE)
 					EXIF_SET_ERR(ret, EXIF_TAG_GPS_LONGITUDE_REF);
 
 				longitude = -longitude;
 			} else if (longitude > 0) {
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LONGITUDE_REF,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LONGITUDE_REF,
 					EXIF_FORMAT_ASCII, 2, "E");
 				if (ret != MM_ERROR_NONE)
 					EXIF_SET_ERR(ret, EXIF_TAG_GPS_LONGITUDE_REF);
@@ -1970,12 +2375,12 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 			if (b) {
 				rData.numerator = deg;
 				rData.denominator = 1;
-				exif_set_rational(b, exif_data_get_byte_order(ed), rData);
+				exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
 				rData.numerator = min;
-				exif_set_rational(b+8, exif_data_get_byte_order(ed), rData);
+				exif_set_rational(b+8, __mmcamcorder_exif_byte_order(handle, ed), rData);
 				rData.numerator = sec;
-				exif_set_rational(b+16, exif_data_get_byte_order(ed), rData);
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LONGITUDE,
+				exif_set_rational(b+16, __mmcamcorder_exif_byte_order(handle, ed), rData);
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_LONGITUDE,
 					EXIF_FORMAT_RATIONAL, 3, (const char *)b);
 				free(b);
 				if (ret != MM_ERROR_NONE)
@@ -1997,7 +2402,7 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 					altitude = -altitude;
 				}
 
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_ALTITUDE_REF,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_ALTITUDE_REF,
 					EXIF_FORMAT_BYTE, 1, (const char *)&alt_ref);
 				if (ret != MM_ERROR_NONE) {
 					_mmcam_dbg_err("error [%x], tag [%x]", ret, EXIF_TAG_GPS_ALTITUDE_REF);
@@ -2010,8 +2415,8 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 
 				rData.numerator = (unsigned int)(altitude + 0.5)*100;
 				rData.denominator = 100;
-				exif_set_rational(b, exif_data_get_byte_order(ed), rData);
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_ALTITUDE,
+				exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_ALTITUDE,
 					EXIF_FORMAT_RATIONAL, 1, (const char *)b);
 				free(b);
 				if (ret != MM_ERROR_NONE)
@@ -2041,17 +2446,17 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 				if (b) {
 					rData.numerator = hour;
 					rData.denominator = 1;
-					exif_set_rational(b, exif_data_get_byte_order(ed), rData);
+					exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
 
 					rData.numerator = min;
 					rData.denominator = 1;
-					exif_set_rational(b + 8, exif_data_get_byte_order(ed), rData);
+					exif_set_rational(b + 8, __mmcamcorder_exif_byte_order(handle, ed), rData);
 
 					rData.numerator = microsec;
 					rData.denominator = 1000000;
-					exif_set_rational(b + 16, exif_data_get_byte_order(ed), rData);
+					exif_set_rational(b + 16, __mmcamcorder_exif_byte_order(handle, ed), rData);
 
-					ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_TIME_STAMP,
+					ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_TIME_STAMP,
 						EXIF_FORMAT_RATIONAL, 3, (const char *)b);
 					free(b);
 					if (ret != MM_ERROR_NONE)
@@ -2072,7 +2477,7 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 				_mmcam_dbg_log("Date stamp [%s]", date_stamp);
 
 				/* cause it should include NULL char */
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_DATE_STAMP,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_DATE_STAMP,
 					EXIF_FORMAT_ASCII, date_stamp_len + 1, (const char *)date_stamp);
 				if (ret != MM_ERROR_NONE)
 					EXIF_SET_ERR(ret, EXIF_TAG_GPS_DATE_STAMP);
@@ -2088,7 +2493,7 @@ static ExifData *__mmcamcorder_update_exif_gps(MMHandleType handle, ExifData *ed
 			if (processing_method) {
 				_mmcam_dbg_log("Processing method [%s]", processing_method);
 
-				ret = mm_exif_set_add_entry(ed, EXIF_IFD_GPS, EXIF_TAG_GPS_PROCESSING_METHOD,
+				ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_GPS, EXIF_TAG_GPS_PROCESSING_METHOD,
 					EXIF_FORMAT_UNDEFINED, processing_method_len, (const char *)processing_method);
 				if (ret != MM_ERROR_NONE)
 					EXIF_SET_ERR(ret, EXIF_TAG_GPS_PROCESSING_METHOD);
@@ -2137,7 +2542,7 @@ int __mmcamcorder_update_exif_info(MMHandleType handle, void* imagedata, int img
 	return ret;
 }
 
-int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int image_height)
+static int __mmcamcorder_make_exif_basic_info(MMHandleType handle, int image_width, int image_height, gboolean patch)
 {
 	int ret = MM_ERROR_NONE;
 	int value;
@@ -2175,11 +2580,13 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		gst_camera_control_get_exif_info(control, &avsys_exif_info);
 	}
 
-	/* get ExifData from exif info */
-	ed = mm_exif_get_exif_from_info(hcamcorder->exif_info);
-	if (ed == NULL) {
-		_mmcam_dbg_err("get exif data error!!");
-		return MM_ERROR_INVALID_HANDLE;
+	/* get ExifData from exif info, values are patched in EXIF template directly without ExifData */
+	if (!patch) {
+		ed = mm_exif_get_exif_from_info(hcamcorder->exif_info);
+		if (ed == NULL) {
+			_mmcam_dbg_err("get exif data error!!");
+			return MM_ERROR_INVALID_HANDLE;
+		}
 	}
 
 	/* Receive attribute info */
@@ -2188,7 +2595,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 
 	/*0. EXIF_TAG_EXIF_VERSION */
 	ExifVersion = MM_EXIF_VERSION;
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_EXIF_VERSION,
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_EXIF_VERSION,
 		EXIF_FORMAT_UNDEFINED, 4, (const char *)&ExifVersion);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_EXIF_VERSION);
@@ -2196,13 +2603,13 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*1. EXIF_TAG_IMAGE_WIDTH */ /*EXIF_TAG_PIXEL_X_DIMENSION*/
 	value = image_width;
 
-	exif_set_long((unsigned char *)&elong[cntl], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_IMAGE_WIDTH,
+	exif_set_long((unsigned char *)&elong[cntl], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_IMAGE_WIDTH,
 		EXIF_FORMAT_LONG, 1, (const char *)&elong[cntl]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_IMAGE_WIDTH);
 
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_PIXEL_X_DIMENSION,
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_PIXEL_X_DIMENSION,
 		EXIF_FORMAT_LONG, 1, (const char *)&elong[cntl++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_PIXEL_X_DIMENSION);
@@ -2212,13 +2619,13 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*2. EXIF_TAG_IMAGE_LENGTH*/ /*EXIF_TAG_PIXEL_Y_DIMENSION*/
 	value = image_height;
 
-	exif_set_long((unsigned char *)&elong[cntl], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_IMAGE_LENGTH,
+	exif_set_long((unsigned char *)&elong[cntl], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_IMAGE_LENGTH,
 		EXIF_FORMAT_LONG, 1, (const char *)&elong[cntl]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_IMAGE_LENGTH);
 
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_PIXEL_Y_DIMENSION,
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_PIXEL_Y_DIMENSION,
 		EXIF_FORMAT_LONG, 1, (const char *)&elong[cntl++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_PIXEL_Y_DIMENSION);
@@ -2243,7 +2650,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
 			tm.tm_hour, tm.tm_min, tm.tm_sec);
 
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_DATE_TIME, EXIF_FORMAT_ASCII, 20, (const char *)b);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_DATE_TIME, EXIF_FORMAT_ASCII, 20, (const char *)b);
 		if (ret != MM_ERROR_NONE) {
 			if (ret == (int)MM_ERROR_CAMCORDER_LOW_MEMORY)
 				g_free(b);
@@ -2251,7 +2658,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			EXIF_SET_ERR(ret, EXIF_TAG_DATE_TIME);
 		}
 
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_DATE_TIME_ORIGINAL, EXIF_FORMAT_ASCII, 20, (const char *)b);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_DATE_TIME_ORIGINAL, EXIF_FORMAT_ASCII, 20, (const char *)b);
 		if (ret != MM_ERROR_NONE) {
 			if (ret == (int)MM_ERROR_CAMCORDER_LOW_MEMORY)
 				g_free(b);
@@ -2259,7 +2666,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			EXIF_SET_ERR(ret, EXIF_TAG_DATE_TIME_ORIGINAL);
 		}
 
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_DATE_TIME_DIGITIZED, EXIF_FORMAT_ASCII, 20, (const char *)b);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_DATE_TIME_DIGITIZED, EXIF_FORMAT_ASCII, 20, (const char *)b);
 		if (ret != MM_ERROR_NONE) {
 			if (ret == (int)MM_ERROR_CAMCORDER_LOW_MEMORY)
 				g_free(b);
@@ -2287,7 +2694,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		_mmcam_dbg_log("desctiption [%s]", str_value);
 
 		if (description) {
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_IMAGE_DESCRIPTION,
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_IMAGE_DESCRIPTION,
 				EXIF_FORMAT_ASCII, strlen(description), (const char *)description);
 			free(description);
 			str_value = NULL;
@@ -2311,7 +2718,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 
 		len = snprintf(software, sizeof(software), "%x.%x ", avsys_exif_info.software_used>>8, (avsys_exif_info.software_used & 0xff));
 		_mmcam_dbg_log("software [%s], len [%d]", software, len);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_0, EXIF_TAG_SOFTWARE,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_0, EXIF_TAG_SOFTWARE,
 			EXIF_FORMAT_ASCII, len, (const char *)software);
 		if (ret != MM_ERROR_NONE) {
 			EXIF_SET_ERR(ret, EXIF_TAG_SOFTWARE);
@@ -2328,7 +2735,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	user_comment = strdup(MM_USER_COMMENT);
 	if (user_comment) {
 		_mmcam_dbg_log("user_comment=%s", user_comment);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_USER_COMMENT,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_USER_COMMENT,
 			EXIF_FORMAT_ASCII, strlen(user_comment), (const char *)user_comment);
 		free(user_comment);
 		if (ret != MM_ERROR_NONE)
@@ -2340,8 +2747,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 
 	/*9. EXIF_TAG_COLOR_SPACE */
 	if (control != NULL) {
-		exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), avsys_exif_info.colorspace);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_COLOR_SPACE,
+		exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), avsys_exif_info.colorspace);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_COLOR_SPACE,
 			EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_COLOR_SPACE);
@@ -2351,7 +2758,7 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	if (control != NULL) {
 		config = avsys_exif_info.component_configuration;
 		_mmcam_dbg_log("EXIF_TAG_COMPONENTS_CONFIGURATION [%4x] ", config);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_COMPONENTS_CONFIGURATION,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_COMPONENTS_CONFIGURATION,
 			EXIF_FORMAT_UNDEFINED, 4, (const char *)&config);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_COMPONENTS_CONFIGURATION);
@@ -2376,8 +2783,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			rData.numerator = avsys_exif_info.exposure_time_numerator;
 			rData.denominator = avsys_exif_info.exposure_time_denominator;
 
-			exif_set_rational(b, exif_data_get_byte_order(ed), rData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_TIME,
+			exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_TIME,
 				EXIF_FORMAT_RATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2402,8 +2809,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		if (b) {
 			rData.numerator = avsys_exif_info.aperture_f_num_numerator;
 			rData.denominator = avsys_exif_info.aperture_f_num_denominator;
-			exif_set_rational(b, exif_data_get_byte_order(ed), rData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_FNUMBER,
+			exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_FNUMBER,
 				EXIF_FORMAT_RATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2419,8 +2826,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*16. EXIF_TAG_EXPOSURE_PROGRAM*/
 	/*FIXME*/
 	value = MM_EXPOSURE_PROGRAM;
-	exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_PROGRAM,
+	exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_PROGRAM,
 		EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_EXPOSURE_PROGRAM);
@@ -2428,8 +2835,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*17. EXIF_TAG_ISO_SPEED_RATINGS*/
 	if (avsys_exif_info.iso) {
 		_mmcam_dbg_log("EXIF_TAG_ISO_SPEED_RATINGS [%d]", avsys_exif_info.iso);
-		exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), avsys_exif_info.iso);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_ISO_SPEED_RATINGS,
+		exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), avsys_exif_info.iso);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_ISO_SPEED_RATINGS,
 			EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_ISO_SPEED_RATINGS);
@@ -2447,8 +2854,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		if (b) {
 			rsData.numerator = avsys_exif_info.shutter_speed_numerator;
 			rsData.denominator = avsys_exif_info.shutter_speed_denominator;
-			exif_set_srational(b, exif_data_get_byte_order(ed), rsData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SHUTTER_SPEED_VALUE,
+			exif_set_srational(b, __mmcamcorder_exif_byte_order(handle, ed), rsData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SHUTTER_SPEED_VALUE,
 				EXIF_FORMAT_SRATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2472,8 +2879,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		if (b) {
 			rData.numerator = avsys_exif_info.aperture_in_APEX;
 			rData.denominator = 1;
-			exif_set_rational(b, exif_data_get_byte_order(ed), rData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_APERTURE_VALUE,
+			exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_APERTURE_VALUE,
 				EXIF_FORMAT_RATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2497,8 +2904,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		if (b) {
 			rsData.numerator = avsys_exif_info.brigtness_numerator;
 			rsData.denominator = avsys_exif_info.brightness_denominator;
-			exif_set_srational(b, exif_data_get_byte_order(ed), rsData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_BRIGHTNESS_VALUE,
+			exif_set_srational(b, __mmcamcorder_exif_byte_order(handle, ed), rsData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_BRIGHTNESS_VALUE,
 				EXIF_FORMAT_SRATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2530,8 +2937,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 				_mmcam_dbg_warn("brightness_step_denominator is ZERO, so set 1");
 				rsData.denominator = 1;
 			}
-			exif_set_srational(b, exif_data_get_byte_order(ed), rsData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_BIAS_VALUE,
+			exif_set_srational(b, __mmcamcorder_exif_byte_order(handle, ed), rsData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_BIAS_VALUE,
 				EXIF_FORMAT_SRATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2555,8 +2962,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		if (b) {
 			rData.numerator = avsys_exif_info.max_lens_aperture_in_APEX;
 			rData.denominator = 1;
-			exif_set_rational(b, exif_data_get_byte_order(ed), rData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_MAX_APERTURE_VALUE,
+			exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_MAX_APERTURE_VALUE,
 				EXIF_FORMAT_RATIONAL, 1, b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2572,9 +2979,9 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 
 	/*24. EXIF_TAG_METERING_MODE */
 	if (control != NULL) {
-		exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), avsys_exif_info.metering_mode);
+		exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), avsys_exif_info.metering_mode);
 		_mmcam_dbg_log("EXIF_TAG_METERING_MODE [%d]", avsys_exif_info.metering_mode);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_METERING_MODE,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_METERING_MODE,
 			EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_METERING_MODE);
@@ -2584,9 +2991,9 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 
 	/*26. EXIF_TAG_FLASH*/
 	if (control != NULL) {
-		exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), avsys_exif_info.flash);
+		exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), avsys_exif_info.flash);
 		_mmcam_dbg_log("EXIF_TAG_FLASH [%d]", avsys_exif_info.flash);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_FLASH,
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_FLASH,
 			EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_FLASH);
@@ -2604,8 +3011,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		if (b) {
 			rData.numerator = avsys_exif_info.focal_len_numerator;
 			rData.denominator = avsys_exif_info.focal_len_denominator;
-			exif_set_rational(b, exif_data_get_byte_order(ed), rData);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_FOCAL_LENGTH,
+			exif_set_rational(b, __mmcamcorder_exif_byte_order(handle, ed), rData);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_FOCAL_LENGTH,
 				EXIF_FORMAT_RATIONAL, 1, (const char *)b);
 			free(b);
 			if (ret != MM_ERROR_NONE)
@@ -2621,8 +3028,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*28. EXIF_TAG_SENSING_METHOD*/
 	/*FIXME*/
 	value = MM_SENSING_MODE;
-	exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SENSING_METHOD,
+	exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SENSING_METHOD,
 		EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_SENSING_METHOD);
@@ -2630,8 +3037,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*29. EXIF_TAG_FILE_SOURCE*/
 /*
 	value = MM_FILE_SOURCE;
-	exif_set_long(&elong[cntl], exif_data_get_byte_order(ed),value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_FILE_SOURCE,
+	exif_set_long(&elong[cntl], __mmcamcorder_exif_byte_order(handle, ed),value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_FILE_SOURCE,
 		EXIF_FORMAT_UNDEFINED, 4, (const char *)&elong[cntl++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_FILE_SOURCE);
@@ -2640,8 +3047,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*30. EXIF_TAG_SCENE_TYPE*/
 /*
 	value = MM_SCENE_TYPE;
-	exif_set_long(&elong[cntl], exif_data_get_byte_order(ed),value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SCENE_TYPE,
+	exif_set_long(&elong[cntl], __mmcamcorder_exif_byte_order(handle, ed),value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SCENE_TYPE,
 		EXIF_FORMAT_UNDEFINED, 4, (const char *)&elong[cntl++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_SCENE_TYPE);
@@ -2650,8 +3057,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*31. EXIF_TAG_EXPOSURE_MODE*/
 	/*FIXME*/
 	value = MM_EXPOSURE_MODE;
-	exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_MODE,
+	exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_EXPOSURE_MODE,
 		EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_EXPOSURE_MODE);
@@ -2667,8 +3074,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 		else
 			set_value = 1;
 
-		exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), set_value);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_WHITE_BALANCE,
+		exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), set_value);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_WHITE_BALANCE,
 			EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_WHITE_BALANCE);
@@ -2682,8 +3089,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	if (ret == MM_ERROR_NONE) {
 		_mmcam_dbg_log("DIGITAL ZOOM [%d]", value);
 
-		exif_set_long(&elong[cntl], exif_data_get_byte_order(ed), value);
-		ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_DIGITAL_ZOOM_RATIO,
+		exif_set_long(&elong[cntl], __mmcamcorder_exif_byte_order(handle, ed), value);
+		ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_DIGITAL_ZOOM_RATIO,
 			EXIF_FORMAT_LONG, 1, (const char *)&elong[cntl++]);
 		if (ret != MM_ERROR_NONE)
 			EXIF_SET_ERR(ret, EXIF_TAG_DIGITAL_ZOOM_RATIO);
@@ -2696,8 +3103,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*FIXME*/
 /*
 	value = MM_FOCAL_LENGTH_35MMFILM;
-	exif_set_short(&eshort[cnts], exif_data_get_byte_order(ed),value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_FOCAL_LENGTH_IN_35MM_FILM,
+	exif_set_short(&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed),value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_FOCAL_LENGTH_IN_35MM_FILM,
 		EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_FOCAL_LENGTH_IN_35MM_FILM);
@@ -2729,8 +3136,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 				break;
 			}
 
-			exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), scene_capture_type);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SCENE_CAPTURE_TYPE,
+			exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), scene_capture_type);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SCENE_CAPTURE_TYPE,
 				EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 			if (ret != MM_ERROR_NONE)
 				EXIF_SET_ERR(ret, EXIF_TAG_SCENE_CAPTURE_TYPE);
@@ -2743,8 +3150,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*FIXME*/
 /*
 	value = MM_GAIN_CONTROL;
-	exif_set_long(&elong[cntl], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_GAIN_CONTROL,
+	exif_set_long(&elong[cntl], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_GAIN_CONTROL,
 		EXIF_FORMAT_LONG, 1, (const char *)&elong[cntl++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_GAIN_CONTROL);
@@ -2772,8 +3179,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			else
 				level = MM_VALUE_HARD;
 
-			exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), level);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_CONTRAST,
+			exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), level);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_CONTRAST,
 				EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 			if (ret != MM_ERROR_NONE)
 				EXIF_SET_ERR(ret, EXIF_TAG_CONTRAST);
@@ -2803,8 +3210,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			else
 				level = MM_VALUE_HARD;
 
-			exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), level);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SATURATION,
+			exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), level);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SATURATION,
 				EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 			if (ret != MM_ERROR_NONE)
 				EXIF_SET_ERR(ret, EXIF_TAG_SATURATION);
@@ -2834,8 +3241,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 			else
 				level = MM_VALUE_HARD;
 
-			exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), level);
-			ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SHARPNESS,
+			exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), level);
+			ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SHARPNESS,
 				EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 			if (ret != MM_ERROR_NONE)
 				EXIF_SET_ERR(ret, EXIF_TAG_SHARPNESS);
@@ -2848,8 +3255,8 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 	/*FIXME*/
 	value = MM_SUBJECT_DISTANCE_RANGE;
 	_mmcam_dbg_log("DISTANCE_RANGE [%d]", value);
-	exif_set_short((unsigned char *)&eshort[cnts], exif_data_get_byte_order(ed), value);
-	ret = mm_exif_set_add_entry(ed, EXIF_IFD_EXIF, EXIF_TAG_SUBJECT_DISTANCE_RANGE,
+	exif_set_short((unsigned char *)&eshort[cnts], __mmcamcorder_exif_byte_order(handle, ed), value);
+	ret = __mmcamcorder_exif_set_entry(handle, ed, EXIF_IFD_EXIF, EXIF_TAG_SUBJECT_DISTANCE_RANGE,
 		EXIF_FORMAT_SHORT, 1, (const char *)&eshort[cnts++]);
 	if (ret != MM_ERROR_NONE)
 		EXIF_SET_ERR(ret, EXIF_TAG_SUBJECT_DISTANCE_RANGE);
@@ -2859,9 +3266,11 @@ int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int
 
 	_mmcam_dbg_log("");
 
-	ret = mm_exif_set_exif_to_info(hcamcorder->exif_info, ed);
-	if (ret != MM_ERROR_NONE)
-		_mmcam_dbg_err("mm_exif_set_exif_to_info err!! [%x]", ret);
+	if (!patch) {
+		ret = mm_exif_set_exif_to_info(hcamcorder->exif_info, ed);
+		if (ret != MM_ERROR_NONE)
+			_mmcam_dbg_err("mm_exif_set_exif_to_info err!! [%x]", ret);
+	}
 
 exit:
 	_mmcam_dbg_log("finished!! [%x]", ret);
@@ -2873,6 +3282,39 @@ exit:
 }
 
 
+int __mmcamcorder_set_exif_basic_info(MMHandleType handle, int image_width, int image_height)
+{
+	int ret = MM_ERROR_NONE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(hcamcorder->exif_info, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	/* patch values in EXIF of previous capture if same entries are set */
+	if (mm_exif_template_patch_begin(&hcamcorder->exif_template) == MM_ERROR_NONE) {
+		__mmcamcorder_make_exif_basic_info(handle, image_width, image_height, TRUE);
+
+		if (mm_exif_template_patch_end(&hcamcorder->exif_template, hcamcorder->exif_info) == MM_ERROR_NONE) {
+			_mmcam_dbg_log("EXIF template patched");
+			return MM_ERROR_NONE;
+		}
+
+		_mmcam_dbg_log("EXIF entries are changed, make new EXIF");
+	}
+
+	/* make EXIF and keep it as template for next capture */
+	mm_exif_template_record_begin(&hcamcorder->exif_template);
+
+	ret = __mmcamcorder_make_exif_basic_info(handle, image_width, image_height, FALSE);
+	if (ret == MM_ERROR_NONE)
+		mm_exif_template_record_end(&hcamcorder->exif_template, hcamcorder->exif_info);
+	else
+		mm_exif_template_clear(&hcamcorder->exif_template);
+
+	return ret;
+}
+
+
 static void __sound_status_changed_cb(keynode_t* node, void *data)
 {
 	mmf_camcorder_t *hcamcorder = (mmf_camcorder_t *)data;
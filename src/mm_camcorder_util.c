@@ -29,8 +29,16 @@
 #include <sys/vfs.h> /* struct statfs */
 #include <sys/time.h> /* gettimeofday */
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <gst/video/video-info.h>
+#include <gst/video/gstvideometa.h>
 #include <gio/gio.h>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* __ARM_NEON || __SSE2__ */
 
 #include "mm_camcorder_internal.h"
 #include "mm_camcorder_util.h"
@@ -79,9 +87,9 @@ static inline gboolean   write_tag(FILE *f, const gchar *tag);
 static inline gboolean   write_to_32(FILE *f, guint val);
 static inline gboolean   write_to_16(FILE *f, guint val);
 static inline gboolean   write_to_24(FILE *f, guint val);
-static gboolean _mmcamcorder_convert_YUYV_to_I420(unsigned char *src, guint width, guint height, unsigned char **dst, unsigned int *dst_len);
-static gboolean _mmcamcorder_convert_UYVY_to_I420(unsigned char *src, guint width, guint height, unsigned char **dst, unsigned int *dst_len);
-static gboolean _mmcamcorder_convert_NV12_to_I420(unsigned char *src, guint width, guint height, unsigned char **dst, unsigned int *dst_len);
+static gboolean _mmcamcorder_convert_YUYV_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height, guint src_stride, unsigned char *dst);
+static gboolean _mmcamcorder_convert_UYVY_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height, guint src_stride, unsigned char *dst);
+static gboolean _mmcamcorder_convert_NV12_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height, guint src_stride, unsigned char *dst);
 
 
 /*===========================================================================================
@@ -685,6 +693,494 @@ gboolean _mmcamcorder_update_composition_matrix(FILE *f, int orientation)
 }
 
 
+static gboolean __mmcamcorder_is_atom_type(const guchar *type)
+{
+	int i = 0;
+
+	for (i = 0 ; i < 4 ; i++) {
+		if (!g_ascii_isalnum(type[i]) && type[i] != ' ' && type[i] != 0xa9)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+
+static void __mmcamcorder_mux_index_trak(_MMCamcorderMuxIndex *index, gint64 trak_pos, const guchar *trak, guint32 trak_size)
+{
+	guint32 pos = 8;
+	guint32 child_size = 0;
+	guint32 matrix_offset = 0;
+
+	while (pos + 8 <= trak_size) {
+		child_size = GST_READ_UINT32_BE(trak + pos);
+		if (child_size < 8 || child_size > trak_size - pos)
+			return;
+
+		if (MMCAM_FOURCC(trak[pos + 4], trak[pos + 5], trak[pos + 6], trak[pos + 7]) == MMCAM_FOURCC('t', 'k', 'h', 'd')) {
+			/* 64 bit times and duration in version 1 */
+			matrix_offset = (child_size > 8 && trak[pos + 8] == 1) ? 52 : 40;
+			if (child_size >= 8 + matrix_offset + 36)
+				index->matrix_pos = trak_pos + pos + 8 + matrix_offset;
+			return;
+		}
+
+		pos += child_size;
+	}
+}
+
+
+static void __mmcamcorder_mux_index_moov(_MMCamcorderMuxIndex *index, const guchar *moov)
+{
+	guint32 pos = 8;
+	guint32 child_size = 0;
+	guint32 child_type = 0;
+
+	index->udta_pos = 0;
+	index->udta_size = 0;
+	index->free_pos = 0;
+	index->free_size = 0;
+	index->matrix_pos = 0;
+
+	while (pos + 8 <= index->moov_size) {
+		child_size = GST_READ_UINT32_BE(moov + pos);
+		if (child_size < 8 || child_size > index->moov_size - pos) {
+			_mmcam_dbg_warn("invalid atom size %u in moov", child_size);
+			return;
+		}
+
+		child_type = MMCAM_FOURCC(moov[pos + 4], moov[pos + 5], moov[pos + 6], moov[pos + 7]);
+
+		switch (child_type) {
+		case MMCAM_FOURCC('u', 'd', 't', 'a'):
+			if (!index->udta_pos) {
+				index->udta_pos = index->moov_pos + pos;
+				index->udta_size = child_size;
+			}
+			break;
+		case MMCAM_FOURCC('f', 'r', 'e', 'e'):
+		case MMCAM_FOURCC('s', 'k', 'i', 'p'):
+			if (child_size > index->free_size) {
+				index->free_pos = index->moov_pos + pos;
+				index->free_size = child_size;
+			}
+			break;
+		case MMCAM_FOURCC('t', 'r', 'a', 'k'):
+			if (!index->matrix_pos)
+				__mmcamcorder_mux_index_trak(index, index->moov_pos + pos, moov + pos, child_size);
+			break;
+		default:
+			break;
+		}
+
+		pos += child_size;
+	}
+
+	_mmcam_dbg_log("moov[%"G_GINT64_FORMAT":%u] udta[%"G_GINT64_FORMAT":%u] free[%"G_GINT64_FORMAT":%u] matrix[%"G_GINT64_FORMAT"]",
+		index->moov_pos, index->moov_size, index->udta_pos, index->udta_size,
+		index->free_pos, index->free_size, index->matrix_pos);
+}
+
+
+void _mmcamcorder_mux_index_reset(_MMCamcorderMuxIndex *index)
+{
+	mmf_return_if_fail(index);
+
+	memset(index, 0x0, sizeof(_MMCamcorderMuxIndex));
+}
+
+
+void _mmcamcorder_mux_index_add_data(_MMCamcorderMuxIndex *index, guint64 offset, const guchar *data, gsize size)
+{
+	int i = 0;
+	gsize pos = 0;
+	guint64 atom_size = 0;
+	guint32 header_size = 0;
+	gint64 end = 0;
+
+	mmf_return_if_fail(index && data);
+
+	end = (gint64)(offset + size);
+	if (end > index->file_size)
+		index->file_size = end;
+
+	/* header of recorded atom can be rewritten. ex) size of mdat at the end of recording */
+	if ((gint64)offset != index->next_pos) {
+		for (i = 0 ; i < index->atom_num ; i++) {
+			if (index->atom_pos[i] == (gint64)offset)
+				break;
+		}
+
+		if (i == index->atom_num)
+			return;
+
+		index->atom_num = i;
+		index->next_pos = (gint64)offset;
+
+		if (index->moov_pos >= index->next_pos) {
+			index->moov_pos = 0;
+			index->moov_size = 0;
+		}
+	}
+
+	while (index->next_pos >= (gint64)offset && index->next_pos < end) {
+		pos = (gsize)(index->next_pos - (gint64)offset);
+		if (size - pos < 8)
+			goto _INDEX_STOP;
+
+		atom_size = GST_READ_UINT32_BE(data + pos);
+		header_size = 8;
+
+		if (atom_size == 1) {
+			if (size - pos < 16)
+				goto _INDEX_STOP;
+
+			atom_size = GST_READ_UINT64_BE(data + pos + 8);
+			header_size = 16;
+		}
+
+		if (!__mmcamcorder_is_atom_type(data + pos + 4) ||
+			index->atom_num >= _MMCAMCORDER_MUX_INDEX_ATOM_MAX)
+			goto _INDEX_STOP;
+
+		index->atom_pos[index->atom_num++] = index->next_pos;
+
+		/* size 0 means that atom is extended to end of file, it will be updated later */
+		if (atom_size == 0) {
+			index->next_pos = -1;
+			return;
+		}
+
+		if (atom_size < header_size)
+			goto _INDEX_STOP;
+
+		if (MMCAM_FOURCC(data[pos + 4], data[pos + 5], data[pos + 6], data[pos + 7]) == MMCAM_FOURCC('m', 'o', 'o', 'v')) {
+			if (header_size == 8 && atom_size <= size - pos) {
+				index->moov_pos = index->next_pos;
+				index->moov_size = (guint32)atom_size;
+				__mmcamcorder_mux_index_moov(index, data + pos);
+			} else {
+				_mmcam_dbg_warn("moov is not in a buffer");
+			}
+		}
+
+		index->next_pos += (gint64)atom_size;
+	}
+
+	return;
+
+_INDEX_STOP:
+	_mmcam_dbg_warn("stop indexing at %"G_GINT64_FORMAT, index->next_pos);
+	index->next_pos = -1;
+}
+
+
+static gboolean __mmcamcorder_check_atom(int fd, gint64 pos, guint32 size, guint32 *fourcc)
+{
+	guchar header[8];
+
+	if (pread(fd, header, sizeof(header), (off_t)pos) != sizeof(header)) {
+		_mmcam_dbg_err("pread failed : errno %d", errno);
+		return FALSE;
+	}
+
+	if (GST_READ_UINT32_BE(header) != size) {
+		_mmcam_dbg_warn("size mismatch [%u] at %"G_GINT64_FORMAT, size, pos);
+		return FALSE;
+	}
+
+	*fourcc = MMCAM_FOURCC(header[4], header[5], header[6], header[7]);
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_pwrite_size(int fd, gint64 pos, guint32 size)
+{
+	guchar buf[4];
+
+	GST_WRITE_UINT32_BE(buf, size);
+
+	if (pwrite(fd, buf, sizeof(buf), (off_t)pos) != sizeof(buf)) {
+		_mmcam_dbg_err("pwrite failed : errno %d", errno);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+
+static int __mmcamcorder_write_metadata_with_index(int fd, _MMCamcorderMuxIndex *index,
+	int gps_enable, _MMCamcorderLocationInfo info, _MMCamcorderLocationInfo geotag, int orientation)
+{
+	int ret = MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+	FILE *f = NULL;
+	guchar data[_MMCAMCORDER_MUX_METADATA_MAX];
+	guchar matrix[36];
+	guint32 fourcc = 0;
+	guint32 length = 0;
+	guint32 remain = 0;
+	guint32 start = 0;
+	gint64 children_len = 0;
+	gint64 moov_end = 0;
+	gint64 write_pos = 0;
+	gboolean in_free = FALSE;
+
+	if (!index->moov_pos) {
+		_mmcam_dbg_log("no moov in index");
+		return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+	}
+
+	if (orientation >= 0 && !index->matrix_pos) {
+		_mmcam_dbg_log("no tkhd in index");
+		return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+	}
+
+	/* make loci and geodata after the space for udta header, free header can be added after them */
+	if (gps_enable) {
+		f = fmemopen(data + 8, sizeof(data) - 16, "w+");
+		if (!f) {
+			_mmcam_dbg_err("fmemopen failed : errno %d", errno);
+			return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+		}
+
+		if (!_mmcamcorder_write_loci(f, info) ||
+			!_mmcamcorder_write_geodata(f, geotag) ||
+			(children_len = ftello(f)) <= 0) {
+			_mmcam_dbg_err("failed to make location data");
+			fclose(f);
+			return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+		}
+
+		fclose(f);
+		f = NULL;
+	}
+
+	/* check that file is not changed after muxing */
+	if (!__mmcamcorder_check_atom(fd, index->moov_pos, index->moov_size, &fourcc) ||
+		fourcc != MMCAM_FOURCC('m', 'o', 'o', 'v'))
+		goto _WRITE_DONE;
+
+	if (index->udta_pos &&
+		(!__mmcamcorder_check_atom(fd, index->udta_pos, index->udta_size, &fourcc) ||
+		fourcc != MMCAM_FOURCC('u', 'd', 't', 'a')))
+		goto _WRITE_DONE;
+
+	if (index->free_pos &&
+		(!__mmcamcorder_check_atom(fd, index->free_pos, index->free_size, &fourcc) ||
+		(fourcc != MMCAM_FOURCC('f', 'r', 'e', 'e') && fourcc != MMCAM_FOURCC('s', 'k', 'i', 'p'))))
+		goto _WRITE_DONE;
+
+	if (children_len > 0) {
+		moov_end = index->moov_pos + index->moov_size;
+
+		/* append to udta or make new udta */
+		start = index->udta_pos ? 8 : 0;
+		length = (guint32)children_len + 8 - start;
+
+		if (index->free_pos &&
+			(!index->udta_pos || index->udta_pos + index->udta_size == index->free_pos) &&
+			(index->free_size == length || index->free_size >= length + 8)) {
+			/* reserved space by muxer */
+			in_free = TRUE;
+			write_pos = index->free_pos;
+			remain = index->free_size - length;
+		} else if (moov_end == index->file_size &&
+			(!index->udta_pos || index->udta_pos + index->udta_size == moov_end)) {
+			/* moov is the last atom */
+			write_pos = moov_end;
+		} else {
+			_mmcam_dbg_log("no space for metadata in index");
+			goto _WRITE_DONE;
+		}
+
+		if (!index->udta_pos) {
+			GST_WRITE_UINT32_BE(data, length);
+			memcpy(data + 4, "udta", 4);
+		}
+
+		if (remain > 0) {
+			GST_WRITE_UINT32_BE(data + start + length, remain);
+			memcpy(data + start + length + 4, "free", 4);
+		}
+
+		_mmcam_dbg_log("write metadata [%u] at %"G_GINT64_FORMAT" (%s)",
+			length, write_pos, in_free ? "reserved" : "end of moov");
+
+		ret = MM_ERROR_CAMCORDER_INTERNAL;
+
+		if (pwrite(fd, data + start, length + (remain > 0 ? 8 : 0), (off_t)write_pos) != (ssize_t)(length + (remain > 0 ? 8 : 0))) {
+			_mmcam_dbg_err("pwrite failed : errno %d", errno);
+			goto _WRITE_DONE;
+		}
+
+		if (index->udta_pos && !__mmcamcorder_pwrite_size(fd, index->udta_pos, index->udta_size + length))
+			goto _WRITE_DONE;
+
+		if (!in_free && !__mmcamcorder_pwrite_size(fd, index->moov_pos, index->moov_size + length))
+			goto _WRITE_DONE;
+	}
+
+	if (orientation >= 0) {
+		ret = MM_ERROR_CAMCORDER_INTERNAL;
+
+		f = fmemopen(matrix, sizeof(matrix), "w");
+		if (!f) {
+			_mmcam_dbg_err("fmemopen failed : errno %d", errno);
+			goto _WRITE_DONE;
+		}
+
+		_mmcamcorder_update_composition_matrix(f, orientation);
+		fclose(f);
+		f = NULL;
+
+		if (pwrite(fd, matrix, sizeof(matrix), (off_t)index->matrix_pos) != sizeof(matrix)) {
+			_mmcam_dbg_err("pwrite failed : errno %d", errno);
+			goto _WRITE_DONE;
+		}
+	}
+
+	ret = MM_ERROR_NONE;
+
+_WRITE_DONE:
+	return ret;
+}
+
+
+static gboolean __mmcamcorder_atom_window_map(_MMCamcorderAtomWindow *window, gint64 pos, gsize size)
+{
+	gint64 map_pos = 0;
+	gsize map_size = 0;
+
+	if (window->data && pos >= window->pos && pos + (gint64)size <= window->pos + (gint64)window->size)
+		return TRUE;
+
+	if (pos < 0 || pos + (gint64)size > window->file_size)
+		return FALSE;
+
+	if (window->data) {
+		munmap(window->data, window->size);
+		window->data = NULL;
+	}
+
+	map_pos = pos - (pos % window->page_size);
+	map_size = MAX(size + (gsize)(pos - map_pos), _MMCAMCORDER_ATOM_WINDOW_SIZE);
+	if (map_pos + (gint64)map_size > window->file_size)
+		map_size = (gsize)(window->file_size - map_pos);
+
+	window->data = mmap(NULL, map_size, PROT_READ, MAP_SHARED, window->fd, (off_t)map_pos);
+	if (window->data == MAP_FAILED) {
+		_mmcam_dbg_err("mmap failed [%"G_GINT64_FORMAT":%zu] : errno %d", map_pos, map_size, errno);
+		window->data = NULL;
+		return FALSE;
+	}
+
+	/* only a few pages are touched, read-around of fault is not needed */
+	madvise(window->data, map_size, MADV_RANDOM);
+
+	window->pos = map_pos;
+	window->size = map_size;
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_mux_index_build(int fd, _MMCamcorderMuxIndex *index)
+{
+	struct stat st;
+	gint64 pos = 0;
+	guint64 atom_size = 0;
+	const guchar *header = NULL;
+	_MMCamcorderAtomWindow window;
+
+	if (fstat(fd, &st) != 0) {
+		_mmcam_dbg_err("fstat failed : errno %d", errno);
+		return FALSE;
+	}
+
+	memset(&window, 0x0, sizeof(_MMCamcorderAtomWindow));
+	window.fd = fd;
+	window.file_size = (gint64)st.st_size;
+	window.page_size = sysconf(_SC_PAGESIZE);
+
+	_mmcamcorder_mux_index_reset(index);
+	index->file_size = window.file_size;
+
+	/* only atom headers and moov are mapped, payload of mdat is skipped */
+	while (pos + 8 <= window.file_size) {
+		if (!__mmcamcorder_atom_window_map(&window, pos, 8))
+			break;
+
+		header = window.data + (pos - window.pos);
+		atom_size = GST_READ_UINT32_BE(header);
+
+		if (atom_size == 1) {
+			if (!__mmcamcorder_atom_window_map(&window, pos, 16))
+				break;
+
+			header = window.data + (pos - window.pos);
+			atom_size = GST_READ_UINT64_BE(header + 8);
+		} else if (atom_size == 0) {
+			atom_size = (guint64)(window.file_size - pos);
+		}
+
+		if (atom_size < 8 || atom_size > (guint64)(window.file_size - pos)) {
+			_mmcam_dbg_warn("invalid atom size %"G_GUINT64_FORMAT" at %"G_GINT64_FORMAT, atom_size, pos);
+			break;
+		}
+
+		if (index->atom_num < _MMCAMCORDER_MUX_INDEX_ATOM_MAX)
+			index->atom_pos[index->atom_num++] = pos;
+
+		if (MMCAM_FOURCC(header[4], header[5], header[6], header[7]) == MMCAM_FOURCC('m', 'o', 'o', 'v') &&
+			atom_size <= G_MAXUINT32 &&
+			__mmcamcorder_atom_window_map(&window, pos, (gsize)atom_size)) {
+			index->moov_pos = pos;
+			index->moov_size = (guint32)atom_size;
+			__mmcamcorder_mux_index_moov(index, window.data + (pos - window.pos));
+			break;
+		}
+
+		pos += (gint64)atom_size;
+	}
+
+	if (window.data)
+		munmap(window.data, window.size);
+
+	return index->moov_pos > 0;
+}
+
+
+int _mmcamcorder_write_metadata_in_place(const char *filename, _MMCamcorderMuxIndex *index,
+	int gps_enable, _MMCamcorderLocationInfo info, _MMCamcorderLocationInfo geotag, int orientation)
+{
+	int fd = -1;
+	int ret = MM_ERROR_NONE;
+	_MMCamcorderMuxIndex file_index;
+
+	mmf_return_val_if_fail(filename && index, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	fd = open(filename, O_RDWR);
+	if (fd < 0) {
+		_mmcam_dbg_err("file open failed : errno %d", errno);
+		return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+	}
+
+	ret = __mmcamcorder_write_metadata_with_index(fd, index, gps_enable, info, geotag, orientation);
+	if (ret == MM_ERROR_CAMCORDER_NOT_SUPPORTED) {
+		/* index of muxing is not available, make it from file */
+		_mmcam_dbg_log("make atom index from file");
+
+		if (__mmcamcorder_mux_index_build(fd, &file_index))
+			ret = __mmcamcorder_write_metadata_with_index(fd, &file_index, gps_enable, info, geotag, orientation);
+	}
+
+	close(fd);
+
+	return ret;
+}
+
+
 static int __mmcamcorder_storage_supported_cb(int storage_id, storage_type_e type,
 	storage_state_e state, const char *path, void *user_data)
 {
@@ -731,6 +1227,8 @@ int _mmcamcorder_get_storage_validity(MMHandleType handle, const char *filename,
 		goto _CHECK_DONE;
 	}
 
+	_mmcamcorder_free_space_tracker_reset(handle);
+
 	err = _mmcamcorder_get_freespace(hcamcorder->storage_info.type, &free_space);
 	if (err != 0) {
 		_mmcam_dbg_err("get free space failed");
@@ -852,62 +1350,326 @@ int _mmcamcorder_get_freespace(storage_type_e type, guint64 *free_space)
 }
 
 
-int _mmcamcorder_get_file_system_type(const gchar *path, int *file_system_type)
+void _mmcamcorder_free_space_tracker_reset(MMHandleType handle)
 {
-	struct statfs fs;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 
-	g_assert(path);
+	mmf_return_if_fail(hcamcorder);
 
-	if (!g_file_test(path, G_FILE_TEST_EXISTS | G_FILE_TEST_IS_DIR)) {
-		_mmcam_dbg_log("File(%s) doesn't exist.", path);
-		return -2;
-	}
+	g_mutex_lock(&hcamcorder->free_space_tracker.lock);
+	hcamcorder->free_space_tracker.valid = FALSE;
+	hcamcorder->free_space_tracker.written = 0;
+	g_mutex_unlock(&hcamcorder->free_space_tracker.lock);
 
-	if (-1 == statfs(path, &fs)) {
-		_mmcam_dbg_log("statfs failed.(%s)", path);
-		return -1;
+	return;
+}
+
+
+int _mmcamcorder_free_space_tracker_get(MMHandleType handle, guint64 write_size, guint64 margin, guint64 *free_space)
+{
+	int ret = 0;
+	gint64 now = 0;
+	guint64 estimated = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderFreeSpaceTracker *tracker = NULL;
+
+	mmf_return_val_if_fail(hcamcorder && free_space, -1);
+
+	tracker = &hcamcorder->free_space_tracker;
+	now = g_get_monotonic_time();
+
+	g_mutex_lock(&tracker->lock);
+
+	if (tracker->valid)
+		estimated = tracker->free_space > tracker->written ? tracker->free_space - tracker->written : 0;
+
+	/* sample again if it's old, much written or close to the margin */
+	if (!tracker->valid ||
+		now - tracker->sample_time >= _MMCAMCORDER_FREE_SPACE_SAMPLE_INTERVAL ||
+		tracker->written >= _MMCAMCORDER_FREE_SPACE_SAMPLE_BYTES ||
+		estimated < (margin << 1)) {
+		ret = _mmcamcorder_get_freespace(hcamcorder->storage_info.type, &tracker->free_space);
+		if (ret != 0) {
+			tracker->valid = FALSE;
+			g_mutex_unlock(&tracker->lock);
+			*free_space = 0;
+			return ret;
+		}
+
+		tracker->valid = TRUE;
+		tracker->written = 0;
+		tracker->sample_time = now;
+		estimated = tracker->free_space;
 	}
 
-	*file_system_type = (int)fs.f_type;
+	tracker->written += write_size;
+
+	g_mutex_unlock(&tracker->lock);
+
+	*free_space = estimated;
 
 	return 0;
 }
 
 
-int _mmcamcorder_get_device_flash_brightness(GDBusConnection *conn, int *brightness)
+static void __mmcamcorder_recording_stats_write_begin(_MMCamcorderRecordingStats *stats)
 {
-	int get_value = 0;
-	int ret = MM_ERROR_NONE;
-	GVariant *params = NULL;
-	GVariant *result = NULL;
+	gint sequence = 0;
 
-	ret = __gdbus_method_call_sync(conn, "org.tizen.system.deviced",
-		"/Org/Tizen/System/DeviceD/Led", "org.tizen.system.deviced.Led",
-		"GetBrightnessForCamera", params, &result, TRUE);
-	if (ret != MM_ERROR_NONE) {
-		_mmcam_dbg_err("Dbus Call on Client Error");
-		return ret;
-	}
+	/* writer side of sequence lock : wait until other writer finishes */
+	do {
+		sequence = g_atomic_int_get(&stats->sequence);
+	} while ((sequence & 1) || !g_atomic_int_compare_and_exchange(&stats->sequence, sequence, sequence + 1));
+}
 
-	if (result) {
-		g_variant_get(result, "(i)", &get_value);
-		*brightness = get_value;
-		_mmcam_dbg_log("flash brightness : %d", *brightness);
-	} else {
-		_mmcam_dbg_err("replied result is null");
-		ret = MM_ERROR_CAMCORDER_INTERNAL;
-	}
 
-	return ret;
+static void __mmcamcorder_recording_stats_write_end(_MMCamcorderRecordingStats *stats)
+{
+	g_atomic_int_inc(&stats->sequence);
 }
 
 
-int _mmcamcorder_send_sound_play_message(GDBusConnection *conn, _MMCamcorderGDbusCbInfo *gdbus_info,
-	const char *sample_name, const char *stream_role, const char *volume_gain, int sync_play)
+void _mmcamcorder_recording_stats_reset(MMHandleType handle)
 {
-	int get_value = 0;
-	int ret = MM_ERROR_NONE;
-	GVariant *params = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderRecordingStats *stats = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	stats = &hcamcorder->recording_stats;
+
+	__mmcamcorder_recording_stats_write_begin(stats);
+
+	memset(&stats->data, 0x0, sizeof(MMCamcorderRecordingStatsType));
+	stats->trailer_time = 0;
+	stats->status_time = 0;
+	stats->status_sent = FALSE;
+
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	return;
+}
+
+
+guint64 _mmcamcorder_recording_stats_get_trailer_size(MMHandleType handle, GstElement *muxer)
+{
+	gint64 now = 0;
+	guint64 trailer_size = 0;
+	gboolean do_query = FALSE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderRecordingStats *stats = NULL;
+
+	mmf_return_val_if_fail(hcamcorder && muxer, 0);
+
+	stats = &hcamcorder->recording_stats;
+	now = g_get_monotonic_time();
+
+	/* trailer size grows slowly, so muxer is queried only when cached one is old */
+	__mmcamcorder_recording_stats_write_begin(stats);
+
+	if (stats->trailer_time == 0 || now - stats->trailer_time >= _MMCAMCORDER_TRAILER_SIZE_INTERVAL) {
+		stats->trailer_time = now;
+		do_query = TRUE;
+	}
+
+	trailer_size = stats->data.trailer_size;
+
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	if (!do_query)
+		return trailer_size;
+
+	MMCAMCORDER_G_OBJECT_GET(muxer, "expected-trailer-size", &trailer_size);
+
+	__mmcamcorder_recording_stats_write_begin(stats);
+	stats->data.trailer_size = trailer_size;
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	return trailer_size;
+}
+
+
+void _mmcamcorder_recording_stats_set_queue_level(MMHandleType handle, guint video_level, guint audio_level)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderRecordingStats *stats = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	stats = &hcamcorder->recording_stats;
+
+	__mmcamcorder_recording_stats_write_begin(stats);
+
+	stats->data.video_queue_level = video_level;
+	stats->data.audio_queue_level = audio_level;
+
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	return;
+}
+
+
+void _mmcamcorder_recording_stats_set_start_latency(MMHandleType handle, guint start_latency)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderRecordingStats *stats = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	stats = &hcamcorder->recording_stats;
+
+	__mmcamcorder_recording_stats_write_begin(stats);
+
+	stats->data.start_latency = start_latency;
+
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	return;
+}
+
+
+void _mmcamcorder_recording_stats_add_dropped(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderRecordingStats *stats = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	stats = &hcamcorder->recording_stats;
+
+	__mmcamcorder_recording_stats_write_begin(stats);
+	stats->data.dropped_frames++;
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	return;
+}
+
+
+gboolean _mmcamcorder_recording_stats_update(MMHandleType handle, guint64 elapsed, guint64 filesize, guint64 remained_time)
+{
+	gint interval = 0;
+	gboolean send_status = FALSE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderRecordingStats *stats = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, FALSE);
+
+	stats = &hcamcorder->recording_stats;
+	interval = g_atomic_int_get(&stats->status_interval);
+
+	__mmcamcorder_recording_stats_write_begin(stats);
+
+	stats->data.elapsed = elapsed;
+	stats->data.filesize = filesize;
+	stats->data.remained_time = remained_time;
+
+	/* recording time is restarted by new recording, then it's sent again */
+	if (interval <= 0 || !stats->status_sent ||
+		elapsed < stats->status_time || elapsed - stats->status_time >= (guint64)interval) {
+		stats->status_time = elapsed;
+		stats->status_sent = TRUE;
+		send_status = TRUE;
+	}
+
+	__mmcamcorder_recording_stats_write_end(stats);
+
+	return send_status;
+}
+
+
+int _mmcamcorder_get_recording_stats(MMHandleType handle, MMCamcorderRecordingStatsType *stats)
+{
+	gint sequence = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(stats, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	/* reader side of sequence lock : retry if it's written while reading */
+	do {
+		sequence = g_atomic_int_get(&hcamcorder->recording_stats.sequence);
+		if (sequence & 1)
+			continue;
+
+		memcpy(stats, &hcamcorder->recording_stats.data, sizeof(MMCamcorderRecordingStatsType));
+	} while ((sequence & 1) || sequence != g_atomic_int_get(&hcamcorder->recording_stats.sequence));
+
+	return MM_ERROR_NONE;
+}
+
+
+int _mmcamcorder_set_recording_status_interval(MMHandleType handle, int interval)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(interval >= 0, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	_mmcam_dbg_log("recording status interval %d -> %d ms",
+		g_atomic_int_get(&hcamcorder->recording_stats.status_interval), interval);
+
+	g_atomic_int_set(&hcamcorder->recording_stats.status_interval, interval);
+
+	return MM_ERROR_NONE;
+}
+
+
+int _mmcamcorder_get_file_system_type(const gchar *path, int *file_system_type)
+{
+	struct statfs fs;
+
+	g_assert(path);
+
+	if (!g_file_test(path, G_FILE_TEST_EXISTS | G_FILE_TEST_IS_DIR)) {
+		_mmcam_dbg_log("File(%s) doesn't exist.", path);
+		return -2;
+	}
+
+	if (-1 == statfs(path, &fs)) {
+		_mmcam_dbg_log("statfs failed.(%s)", path);
+		return -1;
+	}
+
+	*file_system_type = (int)fs.f_type;
+
+	return 0;
+}
+
+
+int _mmcamcorder_get_device_flash_brightness(GDBusConnection *conn, int *brightness)
+{
+	int get_value = 0;
+	int ret = MM_ERROR_NONE;
+	GVariant *params = NULL;
+	GVariant *result = NULL;
+
+	ret = __gdbus_method_call_sync(conn, "org.tizen.system.deviced",
+		"/Org/Tizen/System/DeviceD/Led", "org.tizen.system.deviced.Led",
+		"GetBrightnessForCamera", params, &result, TRUE);
+	if (ret != MM_ERROR_NONE) {
+		_mmcam_dbg_err("Dbus Call on Client Error");
+		return ret;
+	}
+
+	if (result) {
+		g_variant_get(result, "(i)", &get_value);
+		*brightness = get_value;
+		_mmcam_dbg_log("flash brightness : %d", *brightness);
+	} else {
+		_mmcam_dbg_err("replied result is null");
+		ret = MM_ERROR_CAMCORDER_INTERNAL;
+	}
+
+	return ret;
+}
+
+
+int _mmcamcorder_send_sound_play_message(GDBusConnection *conn, _MMCamcorderGDbusCbInfo *gdbus_info,
+	const char *sample_name, const char *stream_role, const char *volume_gain, int sync_play)
+{
+	int get_value = 0;
+	int ret = MM_ERROR_NONE;
+	GVariant *params = NULL;
 	GVariant *result = NULL;
 	guint subs_id = 0;
 
@@ -1276,51 +2038,16 @@ void _mmcamcorder_element_release_noti(gpointer data, GObject *where_the_object_
 }
 
 
-#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-gboolean _mmcamcorder_msg_callback(void *data)
+static void __mmcamcorder_release_msg_item_data(_MMCamcorderMsgItem *item)
 {
-	_MMCamcorderMsgItem *item = (_MMCamcorderMsgItem*)data;
-	mmf_camcorder_t *hcamcorder = NULL;
-	mmf_return_val_if_fail(item, FALSE);
-
-	g_mutex_lock(&item->lock);
-
-	hcamcorder = MMF_CAMCORDER(item->handle);
-	if (hcamcorder == NULL) {
-		_mmcam_dbg_warn("msg id:0x%x, item:%p, handle is NULL", item->id, item);
-		goto MSG_CALLBACK_DONE;
-	}
-
-	/*_mmcam_dbg_log("msg id:%x, msg_cb:%p, msg_data:%p, item:%p", item->id, hcamcorder->msg_cb, hcamcorder->msg_data, item);*/
-
-	_MMCAMCORDER_LOCK(hcamcorder);
-
-	/* remove item from msg data */
-	if (hcamcorder->msg_data) {
-		/*_mmcam_dbg_log("remove item %p", item);*/
-		hcamcorder->msg_data = g_list_remove(hcamcorder->msg_data, item);
-	} else {
-		_mmcam_dbg_warn("msg_data is NULL but item[%p] will be removed", item);
-	}
-
-	_MMCAMCORDER_UNLOCK(hcamcorder);
-
-	_MMCAMCORDER_LOCK_MESSAGE_CALLBACK(hcamcorder);
-
-	if ((hcamcorder) && (hcamcorder->msg_cb))
-		hcamcorder->msg_cb(item->id, (MMMessageParamType*)(&(item->param)), hcamcorder->msg_cb_param);
-
-	_MMCAMCORDER_UNLOCK_MESSAGE_CALLBACK(hcamcorder);
-
-	_MMCAMCORDER_SIGNAL(hcamcorder);
+	mmf_return_if_fail(item);
 
-MSG_CALLBACK_DONE:
 	/* release allocated memory */
 	if (item->id == MM_MESSAGE_CAMCORDER_FACE_DETECT_INFO) {
 		MMCamFaceDetectInfo *cam_fd_info = (MMCamFaceDetectInfo *)item->param.data;
 		if (cam_fd_info) {
 			SAFE_G_FREE(cam_fd_info->face_info);
-			SAFE_G_FREE(cam_fd_info);
+			g_free(cam_fd_info);
 
 			item->param.data = NULL;
 			item->param.size = 0;
@@ -1330,189 +2057,544 @@ MSG_CALLBACK_DONE:
 		if (report) {
 			SAFE_G_FREE(report->recording_filename);
 			g_free(report);
-			report = NULL;
+
 			item->param.data = NULL;
 		}
 	}
 
-	g_mutex_unlock(&item->lock);
-	g_mutex_clear(&item->lock);
-
-	SAFE_G_FREE(item);
-
-	/* For not being called again */
-	return FALSE;
+	return;
 }
-#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 
 
-gboolean _mmcamcorder_send_message(MMHandleType handle, _MMCamcorderMsgItem *data)
-{
-	mmf_camcorder_t* hcamcorder = MMF_CAMCORDER(handle);
 #ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-	_MMCamcorderMsgItem *item = NULL;
-#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
-
-	mmf_return_val_if_fail(hcamcorder, FALSE);
-	mmf_return_val_if_fail(data, FALSE);
-
-	switch (data->id) {
-	case MM_MESSAGE_CAMCORDER_STATE_CHANGED:
-	case MM_MESSAGE_CAMCORDER_STATE_CHANGED_BY_RM:
-		data->param.union_type = MM_MSG_UNION_STATE;
-		break;
-	case MM_MESSAGE_CAMCORDER_RECORDING_STATUS:
-		data->param.union_type = MM_MSG_UNION_RECORDING_STATUS;
-		break;
-	case MM_MESSAGE_CAMCORDER_FIRMWARE_UPDATE:
-		data->param.union_type = MM_MSG_UNION_FIRMWARE;
-		break;
+static int __mmcamcorder_msg_coalesced_index(int id)
+{
+	switch (id) {
 	case MM_MESSAGE_CAMCORDER_CURRENT_VOLUME:
-		data->param.union_type = MM_MSG_UNION_REC_VOLUME_DB;
-		break;
-	case MM_MESSAGE_CAMCORDER_TIME_LIMIT:
-	case MM_MESSAGE_CAMCORDER_MAX_SIZE:
-	case MM_MESSAGE_CAMCORDER_NO_FREE_SPACE:
-	case MM_MESSAGE_CAMCORDER_ERROR:
-	case MM_MESSAGE_CAMCORDER_FOCUS_CHANGED:
-	case MM_MESSAGE_CAMCORDER_CAPTURED:
-	case MM_MESSAGE_CAMCORDER_VIDEO_CAPTURED:
-	case MM_MESSAGE_CAMCORDER_AUDIO_CAPTURED:
-	case MM_MESSAGE_READY_TO_RESUME:
+		return 0;
+	case MM_MESSAGE_CAMCORDER_RECORDING_STATUS:
+		return 1;
 	default:
-		data->param.union_type = MM_MSG_UNION_CODE;
-		break;
+		return -1;
 	}
+}
 
-#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-	item = g_malloc(sizeof(_MMCamcorderMsgItem));
-	if (item) {
-		memcpy(item, data, sizeof(_MMCamcorderMsgItem));
-		item->handle = handle;
-		g_mutex_init(&item->lock);
 
-		_MMCAMCORDER_LOCK(handle);
-		hcamcorder->msg_data = g_list_append(hcamcorder->msg_data, item);
-		/*_mmcam_dbg_log("item[%p]", item);*/
+static void __mmcamcorder_msg_source_wakeup(_MMCamcorderMsgSource *msg_source)
+{
+	/* wake up main context only once until it's dispatched */
+	if (g_atomic_int_compare_and_exchange(&msg_source->wakeup, 0, 1))
+		g_main_context_wakeup(g_source_get_context((GSource *)msg_source));
+}
 
-		/* Use DEFAULT priority */
-		g_idle_add_full(G_PRIORITY_DEFAULT, _mmcamcorder_msg_callback, item, NULL);
 
-		_MMCAMCORDER_UNLOCK(handle);
-	} else {
-		_mmcam_dbg_err("item[id:0x%x] malloc failed : %d", data->id, sizeof(_MMCamcorderMsgItem));
-	}
-#else /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
-	_MMCAMCORDER_LOCK_MESSAGE_CALLBACK(hcamcorder);
+static gboolean __mmcamcorder_msg_coalesced_push(_MMCamcorderMsgCoalesced *coalesced, _MMCamcorderMsgItem *data)
+{
+	gint sequence = 0;
 
-	if (hcamcorder->msg_cb)
-		hcamcorder->msg_cb(data->id, (MMMessageParamType*)(&(data->param)), hcamcorder->msg_cb_param);
-	else
-		_mmcam_dbg_log("message callback is NULL. message id %d", data->id);
+	/* writer side of sequence lock : wait until other writer finishes */
+	do {
+		sequence = g_atomic_int_get(&coalesced->sequence);
+	} while ((sequence & 1) || !g_atomic_int_compare_and_exchange(&coalesced->sequence, sequence, sequence + 1));
 
-	_MMCAMCORDER_UNLOCK_MESSAGE_CALLBACK(hcamcorder);
+	coalesced->item.id = data->id;
+	coalesced->item.param = data->param;
 
-	/* release allocated memory */
-	if (data->id == MM_MESSAGE_CAMCORDER_FACE_DETECT_INFO) {
-		MMCamFaceDetectInfo *cam_fd_info = (MMCamFaceDetectInfo *)data->param.data;
-		if (cam_fd_info) {
-			SAFE_G_FREE(cam_fd_info->face_info);
-			data->param.data = NULL;
-			g_free(cam_fd_info);
-		}
-	} else if (data->id == MM_MESSAGE_CAMCORDER_VIDEO_CAPTURED || data->id == MM_MESSAGE_CAMCORDER_AUDIO_CAPTURED) {
-		MMCamRecordingReport *report = (MMCamRecordingReport *)data->param.data;
-		if (report) {
-			SAFE_G_FREE(report->recording_filename);
-			data->param.data = NULL;
-			g_free(report);
-		}
-	}
-#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+	g_atomic_int_inc(&coalesced->sequence);
 
-	return TRUE;
+	/* new marker is needed only if there is no marker in ring */
+	return g_atomic_int_compare_and_exchange(&coalesced->pending, 0, 1);
 }
 
 
-void _mmcamcorder_remove_message_all(MMHandleType handle)
+static gboolean __mmcamcorder_msg_coalesced_pop(_MMCamcorderMsgCoalesced *coalesced, _MMCamcorderMsgItem *item)
 {
-	mmf_camcorder_t* hcamcorder = MMF_CAMCORDER(handle);
-	gboolean ret = TRUE;
-#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-	_MMCamcorderMsgItem *item = NULL;
-	GList *list = NULL;
-	gint64 end_time = 0;
-#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+	gint sequence = 0;
 
-	mmf_return_if_fail(hcamcorder);
+	/* marker is taken, next one will be pushed by next update */
+	g_atomic_int_set(&coalesced->pending, 0);
+
+	/* reader side of sequence lock : retry if it's overwritten while reading */
+	do {
+		sequence = g_atomic_int_get(&coalesced->sequence);
+		if (sequence & 1)
+			continue;
+
+		item->id = coalesced->item.id;
+		item->param = coalesced->item.param;
+	} while ((sequence & 1) || sequence != g_atomic_int_get(&coalesced->sequence));
+
+	/* it's already delivered by previous marker */
+	if (sequence == coalesced->delivered)
+		return FALSE;
+
+	coalesced->delivered = sequence;
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_msg_ring_push(_MMCamcorderMsgSource *msg_source, _MMCamcorderMsgSlot *entry)
+{
+	_MMCamcorderMsgSlot *slot = NULL;
+	gint position = 0;
+	gint diff = 0;
+
+	/* bounded multi producer ring : claim a position, write item and publish it by slot sequence */
+	position = g_atomic_int_get(&msg_source->tail);
+
+	while (TRUE) {
+		slot = &msg_source->slot[(guint)position & (_MMCAMCORDER_MSG_RING_SIZE - 1)];
+		diff = (gint)((guint)g_atomic_int_get(&slot->sequence) - (guint)position);
+
+		if (diff == 0) {
+			if (g_atomic_int_compare_and_exchange(&msg_source->tail, position, (gint)((guint)position + 1)))
+				break;
+		} else if (diff < 0) {
+			/* ring is full */
+			return FALSE;
+		}
+
+		position = g_atomic_int_get(&msg_source->tail);
+	}
+
+	slot->coalesced = entry->coalesced;
+	slot->item.id = entry->item.id;
+	slot->item.param = entry->item.param;
+
+	g_atomic_int_set(&slot->sequence, (gint)((guint)position + 1));
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_msg_ring_pop(_MMCamcorderMsgSource *msg_source, _MMCamcorderMsgSlot *entry)
+{
+	_MMCamcorderMsgSlot *slot = NULL;
+	guint position = (guint)msg_source->head;
+
+	/* single consumer : only owner of msg_source->consumer can call this */
+	slot = &msg_source->slot[position & (_MMCAMCORDER_MSG_RING_SIZE - 1)];
+
+	if ((gint)((guint)g_atomic_int_get(&slot->sequence) - (position + 1)) < 0)
+		return FALSE;
+
+	entry->coalesced = slot->coalesced;
+	entry->item.id = slot->item.id;
+	entry->item.param = slot->item.param;
+
+	g_atomic_int_set(&slot->sequence, (gint)(position + _MMCAMCORDER_MSG_RING_SIZE));
+	msg_source->head = (gint)(position + 1);
+
+	return TRUE;
+}
+
+
+static void __mmcamcorder_msg_source_push(_MMCamcorderMsgSource *msg_source, _MMCamcorderMsgSlot *entry)
+{
+	gint dropped = 0;
+	_MMCamcorderMsgSlot *spilled = NULL;
+
+	/* once overflow queue is used, messages go to it until it's drained to keep the order */
+	if (g_atomic_int_get(&msg_source->overflow_count) == 0 &&
+		__mmcamcorder_msg_ring_push(msg_source, entry))
+		return;
+
+	g_mutex_lock(&msg_source->overflow_lock);
+
+	if (msg_source->overflow_count == 0 &&
+		__mmcamcorder_msg_ring_push(msg_source, entry)) {
+		g_mutex_unlock(&msg_source->overflow_lock);
+		return;
+	}
+
+	if (!msg_source->overflow)
+		msg_source->overflow = g_try_new0(_MMCamcorderMsgSlot, _MMCAMCORDER_MSG_OVERFLOW_SIZE);
+
+	if (!msg_source->overflow || msg_source->overflow_count >= _MMCAMCORDER_MSG_OVERFLOW_SIZE) {
+		dropped = ++msg_source->overflow_dropped;
+
+		g_mutex_unlock(&msg_source->overflow_lock);
+
+		_mmcam_dbg_err("overflow queue is full, drop id 0x%x [dropped %d]", entry->item.id, dropped);
+
+		/* marker is dropped, next update of coalesced message pushes new one */
+		if (entry->coalesced > 0)
+			g_atomic_int_set(&msg_source->coalesced[entry->coalesced - 1].pending, 0);
+		else
+			__mmcamcorder_release_msg_item_data(&entry->item);
+
+		return;
+	}
+
+	spilled = &msg_source->overflow[(msg_source->overflow_head + msg_source->overflow_count) % _MMCAMCORDER_MSG_OVERFLOW_SIZE];
+	spilled->coalesced = entry->coalesced;
+	spilled->item.id = entry->item.id;
+	spilled->item.param = entry->item.param;
+
+	g_atomic_int_inc(&msg_source->overflow_count);
+	msg_source->overflow_total++;
+
+	g_mutex_unlock(&msg_source->overflow_lock);
+
+	_mmcam_dbg_warn("message ring is full, keep id 0x%x in overflow queue", entry->item.id);
+
+	return;
+}
+
+
+static gboolean __mmcamcorder_msg_source_pop(_MMCamcorderMsgSource *msg_source, _MMCamcorderMsgSlot *entry)
+{
+	_MMCamcorderMsgSlot *spilled = NULL;
+
+	/* messages in overflow queue are always newer than the ones in ring */
+	if (__mmcamcorder_msg_ring_pop(msg_source, entry))
+		return TRUE;
+
+	if (g_atomic_int_get(&msg_source->overflow_count) == 0)
+		return FALSE;
+
+	g_mutex_lock(&msg_source->overflow_lock);
+
+	if (msg_source->overflow_count == 0) {
+		g_mutex_unlock(&msg_source->overflow_lock);
+		return FALSE;
+	}
+
+	spilled = &msg_source->overflow[msg_source->overflow_head];
+
+	entry->coalesced = spilled->coalesced;
+	entry->item.id = spilled->item.id;
+	entry->item.param = spilled->item.param;
+
+	msg_source->overflow_head = (msg_source->overflow_head + 1) % _MMCAMCORDER_MSG_OVERFLOW_SIZE;
+	g_atomic_int_add(&msg_source->overflow_count, -1);
+
+	g_mutex_unlock(&msg_source->overflow_lock);
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_msg_source_is_pending(_MMCamcorderMsgSource *msg_source)
+{
+	_MMCamcorderMsgSlot *slot = &msg_source->slot[(guint)msg_source->head & (_MMCAMCORDER_MSG_RING_SIZE - 1)];
+
+	if (g_atomic_int_get(&msg_source->overflow_count) > 0)
+		return TRUE;
+
+	return (gint)((guint)g_atomic_int_get(&slot->sequence) - ((guint)msg_source->head + 1)) >= 0;
+}
+
+
+static gboolean __mmcamcorder_msg_source_prepare(GSource *source, gint *timeout)
+{
+	*timeout = -1;
+
+	return __mmcamcorder_msg_source_is_pending((_MMCamcorderMsgSource *)source);
+}
+
+
+static gboolean __mmcamcorder_msg_source_check(GSource *source)
+{
+	return __mmcamcorder_msg_source_is_pending((_MMCamcorderMsgSource *)source);
+}
+
+
+static gboolean __mmcamcorder_msg_source_dispatch(GSource *source, GSourceFunc callback, gpointer user_data)
+{
+	int count = 0;
+	_MMCamcorderMsgSlot entry;
+	_MMCamcorderMsgSource *msg_source = (_MMCamcorderMsgSource *)source;
+	mmf_camcorder_t *hcamcorder = NULL;
+
+	/* ring is being flushed by other thread */
+	if (!g_atomic_int_compare_and_exchange(&msg_source->consumer, 0, 1))
+		return G_SOURCE_CONTINUE;
+
+	if (g_source_is_destroyed(source)) {
+		_mmcam_dbg_warn("source is destroyed");
+		return G_SOURCE_REMOVE;
+	}
+
+	hcamcorder = MMF_CAMCORDER(msg_source->hcamcorder);
+
+	g_atomic_pointer_set(&msg_source->consumer_thread, g_thread_self());
+	g_atomic_int_set(&msg_source->wakeup, 0);
+
+	memset(&entry, 0x0, sizeof(_MMCamcorderMsgSlot));
+
+	_MMCAMCORDER_LOCK_MESSAGE_CALLBACK(hcamcorder);
+
+	while (count < _MMCAMCORDER_MSG_DISPATCH_BATCH && __mmcamcorder_msg_source_pop(msg_source, &entry)) {
+		count++;
+
+		/* deliver the latest coalesced message at the position of its marker */
+		if (entry.coalesced > 0 &&
+			!__mmcamcorder_msg_coalesced_pop(&msg_source->coalesced[entry.coalesced - 1], &entry.item))
+			continue;
+
+		if (hcamcorder->msg_cb)
+			hcamcorder->msg_cb(entry.item.id, (MMMessageParamType *)(&(entry.item.param)), hcamcorder->msg_cb_param);
+
+		__mmcamcorder_release_msg_item_data(&entry.item);
+
+		/* source could be destroyed in message callback */
+		if (g_source_is_destroyed(source)) {
+			_mmcam_dbg_warn("source is destroyed in message callback");
+			break;
+		}
+	}
+
+	_MMCAMCORDER_UNLOCK_MESSAGE_CALLBACK(hcamcorder);
+
+	g_atomic_pointer_set(&msg_source->consumer_thread, NULL);
+
+	/* release consumer with lock, then destroy can not miss the signal and handle is not touched after unlock */
+	_MMCAMCORDER_LOCK(hcamcorder);
+	g_atomic_int_set(&msg_source->consumer, 0);
+	_MMCAMCORDER_BROADCAST(hcamcorder);
+	_MMCAMCORDER_UNLOCK(hcamcorder);
+
+	return G_SOURCE_CONTINUE;
+}
+
+
+static void __mmcamcorder_msg_source_finalize(GSource *source)
+{
+	_MMCamcorderMsgSlot entry;
+	_MMCamcorderMsgSource *msg_source = (_MMCamcorderMsgSource *)source;
+
+	/* release messages which are not delivered */
+	while (__mmcamcorder_msg_source_pop(msg_source, &entry))
+		__mmcamcorder_release_msg_item_data(&entry.item);
+
+	if (msg_source->overflow_total > 0)
+		_mmcam_dbg_warn("overflow message count %d, dropped %d",
+			msg_source->overflow_total, msg_source->overflow_dropped);
+
+	g_free(msg_source->overflow);
+	msg_source->overflow = NULL;
+
+	g_mutex_clear(&msg_source->overflow_lock);
+
+	return;
+}
+
+
+static GSourceFuncs msg_source_funcs = {
+	__mmcamcorder_msg_source_prepare,
+	__mmcamcorder_msg_source_check,
+	__mmcamcorder_msg_source_dispatch,
+	__mmcamcorder_msg_source_finalize,
+	NULL,
+	NULL
+};
+
+
+static void __mmcamcorder_msg_source_acquire(mmf_camcorder_t *hcamcorder, _MMCamcorderMsgSource *msg_source, gboolean *reentered)
+{
+	/* should be called with _MMCAMCORDER_LOCK */
+	*reentered = FALSE;
+
+	while (!g_atomic_int_compare_and_exchange(&msg_source->consumer, 0, 1)) {
+		/* called in message callback : consumer is this thread and ring is not being read now */
+		if (g_atomic_pointer_get(&msg_source->consumer_thread) == g_thread_self()) {
+			_mmcam_dbg_warn("called in message callback");
+			*reentered = TRUE;
+			return;
+		}
+
+		/* dispatch releases consumer with _MMCAMCORDER_LOCK, wait until it's done */
+		_mmcam_dbg_warn("message is being delivered, wait...");
+
+		_MMCAMCORDER_WAIT(hcamcorder);
+	}
+
+	return;
+}
+
+
+GSource *_mmcamcorder_msg_source_new(MMHandleType handle)
+{
+	int i = 0;
+	_MMCamcorderMsgSource *msg_source = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, NULL);
+
+	msg_source = (_MMCamcorderMsgSource *)g_source_new(&msg_source_funcs, sizeof(_MMCamcorderMsgSource));
+	if (!msg_source) {
+		_mmcam_dbg_err("failed to create message source");
+		return NULL;
+	}
+
+	msg_source->hcamcorder = hcamcorder;
+
+	g_mutex_init(&msg_source->overflow_lock);
+
+	for (i = 0 ; i < _MMCAMCORDER_MSG_RING_SIZE ; i++)
+		msg_source->slot[i].sequence = i;
+
+	/* Use DEFAULT priority */
+	g_source_set_priority((GSource *)msg_source, G_PRIORITY_DEFAULT);
+	g_source_attach((GSource *)msg_source, NULL);
+
+	_mmcam_dbg_log("message source %p, ring size %d", msg_source, _MMCAMCORDER_MSG_RING_SIZE);
+
+	return (GSource *)msg_source;
+}
 
-	_MMCAMCORDER_LOCK(handle);
 
+void _mmcamcorder_msg_source_destroy(MMHandleType handle)
+{
+	gboolean reentered = FALSE;
+	_MMCamcorderMsgSource *msg_source = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	if (!hcamcorder->msg_source)
+		return;
+
+	msg_source = (_MMCamcorderMsgSource *)hcamcorder->msg_source;
+
+	_MMCAMCORDER_LOCK(hcamcorder);
+
+	/* consumer is not released, then dispatch will not be done after this */
+	__mmcamcorder_msg_source_acquire(hcamcorder, msg_source, &reentered);
+
+	g_source_destroy((GSource *)msg_source);
+	hcamcorder->msg_source = NULL;
+
+	_MMCAMCORDER_UNLOCK(hcamcorder);
+
+	g_source_unref((GSource *)msg_source);
+
+	_mmcam_dbg_log("done");
+
+	return;
+}
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+
+
+gboolean _mmcamcorder_send_message(MMHandleType handle, _MMCamcorderMsgItem *data)
+{
+	mmf_camcorder_t* hcamcorder = MMF_CAMCORDER(handle);
 #ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
-	if (!hcamcorder->msg_data) {
-		_mmcam_dbg_log("No message data is remained.");
-	} else {
-		list = hcamcorder->msg_data;
+	int index = 0;
+	_MMCamcorderMsgSlot entry;
+	_MMCamcorderMsgSource *msg_source = NULL;
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 
-		while (list) {
-			item = list->data;
-			list = g_list_next(list);
+	mmf_return_val_if_fail(hcamcorder, FALSE);
+	mmf_return_val_if_fail(data, FALSE);
 
-			if (!item) {
-				_mmcam_dbg_err("Fail to remove message. The item is NULL");
-			} else {
-				if (g_mutex_trylock(&(item->lock))) {
-					ret = g_idle_remove_by_data(item);
+	switch (data->id) {
+	case MM_MESSAGE_CAMCORDER_STATE_CHANGED:
+	case MM_MESSAGE_CAMCORDER_STATE_CHANGED_BY_RM:
+		data->param.union_type = MM_MSG_UNION_STATE;
+		break;
+	case MM_MESSAGE_CAMCORDER_RECORDING_STATUS:
+		data->param.union_type = MM_MSG_UNION_RECORDING_STATUS;
+		break;
+	case MM_MESSAGE_CAMCORDER_FIRMWARE_UPDATE:
+		data->param.union_type = MM_MSG_UNION_FIRMWARE;
+		break;
+	case MM_MESSAGE_CAMCORDER_CURRENT_VOLUME:
+		data->param.union_type = MM_MSG_UNION_REC_VOLUME_DB;
+		break;
+	case MM_MESSAGE_CAMCORDER_TIME_LIMIT:
+	case MM_MESSAGE_CAMCORDER_MAX_SIZE:
+	case MM_MESSAGE_CAMCORDER_NO_FREE_SPACE:
+	case MM_MESSAGE_CAMCORDER_ERROR:
+	case MM_MESSAGE_CAMCORDER_FOCUS_CHANGED:
+	case MM_MESSAGE_CAMCORDER_CAPTURED:
+	case MM_MESSAGE_CAMCORDER_VIDEO_CAPTURED:
+	case MM_MESSAGE_CAMCORDER_AUDIO_CAPTURED:
+	case MM_MESSAGE_READY_TO_RESUME:
+	default:
+		data->param.union_type = MM_MSG_UNION_CODE;
+		break;
+	}
+
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+	msg_source = (_MMCamcorderMsgSource *)hcamcorder->msg_source;
+	if (!msg_source) {
+		_mmcam_dbg_err("no message source for id 0x%x", data->id);
+		__mmcamcorder_release_msg_item_data(data);
+		return FALSE;
+	}
+
+	memset(&entry, 0x0, sizeof(_MMCamcorderMsgSlot));
+
+	index = __mmcamcorder_msg_coalesced_index(data->id);
+	if (index >= 0) {
+		/* overwrite previous one if it's not delivered yet, its marker keeps the position in ring */
+		if (!__mmcamcorder_msg_coalesced_push(&msg_source->coalesced[index], data))
+			return TRUE;
+
+		entry.coalesced = index + 1;
+	} else {
+		entry.item.id = data->id;
+		entry.item.param = data->param;
+	}
 
-					_mmcam_dbg_log("remove msg item[%p], ret[%d]", item, ret);
+	__mmcamcorder_msg_source_push(msg_source, &entry);
+	__mmcamcorder_msg_source_wakeup(msg_source);
+#else /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+	_MMCAMCORDER_LOCK_MESSAGE_CALLBACK(hcamcorder);
 
-					if (ret == FALSE) {
-						item->handle = 0;
-						_mmcam_dbg_warn("failed to remove msg cb for item %p, it will be called later with NULL handle", item);
-					}
+	if (hcamcorder->msg_cb)
+		hcamcorder->msg_cb(data->id, (MMMessageParamType*)(&(data->param)), hcamcorder->msg_cb_param);
+	else
+		_mmcam_dbg_log("message callback is NULL. message id %d", data->id);
 
-					/* release allocated memory */
-					if (item->id == MM_MESSAGE_CAMCORDER_FACE_DETECT_INFO) {
-						MMCamFaceDetectInfo *cam_fd_info = (MMCamFaceDetectInfo *)item->param.data;
-						if (cam_fd_info) {
-							SAFE_G_FREE(cam_fd_info->face_info);
-							item->param.size = 0;
-						}
-						SAFE_G_FREE(cam_fd_info);
-					} else if (item->id == MM_MESSAGE_CAMCORDER_VIDEO_CAPTURED || item->id == MM_MESSAGE_CAMCORDER_AUDIO_CAPTURED) {
-						MMCamRecordingReport *report = (MMCamRecordingReport *)item->param.data;
-						if (report)
-							SAFE_G_FREE(report->recording_filename);
+	_MMCAMCORDER_UNLOCK_MESSAGE_CALLBACK(hcamcorder);
 
-						SAFE_G_FREE(report);
-					}
+	__mmcamcorder_release_msg_item_data(data);
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 
-					hcamcorder->msg_data = g_list_remove(hcamcorder->msg_data, item);
+	return TRUE;
+}
 
-					g_mutex_unlock(&(item->lock));
 
-					if (ret == TRUE) {
-						g_mutex_clear(&item->lock);
+void _mmcamcorder_remove_message_all(MMHandleType handle)
+{
+	mmf_camcorder_t* hcamcorder = MMF_CAMCORDER(handle);
+	gboolean ret = TRUE;
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+	int i = 0;
+	int count = 0;
+	gboolean reentered = FALSE;
+	_MMCamcorderMsgSlot entry;
+	_MMCamcorderMsgSource *msg_source = NULL;
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 
-						SAFE_G_FREE(item);
+	mmf_return_if_fail(hcamcorder);
 
-						_mmcam_dbg_log("remove msg done");
-					}
-				} else {
-					_mmcam_dbg_warn("item lock failed. it's being called...");
+	_MMCAMCORDER_LOCK(handle);
 
-					end_time = g_get_monotonic_time() + (100 * G_TIME_SPAN_MILLISECOND);
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+	msg_source = (_MMCamcorderMsgSource *)hcamcorder->msg_source;
+	if (!msg_source) {
+		_mmcam_dbg_log("No message source.");
+	} else {
+		__mmcamcorder_msg_source_acquire(hcamcorder, msg_source, &reentered);
 
-					if (_MMCAMCORDER_WAIT_UNTIL(handle, end_time))
-						_mmcam_dbg_warn("signal received");
-					else
-						_mmcam_dbg_warn("timeout");
-				}
-			}
+		while (__mmcamcorder_msg_source_pop(msg_source, &entry)) {
+			__mmcamcorder_release_msg_item_data(&entry.item);
+			count++;
 		}
 
-		g_list_free(hcamcorder->msg_data);
-		hcamcorder->msg_data = NULL;
+		for (i = 0 ; i < _MMCAMCORDER_MSG_COALESCED_NUM ; i++)
+			g_atomic_int_set(&msg_source->coalesced[i].pending, 0);
+
+		/* consumer is released by dispatch if it's called in message callback */
+		if (!reentered)
+			g_atomic_int_set(&msg_source->consumer, 0);
+
+		_mmcam_dbg_log("removed message count %d", count);
 	}
 #endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
 
@@ -1876,22 +2958,156 @@ gboolean _mmcamcorder_resize_frame(unsigned char *src_data, unsigned int src_wid
 }
 
 
-gboolean _mmcamcorder_encode_jpeg(void *src_data, unsigned int src_width, unsigned int src_height,
-	int src_format, unsigned int src_length, unsigned int jpeg_quality,
-	void **result_data, unsigned int *result_length)
+unsigned int _mmcamcorder_get_sample_stride(GstSample *sample)
 {
-	int ret = 0;
+	GstCaps *caps = NULL;
+	GstBuffer *buffer = NULL;
+	GstVideoMeta *meta = NULL;
+	GstVideoInfo info;
+
+	if (!sample)
+		return 0;
+
+	/* stride of source which is aligned by hardware */
+	buffer = gst_sample_get_buffer(sample);
+	if (buffer) {
+		meta = gst_buffer_get_video_meta(buffer);
+		if (meta)
+			return (unsigned int)meta->stride[0];
+	}
+
+	caps = gst_sample_get_caps(sample);
+	if (caps && gst_video_info_from_caps(&info, caps))
+		return (unsigned int)GST_VIDEO_INFO_PLANE_STRIDE(&info, 0);
+
+	return 0;
+}
+
+
+gboolean _mmcamcorder_get_src_stride(int src_format, unsigned int src_width, unsigned int src_height,
+	unsigned int src_length, unsigned int stride_hint, unsigned int *src_stride)
+{
+	unsigned int rows = 0;
+	unsigned int stride = 0;
+	unsigned int derived = 0;
+
+	if (!src_stride || src_width == 0 || src_height == 0)
+		return FALSE;
+
+	switch (src_format) {
+	case MM_PIXEL_FORMAT_NV12:
+	case MM_PIXEL_FORMAT_NV21:
+		/* Y plane and half height UV plane with same stride */
+		stride = src_width;
+		rows = src_height + ((src_height + 1) >> 1);
+		break;
+	case MM_PIXEL_FORMAT_YUYV:
+	case MM_PIXEL_FORMAT_UYVY:
+		stride = src_width << 1;
+		rows = src_height;
+		break;
+	default:
+		return FALSE;
+	}
+
+	if (stride_hint >= stride && (guint64)stride_hint * rows <= src_length) {
+		/* stride from video meta or caps */
+		stride = stride_hint;
+	} else {
+		/* buffer could be padded at the end, then stride is derived only if length is exactly same with planes */
+		derived = src_length / rows;
+		if (derived > stride && (guint64)derived * rows == src_length)
+			stride = derived;
+	}
+
+	if ((guint64)stride * rows > src_length) {
+		_mmcam_dbg_err("too small source - length %u, stride %u, %ux%u", src_length, stride, src_width, src_height);
+		return FALSE;
+	}
+
+	*src_stride = stride;
+
+	return TRUE;
+}
+
+
+static int __mmcamcorder_get_jpeg_direct_format(int src_format)
+{
+	switch (src_format) {
+	case MM_PIXEL_FORMAT_NV12:
+		return MM_UTIL_COLOR_NV12;
+	case MM_PIXEL_FORMAT_YUYV:
+		return MM_UTIL_COLOR_YUYV;
+	case MM_PIXEL_FORMAT_UYVY:
+		return MM_UTIL_COLOR_UYVY;
+	default:
+		return -1;
+	}
+}
+
+
+gboolean _mmcamcorder_encode_jpeg(MMHandleType handle, void *src_data, unsigned int src_width, unsigned int src_height,
+	int src_format, unsigned int src_length, unsigned int stride_hint, unsigned int jpeg_quality,
+	void **result_data, unsigned int *result_length)
+{
+	int ret = 0;
 	gboolean ret_conv = TRUE;
 	int jpeg_format = 0;
+	int direct_format = -1;
+	unsigned int src_stride = 0;
 	unsigned char *converted_src = NULL;
 	unsigned int converted_src_size = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 
 	mmf_return_val_if_fail(src_data && result_data && result_length, FALSE);
 
+	/* try to encode semi-planar and packed 4:2:2 source directly if it's not padded */
+	direct_format = __mmcamcorder_get_jpeg_direct_format(src_format);
+	if (direct_format >= 0) {
+		if (!_mmcamcorder_get_src_stride(src_format, src_width, src_height, src_length, stride_hint, &src_stride))
+			return FALSE;
+
+		if ((src_format == MM_PIXEL_FORMAT_NV12 && src_stride != src_width) ||
+			(src_format != MM_PIXEL_FORMAT_NV12 && src_stride != (src_width << 1))) {
+			_mmcam_dbg_log("padded source - stride %u, width %u", src_stride, src_width);
+		} else if (hcamcorder && (g_atomic_int_get(&hcamcorder->jpeg_direct_unsupported) & (1 << direct_format))) {
+			_mmcam_dbg_log("direct encoding is not supported for format %d", src_format);
+		} else {
+			ret = mm_util_jpeg_encode_to_memory(result_data, result_length,
+				src_data, src_width, src_height, direct_format, jpeg_quality);
+			if (ret == MM_ERROR_NONE)
+				return TRUE;
+
+			_mmcam_dbg_warn("direct encoding failed for format %d [0x%x], fallback to conversion", src_format, ret);
+
+			/* other errors could be transient, then try direct encoding again next time */
+			if (hcamcorder && ret == MM_UTIL_ERROR_NOT_SUPPORTED_FORMAT)
+				g_atomic_int_or((guint *)&hcamcorder->jpeg_direct_unsupported, (guint)(1 << direct_format));
+		}
+	}
+
 	switch (src_format) {
 	case MM_PIXEL_FORMAT_NV12:
-		//jpeg_format = MM_UTIL_COLOR_NV12;
-		ret_conv = _mmcamcorder_convert_NV12_to_I420(src_data, src_width, src_height, &converted_src, &converted_src_size);
+	case MM_PIXEL_FORMAT_YUYV:
+	case MM_PIXEL_FORMAT_UYVY:
+		/* converted to I420 */
+		converted_src_size = (src_width * src_height * 3) >> 1;
+		converted_src = _mmcamcorder_buffer_pool_get(handle, converted_src_size);
+		if (!converted_src) {
+			_mmcam_dbg_err("failed to get buffer for conversion. size %u", converted_src_size);
+			return FALSE;
+		}
+
+		if (hcamcorder)
+			g_atomic_int_inc(&hcamcorder->jpeg_fallback_count);
+
+		if (src_format == MM_PIXEL_FORMAT_NV12)
+			ret_conv = _mmcamcorder_convert_NV12_to_I420(handle, src_data, src_width, src_height, src_stride, converted_src);
+		else if (src_format == MM_PIXEL_FORMAT_YUYV)
+			ret_conv = _mmcamcorder_convert_YUYV_to_I420(handle, src_data, src_width, src_height, src_stride, converted_src);
+		else
+			ret_conv = _mmcamcorder_convert_UYVY_to_I420(handle, src_data, src_width, src_height, src_stride, converted_src);
+
 		jpeg_format = MM_UTIL_COLOR_YUV420;
 		break;
 	case MM_PIXEL_FORMAT_NV16:
@@ -1902,16 +3118,6 @@ gboolean _mmcamcorder_encode_jpeg(void *src_data, unsigned int src_width, unsign
 		jpeg_format = MM_UTIL_COLOR_NV21;
 		converted_src = src_data;
 		break;
-	case MM_PIXEL_FORMAT_YUYV:
-		//jpeg_format = MM_UTIL_COLOR_YUYV;
-		ret_conv = _mmcamcorder_convert_YUYV_to_I420(src_data, src_width, src_height, &converted_src, &converted_src_size);
-		jpeg_format = MM_UTIL_COLOR_YUV420;
-		break;
-	case MM_PIXEL_FORMAT_UYVY:
-		//jpeg_format = MM_UTIL_COLOR_UYVY;
-		ret_conv = _mmcamcorder_convert_UYVY_to_I420(src_data, src_width, src_height, &converted_src, &converted_src_size);
-		jpeg_format = MM_UTIL_COLOR_YUV420;
-		break;
 	case MM_PIXEL_FORMAT_I420:
 		jpeg_format = MM_UTIL_COLOR_YUV420;
 		converted_src = src_data;
@@ -1943,7 +3149,7 @@ gboolean _mmcamcorder_encode_jpeg(void *src_data, unsigned int src_width, unsign
 	if (ret_conv == FALSE) {
 		if (converted_src &&
 		    converted_src != src_data) {
-			free(converted_src);
+			_mmcamcorder_buffer_pool_put(handle, converted_src);
 			converted_src = NULL;
 		}
 		_mmcam_dbg_err("color convert error source format[%d], jpeg format[%d]", src_format, jpeg_format);
@@ -1954,7 +3160,7 @@ gboolean _mmcamcorder_encode_jpeg(void *src_data, unsigned int src_width, unsign
 		converted_src, src_width, src_height, jpeg_format, jpeg_quality);
 
 	if (converted_src && (converted_src != src_data)) {
-		free(converted_src);
+		_mmcamcorder_buffer_pool_put(handle, converted_src);
 		converted_src = NULL;
 	}
 
@@ -1968,41 +3174,31 @@ gboolean _mmcamcorder_encode_jpeg(void *src_data, unsigned int src_width, unsign
 
 
 /* make UYVY smaller as multiple size. ex: 640x480 -> 320x240 or 160x120 ... */
-gboolean _mmcamcorder_downscale_UYVYorYUYV(unsigned char *src, unsigned int src_width, unsigned int src_height,
-	unsigned char **dst, unsigned int dst_width, unsigned int dst_height)
+static void __mmcamcorder_downscale_UYVYorYUYV_stripe(void *data, unsigned int start, unsigned int end)
 {
 	unsigned int i = 0;
+	unsigned int line = 0;
 	int j = 0;
 	int k = 0;
 	int src_index = 0;
-	int ratio_width = 0;
-	int ratio_height = 0;
 	int line_base = 0;
 	int line_width = 0;
 	int jump_width = 0;
+	unsigned char *src = NULL;
 	unsigned char *result = NULL;
+	_MMCamcorderConvertInfo *info = (_MMCamcorderConvertInfo *)data;
 
-	if (src == NULL || dst == NULL) {
-		_mmcam_dbg_err("src[%p] or dst[%p] is NULL", src, dst);
-		return FALSE;
-	}
-
-	result = (unsigned char *)malloc((dst_width * dst_height)<<1);
-	if (!result) {
-		_mmcam_dbg_err("failed to alloc dst data");
-		return FALSE;
-	}
-
-	ratio_width = src_width / dst_width;
-	ratio_height = src_height / dst_height;
-	line_width = src_width << 1;
-	jump_width = ratio_width << 1;
-
-	_mmcam_dbg_warn("[src %dx%d] [dst %dx%d] [line width %d] [ratio width %d, height %d]",
-		src_width, src_height, dst_width, dst_height, line_width, ratio_width, ratio_height);
+	src = info->src;
+	result = info->dst;
+	line_width = info->line_width;
+	jump_width = info->jump_width;
 
-	for (i = 0 ; i < src_height ; i += ratio_height) {
+	/* a unit is a destination line */
+	for (line = start ; line < end ; line++) {
+		i = line * info->ratio_height;
+		k = line * info->dst_line_size;
 		line_base = i * line_width;
+
 		for (j = 0 ; j < line_width ; j += jump_width) {
 			src_index = line_base + j;
 			result[k++] = src[src_index];
@@ -2018,6 +3214,54 @@ gboolean _mmcamcorder_downscale_UYVYorYUYV(unsigned char *src, unsigned int src_
 			result[k++] = src[src_index+1];
 		}
 	}
+}
+
+
+gboolean _mmcamcorder_downscale_UYVYorYUYV(MMHandleType handle, unsigned char *src, unsigned int src_width, unsigned int src_height,
+	unsigned char **dst, unsigned int dst_width, unsigned int dst_height, int arena_slot)
+{
+	unsigned int ratio_width = 0;
+	unsigned int line_num = 0;
+	unsigned int result_size = 0;
+	unsigned char *result = NULL;
+	_MMCamcorderConvertInfo info;
+
+	if (src == NULL || dst == NULL) {
+		_mmcam_dbg_err("src[%p] or dst[%p] is NULL", src, dst);
+		return FALSE;
+	}
+
+	if (dst_width == 0 || dst_height == 0 || src_width < dst_width || src_height < dst_height) {
+		_mmcam_dbg_err("invalid size [src %dx%d] [dst %dx%d]", src_width, src_height, dst_width, dst_height);
+		return FALSE;
+	}
+
+	memset(&info, 0x0, sizeof(_MMCamcorderConvertInfo));
+
+	ratio_width = src_width / dst_width;
+	info.ratio_height = src_height / dst_height;
+	info.line_width = src_width << 1;
+	info.jump_width = ratio_width << 1;
+
+	/* 4 bytes are written for every two jumps */
+	line_num = (src_height + info.ratio_height - 1) / info.ratio_height;
+	info.dst_line_size = ((info.line_width + (info.jump_width << 1) - 1) / (info.jump_width << 1)) << 2;
+
+	result_size = MAX((dst_width * dst_height) << 1, line_num * info.dst_line_size);
+
+	result = (unsigned char *)_mmcamcorder_burst_arena_alloc(handle, arena_slot, result_size);
+	if (!result) {
+		_mmcam_dbg_err("failed to alloc dst data");
+		return FALSE;
+	}
+
+	_mmcam_dbg_warn("[src %dx%d] [dst %dx%d] [line width %d] [ratio width %d, height %d]",
+		src_width, src_height, dst_width, dst_height, info.line_width, ratio_width, info.ratio_height);
+
+	info.src = src;
+	info.dst = result;
+
+	_mmcamcorder_stripe_run(handle, __mmcamcorder_downscale_UYVYorYUYV_stripe, &info, line_num);
 
 	*dst = result;
 
@@ -2106,6 +3350,12 @@ void *_mmcamcorder_util_task_thread_func(void *data)
 			_mmcam_dbg_log("_mmcamcorder_video_prepare_record return 0x%x", ret);
 			hcamcorder->task_thread_state = _MMCAMCORDER_TASK_THREAD_STATE_NONE;
 			break;
+		case _MMCAMCORDER_TASK_THREAD_STATE_ENCODE_PIPE_WARM:
+			ret = _mmcamcorder_video_warm_record((MMHandleType)hcamcorder);
+
+			_mmcam_dbg_log("_mmcamcorder_video_warm_record return 0x%x", ret);
+			hcamcorder->task_thread_state = _MMCAMCORDER_TASK_THREAD_STATE_NONE;
+			break;
 		case _MMCAMCORDER_TASK_THREAD_STATE_CHECK_CAPTURE_IN_RECORDING:
 			{
 				gint64 end_time = 0;
@@ -2149,133 +3399,208 @@ void *_mmcamcorder_util_task_thread_func(void *data)
 }
 
 
-static gboolean _mmcamcorder_convert_YUYV_to_I420(unsigned char *src, guint width, guint height, unsigned char **dst, unsigned int *dst_len)
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+static int __mmcamcorder_split_yuv422_row_kernel(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy)
 {
-	unsigned int i = 0;
-	int j = 0;
-	int src_offset = 0;
-	int dst_y_offset = 0;
-	int dst_u_offset = 0;
-	int dst_v_offset = 0;
-	int loop_length = 0;
-	unsigned int dst_size = 0;
-	unsigned char *dst_data = NULL;
-
-	if (!src || !dst || !dst_len) {
-		_mmcam_dbg_err("NULL pointer %p, %p, %p", src, dst, dst_len);
-		return FALSE;
-	}
+	int i = 0;
+	uint8x8x4_t packed;
+	uint8x8x2_t luma;
 
-	dst_size = (width * height * 3) >> 1;
+	/* 16 pixels per loop : Y0 U Y1 V(YUYV) or U Y0 V Y1(UYVY) are deinterleaved by vld4 */
+	for (i = 0 ; i + 16 <= width ; i += 16) {
+		packed = vld4_u8(src + (i << 1));
 
-	_mmcam_dbg_log("YUVY -> I420 : %dx%d, dst size %d", width, height, dst_size);
+		luma.val[0] = is_uyvy ? packed.val[1] : packed.val[0];
+		luma.val[1] = is_uyvy ? packed.val[3] : packed.val[2];
+		vst2_u8(dst_y + i, luma);
 
-	dst_data = (unsigned char *)malloc(dst_size);
-	if (!dst_data) {
-		_mmcam_dbg_err("failed to alloc dst_data. size %d", dst_size);
-		return FALSE;
+		if (dst_u) {
+			vst1_u8(dst_u + (i >> 1), is_uyvy ? packed.val[0] : packed.val[1]);
+			vst1_u8(dst_v + (i >> 1), is_uyvy ? packed.val[2] : packed.val[3]);
+		}
 	}
 
-	loop_length = width << 1;
-	dst_u_offset = width * height;
-	dst_v_offset = dst_u_offset + (dst_u_offset >> 2);
+	return i;
+}
 
-	_mmcam_dbg_log("offset y %d, u %d, v %d", dst_y_offset, dst_u_offset, dst_v_offset);
 
-	for (i = 0 ; i < height ; i++) {
-		for (j = 0 ; j < loop_length ; j += 2) {
-			dst_data[dst_y_offset++] = src[src_offset++]; /*Y*/
+static int __mmcamcorder_split_uv_kernel(unsigned char *src, unsigned char *dst_u, unsigned char *dst_v, int pair_num)
+{
+	int i = 0;
+	uint8x16x2_t uv;
 
-			if (i % 2 == 0) {
-				if (j % 4 == 0)
-					dst_data[dst_u_offset++] = src[src_offset++]; /*U*/
-				else
-					dst_data[dst_v_offset++] = src[src_offset++]; /*V*/
-			} else {
-				src_offset++;
-			}
-		}
+	for (i = 0 ; i + 16 <= pair_num ; i += 16) {
+		uv = vld2q_u8(src + (i << 1));
+		vst1q_u8(dst_u + i, uv.val[0]);
+		vst1q_u8(dst_v + i, uv.val[1]);
 	}
 
-	*dst = dst_data;
-	*dst_len = dst_size;
+	return i;
+}
+#elif defined(__SSE2__)
+static int __mmcamcorder_split_yuv422_row_kernel(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy)
+{
+	int i = 0;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask_low = _mm_set1_epi16(0x00ff);
+	__m128i packed[2];
+	__m128i luma[2];
+	__m128i chroma[2];
+	__m128i uv;
+
+	/* 16 pixels per loop : low and high byte of each 16 bits lane are split by mask and shift */
+	for (i = 0 ; i + 16 <= width ; i += 16) {
+		packed[0] = _mm_loadu_si128((const __m128i *)(src + (i << 1)));
+		packed[1] = _mm_loadu_si128((const __m128i *)(src + (i << 1) + 16));
+
+		if (is_uyvy) {
+			luma[0] = _mm_srli_epi16(packed[0], 8);
+			luma[1] = _mm_srli_epi16(packed[1], 8);
+			chroma[0] = _mm_and_si128(packed[0], mask_low);
+			chroma[1] = _mm_and_si128(packed[1], mask_low);
+		} else {
+			luma[0] = _mm_and_si128(packed[0], mask_low);
+			luma[1] = _mm_and_si128(packed[1], mask_low);
+			chroma[0] = _mm_srli_epi16(packed[0], 8);
+			chroma[1] = _mm_srli_epi16(packed[1], 8);
+		}
 
-	_mmcam_dbg_log("DONE: YUVY -> I420 : %dx%d, dst data %p, size %d", width, height, *dst, dst_size);
+		_mm_storeu_si128((__m128i *)(dst_y + i), _mm_packus_epi16(luma[0], luma[1]));
 
-	return TRUE;
+		if (dst_u) {
+			uv = _mm_packus_epi16(chroma[0], chroma[1]);
+			_mm_storel_epi64((__m128i *)(dst_u + (i >> 1)), _mm_packus_epi16(_mm_and_si128(uv, mask_low), zero));
+			_mm_storel_epi64((__m128i *)(dst_v + (i >> 1)), _mm_packus_epi16(_mm_srli_epi16(uv, 8), zero));
+		}
+	}
+
+	return i;
 }
 
 
-static gboolean _mmcamcorder_convert_UYVY_to_I420(unsigned char *src, guint width, guint height, unsigned char **dst, unsigned int *dst_len)
+static int __mmcamcorder_split_uv_kernel(unsigned char *src, unsigned char *dst_u, unsigned char *dst_v, int pair_num)
 {
-	unsigned int i = 0;
-	int j = 0;
-	int src_offset = 0;
-	int dst_y_offset = 0;
-	int dst_u_offset = 0;
-	int dst_v_offset = 0;
-	int loop_length = 0;
-	unsigned int dst_size = 0;
-	unsigned char *dst_data = NULL;
-
-	if (!src || !dst || !dst_len) {
-		_mmcam_dbg_err("NULL pointer %p, %p, %p", src, dst, dst_len);
-		return FALSE;
+	int i = 0;
+	const __m128i mask_low = _mm_set1_epi16(0x00ff);
+	__m128i uv[2];
+
+	for (i = 0 ; i + 16 <= pair_num ; i += 16) {
+		uv[0] = _mm_loadu_si128((const __m128i *)(src + (i << 1)));
+		uv[1] = _mm_loadu_si128((const __m128i *)(src + (i << 1) + 16));
+
+		_mm_storeu_si128((__m128i *)(dst_u + i),
+			_mm_packus_epi16(_mm_and_si128(uv[0], mask_low), _mm_and_si128(uv[1], mask_low)));
+		_mm_storeu_si128((__m128i *)(dst_v + i),
+			_mm_packus_epi16(_mm_srli_epi16(uv[0], 8), _mm_srli_epi16(uv[1], 8)));
 	}
 
-	dst_size = (width * height * 3) >> 1;
+	return i;
+}
+#else /* __ARM_NEON || __SSE2__ */
+static int __mmcamcorder_split_yuv422_row_kernel(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy)
+{
+	return 0;
+}
 
-	_mmcam_dbg_log("UYVY -> I420 : %dx%d, dst size %d", width, height, dst_size);
 
-	dst_data = (unsigned char *)malloc(dst_size);
-	if (!dst_data) {
-		_mmcam_dbg_err("failed to alloc dst_data. size %d", dst_size);
-		return FALSE;
-	}
+static int __mmcamcorder_split_uv_kernel(unsigned char *src, unsigned char *dst_u, unsigned char *dst_v, int pair_num)
+{
+	return 0;
+}
+#endif /* __ARM_NEON || __SSE2__ */
 
-	loop_length = width << 1;
-	dst_u_offset = width * height;
-	dst_v_offset = dst_u_offset + (dst_u_offset >> 2);
 
-	_mmcam_dbg_log("offset y %d, u %d, v %d", dst_y_offset, dst_u_offset, dst_v_offset);
+void _mmcamcorder_split_yuv422_row_ref(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy)
+{
+	int i = 0;
+	int luma_offset = is_uyvy ? 1 : 0;
+	int chroma_offset = is_uyvy ? 0 : 1;
 
-	for (i = 0 ; i < height ; i++) {
-		for (j = 0 ; j < loop_length ; j += 2) {
-			if (i % 2 == 0) {
-				if (j % 4 == 0)
-					dst_data[dst_u_offset++] = src[src_offset++]; /*U*/
-				else
-					dst_data[dst_v_offset++] = src[src_offset++]; /*V*/
-			} else {
-				src_offset++;
-			}
+	for (i = 0 ; i < width ; i++) {
+		dst_y[i] = src[(i << 1) + luma_offset];
 
-			dst_data[dst_y_offset++] = src[src_offset++]; /*Y*/
+		/* chroma of the last pixel of odd width is not used : chroma width is (width / 2) */
+		if (dst_u && i % 2 == 0 && i + 1 < width) {
+			dst_u[i >> 1] = src[(i << 1) + chroma_offset];
+			dst_v[i >> 1] = src[(i << 1) + 2 + chroma_offset];
 		}
 	}
+}
+
 
-	*dst = dst_data;
-	*dst_len = dst_size;
+void _mmcamcorder_split_yuv422_row(unsigned char *src, unsigned char *dst_y,
+	unsigned char *dst_u, unsigned char *dst_v, int width, gboolean is_uyvy)
+{
+	int i = 0;
+	int luma_offset = is_uyvy ? 1 : 0;
+	int chroma_offset = is_uyvy ? 0 : 1;
 
-	_mmcam_dbg_log("DONE: UYVY -> I420 : %dx%d, dst data %p, size %d", width, height, *dst, dst_size);
+	i = __mmcamcorder_split_yuv422_row_kernel(src, dst_y, dst_u, dst_v, width, is_uyvy);
 
-	return TRUE;
+	/* remained pixels */
+	for ( ; i + 1 < width ; i += 2) {
+		dst_y[i] = src[(i << 1) + luma_offset];
+		dst_y[i + 1] = src[(i << 1) + 2 + luma_offset];
+
+		if (dst_u) {
+			dst_u[i >> 1] = src[(i << 1) + chroma_offset];
+			dst_v[i >> 1] = src[(i << 1) + 2 + chroma_offset];
+		}
+	}
+
+	/* the last pixel of odd width */
+	if (i < width)
+		dst_y[i] = src[(i << 1) + luma_offset];
 }
 
 
-static gboolean _mmcamcorder_convert_NV12_to_I420(unsigned char *src, guint width, guint height, unsigned char **dst, unsigned int *dst_len)
+static void __mmcamcorder_split_uv_row(unsigned char *src, unsigned char *dst_u, unsigned char *dst_v, int pair_num)
 {
 	int i = 0;
-	int src_offset = 0;
-	int dst_y_offset = 0;
-	int dst_u_offset = 0;
-	int dst_v_offset = 0;
-	int loop_length = 0;
-	unsigned int dst_size = 0;
-	unsigned char *dst_data = NULL;
-
-	if (!src || !dst || !dst_len) {
-		_mmcam_dbg_err("NULL pointer %p, %p, %p", src, dst, dst_len);
+
+	i = __mmcamcorder_split_uv_kernel(src, dst_u, dst_v, pair_num);
+
+	/* remained pairs */
+	for ( ; i < pair_num ; i++) {
+		dst_u[i] = src[i << 1];
+		dst_v[i] = src[(i << 1) + 1];
+	}
+}
+
+
+static void __mmcamcorder_convert_YUV422_to_I420_stripe(void *data, unsigned int start, unsigned int end)
+{
+	unsigned int i = 0;
+	_MMCamcorderConvertInfo *info = (_MMCamcorderConvertInfo *)data;
+	unsigned char *dst_y = info->dst;
+	unsigned char *dst_u = dst_y + (info->width * info->height);
+	unsigned char *dst_v = dst_u + ((info->width * info->height) >> 2);
+
+	/* a unit is two lines, and chroma of even line is used for I420 */
+	for (i = start << 1 ; i < (end << 1) && i < info->height ; i++) {
+		if (i % 2 == 0) {
+			_mmcamcorder_split_yuv422_row(info->src + (i * info->src_stride), dst_y + (i * info->width),
+				dst_u + ((i >> 1) * (info->width >> 1)), dst_v + ((i >> 1) * (info->width >> 1)),
+				info->width, info->is_uyvy);
+		} else {
+			_mmcamcorder_split_yuv422_row(info->src + (i * info->src_stride), dst_y + (i * info->width),
+				NULL, NULL, info->width, info->is_uyvy);
+		}
+	}
+}
+
+
+static gboolean __mmcamcorder_convert_YUV422_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height,
+	guint src_stride, unsigned char *dst, gboolean is_uyvy)
+{
+	_MMCamcorderConvertInfo info;
+
+	if (!src || !dst) {
+		_mmcam_dbg_err("NULL pointer %p, %p", src, dst);
 		return FALSE;
 	}
 
@@ -2285,40 +3610,123 @@ static gboolean _mmcamcorder_convert_NV12_to_I420(unsigned char *src, guint widt
 		return FALSE;
 	}
 
-	dst_size = (width * height * 3) >> 1;
+	memset(&info, 0x0, sizeof(_MMCamcorderConvertInfo));
 
-	_mmcam_dbg_log("NV12 -> I420 : %dx%d, dst size %d", width, height, dst_size);
+	info.src = src;
+	info.dst = dst;
+	info.width = width;
+	info.height = height;
+	info.src_stride = src_stride;
+	info.is_uyvy = is_uyvy;
 
-	dst_data = (unsigned char *)malloc(dst_size);
-	if (!dst_data) {
-		_mmcam_dbg_err("failed to alloc dst_data. size %d", dst_size);
-		return FALSE;
+	_mmcamcorder_stripe_run(handle, __mmcamcorder_convert_YUV422_to_I420_stripe, &info, (height + 1) >> 1);
+
+	return TRUE;
+}
+
+
+static gboolean _mmcamcorder_convert_YUYV_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height, guint src_stride, unsigned char *dst)
+{
+	gboolean ret = FALSE;
+
+	_mmcam_dbg_log("YUYV -> I420 : %dx%d, dst %p", width, height, dst);
+
+	ret = __mmcamcorder_convert_YUV422_to_I420(handle, src, width, height, src_stride, dst, FALSE);
+
+	_mmcam_dbg_log("DONE: YUYV -> I420 : ret %d", ret);
+
+	return ret;
+}
+
+
+static gboolean _mmcamcorder_convert_UYVY_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height, guint src_stride, unsigned char *dst)
+{
+	gboolean ret = FALSE;
+
+	_mmcam_dbg_log("UYVY -> I420 : %dx%d, dst %p", width, height, dst);
+
+	ret = __mmcamcorder_convert_YUV422_to_I420(handle, src, width, height, src_stride, dst, TRUE);
+
+	_mmcam_dbg_log("DONE: UYVY -> I420 : ret %d", ret);
+
+	return ret;
+}
+
+
+static void __mmcamcorder_convert_NV12_to_I420_stripe(void *data, unsigned int start, unsigned int end)
+{
+	unsigned int i = 0;
+	unsigned int y_size = 0;
+	unsigned int pair_num = 0;
+	unsigned int pair_start = 0;
+	unsigned int pair_end = 0;
+	unsigned int pair_line = 0;
+	unsigned char *src_uv = NULL;
+	unsigned char *dst_u = NULL;
+	unsigned char *dst_v = NULL;
+	_MMCamcorderConvertInfo *info = (_MMCamcorderConvertInfo *)data;
+
+	y_size = info->width * info->height;
+	pair_num = y_size >> 2;
+	src_uv = info->src + (info->src_stride * info->height);
+	dst_u = info->dst + y_size;
+	dst_v = dst_u + pair_num;
+
+	if (info->src_stride != info->width) {
+		/* a unit is a line : copy Y line, and split UV line for even line */
+		pair_line = info->width >> 1;
+
+		for (i = start ; i < end ; i++) {
+			memcpy(info->dst + (i * info->width), info->src + (i * info->src_stride), info->width);
+
+			if (i % 2 == 0) {
+				__mmcamcorder_split_uv_row(src_uv + ((i >> 1) * info->src_stride),
+					dst_u + ((i >> 1) * pair_line), dst_v + ((i >> 1) * pair_line), pair_line);
+			}
+		}
+
+		return;
 	}
 
-	loop_length = width << 1;
-	dst_u_offset = width * height;
-	dst_v_offset = dst_u_offset + (dst_u_offset >> 2);
+	/* memcpy Y : a unit is a line */
+	memcpy(info->dst + (start * info->width), info->src + (start * info->width), (end - start) * info->width);
+
+	/* split U and V in the same portion of chroma plane */
+	pair_start = (unsigned int)(((guint64)pair_num * start) / info->height);
+	pair_end = (unsigned int)(((guint64)pair_num * end) / info->height);
 
-	_mmcam_dbg_log("offset y %d, u %d, v %d", dst_y_offset, dst_u_offset, dst_v_offset);
+	__mmcamcorder_split_uv_row(src_uv + (pair_start << 1), dst_u + pair_start, dst_v + pair_start, pair_end - pair_start);
+}
 
-	/* memcpy Y */
-	memcpy(dst_data, src, dst_u_offset);
 
-	loop_length = dst_u_offset >> 1;
-	src_offset = dst_u_offset;
+static gboolean _mmcamcorder_convert_NV12_to_I420(MMHandleType handle, unsigned char *src, guint width, guint height, guint src_stride, unsigned char *dst)
+{
+	_MMCamcorderConvertInfo info;
 
-	/* set U and V */
-	for (i = 0 ; i < loop_length ; i++) {
-		if (i % 2 == 0)
-			dst_data[dst_u_offset++] = src[src_offset++];
-		else
-			dst_data[dst_v_offset++] = src[src_offset++];
+	if (!src || !dst) {
+		_mmcam_dbg_err("NULL pointer %p, %p", src, dst);
+		return FALSE;
+	}
+
+	/* buffer overflow prevention check */
+	if (width > __MMCAMCORDER_MAX_WIDTH || height > __MMCAMCORDER_MAX_HEIGHT) {
+		_mmcam_dbg_err("too large size %d x %d", width, height);
+		return FALSE;
 	}
 
-	*dst = dst_data;
-	*dst_len = dst_size;
+	_mmcam_dbg_log("NV12 -> I420 : %dx%d, dst %p", width, height, dst);
+
+	memset(&info, 0x0, sizeof(_MMCamcorderConvertInfo));
+
+	info.src = src;
+	info.dst = dst;
+	info.width = width;
+	info.height = height;
+	info.src_stride = src_stride;
 
-	_mmcam_dbg_log("DONE: NV12 -> I420 : %dx%d, dst data %p, size %d", width, height, *dst, dst_size);
+	_mmcamcorder_stripe_run(handle, __mmcamcorder_convert_NV12_to_I420_stripe, &info, height);
+
+	_mmcam_dbg_log("DONE: NV12 -> I420 : %dx%d", width, height);
 
 	return TRUE;
 }
@@ -2368,3 +3776,688 @@ int _mmcamcorder_get_audiosrc_blocksize(int samplerate, int format, int channel,
 
 	return TRUE;
 }
+
+
+gboolean _mmcamcorder_get_audio_square_sum_ref(unsigned char *data, int size, int format, int channel,
+	guint64 *square_sum, int *count)
+{
+	int i = 0;
+	int sample = 0;
+	int sample_num = 0;
+
+	if (!data || !square_sum || !count) {
+		_mmcam_dbg_err("NULL ptr %p %p %p", data, square_sum, count);
+		return FALSE;
+	}
+
+	if (channel < 1 || channel > _MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX) {
+		_mmcam_dbg_err("invalid channel %d", channel);
+		return FALSE;
+	}
+
+	for (i = 0 ; i < channel ; i++)
+		square_sum[i] = 0;
+
+	if (format == MM_CAMCORDER_AUDIO_FORMAT_PCM_S16_LE) {
+		gint16 *pcm16 = (gint16 *)data;
+
+		sample_num = (size >> 1) - ((size >> 1) % channel);
+
+		for (i = 0 ; i < sample_num ; i++) {
+			sample = pcm16[i];
+			square_sum[i % channel] += (guint64)(sample * sample);
+		}
+	} else { /* MM_CAMCORDER_AUDIO_FORMAT_PCM_U8 */
+		sample_num = size - (size % channel);
+
+		for (i = 0 ; i < sample_num ; i++) {
+			sample = (int)data[i] - 128;
+			square_sum[i % channel] += (guint64)(sample * sample);
+		}
+	}
+
+	*count = sample_num / channel;
+
+	return TRUE;
+}
+
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+static int __mmcamcorder_square_sum_s16_kernel(gint16 *pcm16, int frame_num, int channel, guint64 *square_sum)
+{
+	int i = 0;
+	int frame_done = 0;
+	int32x4_t square = {0, };
+	int64x2_t sum[_MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX] = {{0, }, };
+
+	/* 8 frames per loop, square of S16 fits in 31 bits */
+	if (channel == 1) {
+		for (i = 0 ; i + 8 <= frame_num ; i += 8) {
+			int16x8_t v = vld1q_s16(pcm16 + i);
+
+			square = vmull_s16(vget_low_s16(v), vget_low_s16(v));
+			sum[0] = vpadalq_s32(sum[0], square);
+			square = vmull_s16(vget_high_s16(v), vget_high_s16(v));
+			sum[0] = vpadalq_s32(sum[0], square);
+		}
+	} else {
+		for (i = 0 ; i + 8 <= frame_num ; i += 8) {
+			int16x8x2_t v = vld2q_s16(pcm16 + (i << 1));
+
+			square = vmull_s16(vget_low_s16(v.val[0]), vget_low_s16(v.val[0]));
+			sum[0] = vpadalq_s32(sum[0], square);
+			square = vmull_s16(vget_high_s16(v.val[0]), vget_high_s16(v.val[0]));
+			sum[0] = vpadalq_s32(sum[0], square);
+			square = vmull_s16(vget_low_s16(v.val[1]), vget_low_s16(v.val[1]));
+			sum[1] = vpadalq_s32(sum[1], square);
+			square = vmull_s16(vget_high_s16(v.val[1]), vget_high_s16(v.val[1]));
+			sum[1] = vpadalq_s32(sum[1], square);
+		}
+	}
+
+	frame_done = i;
+
+	for (i = 0 ; i < channel ; i++)
+		square_sum[i] = (guint64)vgetq_lane_s64(sum[i], 0) + (guint64)vgetq_lane_s64(sum[i], 1);
+
+	return frame_done;
+}
+#elif defined(__SSE2__)
+static int __mmcamcorder_square_sum_s16_kernel(gint16 *pcm16, int frame_num, int channel, guint64 *square_sum)
+{
+	int i = 0;
+	int frame_done = 0;
+	guint64 lane[2] = {0, };
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask_even = _mm_set1_epi32(0x0000ffff);
+	__m128i v = zero;
+	__m128i square = zero;
+	__m128i sum[_MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX] = {zero, zero};
+
+	/* _mm_madd_epi16 adds two squares into 32 bits lane, it's widened to 64 bits before accumulation */
+	if (channel == 1) {
+		for (i = 0 ; i + 8 <= frame_num ; i += 8) {
+			v = _mm_loadu_si128((const __m128i *)(pcm16 + i));
+			square = _mm_madd_epi16(v, v);
+			sum[0] = _mm_add_epi64(sum[0], _mm_unpacklo_epi32(square, zero));
+			sum[0] = _mm_add_epi64(sum[0], _mm_unpackhi_epi32(square, zero));
+		}
+	} else {
+		/* 4 frames per loop : left channel is low 16 bits of each 32 bits lane */
+		for (i = 0 ; i + 4 <= frame_num ; i += 4) {
+			v = _mm_loadu_si128((const __m128i *)(pcm16 + (i << 1)));
+			square = _mm_and_si128(v, mask_even);
+			square = _mm_madd_epi16(square, square);
+			sum[0] = _mm_add_epi64(sum[0], _mm_unpacklo_epi32(square, zero));
+			sum[0] = _mm_add_epi64(sum[0], _mm_unpackhi_epi32(square, zero));
+			square = _mm_srli_epi32(v, 16);
+			square = _mm_madd_epi16(square, square);
+			sum[1] = _mm_add_epi64(sum[1], _mm_unpacklo_epi32(square, zero));
+			sum[1] = _mm_add_epi64(sum[1], _mm_unpackhi_epi32(square, zero));
+		}
+	}
+
+	frame_done = i;
+
+	for (i = 0 ; i < channel ; i++) {
+		_mm_storeu_si128((__m128i *)lane, sum[i]);
+		square_sum[i] = lane[0] + lane[1];
+	}
+
+	return frame_done;
+}
+#else /* __ARM_NEON || __SSE2__ */
+static int __mmcamcorder_square_sum_s16_kernel(gint16 *pcm16, int frame_num, int channel, guint64 *square_sum)
+{
+	int i = 0;
+	int frame_done = 0;
+	guint64 sum[4] = {0, };
+
+	/* unrolled without branch to be vectorized by compiler */
+	if (channel == 1) {
+		for (i = 0 ; i + 4 <= frame_num ; i += 4) {
+			sum[0] += (guint64)(pcm16[i] * pcm16[i]);
+			sum[1] += (guint64)(pcm16[i + 1] * pcm16[i + 1]);
+			sum[2] += (guint64)(pcm16[i + 2] * pcm16[i + 2]);
+			sum[3] += (guint64)(pcm16[i + 3] * pcm16[i + 3]);
+		}
+
+		square_sum[0] = sum[0] + sum[1] + sum[2] + sum[3];
+	} else {
+		for (i = 0 ; i + 2 <= frame_num ; i += 2) {
+			sum[0] += (guint64)(pcm16[(i << 1)] * pcm16[(i << 1)]);
+			sum[1] += (guint64)(pcm16[(i << 1) + 1] * pcm16[(i << 1) + 1]);
+			sum[2] += (guint64)(pcm16[(i << 1) + 2] * pcm16[(i << 1) + 2]);
+			sum[3] += (guint64)(pcm16[(i << 1) + 3] * pcm16[(i << 1) + 3]);
+		}
+
+		square_sum[0] = sum[0] + sum[2];
+		square_sum[1] = sum[1] + sum[3];
+	}
+
+	frame_done = i;
+
+	return frame_done;
+}
+#endif /* __ARM_NEON || __SSE2__ */
+
+
+gboolean _mmcamcorder_get_audio_square_sum(unsigned char *data, int size, int format, int channel,
+	guint64 *square_sum, int *count)
+{
+	int i = 0;
+	int frame_num = 0;
+	int frame_done = 0;
+	int sample = 0;
+	gint16 *pcm16 = NULL;
+
+	if (format != MM_CAMCORDER_AUDIO_FORMAT_PCM_S16_LE ||
+		channel < 1 || channel > _MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX)
+		return _mmcamcorder_get_audio_square_sum_ref(data, size, format, channel, square_sum, count);
+
+	if (!data || !square_sum || !count) {
+		_mmcam_dbg_err("NULL ptr %p %p %p", data, square_sum, count);
+		return FALSE;
+	}
+
+	pcm16 = (gint16 *)data;
+	frame_num = (size >> 1) / channel;
+
+	frame_done = __mmcamcorder_square_sum_s16_kernel(pcm16, frame_num, channel, square_sum);
+
+	/* remained samples */
+	for (i = frame_done * channel ; i < frame_num * channel ; i++) {
+		sample = pcm16[i];
+		square_sum[i % channel] += (guint64)(sample * sample);
+	}
+
+	*count = frame_num;
+
+	return TRUE;
+}
+
+
+unsigned char *_mmcamcorder_buffer_pool_get(MMHandleType handle, unsigned int size)
+{
+	int i = 0;
+	int index = -1;
+	void *data = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBufferPool *pool = NULL;
+
+	if (size == 0) {
+		_mmcam_dbg_err("invalid size");
+		return NULL;
+	}
+
+	if (!hcamcorder) {
+		/* no pool, just allocate it */
+		if (posix_memalign(&data, _MMCAMCORDER_BUFFER_POOL_ALIGN, size) != 0) {
+			_mmcam_dbg_err("failed to alloc size %u", size);
+			return NULL;
+		}
+
+		return (unsigned char *)data;
+	}
+
+	pool = &hcamcorder->buffer_pool;
+
+	g_mutex_lock(&pool->lock);
+
+	/* find free buffer which is large enough, or any free one to be reallocated */
+	for (i = 0 ; i < _MMCAMCORDER_BUFFER_POOL_SIZE ; i++) {
+		if (pool->in_use[i])
+			continue;
+
+		if (pool->data[i] && pool->size[i] >= size) {
+			index = i;
+			break;
+		}
+
+		if (index < 0)
+			index = i;
+	}
+
+	if (index < 0) {
+		g_mutex_unlock(&pool->lock);
+
+		_mmcam_dbg_warn("no free buffer in pool, allocate size %u", size);
+
+		if (posix_memalign(&data, _MMCAMCORDER_BUFFER_POOL_ALIGN, size) != 0) {
+			_mmcam_dbg_err("failed to alloc size %u", size);
+			return NULL;
+		}
+
+		return (unsigned char *)data;
+	}
+
+	if (!pool->data[index] || pool->size[index] < size) {
+		_mmcam_dbg_log("alloc pool buffer[%d] size %u -> %u", index, pool->size[index], size);
+
+		SAFE_FREE(pool->data[index]);
+		pool->size[index] = 0;
+
+		if (posix_memalign(&data, _MMCAMCORDER_BUFFER_POOL_ALIGN, size) != 0) {
+			g_mutex_unlock(&pool->lock);
+			_mmcam_dbg_err("failed to alloc size %u", size);
+			return NULL;
+		}
+
+		pool->data[index] = (unsigned char *)data;
+		pool->size[index] = size;
+	}
+
+	pool->in_use[index] = TRUE;
+	data = pool->data[index];
+
+	g_mutex_unlock(&pool->lock);
+
+	return (unsigned char *)data;
+}
+
+
+void _mmcamcorder_buffer_pool_put(MMHandleType handle, unsigned char *data)
+{
+	int i = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBufferPool *pool = NULL;
+
+	if (!data)
+		return;
+
+	if (hcamcorder) {
+		pool = &hcamcorder->buffer_pool;
+
+		g_mutex_lock(&pool->lock);
+
+		for (i = 0 ; i < _MMCAMCORDER_BUFFER_POOL_SIZE ; i++) {
+			if (pool->data[i] == data) {
+				pool->in_use[i] = FALSE;
+				g_mutex_unlock(&pool->lock);
+				return;
+			}
+		}
+
+		g_mutex_unlock(&pool->lock);
+	}
+
+	/* not from pool */
+	free(data);
+
+	return;
+}
+
+
+void _mmcamcorder_buffer_pool_flush(MMHandleType handle)
+{
+	int i = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBufferPool *pool = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	pool = &hcamcorder->buffer_pool;
+
+	g_mutex_lock(&pool->lock);
+
+	for (i = 0 ; i < _MMCAMCORDER_BUFFER_POOL_SIZE ; i++) {
+		if (pool->in_use[i]) {
+			_mmcam_dbg_warn("buffer[%d] %p is in use", i, pool->data[i]);
+			continue;
+		}
+
+		if (pool->data[i])
+			_mmcam_dbg_log("release pool buffer[%d] %p, size %u", i, pool->data[i], pool->size[i]);
+
+		SAFE_FREE(pool->data[i]);
+		pool->size[i] = 0;
+	}
+
+	g_mutex_unlock(&pool->lock);
+
+	return;
+}
+
+
+gboolean _mmcamcorder_burst_arena_prepare(MMHandleType handle, int slot_num, unsigned int slot_size)
+{
+	int i = 0;
+	void *data = NULL;
+	unsigned int need_size = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBurstArena *arena = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, FALSE);
+
+	if (slot_num < 1 || slot_size == 0) {
+		_mmcam_dbg_err("invalid slot num %d or size %u", slot_num, slot_size);
+		return FALSE;
+	}
+
+	arena = &hcamcorder->burst_arena;
+
+	slot_num = MIN(slot_num, _MMCAMCORDER_BURST_ARENA_SLOT_MAX);
+	slot_size = (slot_size + _MMCAMCORDER_BURST_ARENA_ALIGN - 1) & ~(_MMCAMCORDER_BURST_ARENA_ALIGN - 1);
+
+	if (slot_size > G_MAXUINT / (unsigned int)slot_num) {
+		_mmcam_dbg_err("too large arena - slot num %d, size %u", slot_num, slot_size);
+		return FALSE;
+	}
+
+	need_size = slot_size * slot_num;
+
+	g_mutex_lock(&arena->lock);
+
+	/* keep current layout until previous burst is released */
+	for (i = 0 ; i < arena->slot_num ; i++) {
+		if (arena->in_use[i]) {
+			_mmcam_dbg_warn("slot[%d] is in use, keep current arena", i);
+			g_mutex_unlock(&arena->lock);
+			return FALSE;
+		}
+	}
+
+	/* recycle memory of previous burst if it's large enough */
+	if (arena->size < need_size) {
+		_mmcam_dbg_log("alloc arena size %u -> %u", arena->size, need_size);
+
+		SAFE_FREE(arena->data);
+		arena->size = 0;
+		arena->slot_num = 0;
+
+		if (posix_memalign(&data, _MMCAMCORDER_BURST_ARENA_ALIGN, need_size) != 0) {
+			g_mutex_unlock(&arena->lock);
+			_mmcam_dbg_err("failed to alloc arena size %u", need_size);
+			return FALSE;
+		}
+
+		arena->data = (unsigned char *)data;
+		arena->size = need_size;
+	}
+
+	arena->slot_num = slot_num;
+	arena->slot_size = slot_size;
+	arena->fallback_count = 0;
+
+	for (i = 0 ; i < _MMCAMCORDER_BURST_ARENA_SLOT_MAX ; i++) {
+		arena->used[i] = 0;
+		arena->in_use[i] = FALSE;
+	}
+
+	g_mutex_unlock(&arena->lock);
+
+	_mmcam_dbg_log("arena %p - slot num %d, size %u", arena->data, slot_num, slot_size);
+
+	return TRUE;
+}
+
+
+int _mmcamcorder_burst_arena_acquire(MMHandleType handle)
+{
+	int i = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBurstArena *arena = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, -1);
+
+	arena = &hcamcorder->burst_arena;
+
+	g_mutex_lock(&arena->lock);
+
+	for (i = 0 ; i < arena->slot_num ; i++) {
+		if (!arena->in_use[i]) {
+			arena->in_use[i] = TRUE;
+			arena->used[i] = 0;
+			g_mutex_unlock(&arena->lock);
+			return i;
+		}
+	}
+
+	g_mutex_unlock(&arena->lock);
+
+	_mmcam_dbg_warn("no free slot in arena[num %d]", arena->slot_num);
+
+	return -1;
+}
+
+
+void *_mmcamcorder_burst_arena_alloc(MMHandleType handle, int slot, unsigned int size)
+{
+	unsigned int aligned_size = 0;
+	void *data = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBurstArena *arena = NULL;
+
+	if (size == 0)
+		return NULL;
+
+	if (hcamcorder && slot >= 0 && slot < _MMCAMCORDER_BURST_ARENA_SLOT_MAX) {
+		arena = &hcamcorder->burst_arena;
+		aligned_size = (size + _MMCAMCORDER_BURST_ARENA_ALIGN - 1) & ~(_MMCAMCORDER_BURST_ARENA_ALIGN - 1);
+
+		g_mutex_lock(&arena->lock);
+
+		if (arena->in_use[slot] && aligned_size >= size &&
+			aligned_size <= arena->slot_size - arena->used[slot]) {
+			data = arena->data + (arena->slot_size * slot) + arena->used[slot];
+			arena->used[slot] += aligned_size;
+			g_mutex_unlock(&arena->lock);
+			return data;
+		}
+
+		arena->fallback_count++;
+
+		_mmcam_dbg_warn("slot[%d] is not enough for size %u, used %u/%u",
+			slot, size, arena->used[slot], arena->slot_size);
+
+		g_mutex_unlock(&arena->lock);
+	}
+
+	/* not from arena */
+	return malloc(size);
+}
+
+
+void _mmcamcorder_burst_arena_free(MMHandleType handle, void *data)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBurstArena *arena = NULL;
+
+	if (!data)
+		return;
+
+	if (hcamcorder) {
+		arena = &hcamcorder->burst_arena;
+
+		g_mutex_lock(&arena->lock);
+
+		/* memory in arena is reclaimed when its slot is released */
+		if (arena->data && (unsigned char *)data >= arena->data &&
+			(unsigned char *)data < arena->data + arena->size) {
+			g_mutex_unlock(&arena->lock);
+			return;
+		}
+
+		g_mutex_unlock(&arena->lock);
+	}
+
+	/* not from arena */
+	free(data);
+
+	return;
+}
+
+
+void _mmcamcorder_burst_arena_release(MMHandleType handle, int slot)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBurstArena *arena = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	if (slot < 0 || slot >= _MMCAMCORDER_BURST_ARENA_SLOT_MAX)
+		return;
+
+	arena = &hcamcorder->burst_arena;
+
+	g_mutex_lock(&arena->lock);
+
+	arena->in_use[slot] = FALSE;
+	arena->used[slot] = 0;
+
+	g_mutex_unlock(&arena->lock);
+
+	return;
+}
+
+
+void _mmcamcorder_burst_arena_flush(MMHandleType handle)
+{
+	int i = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderBurstArena *arena = NULL;
+
+	mmf_return_if_fail(hcamcorder);
+
+	arena = &hcamcorder->burst_arena;
+
+	g_mutex_lock(&arena->lock);
+
+	for (i = 0 ; i < arena->slot_num ; i++) {
+		if (arena->in_use[i]) {
+			_mmcam_dbg_warn("slot[%d] is in use, skip release arena", i);
+			g_mutex_unlock(&arena->lock);
+			return;
+		}
+	}
+
+	if (arena->data) {
+		_mmcam_dbg_log("release arena %p, size %u, fallback count %d",
+			arena->data, arena->size, arena->fallback_count);
+	}
+
+	SAFE_FREE(arena->data);
+	arena->size = 0;
+	arena->slot_size = 0;
+	arena->slot_num = 0;
+
+	g_mutex_unlock(&arena->lock);
+
+	return;
+}
+
+
+static void __mmcamcorder_stripe_worker(gpointer data, gpointer user_data)
+{
+	_MMCamcorderStripeTask *task = (_MMCamcorderStripeTask *)data;
+
+	mmf_return_if_fail(task && task->func && task->sync);
+
+	task->func(task->data, task->start, task->end);
+
+	g_mutex_lock(&task->sync->lock);
+	task->sync->remained--;
+	g_cond_signal(&task->sync->cond);
+	g_mutex_unlock(&task->sync->lock);
+}
+
+
+GThreadPool *_mmcamcorder_stripe_pool_new(MMHandleType handle, int *thread_num)
+{
+	int conf_thread_num = 0;
+	GThreadPool *pool = NULL;
+	GError *error = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder && thread_num, NULL);
+
+	/* 0 : number of processors, 1 : serial */
+	_mmcamcorder_conf_get_value_int(handle, hcamcorder->conf_main,
+		CONFIGURE_CATEGORY_MAIN_CAPTURE,
+		"ConvertThreadNum",
+		&conf_thread_num);
+
+	if (conf_thread_num <= 0)
+		conf_thread_num = (int)g_get_num_processors();
+
+	*thread_num = CLAMP(conf_thread_num, 1, _MMCAMCORDER_STRIPE_THREAD_MAX);
+
+	_mmcam_dbg_log("stripe thread num %d (conf %d)", *thread_num, conf_thread_num);
+
+	if (*thread_num <= 1)
+		return NULL;
+
+	/* caller thread also processes a stripe */
+	pool = g_thread_pool_new(__mmcamcorder_stripe_worker, NULL, *thread_num - 1, TRUE, &error);
+	if (!pool) {
+		_mmcam_dbg_err("failed to create stripe pool [%s]", error ? error->message : "unknown");
+		g_clear_error(&error);
+		*thread_num = 1;
+	}
+
+	return pool;
+}
+
+
+void _mmcamcorder_stripe_run(MMHandleType handle, _MMCamcorderStripeFunc func, void *data, unsigned int total)
+{
+	int i = 0;
+	int stripe_num = 1;
+	unsigned int stripe_size = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderStripeSync sync;
+	_MMCamcorderStripeTask task[_MMCAMCORDER_STRIPE_THREAD_MAX];
+
+	mmf_return_if_fail(func);
+
+	if (hcamcorder && hcamcorder->stripe_pool)
+		stripe_num = MIN(hcamcorder->stripe_thread_num, (int)(total / _MMCAMCORDER_STRIPE_MIN_UNIT));
+
+	if (stripe_num <= 1) {
+		func(data, 0, total);
+		return;
+	}
+
+	stripe_size = (total + stripe_num - 1) / stripe_num;
+
+	g_mutex_init(&sync.lock);
+	g_cond_init(&sync.cond);
+	sync.remained = 0;
+
+	for (i = 0 ; i < stripe_num ; i++) {
+		task[i].func = func;
+		task[i].data = data;
+		task[i].start = MIN(total, i * stripe_size);
+		task[i].end = MIN(total, (i + 1) * stripe_size);
+		task[i].sync = &sync;
+	}
+
+	/* push stripes except the first one which is processed in this thread */
+	for (i = 1 ; i < stripe_num ; i++) {
+		g_mutex_lock(&sync.lock);
+		sync.remained++;
+		g_mutex_unlock(&sync.lock);
+
+		if (!g_thread_pool_push(hcamcorder->stripe_pool, &task[i], NULL)) {
+			_mmcam_dbg_warn("failed to push stripe %d, process it here", i);
+
+			g_mutex_lock(&sync.lock);
+			sync.remained--;
+			g_mutex_unlock(&sync.lock);
+
+			func(data, task[i].start, task[i].end);
+		}
+	}
+
+	func(data, task[0].start, task[0].end);
+
+	g_mutex_lock(&sync.lock);
+	while (sync.remained > 0)
+		g_cond_wait(&sync.cond, &sync.lock);
+	g_mutex_unlock(&sync.lock);
+
+	g_mutex_clear(&sync.lock);
+	g_cond_clear(&sync.cond);
+
+	return;
+}
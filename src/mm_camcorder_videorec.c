@@ -23,6 +23,7 @@
 |  INCLUDE FILES																		|
 =======================================================================================*/
 #include <gst/video/cameracontrol.h>
+#include <gst/video/video-event.h>
 #include <gst/app/gstappsrc.h>
 #include "mm_camcorder_internal.h"
 #include "mm_camcorder_videorec.h"
@@ -55,6 +56,21 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_audio_disable(GstPad *pad
 static GstPadProbeReturn __mmcamcorder_audio_dataprobe_audio_mute(GstPad *pad, GstPadProbeInfo *info, gpointer u_data);
 static gboolean __mmcamcorder_add_metadata(MMHandleType handle, int fileformat);
 static gboolean __mmcamcorder_add_metadata_mp4(MMHandleType handle);
+static void __mmcamcorder_get_encode_settings(MMHandleType handle, _MMCamcorderEncodeSettings *settings);
+static GstPadProbeReturn __mmcamcorder_video_dataprobe_segment(GstPad *pad, GstPadProbeInfo *info, gpointer u_data);
+static GstPadProbeReturn __mmcamcorder_audio_dataprobe_segment(GstPad *pad, GstPadProbeInfo *info, gpointer u_data);
+static GstPad *__mmcamcorder_segment_get_split_pad(_MMCamcorderSubContext *sc, gboolean is_video);
+static gchar *__mmcamcorder_segment_make_filename(mmf_camcorder_t *hcamcorder, const gchar *target, guint index);
+static void __mmcamcorder_segment_start(mmf_camcorder_t *hcamcorder);
+static gpointer __mmcamcorder_segment_thread(gpointer data);
+static gboolean __mmcamcorder_segment_request(mmf_camcorder_t *hcamcorder);
+static void __mmcamcorder_segment_request_keyframe(mmf_camcorder_t *hcamcorder, GstPad *pad);
+static guint64 __mmcamcorder_segment_elapsed(mmf_camcorder_t *hcamcorder, guint64 rec_pipe_time);
+static void __mmcamcorder_segment_report(mmf_camcorder_t *hcamcorder, const gchar *filename, guint index, guint64 duration);
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+static int __mmcamcorder_acquire_encoder_resource(mmf_camcorder_t *hcamcorder);
+static void __mmcamcorder_release_encoder_resource(mmf_camcorder_t *hcamcorder);
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
 
 /*=======================================================================================
 |  FUNCTION DEFINITIONS									|
@@ -90,6 +106,8 @@ static gboolean __mmcamcorder_video_stream_cb(GstElement *element, GstSample *sa
 		if (sc->encode_element[_MMCAMCORDER_AUDIOSRC_SRC].gst) {
 			if (sc->info_video->is_firstframe) {
 				sc->info_video->is_firstframe = FALSE;
+				_mmcamcorder_recording_stats_set_start_latency((MMHandleType)hcamcorder,
+					(guint)((g_get_monotonic_time() - sc->info_video->record_start_time) / 1000));
 				pipe_clock = GST_ELEMENT_CLOCK(sc->encode_element[_MMCAMCORDER_AUDIOSRC_SRC].gst);
 				if (pipe_clock) {
 					gst_object_ref(pipe_clock);
@@ -100,6 +118,8 @@ static gboolean __mmcamcorder_video_stream_cb(GstElement *element, GstSample *sa
 		} else {
 			if (sc->info_video->is_firstframe) {
 				sc->info_video->is_firstframe = FALSE;
+				_mmcamcorder_recording_stats_set_start_latency((MMHandleType)hcamcorder,
+					(guint)((g_get_monotonic_time() - sc->info_video->record_start_time) / 1000));
 				sc->info_video->base_video_ts = GST_BUFFER_PTS(buffer);
 			}
 		}
@@ -163,6 +183,9 @@ int _mmcamcorder_create_recorder_pipeline(MMHandleType handle)
 
 	_MMCAMCORDER_PIPELINE_MAKE(sc, sc->encode_element, _MMCAMCORDER_ENCODE_MAIN_PIPE, "recorder_pipeline", err);
 
+	/* kept pipeline is reused only with these settings */
+	__mmcamcorder_get_encode_settings(handle, &sc->encode_settings);
+
 	/* get audio disable */
 	mm_camcorder_get_attributes(handle, NULL,
 		MMCAM_AUDIO_DISABLE, &sc->audio_disable,
@@ -279,6 +302,21 @@ int _mmcamcorder_create_recorder_pipeline(MMHandleType handle)
 			__mmcamcorder_audio_dataprobe_check, hcamcorder);
 		gst_object_unref(srcpad);
 		srcpad = NULL;
+
+		/* split points for segmented recording, they are linked to muxer */
+		srcpad = __mmcamcorder_segment_get_split_pad(sc, TRUE);
+		MMCAMCORDER_ADD_BUFFER_PROBE(srcpad, _MMCAMCORDER_HANDLER_VIDEOREC,
+			__mmcamcorder_video_dataprobe_segment, hcamcorder);
+		gst_object_unref(srcpad);
+		srcpad = NULL;
+
+		if (sc->audio_disable == FALSE) {
+			srcpad = __mmcamcorder_segment_get_split_pad(sc, FALSE);
+			MMCAMCORDER_ADD_BUFFER_PROBE(srcpad, _MMCAMCORDER_HANDLER_VIDEOREC,
+				__mmcamcorder_audio_dataprobe_segment, hcamcorder);
+			gst_object_unref(srcpad);
+			srcpad = NULL;
+		}
 	}
 
 	sinkpad = gst_element_get_static_pad(sc->encode_element[_MMCAMCORDER_ENCSINK_SINK].gst, "sink");
@@ -357,9 +395,6 @@ int _mmcamcorder_remove_encode_pipeline(MMHandleType handle)
 	GstPad *reqpad = NULL;
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 	_MMCamcorderSubContext *sc = NULL;
-#ifdef _MMCAMCORDER_MM_RM_SUPPORT
-	int ret = MM_ERROR_NONE;
-#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
 
 	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
 
@@ -402,27 +437,7 @@ int _mmcamcorder_remove_encode_pipeline(MMHandleType handle)
 		_mmcam_dbg_warn("Encoder pipeline removed");
 
 #ifdef _MMCAMCORDER_MM_RM_SUPPORT
-		_MMCAMCORDER_LOCK_RESOURCE(hcamcorder);
-
-		_mmcam_dbg_warn("lock resource - cb calling %d", hcamcorder->is_release_cb_calling);
-
-		if (hcamcorder->is_release_cb_calling == FALSE) {
-			/* release resource */
-			ret = mm_resource_manager_mark_for_release(hcamcorder->resource_manager,
-					hcamcorder->video_encoder_resource);
-			if (ret == MM_RESOURCE_MANAGER_ERROR_NONE)
-				hcamcorder->video_encoder_resource = NULL;
-
-			_mmcam_dbg_warn("mark resource for release 0x%x", ret);
-
-			ret = mm_resource_manager_commit(hcamcorder->resource_manager);
-
-			_mmcam_dbg_warn("commit resource release 0x%x", ret);
-		}
-
-		_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
-
-		_mmcam_dbg_warn("unlock resource");
+		__mmcamcorder_release_encoder_resource(hcamcorder);
 #endif /* _MMCAMCORDER_MM_RM_SUPPORT */
 	}
 
@@ -449,6 +464,11 @@ int _mmcamcorder_remove_recorder_pipeline(MMHandleType handle)
 		return MM_ERROR_NONE;
 	}
 
+	sc->encode_pipe_parked = FALSE;
+
+	/* release streaming threads waiting for next segment */
+	_mmcamcorder_video_segment_abort(handle);
+
 	_mmcamcorder_remove_all_handlers((MMHandleType)hcamcorder, _MMCAMCORDER_HANDLER_VIDEOREC);
 
 	ret = _mmcamcorder_gst_set_state(handle, sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst, GST_STATE_NULL);
@@ -543,35 +563,12 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 			/* Recording */
 			_mmcam_dbg_log("Record Start - dual stream %d", info->support_dual_stream);
 
-#ifdef _MMCAMCORDER_MM_RM_SUPPORT
-			_MMCAMCORDER_LOCK_RESOURCE(hcamcorder);
-
-			/* prepare resource manager for H/W encoder */
-			if (hcamcorder->video_encoder_resource == NULL) {
-				ret = mm_resource_manager_mark_for_acquire(hcamcorder->resource_manager,
-						MM_RESOURCE_MANAGER_RES_TYPE_VIDEO_ENCODER,
-						MM_RESOURCE_MANAGER_RES_VOLUME_FULL,
-						&hcamcorder->video_encoder_resource);
-				if (ret != MM_RESOURCE_MANAGER_ERROR_NONE) {
-					_mmcam_dbg_err("could not prepare for encoder resource");
-					ret = MM_ERROR_RESOURCE_INTERNAL;
-					_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
-					goto _ERR_CAMCORDER_VIDEO_COMMAND;
-				}
-			} else {
-				_mmcam_dbg_log("encoder already acquired");
-			}
+			info->record_start_time = g_get_monotonic_time();
 
-			/* acquire resources */
-			ret = mm_resource_manager_commit(hcamcorder->resource_manager);
-			if (ret != MM_RESOURCE_MANAGER_ERROR_NONE) {
-				_mmcam_dbg_err("could not acquire resources");
-				ret = MM_ERROR_RESOURCE_INTERNAL;
-				_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+			ret = __mmcamcorder_acquire_encoder_resource(hcamcorder);
+			if (ret != MM_ERROR_NONE)
 				goto _ERR_CAMCORDER_VIDEO_COMMAND;
-			}
-
-			_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
 #endif /* _MMCAMCORDER_MM_RM_SUPPORT */
 
 			/* init record_dual_stream */
@@ -625,7 +622,7 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 			_mmcamcorder_adjust_recording_max_size(target_filename, &info->max_size);
 
 			g_mutex_lock(&hcamcorder->task_thread_lock);
-			if (sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst == NULL &&
+			if ((sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst == NULL || sc->encode_pipe_parked) &&
 			    hcamcorder->task_thread_state == _MMCAMCORDER_TASK_THREAD_STATE_NONE) {
 				/* Play record start sound */
 				_mmcamcorder_sound_solo_play(handle, _MMCAMCORDER_SAMPLE_SOUND_NAME_REC_START, FALSE);
@@ -676,6 +673,9 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 
 				ret = _mmcamcorder_gst_set_state(handle, pipeline, GST_STATE_READY);
 
+				/* kept frames have old resolution */
+				_mmcamcorder_video_pre_record_flush(handle);
+
 				/* check decoder recreation */
 				if (!_mmcamcorder_recreate_decoder_for_encoded_preview(handle)) {
 					_mmcam_dbg_err("_mmcamcorder_recreate_decoder_for_encoded_preview failed");
@@ -735,6 +735,14 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 			info->push_encoding_buffer = PUSH_ENCODING_BUFFER_INIT;
 			info->base_video_ts = 0;
 
+			/* audio waits for frames kept before record start,
+			   condition is same with the one for keeping them in preview probe */
+			info->pre_record_offset = 0;
+			g_atomic_int_set(&info->wait_pre_record,
+				hcamcorder->pre_record.duration > 0 &&
+				info->support_dual_stream == FALSE &&
+				sc->info_image->preview_format == MM_PIXEL_FORMAT_ENCODED_H264);
+
 			/* connect video stream cb signal */
 			/*130826 Connect video stream cb for handling fast record frame cb*/
 			if (info->record_dual_stream) {
@@ -757,9 +765,9 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 				}
 			}
 
-			/* check pre-created encode pipeline */
+			/* check pre-created encode pipeline, kept one in READY is reused in prepare */
 			g_mutex_lock(&hcamcorder->task_thread_lock);
-			if (sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst == NULL &&
+			if ((sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst == NULL || sc->encode_pipe_parked) &&
 			    hcamcorder->task_thread_state == _MMCAMCORDER_TASK_THREAD_STATE_NONE) {
 				/* create encoding pipeline */
 				ret = _mmcamcorder_video_prepare_record((MMHandleType)hcamcorder);
@@ -788,11 +796,16 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 			info->is_firstframe = TRUE;
 			info->audio_frame_count = 0;
 			info->filesize = 0;
+			_mmcamcorder_free_space_tracker_reset((MMHandleType)hcamcorder);
+			_mmcamcorder_recording_stats_reset((MMHandleType)hcamcorder);
 			sc->ferror_send = FALSE;
 			sc->ferror_count = 0;
 			hcamcorder->error_occurs = FALSE;
 			sc->bget_eos = FALSE;
 			sc->muxed_stream_offset = 0;
+			_mmcamcorder_mux_index_reset(&sc->mux_index);
+			_mmcamcorder_mstream_delivery_reset(handle);
+			__mmcamcorder_segment_start(hcamcorder);
 
 			ret = _mmcamcorder_gst_set_state(handle, sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst, GST_STATE_PLAYING);
 			if (ret != MM_ERROR_NONE) {
@@ -910,7 +923,10 @@ int _mmcamcorder_video_command(MMHandleType handle, int command)
 		/* block push buffer */
 		info->push_encoding_buffer = PUSH_ENCODING_BUFFER_STOP;
 
-		ret = _mmcamcorder_remove_recorder_pipeline((MMHandleType)hcamcorder);
+		/* muxed data of canceled file is not delivered, and muxer is not blocked by delivery */
+		_mmcamcorder_mstream_delivery_cancel(handle);
+
+		ret = _mmcamcorder_video_park_record((MMHandleType)hcamcorder);
 		if (ret != MM_ERROR_NONE)
 			goto _ERR_CAMCORDER_VIDEO_COMMAND;
 
@@ -1124,13 +1140,17 @@ int _mmcamcorder_video_handle_eos(MMHandleType handle)
 {
 	int ret = MM_ERROR_NONE;
 	int enabletag = 0;
+	guint segment_index = 0;
 	guint64 file_size = 0;
+	gboolean segment_active = FALSE;
+	gboolean segment_closed = FALSE;
 
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
 	_MMCamcorderSubContext *sc = NULL;
 	_MMCamcorderVideoInfo *info = NULL;
 	_MMCamcorderMsgItem msg;
 	MMCamRecordingReport *report = NULL;
+	MMCamcorderRecordingStatsType stats;
 
 	mmf_return_val_if_fail(hcamcorder, FALSE);
 
@@ -1148,13 +1168,16 @@ int _mmcamcorder_video_handle_eos(MMHandleType handle)
 	/* remove blocking part */
 	MMCAMCORDER_G_OBJECT_SET(sc->encode_element[_MMCAMCORDER_ENCSINK_ENCBIN].gst, "block", FALSE);
 
+	/* all muxed data is passed at EOS */
+	_mmcamcorder_mstream_delivery_flush(handle);
+
 	mm_camcorder_get_attributes(handle, NULL,
 		MMCAM_RECORDER_TAG_ENABLE, &enabletag,
 		NULL);
 
-	ret = _mmcamcorder_remove_recorder_pipeline((MMHandleType)hcamcorder);
+	ret = _mmcamcorder_video_park_record((MMHandleType)hcamcorder);
 	if (ret != MM_ERROR_NONE)
-		_mmcam_dbg_warn("_MMCamcorder_CMD_COMMIT:__mmcamcorder_remove_recorder_pipeline failed. error[%x]", ret);
+		_mmcam_dbg_warn("_MMCamcorder_CMD_COMMIT:_mmcamcorder_video_park_record failed. error[%x]", ret);
 
 	/* set recording hint */
 	MMCAMCORDER_G_OBJECT_SET(sc->element[_MMCAMCORDER_VIDEOSRC_SRC].gst, "recording-hint", FALSE);
@@ -1174,13 +1197,26 @@ int _mmcamcorder_video_handle_eos(MMHandleType handle)
 		}
 	}
 
-	if (enabletag && !(sc->ferror_send)) {
+	g_mutex_lock(&hcamcorder->segment.lock);
+	segment_active = hcamcorder->segment.active;
+	segment_closed = hcamcorder->segment.closed;
+	segment_index = hcamcorder->segment.index;
+	g_mutex_unlock(&hcamcorder->segment.lock);
+
+	if (enabletag && !(sc->ferror_send) && !segment_closed) {
 		ret = __mmcamcorder_add_metadata((MMHandleType)hcamcorder, info->fileformat);
 		_mmcam_dbg_log("Writing location information [%s] !!", ret ? "SUCCEEDED" : "FAILED");
 	}
 
-	/* Check file size */
-	if (info->max_size > 0) {
+	/* last segment, it's reported before recording report */
+	if (segment_active && !segment_closed) {
+		_mmcamcorder_get_recording_stats(handle, &stats);
+		__mmcamcorder_segment_report(hcamcorder, info->filename, segment_index,
+			__mmcamcorder_segment_elapsed(hcamcorder, stats.elapsed));
+	}
+
+	/* Check file size, segment can be over the limit until next keyframe */
+	if (info->max_size > 0 && !segment_active) {
 		_mmcamcorder_get_file_size(info->filename, &file_size);
 		_mmcam_dbg_log("MAX size %"G_GUINT64_FORMAT" byte - created filesize %"G_GUINT64_FORMAT" byte",
 					   info->max_size, file_size);
@@ -1270,6 +1306,10 @@ int _mmcamcorder_video_handle_eos(MMHandleType handle)
 	info->filesize = 0;
 	info->b_commiting = FALSE;
 
+	g_mutex_lock(&hcamcorder->segment.lock);
+	hcamcorder->segment.active = FALSE;
+	g_mutex_unlock(&hcamcorder->segment.lock);
+
 	/* check recording stop sound */
 	_mmcamcorder_sound_solo_play_wait(handle);
 
@@ -1321,18 +1361,20 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_check(GstPad *pad, GstPad
 	if (sc->ferror_send || sc->isMaxsizePausing) {
 		_mmcam_dbg_warn("Recording is paused, drop frames");
 		g_mutex_unlock(&videoinfo->size_check_lock);
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
 		return GST_PAD_PROBE_DROP;
 	}
 
 	/* get trailer size */
 	if (videoinfo->fileformat == MM_FILE_FORMAT_3GP || videoinfo->fileformat == MM_FILE_FORMAT_MP4)
-		MMCAMCORDER_G_OBJECT_GET(sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst, "expected-trailer-size", &trailer_size);
+		trailer_size = _mmcamcorder_recording_stats_get_trailer_size((MMHandleType)hcamcorder, sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst);
 	else
 		trailer_size = 0;
 
 	/* check max size of recorded file */
 	max_size = videoinfo->filesize + buffer_size + trailer_size + _MMCAMCORDER_MMS_MARGIN_SPACE;
-	if (videoinfo->max_size > 0 && videoinfo->max_size < max_size) {
+	if (videoinfo->max_size > 0 && videoinfo->max_size < max_size &&
+	    !__mmcamcorder_segment_request(hcamcorder)) {
 		GstState pipeline_state = GST_STATE_VOID_PENDING;
 		GstElement *pipeline = sc->element[_MMCAMCORDER_MAIN_PIPE].gst;
 		_mmcam_dbg_warn("Max size!!! Recording is paused.");
@@ -1352,6 +1394,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_check(GstPad *pad, GstPad
 
 		g_mutex_unlock(&videoinfo->size_check_lock);
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		return FALSE;
 	}
 
@@ -1393,9 +1437,12 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 	/*_mmcam_dbg_log("[%" GST_TIME_FORMAT "]", GST_TIME_ARGS(GST_BUFFER_PTS(buffer)));*/
 	if (sc->ferror_send) {
 		_mmcam_dbg_warn("file write error, drop frames");
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
 		return GST_PAD_PROBE_DROP;
 	}
 
+	__mmcamcorder_segment_request_keyframe(hcamcorder, pad);
+
 	gst_buffer_map(buffer, &mapinfo, GST_MAP_READ);
 	buffer_size = mapinfo.size;
 	gst_buffer_unmap(buffer, &mapinfo);
@@ -1412,12 +1459,13 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 
 	/* get trailer size */
 	if (videoinfo->fileformat == MM_FILE_FORMAT_3GP || videoinfo->fileformat == MM_FILE_FORMAT_MP4)
-		MMCAMCORDER_G_OBJECT_GET(sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst, "expected-trailer-size", &trailer_size);
+		trailer_size = _mmcamcorder_recording_stats_get_trailer_size((MMHandleType)hcamcorder, sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst);
 	else
 		trailer_size = 0;
 
-	/* check free space */
-	ret = _mmcamcorder_get_freespace(hcamcorder->storage_info.type, &free_space);
+	/* check free space : estimated one is used between samples */
+	ret = _mmcamcorder_free_space_tracker_get((MMHandleType)hcamcorder, buffer_size,
+		_MMCAMCORDER_MINIMUM_SPACE + buffer_size + trailer_size, &free_space);
 	if (ret != 0) {
 		_mmcam_dbg_err("Error occured. [%d]", ret);
 		if (sc->ferror_count == 2 && sc->ferror_send == FALSE) {
@@ -1431,6 +1479,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 			sc->ferror_count++;
 		}
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		return GST_PAD_PROBE_DROP; /* skip this buffer */
 	}
 
@@ -1462,6 +1512,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 				_mmcam_dbg_warn("error was already sent");
 			}
 
+			_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 			return GST_PAD_PROBE_DROP;
 		}
 	}
@@ -1475,6 +1527,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 
 	queued_buffer = aq_size + vq_size;
 
+	_mmcamcorder_recording_stats_set_queue_level((MMHandleType)hcamcorder, vq_size, aq_size);
+
 	if (free_space < (_MMCAMCORDER_MINIMUM_SPACE + buffer_size + trailer_size + queued_buffer)) {
 		_mmcam_dbg_warn("No more space for recording!!! Recording is paused.");
 		_mmcam_dbg_warn("Free Space : [%" G_GUINT64_FORMAT "], trailer size : [%" G_GUINT64_FORMAT "]," \
@@ -1489,6 +1543,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 			_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
 		}
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		return GST_PAD_PROBE_DROP;
 	}
 
@@ -1496,7 +1552,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 
 	/* check max size of recorded file */
 	max_size = videoinfo->filesize + buffer_size + trailer_size + _MMCAMCORDER_MMS_MARGIN_SPACE;
-	if (videoinfo->max_size > 0 && videoinfo->max_size < max_size) {
+	if (videoinfo->max_size > 0 && videoinfo->max_size < max_size &&
+	    !__mmcamcorder_segment_request(hcamcorder)) {
 		GstState pipeline_state = GST_STATE_VOID_PENDING;
 		GstElement *pipeline = sc->element[_MMCAMCORDER_MAIN_PIPE].gst;
 		_mmcam_dbg_warn("Max size!!! Recording is paused.");
@@ -1516,6 +1573,8 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_record(GstPad *pad, GstPa
 
 		g_mutex_unlock(&videoinfo->size_check_lock);
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		return GST_PAD_PROBE_DROP;
 	}
 
@@ -1535,6 +1594,7 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_audio_disable(GstPad *pad
 {
 	guint64 trailer_size = 0;
 	guint64 rec_pipe_time = 0;
+	guint64 segment_time = 0;
 	unsigned int remained_time = 0;
 
 	GstClockTime b_time;
@@ -1558,14 +1618,16 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_audio_disable(GstPad *pad
 	b_time = GST_BUFFER_PTS(buffer);
 
 	rec_pipe_time = GST_TIME_AS_MSECONDS(b_time);
+	segment_time = __mmcamcorder_segment_elapsed(hcamcorder, rec_pipe_time);
 
 	if (videoinfo->fileformat == MM_FILE_FORMAT_3GP || videoinfo->fileformat == MM_FILE_FORMAT_MP4)
-		MMCAMCORDER_G_OBJECT_GET(sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst, "expected-trailer-size", &trailer_size);
+		trailer_size = _mmcamcorder_recording_stats_get_trailer_size((MMHandleType)hcamcorder, sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst);
 	else
 		trailer_size = 0;
 
 	/* check max time */
-	if (videoinfo->max_time > 0 && rec_pipe_time > videoinfo->max_time) {
+	if (videoinfo->max_time > 0 && segment_time > videoinfo->max_time &&
+	    !__mmcamcorder_segment_request(hcamcorder)) {
 		_mmcam_dbg_warn("Time current [%" G_GUINT64_FORMAT "], Max [%" G_GUINT64_FORMAT "], motion rate [%lf]", \
 			rec_pipe_time, videoinfo->max_time, videoinfo->record_motion_rate);
 
@@ -1574,6 +1636,9 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_audio_disable(GstPad *pad
 
 			sc->isMaxtimePausing = TRUE;
 
+			_mmcamcorder_recording_stats_update((MMHandleType)hcamcorder, rec_pipe_time,
+				(videoinfo->filesize + trailer_size) >> 10, 0);
+
 			msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
 			msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
 			msg.param.recording_status.filesize = (unsigned long long)((videoinfo->filesize + trailer_size) >> 10);
@@ -1584,24 +1649,30 @@ static GstPadProbeReturn __mmcamcorder_video_dataprobe_audio_disable(GstPad *pad
 			_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
 		}
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		return GST_PAD_PROBE_DROP;
 	}
 
 	/* calculate remained time can be recorded */
-	if (videoinfo->max_time > 0 && videoinfo->max_time < (remained_time + rec_pipe_time)) {
-		remained_time = videoinfo->max_time - rec_pipe_time;
+	if (videoinfo->max_time > 0 && videoinfo->max_time < (remained_time + segment_time)) {
+		remained_time = segment_time < videoinfo->max_time ? videoinfo->max_time - segment_time : 0;
 	} else if (videoinfo->max_size > 0) {
 		long double max_size = (long double)videoinfo->max_size;
 		long double current_size = (long double)(videoinfo->filesize + trailer_size);
 
-		remained_time = (unsigned int)((long double)rec_pipe_time * (max_size/current_size)) - rec_pipe_time;
+		remained_time = (unsigned int)((long double)segment_time * (max_size/current_size)) - segment_time;
 	}
 
-	msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
-	msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
-	msg.param.recording_status.filesize = (unsigned long long)((videoinfo->filesize + trailer_size) >> 10);
-	msg.param.recording_status.remained_time = remained_time;
-	_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+	/* statistics is updated for every buffer, but message is sent by the interval */
+	if (_mmcamcorder_recording_stats_update((MMHandleType)hcamcorder, rec_pipe_time,
+		(videoinfo->filesize + trailer_size) >> 10, remained_time)) {
+		msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
+		msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
+		msg.param.recording_status.filesize = (unsigned long long)((videoinfo->filesize + trailer_size) >> 10);
+		msg.param.recording_status.remained_time = remained_time;
+		_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+	}
 
 	/*
 	_mmcam_dbg_log("time [%" GST_TIME_FORMAT "], size [%d]",
@@ -1647,6 +1718,7 @@ static GstPadProbeReturn __mmcamcorder_audioque_dataprobe(GstPad *pad, GstPadPro
 	_MMCamcorderSubContext *sc = NULL;
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
 	_MMCamcorderVideoInfo *videoinfo = NULL;
+	guint64 segment_time = 0;
 	unsigned int remained_time = 0;
 	GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
 
@@ -1666,23 +1738,25 @@ static GstPadProbeReturn __mmcamcorder_audioque_dataprobe(GstPad *pad, GstPadPro
 	}
 
 	rec_pipe_time = GST_TIME_AS_MSECONDS(GST_BUFFER_PTS(buffer));
+	segment_time = __mmcamcorder_segment_elapsed(hcamcorder, rec_pipe_time);
 
 	if (videoinfo->fileformat == MM_FILE_FORMAT_3GP || videoinfo->fileformat == MM_FILE_FORMAT_MP4)
-		MMCAMCORDER_G_OBJECT_GET(sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst, "expected-trailer-size", &trailer_size);
+		trailer_size = _mmcamcorder_recording_stats_get_trailer_size((MMHandleType)hcamcorder, sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst);
 	else
 		trailer_size = 0;
 
 	/* calculate remained time can be recorded */
-	if (videoinfo->max_time > 0 && videoinfo->max_time < (remained_time + rec_pipe_time)) {
-		remained_time = videoinfo->max_time - rec_pipe_time;
+	if (videoinfo->max_time > 0 && videoinfo->max_time < (remained_time + segment_time)) {
+		remained_time = segment_time < videoinfo->max_time ? videoinfo->max_time - segment_time : 0;
 	} else if (videoinfo->max_size > 0) {
 		long double max_size = (long double)videoinfo->max_size;
 		long double current_size = (long double)(videoinfo->filesize + trailer_size);
 
-		remained_time = (unsigned long long)((long double)rec_pipe_time * (max_size/current_size)) - rec_pipe_time;
+		remained_time = (unsigned long long)((long double)segment_time * (max_size/current_size)) - segment_time;
 	}
 
-	if (videoinfo->max_time > 0 && rec_pipe_time > videoinfo->max_time) {
+	if (videoinfo->max_time > 0 && segment_time > videoinfo->max_time &&
+	    !__mmcamcorder_segment_request(hcamcorder)) {
 		_mmcam_dbg_warn("Time current [%" G_GUINT64_FORMAT "], Max [%" G_GUINT64_FORMAT "], motion rate [%lf]", \
 			rec_pipe_time, videoinfo->max_time, videoinfo->record_motion_rate);
 
@@ -1691,6 +1765,9 @@ static GstPadProbeReturn __mmcamcorder_audioque_dataprobe(GstPad *pad, GstPadPro
 
 			sc->isMaxtimePausing = TRUE;
 
+			_mmcamcorder_recording_stats_update((MMHandleType)hcamcorder, rec_pipe_time,
+				(videoinfo->filesize + trailer_size) >> 10, 0);
+
 			msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
 			msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
 			msg.param.recording_status.filesize = (unsigned long long)((videoinfo->filesize + trailer_size) >> 10);
@@ -1701,14 +1778,20 @@ static GstPadProbeReturn __mmcamcorder_audioque_dataprobe(GstPad *pad, GstPadPro
 			_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
 		}
 
+		_mmcamcorder_recording_stats_add_dropped((MMHandleType)hcamcorder);
+
 		return GST_PAD_PROBE_DROP;
 	}
 
-	msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
-	msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
-	msg.param.recording_status.filesize = (unsigned long long)((videoinfo->filesize + trailer_size) >> 10);
-	msg.param.recording_status.remained_time = remained_time;
-	_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+	/* statistics is updated for every buffer, but message is sent by the interval */
+	if (_mmcamcorder_recording_stats_update((MMHandleType)hcamcorder, rec_pipe_time,
+		(videoinfo->filesize + trailer_size) >> 10, remained_time)) {
+		msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
+		msg.param.recording_status.elapsed = (unsigned long long)rec_pipe_time;
+		msg.param.recording_status.filesize = (unsigned long long)((videoinfo->filesize + trailer_size) >> 10);
+		msg.param.recording_status.remained_time = remained_time;
+		_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+	}
 
 	/*
 	_mmcam_dbg_log("audio data probe :: time [%" GST_TIME_FORMAT "], size [%lld KB]",
@@ -1722,36 +1805,50 @@ static GstPadProbeReturn __mmcamcorder_audioque_dataprobe(GstPad *pad, GstPadPro
 static GstPadProbeReturn __mmcamcorder_audio_dataprobe_audio_mute(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
 {
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
-	double volume = 0.0;
-	int format = 0;
-	int channel = 0;
-	int err = MM_ERROR_UNKNOWN;
-	char *err_name = NULL;
+	_MMCamcorderSubContext *sc = NULL;
+	_MMCamcorderAttrSnapshot attrs;
 	GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+	GstBuffer *silence = NULL;
 	GstMapInfo mapinfo;
 
 	mmf_return_val_if_fail(buffer, GST_PAD_PROBE_DROP);
 	mmf_return_val_if_fail(hcamcorder, GST_PAD_PROBE_DROP);
 
+	sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	mmf_return_val_if_fail(sc && sc->info_video, GST_PAD_PROBE_DROP);
+
+	/* audio starts after pre-recorded video frames */
+	if (g_atomic_int_get(&sc->info_video->wait_pre_record))
+		return GST_PAD_PROBE_DROP;
+
+	if (sc->info_video->pre_record_offset > 0 && GST_BUFFER_PTS_IS_VALID(buffer))
+		GST_BUFFER_PTS(buffer) += sc->info_video->pre_record_offset;
+
 	/*_mmcam_dbg_log("AUDIO SRC time stamp : [%" GST_TIME_FORMAT "] \n", GST_TIME_ARGS(GST_BUFFER_PTS(buffer)));*/
-	err = mm_camcorder_get_attributes((MMHandleType)hcamcorder, &err_name,
-		MMCAM_AUDIO_VOLUME, &volume,
-		MMCAM_AUDIO_FORMAT, &format,
-		MMCAM_AUDIO_CHANNEL, &channel,
-		NULL);
-	if (err != MM_ERROR_NONE) {
-		_mmcam_dbg_warn("Get attrs fail. (%s:%x)", err_name, err);
-		SAFE_FREE(err_name);
-		return err;
-	}
+	_mmcamcorder_get_attr_snapshot((MMHandleType)hcamcorder, &attrs);
 
 	memset(&mapinfo, 0x0, sizeof(GstMapInfo));
 
-	gst_buffer_map(buffer, &mapinfo, GST_MAP_READWRITE);
+	/* Set audio stream NULL - replace it with shared silence instead of writing it */
+	if (attrs.audio_volume == 0.0)
+		silence = _mmcamcorder_get_silence_buffer((MMHandleType)hcamcorder, buffer);
 
-	/* Set audio stream NULL */
-	if (volume == 0.0)
-		memset(mapinfo.data, 0, mapinfo.size);
+	if (silence) {
+		gst_buffer_unref(buffer);
+		buffer = silence;
+		GST_PAD_PROBE_INFO_DATA(info) = buffer;
+
+		/* no stream callback, then muted buffer is not touched at all */
+		if (!hcamcorder->astream_cb)
+			return GST_PAD_PROBE_OK;
+
+		gst_buffer_map(buffer, &mapinfo, GST_MAP_READ);
+	} else {
+		gst_buffer_map(buffer, &mapinfo, GST_MAP_READWRITE);
+
+		if (attrs.audio_volume == 0.0)
+			memset(mapinfo.data, 0, mapinfo.size);
+	}
 
 	/* CALL audio stream callback */
 	if (hcamcorder->astream_cb && buffer && mapinfo.data && mapinfo.size > 0) {
@@ -1767,8 +1864,8 @@ static GstPadProbeReturn __mmcamcorder_audio_dataprobe_audio_mute(GstPad *pad, G
 			GST_BUFFER_DATA(buffer), width, height, format);*/
 
 		stream.data = (void *)mapinfo.data;
-		stream.format = format;
-		stream.channel = channel;
+		stream.format = attrs.audio_format;
+		stream.channel = attrs.audio_channel;
 		stream.length = mapinfo.size;
 		stream.timestamp = (unsigned int)(GST_BUFFER_PTS(buffer)/1000000); /* nano -> milli second */
 
@@ -1836,13 +1933,6 @@ static gboolean __mmcamcorder_add_metadata_mp4(MMHandleType handle)
 
 	info = sc->info_video;
 
-	f = fopen64(info->filename, "rb+");
-	if (f == NULL) {
-		strerror_r(errno, err_msg, MAX_ERROR_MESSAGE_LEN);
-		_mmcam_dbg_err("file open failed [%s]", err_msg);
-		return FALSE;
-	}
-
 	mm_camcorder_get_attributes(handle, &err_name,
 		MMCAM_TAG_LATITUDE, &latitude,
 		MMCAM_TAG_LONGITUDE, &longitude,
@@ -1861,6 +1951,24 @@ static gboolean __mmcamcorder_add_metadata_mp4(MMHandleType handle)
 	geo_info.longitude = longitude *10000;
 	geo_info.latitude = latitude *10000;
 	geo_info.altitude = altitude *10000;
+
+	/* write with atom index which is recorded while muxing */
+	err = _mmcamcorder_write_metadata_in_place(info->filename, &sc->mux_index,
+		gps_enable, location_info, geo_info, orientation);
+	if (err == MM_ERROR_NONE)
+		return TRUE;
+	else if (err != MM_ERROR_CAMCORDER_NOT_SUPPORTED)
+		return FALSE;
+
+	_mmcam_dbg_log("scan file to write metadata");
+
+	f = fopen64(info->filename, "rb+");
+	if (f == NULL) {
+		strerror_r(errno, err_msg, MAX_ERROR_MESSAGE_LEN);
+		_mmcam_dbg_err("file open failed [%s]", err_msg);
+		return FALSE;
+	}
+
 	/* find udta container.
 	   if, there are udta container, write loci box after that
 	   else, make udta container and write loci box. */
@@ -2010,7 +2118,11 @@ int _mmcamcorder_video_prepare_record(MMHandleType handle)
 	int ret = MM_ERROR_NONE;
 	int size = 0;
 	char *temp_filename = NULL;
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+	gboolean parked = FALSE;
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
 
+	_MMCamcorderEncodeSettings settings;
 	_MMCamcorderVideoInfo *info = NULL;
 	_MMCamcorderSubContext *sc = NULL;
 	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
@@ -2025,10 +2137,35 @@ int _mmcamcorder_video_prepare_record(MMHandleType handle)
 
 	_mmcam_dbg_warn("start");
 
-	/* create encoding pipeline */
-	ret = _mmcamcorder_create_recorder_pipeline((MMHandleType)hcamcorder);
-	if (ret != MM_ERROR_NONE)
-		goto _ERR_PREPARE_RECORD;
+	/* reuse encoding pipeline kept in READY if settings are not changed */
+	__mmcamcorder_get_encode_settings(handle, &settings);
+
+	if (sc->encode_pipe_parked &&
+	    memcmp(&settings, &sc->encode_settings, sizeof(_MMCamcorderEncodeSettings)) == 0) {
+		_mmcam_dbg_warn("reuse encoding pipeline");
+		sc->encode_pipe_parked = FALSE;
+
+		/* it could be paused when previous recording is canceled */
+		MMCAMCORDER_G_OBJECT_SET(sc->encode_element[_MMCAMCORDER_ENCSINK_ENCBIN].gst, "runtime-pause", FALSE);
+	} else {
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+		parked = sc->encode_pipe_parked;
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
+
+		/* create encoding pipeline */
+		ret = _mmcamcorder_create_recorder_pipeline((MMHandleType)hcamcorder);
+		if (ret != MM_ERROR_NONE)
+			goto _ERR_PREPARE_RECORD;
+
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+		/* encoder is released with kept pipeline */
+		if (parked) {
+			ret = __mmcamcorder_acquire_encoder_resource(hcamcorder);
+			if (ret != MM_ERROR_NONE)
+				goto _ERR_PREPARE_RECORD;
+		}
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
+	}
 
 	SAFE_G_FREE(info->filename);
 
@@ -2036,7 +2173,8 @@ int _mmcamcorder_video_prepare_record(MMHandleType handle)
 		MMCAM_TARGET_FILENAME, &temp_filename, &size,
 		NULL);
 	if (temp_filename) {
-		info->filename = g_strdup(temp_filename);
+		/* first segment could be named by template */
+		info->filename = __mmcamcorder_segment_make_filename(hcamcorder, temp_filename, 1);
 		if (!info->filename) {
 			_mmcam_dbg_err("strdup[src:%p] was failed", temp_filename);
 			goto _ERR_PREPARE_RECORD;
@@ -2073,3 +2211,1180 @@ _ERR_PREPARE_RECORD:
 
 	return ret;
 }
+
+
+static void __mmcamcorder_pre_record_gop_free(_MMCamcorderPreRecordGop *gop)
+{
+	GstBuffer *frame = NULL;
+
+	if (!gop)
+		return;
+
+	while ((frame = g_queue_pop_head(&gop->frames)) != NULL)
+		gst_buffer_unref(frame);
+
+	g_free(gop);
+}
+
+
+static void __mmcamcorder_pre_record_clear(_MMCamcorderPreRecord *pre_record)
+{
+	_MMCamcorderPreRecordGop *gop = NULL;
+
+	while ((gop = g_queue_pop_head(&pre_record->gops)) != NULL)
+		__mmcamcorder_pre_record_gop_free(gop);
+
+	pre_record->size = 0;
+	pre_record->last_pts = GST_CLOCK_TIME_NONE;
+}
+
+
+int _mmcamcorder_video_set_pre_record(MMHandleType handle, int duration, int max_size)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(duration >= 0 && max_size >= 0, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	if (duration > 0 && max_size == 0) {
+		_mmcam_dbg_err("max size should be set for pre-record duration %d ms", duration);
+		return MM_ERROR_CAMCORDER_INVALID_ARGUMENT;
+	}
+
+	_mmcam_dbg_log("pre-record duration %d ms, max size %d KB", duration, max_size);
+
+	g_mutex_lock(&hcamcorder->pre_record.lock);
+
+	__mmcamcorder_pre_record_clear(&hcamcorder->pre_record);
+
+	hcamcorder->pre_record.duration = (GstClockTime)duration * GST_MSECOND;
+	hcamcorder->pre_record.max_size = ((gsize)max_size) << 10;
+
+	g_mutex_unlock(&hcamcorder->pre_record.lock);
+
+	return MM_ERROR_NONE;
+}
+
+
+void _mmcamcorder_video_pre_record_push(MMHandleType handle, GstBuffer *buffer)
+{
+	gsize size = 0;
+	gboolean is_keyframe = FALSE;
+	GstBuffer *frame = NULL;
+	GstBuffer *next_keyframe = NULL;
+	GstMapInfo mapinfo;
+	_MMCamcorderPreRecord *pre_record = NULL;
+	_MMCamcorderPreRecordGop *gop = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+	mmf_return_if_fail(buffer);
+
+	pre_record = &hcamcorder->pre_record;
+	is_keyframe = !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+
+	g_mutex_lock(&pre_record->lock);
+
+	if (pre_record->duration == 0)
+		goto _PRE_RECORD_PUSH_DONE;
+
+	/* recording should start with keyframe */
+	if (!is_keyframe && g_queue_is_empty(&pre_record->gops))
+		goto _PRE_RECORD_PUSH_DONE;
+
+	/* frame is copied, because holding buffer of source for seconds starves it */
+	memset(&mapinfo, 0x0, sizeof(GstMapInfo));
+	if (!gst_buffer_map(buffer, &mapinfo, GST_MAP_READ)) {
+		_mmcam_dbg_warn("failed to map frame %p", buffer);
+		goto _PRE_RECORD_PUSH_DONE;
+	}
+
+	size = mapinfo.size;
+	frame = gst_buffer_new_allocate(NULL, size, NULL);
+	if (frame) {
+		gst_buffer_fill(frame, 0, mapinfo.data, size);
+		gst_buffer_copy_into(frame, buffer, GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+	}
+
+	gst_buffer_unmap(buffer, &mapinfo);
+
+	if (!frame) {
+		_mmcam_dbg_warn("failed to allocate frame [size %"G_GSIZE_FORMAT"]", size);
+		goto _PRE_RECORD_PUSH_DONE;
+	}
+
+	if (is_keyframe) {
+		gop = g_new0(_MMCamcorderPreRecordGop, 1);
+		g_queue_push_tail(&pre_record->gops, gop);
+	} else {
+		gop = g_queue_peek_tail(&pre_record->gops);
+	}
+
+	g_queue_push_tail(&gop->frames, frame);
+	gop->size += size;
+	pre_record->size += size;
+	pre_record->last_pts = GST_BUFFER_PTS(frame);
+
+	/* evict the oldest GOP while the rest still covers duration or size is over */
+	while ((gop = g_queue_peek_head(&pre_record->gops)) != NULL) {
+		if (pre_record->size <= pre_record->max_size) {
+			_MMCamcorderPreRecordGop *next = g_queue_peek_nth(&pre_record->gops, 1);
+			if (!next)
+				break;
+
+			next_keyframe = g_queue_peek_head(&next->frames);
+			if (pre_record->last_pts < GST_BUFFER_PTS(next_keyframe) ||
+			    pre_record->last_pts - GST_BUFFER_PTS(next_keyframe) < pre_record->duration)
+				break;
+		} else if (g_queue_get_length(&pre_record->gops) == 1) {
+			_mmcam_dbg_warn("GOP is larger than max size %"G_GSIZE_FORMAT", drop until next keyframe",
+				pre_record->max_size);
+		}
+
+		g_queue_pop_head(&pre_record->gops);
+		pre_record->size -= gop->size;
+		__mmcamcorder_pre_record_gop_free(gop);
+	}
+
+_PRE_RECORD_PUSH_DONE:
+	g_mutex_unlock(&pre_record->lock);
+}
+
+
+void _mmcamcorder_video_pre_record_take(MMHandleType handle, GQueue *frames)
+{
+	GstBuffer *frame = NULL;
+	_MMCamcorderPreRecordGop *gop = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+	mmf_return_if_fail(frames);
+
+	g_mutex_lock(&hcamcorder->pre_record.lock);
+
+	while ((gop = g_queue_pop_head(&hcamcorder->pre_record.gops)) != NULL) {
+		while ((frame = g_queue_pop_head(&gop->frames)) != NULL)
+			g_queue_push_tail(frames, frame);
+
+		g_free(gop);
+	}
+
+	hcamcorder->pre_record.size = 0;
+	hcamcorder->pre_record.last_pts = GST_CLOCK_TIME_NONE;
+
+	g_mutex_unlock(&hcamcorder->pre_record.lock);
+}
+
+
+void _mmcamcorder_video_pre_record_flush(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	g_mutex_lock(&hcamcorder->pre_record.lock);
+	__mmcamcorder_pre_record_clear(&hcamcorder->pre_record);
+	g_mutex_unlock(&hcamcorder->pre_record.lock);
+}
+
+
+static void __mmcamcorder_get_encode_settings(MMHandleType handle, _MMCamcorderEncodeSettings *settings)
+{
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+
+	memset(settings, 0x0, sizeof(_MMCamcorderEncodeSettings));
+
+	mm_camcorder_get_attributes(handle, NULL,
+		MMCAM_VIDEO_ENCODER, &settings->video_encoder,
+		MMCAM_AUDIO_ENCODER, &settings->audio_encoder,
+		MMCAM_FILE_FORMAT, &settings->file_format,
+		MMCAM_VIDEO_WIDTH, &settings->video_width,
+		MMCAM_VIDEO_HEIGHT, &settings->video_height,
+		MMCAM_CAMERA_WIDTH, &settings->camera_width,
+		MMCAM_CAMERA_HEIGHT, &settings->camera_height,
+		MMCAM_CAMERA_FPS, &settings->camera_fps,
+		MMCAM_VIDEO_ENCODER_BITRATE, &settings->video_bitrate,
+		MMCAM_AUDIO_ENCODER_BITRATE, &settings->audio_bitrate,
+		MMCAM_AUDIO_DISABLE, &settings->audio_disable,
+		MMCAM_AUDIO_DEVICE, &settings->audio_device,
+		MMCAM_AUDIO_SAMPLERATE, &settings->audio_samplerate,
+		MMCAM_AUDIO_FORMAT, &settings->audio_format,
+		MMCAM_AUDIO_CHANNEL, &settings->audio_channel,
+		MMCAM_SOUND_STREAM_INDEX, &settings->sound_stream_index,
+		NULL);
+
+	if (sc) {
+		settings->preview_format = sc->info_image ? sc->info_image->preview_format : 0;
+		settings->is_modified_rate = sc->is_modified_rate;
+	}
+}
+
+
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+static int __mmcamcorder_acquire_encoder_resource(mmf_camcorder_t *hcamcorder)
+{
+	int ret = MM_ERROR_NONE;
+
+	_MMCAMCORDER_LOCK_RESOURCE(hcamcorder);
+
+	/* prepare resource manager for H/W encoder */
+	if (hcamcorder->video_encoder_resource == NULL) {
+		ret = mm_resource_manager_mark_for_acquire(hcamcorder->resource_manager,
+				MM_RESOURCE_MANAGER_RES_TYPE_VIDEO_ENCODER,
+				MM_RESOURCE_MANAGER_RES_VOLUME_FULL,
+				&hcamcorder->video_encoder_resource);
+		if (ret != MM_RESOURCE_MANAGER_ERROR_NONE) {
+			_mmcam_dbg_err("could not prepare for encoder resource");
+			_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
+			return MM_ERROR_RESOURCE_INTERNAL;
+		}
+	} else {
+		_mmcam_dbg_log("encoder already acquired");
+	}
+
+	/* acquire resources */
+	ret = mm_resource_manager_commit(hcamcorder->resource_manager);
+	if (ret != MM_RESOURCE_MANAGER_ERROR_NONE) {
+		_mmcam_dbg_err("could not acquire resources");
+		_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
+		return MM_ERROR_RESOURCE_INTERNAL;
+	}
+
+	_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
+
+	return MM_ERROR_NONE;
+}
+
+
+static void __mmcamcorder_release_encoder_resource(mmf_camcorder_t *hcamcorder)
+{
+	int ret = MM_ERROR_NONE;
+
+	_MMCAMCORDER_LOCK_RESOURCE(hcamcorder);
+
+	_mmcam_dbg_warn("lock resource - cb calling %d", hcamcorder->is_release_cb_calling);
+
+	if (hcamcorder->is_release_cb_calling == FALSE) {
+		/* release resource */
+		ret = mm_resource_manager_mark_for_release(hcamcorder->resource_manager,
+				hcamcorder->video_encoder_resource);
+		if (ret == MM_RESOURCE_MANAGER_ERROR_NONE)
+			hcamcorder->video_encoder_resource = NULL;
+
+		_mmcam_dbg_warn("mark resource for release 0x%x", ret);
+
+		ret = mm_resource_manager_commit(hcamcorder->resource_manager);
+
+		_mmcam_dbg_warn("commit resource release 0x%x", ret);
+	}
+
+	_MMCAMCORDER_UNLOCK_RESOURCE(hcamcorder);
+
+	_mmcam_dbg_warn("unlock resource");
+}
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
+
+
+int _mmcamcorder_video_warm_record(MMHandleType handle)
+{
+	int ret = MM_ERROR_NONE;
+	_MMCamcorderEncodeSettings settings;
+	_MMCamcorderVideoInfo *info = NULL;
+	_MMCamcorderSubContext *sc = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	mmf_return_val_if_fail(sc, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+	mmf_return_val_if_fail(sc->info_video, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	info = sc->info_video;
+
+	if (!g_atomic_int_get(&hcamcorder->warm_record)) {
+		_mmcam_dbg_log("warm record is disabled");
+		return MM_ERROR_NONE;
+	}
+
+	if (sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst) {
+		if (!sc->encode_pipe_parked) {
+			_mmcam_dbg_warn("encoding pipeline is in use");
+			return MM_ERROR_NONE;
+		}
+
+		__mmcamcorder_get_encode_settings(handle, &settings);
+		if (memcmp(&settings, &sc->encode_settings, sizeof(_MMCamcorderEncodeSettings)) == 0) {
+			_mmcam_dbg_log("encoding pipeline is already kept");
+			return MM_ERROR_NONE;
+		}
+
+		_mmcam_dbg_warn("settings are changed, rebuild encoding pipeline");
+		_mmcamcorder_remove_recorder_pipeline(handle);
+	}
+
+	_mmcam_dbg_warn("start");
+
+	/* video size is decided as same as record start */
+	mm_camcorder_get_attributes(handle, NULL,
+		MMCAM_CAMERA_WIDTH, &info->preview_width,
+		MMCAM_CAMERA_HEIGHT, &info->preview_height,
+		MMCAM_VIDEO_WIDTH, &info->video_width,
+		MMCAM_VIDEO_HEIGHT, &info->video_height,
+		NULL);
+
+	if (info->video_width == 0 || info->video_height == 0) {
+		info->video_width = info->preview_width;
+		info->video_height = info->preview_height;
+	}
+
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+	/* encoder could be opened in READY */
+	ret = __mmcamcorder_acquire_encoder_resource(hcamcorder);
+	if (ret != MM_ERROR_NONE)
+		return ret;
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
+
+	ret = _mmcamcorder_create_recorder_pipeline(handle);
+	if (ret != MM_ERROR_NONE)
+		goto _ERR_WARM_RECORD;
+
+	ret = _mmcamcorder_gst_set_state(handle, sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst, GST_STATE_READY);
+	if (ret != MM_ERROR_NONE)
+		goto _ERR_WARM_RECORD;
+
+	sc->encode_pipe_parked = TRUE;
+
+	_mmcam_dbg_warn("done");
+
+	return MM_ERROR_NONE;
+
+_ERR_WARM_RECORD:
+	_mmcamcorder_remove_recorder_pipeline(handle);
+
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+	/* removed before encoding pipeline is made */
+	if (hcamcorder->video_encoder_resource)
+		__mmcamcorder_release_encoder_resource(hcamcorder);
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
+
+	return ret;
+}
+
+
+void _mmcamcorder_video_request_warm_record(MMHandleType handle)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	if (!g_atomic_int_get(&hcamcorder->warm_record))
+		return;
+
+	g_mutex_lock(&hcamcorder->task_thread_lock);
+
+	if (hcamcorder->task_thread_state == _MMCAMCORDER_TASK_THREAD_STATE_NONE) {
+		_mmcam_dbg_log("request to build encoding pipeline");
+		hcamcorder->task_thread_state = _MMCAMCORDER_TASK_THREAD_STATE_ENCODE_PIPE_WARM;
+		g_cond_signal(&hcamcorder->task_thread_cond);
+	} else {
+		_mmcam_dbg_warn("task thread is busy [state %d], encoding pipeline is built at record start",
+			hcamcorder->task_thread_state);
+	}
+
+	g_mutex_unlock(&hcamcorder->task_thread_lock);
+}
+
+
+int _mmcamcorder_video_park_record(MMHandleType handle)
+{
+	int ret = MM_ERROR_NONE;
+	_MMCamcorderSubContext *sc = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	mmf_return_val_if_fail(sc, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	/* release streaming threads waiting for next segment */
+	_mmcamcorder_video_segment_abort(handle);
+
+	if (!g_atomic_int_get(&hcamcorder->warm_record) ||
+	    !sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst ||
+	    sc->ferror_send || hcamcorder->error_occurs)
+		return _mmcamcorder_remove_recorder_pipeline(handle);
+
+#ifdef _MMCAMCORDER_MM_RM_SUPPORT
+	/* encoder is released by resource manager */
+	if (hcamcorder->is_release_cb_calling || hcamcorder->video_encoder_resource == NULL)
+		return _mmcamcorder_remove_recorder_pipeline(handle);
+#endif /* _MMCAMCORDER_MM_RM_SUPPORT */
+
+	/* READY resets EOS and closes file, then the pipeline can be started again */
+	ret = _mmcamcorder_gst_set_state(handle, sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst, GST_STATE_READY);
+	if (ret != MM_ERROR_NONE) {
+		_mmcam_dbg_err("failed to keep encoding pipeline [0x%x]", ret);
+		return _mmcamcorder_remove_recorder_pipeline(handle);
+	}
+
+	g_mutex_lock(&hcamcorder->task_thread_lock);
+	sc->encode_pipe_parked = TRUE;
+	g_mutex_unlock(&hcamcorder->task_thread_lock);
+
+	_mmcam_dbg_warn("encoding pipeline is kept for next recording");
+
+	return MM_ERROR_NONE;
+}
+
+
+void _mmcamcorder_video_remove_parked_record(MMHandleType handle)
+{
+	_MMCamcorderSubContext *sc = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	if (!sc)
+		return;
+
+	g_mutex_lock(&hcamcorder->task_thread_lock);
+
+	/* not started yet */
+	if (hcamcorder->task_thread_state == _MMCAMCORDER_TASK_THREAD_STATE_ENCODE_PIPE_WARM) {
+		_mmcam_dbg_warn("cancel building encoding pipeline");
+		hcamcorder->task_thread_state = _MMCAMCORDER_TASK_THREAD_STATE_NONE;
+	}
+
+	if (sc->encode_pipe_parked) {
+		_mmcam_dbg_warn("remove kept encoding pipeline");
+		_mmcamcorder_remove_recorder_pipeline(handle);
+	}
+
+	g_mutex_unlock(&hcamcorder->task_thread_lock);
+}
+
+
+int _mmcamcorder_video_set_warm_record(MMHandleType handle, int enable)
+{
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	if (hcamcorder->type != MM_CAMCORDER_MODE_VIDEO_CAPTURE) {
+		_mmcam_dbg_err("not supported in mode %d", hcamcorder->type);
+		return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+	}
+
+	_mmcam_dbg_log("warm record %d -> %d", g_atomic_int_get(&hcamcorder->warm_record), enable);
+
+	g_atomic_int_set(&hcamcorder->warm_record, enable ? TRUE : FALSE);
+
+	if (enable) {
+		if (_mmcamcorder_get_state(handle) == MM_CAMCORDER_STATE_PREPARE)
+			_mmcamcorder_video_request_warm_record(handle);
+	} else {
+		_mmcamcorder_video_remove_parked_record(handle);
+	}
+
+	return MM_ERROR_NONE;
+}
+
+
+static GstPad *__mmcamcorder_segment_get_split_pad(_MMCamcorderSubContext *sc, gboolean is_video)
+{
+	GstElement *element = NULL;
+
+	if (is_video) {
+		element = sc->encode_element[_MMCAMCORDER_ENCSINK_VENC_QUE].gst;
+		if (!element)
+			element = sc->encode_element[_MMCAMCORDER_ENCSINK_VENC].gst;
+	} else {
+		element = sc->encode_element[_MMCAMCORDER_ENCSINK_AENC_QUE].gst;
+		if (!element)
+			element = sc->encode_element[_MMCAMCORDER_ENCSINK_AENC].gst;
+	}
+
+	if (!element)
+		return NULL;
+
+	return gst_element_get_static_pad(element, "src");
+}
+
+
+static GstClockTime __mmcamcorder_segment_running_time(GstPad *pad, GstBuffer *buffer)
+{
+	GstEvent *event = NULL;
+	const GstSegment *segment = NULL;
+	GstClockTime running_time = GST_BUFFER_PTS(buffer);
+
+	if (!GST_CLOCK_TIME_IS_VALID(running_time))
+		return GST_CLOCK_TIME_NONE;
+
+	event = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0);
+	if (event) {
+		gst_event_parse_segment(event, &segment);
+		running_time = gst_segment_to_running_time(segment, GST_FORMAT_TIME, running_time);
+		gst_event_unref(event);
+	}
+
+	return running_time;
+}
+
+
+static gchar *__mmcamcorder_segment_make_filename(mmf_camcorder_t *hcamcorder, const gchar *target, guint index)
+{
+	const gchar *p = NULL;
+	const gchar *dot = NULL;
+	const gchar *slash = NULL;
+	gchar *filename = NULL;
+	GString *format = NULL;
+	GDateTime *now = NULL;
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	g_mutex_lock(&segment->lock);
+
+	if (!segment->enable || (!segment->filename_template && index == 1)) {
+		filename = g_strdup(target);
+	} else if (segment->filename_template) {
+		/* "%N" is segment number, the others are converted by g_date_time_format() */
+		format = g_string_new(NULL);
+
+		for (p = segment->filename_template ; *p ; p++) {
+			if (p[0] == '%' && p[1] == 'N') {
+				g_string_append_printf(format, "%u", index);
+				p++;
+			} else if (p[0] == '%' && p[1] == '%') {
+				g_string_append(format, "%%");
+				p++;
+			} else {
+				g_string_append_c(format, *p);
+			}
+		}
+
+		now = g_date_time_new_now_local();
+		filename = g_date_time_format(now, format->str);
+		g_date_time_unref(now);
+
+		if (!filename)
+			_mmcam_dbg_err("invalid template [%s]", segment->filename_template);
+
+		g_string_free(format, TRUE);
+	} else if (target) {
+		/* "_N" is inserted before extension of target file */
+		slash = strrchr(target, '/');
+		dot = strrchr(slash ? slash : target, '.');
+		if (dot)
+			filename = g_strdup_printf("%.*s_%u%s", (int)(dot - target), target, index, dot);
+		else
+			filename = g_strdup_printf("%s_%u", target, index);
+	}
+
+	g_mutex_unlock(&segment->lock);
+
+	return filename;
+}
+
+
+static void __mmcamcorder_segment_start(mmf_camcorder_t *hcamcorder)
+{
+	GstElementFactory *factory = NULL;
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	_MMCamcorderVideoInfo *info = sc->info_video;
+
+	factory = gst_element_get_factory(sc->encode_element[_MMCAMCORDER_ENCSINK_SINK].gst);
+
+	g_mutex_lock(&segment->lock);
+
+	/* split points are added only for filesink */
+	segment->active = segment->enable && info->filename &&
+		(info->max_size > 0 || info->max_time > 0) && factory &&
+		!g_strcmp0(gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory)), "filesink");
+	segment->closed = FALSE;
+	segment->index = 1;
+	segment->start_time = 0;
+	segment->split_time = 0;
+	g_atomic_int_set(&segment->key_requested, FALSE);
+	g_atomic_int_set(&segment->failed, FALSE);
+	g_atomic_int_set(&segment->state, _MMCAMCORDER_SEGMENT_STATE_NONE);
+
+	/* files are switched on segment thread, streaming threads only wait at split point */
+	if (segment->active && !segment->thread) {
+		segment->exit = FALSE;
+		segment->thread = g_thread_try_new("MMCAM_SEGMENT",
+			__mmcamcorder_segment_thread, (gpointer)hcamcorder, NULL);
+		if (!segment->thread) {
+			_mmcam_dbg_err("failed to create segment thread");
+			segment->active = FALSE;
+		}
+	}
+
+	g_mutex_unlock(&segment->lock);
+
+	if (segment->active) {
+		_mmcam_dbg_warn("segmented recording - max size %"G_GUINT64_FORMAT" byte, max time %"G_GUINT64_FORMAT" ms",
+			info->max_size, info->max_time);
+	}
+}
+
+
+static gboolean __mmcamcorder_segment_request(mmf_camcorder_t *hcamcorder)
+{
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	if (!segment->active)
+		return FALSE;
+
+	if (g_atomic_int_compare_and_exchange(&segment->state,
+		_MMCAMCORDER_SEGMENT_STATE_NONE, _MMCAMCORDER_SEGMENT_STATE_REQUESTED))
+		_mmcam_dbg_warn("limit of segment[%u] is reached, wait for keyframe", segment->index);
+
+	return TRUE;
+}
+
+
+static void __mmcamcorder_segment_request_keyframe(mmf_camcorder_t *hcamcorder, GstPad *pad)
+{
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_REQUESTED ||
+	    !g_atomic_int_compare_and_exchange(&segment->key_requested, FALSE, TRUE))
+		return;
+
+	_mmcam_dbg_log("request keyframe for segment[%u]", segment->index + 1);
+
+	if (!gst_pad_send_event(pad, gst_video_event_new_upstream_force_key_unit(GST_CLOCK_TIME_NONE, TRUE, segment->index)))
+		_mmcam_dbg_warn("keyframe request is not handled, wait for next keyframe");
+}
+
+
+static guint64 __mmcamcorder_segment_elapsed(mmf_camcorder_t *hcamcorder, guint64 rec_pipe_time)
+{
+	guint64 start_time = 0;
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+
+	g_mutex_lock(&segment->lock);
+
+	if (!segment->active) {
+		g_mutex_unlock(&segment->lock);
+		return rec_pipe_time;
+	}
+
+	start_time = GST_TIME_AS_MSECONDS(segment->start_time);
+
+	g_mutex_unlock(&segment->lock);
+
+	/* start time is timestamp for muxer, it's scaled for slow/fast motion recording */
+	if (sc->info_video->record_timestamp_ratio != _MMCAMCORDER_DEFAULT_RECORDING_MOTION_RATE)
+		start_time = (guint64)((double)start_time / sc->info_video->record_timestamp_ratio);
+
+	return rec_pipe_time > start_time ? rec_pipe_time - start_time : 0;
+}
+
+
+static void __mmcamcorder_segment_report(mmf_camcorder_t *hcamcorder, const gchar *filename, guint index, guint64 duration)
+{
+	guint64 file_size = 0;
+	MMCamcorderRecordingSegmentType segment;
+
+	_mmcamcorder_get_file_size(filename, &file_size);
+
+	_mmcam_dbg_warn("segment[%u] [%s] - duration %"G_GUINT64_FORMAT" ms, size %"G_GUINT64_FORMAT" byte",
+		index, filename, duration, file_size);
+
+	memset(&segment, 0x0, sizeof(MMCamcorderRecordingSegmentType));
+
+	segment.filename = filename;
+	segment.index = index;
+	segment.duration = (unsigned long long)duration;
+	segment.filesize = (unsigned long long)(file_size >> 10);
+
+	_MMCAMCORDER_LOCK_SEGMENT_CALLBACK(hcamcorder);
+
+	if (hcamcorder->segment_cb)
+		hcamcorder->segment_cb(&segment, hcamcorder->segment_cb_param);
+
+	_MMCAMCORDER_UNLOCK_SEGMENT_CALLBACK(hcamcorder);
+}
+
+
+static void __mmcamcorder_segment_fail(mmf_camcorder_t *hcamcorder, int error_code)
+{
+	_MMCamcorderMsgItem msg;
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	_mmcam_dbg_err("failed to split segment[%u] [0x%x]", segment->index, error_code);
+
+	g_mutex_lock(&segment->lock);
+
+	segment->active = FALSE;
+	g_atomic_int_set(&segment->failed, TRUE);
+	g_atomic_int_set(&segment->state, _MMCAMCORDER_SEGMENT_STATE_NONE);
+	g_cond_broadcast(&segment->cond);
+
+	g_mutex_unlock(&segment->lock);
+
+	msg.id = MM_MESSAGE_CAMCORDER_ERROR;
+	msg.param.code = error_code;
+	_mmcamcorder_send_message((MMHandleType)hcamcorder, &msg);
+}
+
+
+static gboolean __mmcamcorder_segment_resend_event(GstPad *pad, GstEvent **event, gpointer user_data)
+{
+	GstPad *peer = NULL;
+	GstEvent *new_event = NULL;
+	GstSegment segment;
+	guint64 position = 0;
+	GstClockTime split_time = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(user_data);
+
+	if (GST_EVENT_TYPE(*event) == GST_EVENT_EOS)
+		return TRUE;
+
+	if (GST_EVENT_TYPE(*event) == GST_EVENT_SEGMENT) {
+		/* running time of next segment starts from split point */
+		gst_event_copy_segment(*event, &segment);
+
+		if (segment.format == GST_FORMAT_TIME) {
+			g_mutex_lock(&hcamcorder->segment.lock);
+			split_time = hcamcorder->segment.split_time;
+			g_mutex_unlock(&hcamcorder->segment.lock);
+
+			position = gst_segment_position_from_running_time(&segment, GST_FORMAT_TIME, split_time);
+			if (GST_CLOCK_TIME_IS_VALID(position)) {
+				segment.start = position;
+				segment.time = position;
+				segment.position = position;
+				segment.base = 0;
+			}
+		}
+
+		new_event = gst_event_new_segment(&segment);
+	} else {
+		new_event = gst_event_ref(*event);
+	}
+
+	peer = gst_pad_get_peer(pad);
+	if (!peer) {
+		gst_event_unref(new_event);
+		return TRUE;
+	}
+
+	if (!gst_pad_send_event(peer, new_event))
+		_mmcam_dbg_warn("[%s:%s] failed to send %s", GST_DEBUG_PAD_NAME(peer), GST_EVENT_TYPE_NAME(*event));
+
+	gst_object_unref(peer);
+
+	return TRUE;
+}
+
+
+static gboolean __mmcamcorder_segment_lock_encode_state(mmf_camcorder_t *hcamcorder)
+{
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	/* muxer and sink are not restarted while state of encoding pipeline is being changed */
+	while (!_MMCAMCORDER_TRYLOCK_GST_ENCODE_STATE(hcamcorder)) {
+		if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_SPLITTING) {
+			_mmcam_dbg_warn("encoding pipeline is being stopped");
+			return FALSE;
+		}
+
+		g_usleep(_MMCAMCORDER_SEGMENT_LOCK_INTERVAL);
+	}
+
+	/* splitting could be aborted while waiting for lock */
+	if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_SPLITTING) {
+		_mmcam_dbg_warn("splitting is aborted");
+		_MMCAMCORDER_UNLOCK_GST_ENCODE_STATE(hcamcorder);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+
+static void __mmcamcorder_segment_switch(mmf_camcorder_t *hcamcorder)
+{
+	int size = 0;
+	int enabletag = 0;
+	guint index = 0;
+	guint64 duration = 0;
+	gboolean async = TRUE;
+	gboolean restarted = FALSE;
+	char *target = NULL;
+	gchar *filename = NULL;
+	GstPad *pad = NULL;
+	GstElement *mux = NULL;
+	GstElement *sink = NULL;
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+	_MMCamcorderSubContext *sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	_MMCamcorderVideoInfo *info = sc->info_video;
+
+	mux = sc->encode_element[_MMCAMCORDER_ENCSINK_MUX].gst;
+	sink = sc->encode_element[_MMCAMCORDER_ENCSINK_SINK].gst;
+
+	mm_camcorder_get_attributes((MMHandleType)hcamcorder, NULL,
+		MMCAM_TARGET_FILENAME, &target, &size,
+		MMCAM_RECORDER_TAG_ENABLE, &enabletag,
+		NULL);
+
+	g_mutex_lock(&segment->lock);
+	index = segment->index;
+	duration = GST_TIME_AS_MSECONDS(segment->split_time - segment->start_time);
+	g_mutex_unlock(&segment->lock);
+
+	filename = __mmcamcorder_segment_make_filename(hcamcorder, target ? target : info->filename, index + 1);
+	if (!filename) {
+		__mmcamcorder_segment_fail(hcamcorder, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+		return;
+	}
+
+	if (!__mmcamcorder_segment_lock_encode_state(hcamcorder)) {
+		g_free(filename);
+		return;
+	}
+
+	/* close current file */
+	gst_element_set_state(mux, GST_STATE_NULL);
+	gst_element_set_state(sink, GST_STATE_NULL);
+
+	_MMCAMCORDER_UNLOCK_GST_ENCODE_STATE(hcamcorder);
+
+	if (enabletag && !(sc->ferror_send)) {
+		if (!__mmcamcorder_add_metadata((MMHandleType)hcamcorder, info->fileformat))
+			_mmcam_dbg_warn("failed to write location information [%s]", info->filename);
+	}
+
+	/* all muxed data of finished file is delivered before it's reported,
+	   then muxed stream of next file starts from offset 0.
+	   it's done without lock, because application callbacks can take long time */
+	_mmcamcorder_mstream_delivery_flush((MMHandleType)hcamcorder);
+	__mmcamcorder_segment_report(hcamcorder, info->filename, index, duration);
+
+	if (!__mmcamcorder_segment_lock_encode_state(hcamcorder)) {
+		/* recording is finished with this file, it should not be reported again */
+		g_mutex_lock(&segment->lock);
+		segment->closed = TRUE;
+		g_mutex_unlock(&segment->lock);
+
+		g_free(filename);
+		return;
+	}
+
+	g_free(info->filename);
+	info->filename = filename;
+
+	g_mutex_lock(&info->size_check_lock);
+	info->filesize = 0;
+	g_mutex_unlock(&info->size_check_lock);
+
+	sc->muxed_stream_offset = 0;
+	_mmcamcorder_mux_index_reset(&sc->mux_index);
+
+	/* open next file, sink should not wait for preroll in running pipeline */
+	_mmcam_dbg_warn("segment[%u] [%s]", index + 1, info->filename);
+
+	MMCAMCORDER_G_OBJECT_SET_POINTER(sink, "location", info->filename);
+	MMCAMCORDER_G_OBJECT_GET(sink, "async", &async);
+	MMCAMCORDER_G_OBJECT_SET(sink, "async", FALSE);
+
+	restarted = gst_element_sync_state_with_parent(sink) && gst_element_sync_state_with_parent(mux);
+
+	MMCAMCORDER_G_OBJECT_SET(sink, "async", async);
+
+	_MMCAMCORDER_UNLOCK_GST_ENCODE_STATE(hcamcorder);
+
+	if (restarted) {
+		pad = __mmcamcorder_segment_get_split_pad(sc, TRUE);
+		gst_pad_sticky_events_foreach(pad, __mmcamcorder_segment_resend_event, hcamcorder);
+		gst_object_unref(pad);
+
+		if (sc->audio_disable == FALSE) {
+			pad = __mmcamcorder_segment_get_split_pad(sc, FALSE);
+			gst_pad_sticky_events_foreach(pad, __mmcamcorder_segment_resend_event, hcamcorder);
+			gst_object_unref(pad);
+		}
+
+		g_mutex_lock(&segment->lock);
+
+		segment->index++;
+		segment->start_time = segment->split_time;
+		g_atomic_int_set(&segment->key_requested, FALSE);
+		g_atomic_int_set(&segment->state, _MMCAMCORDER_SEGMENT_STATE_NONE);
+		g_cond_broadcast(&segment->cond);
+
+		g_mutex_unlock(&segment->lock);
+	} else {
+		__mmcamcorder_segment_fail(hcamcorder, MM_ERROR_CAMCORDER_GST_STATECHANGE);
+	}
+}
+
+
+static void __mmcamcorder_segment_finish(mmf_camcorder_t *hcamcorder, GstPad *pad, gboolean is_video)
+{
+	GstPad *peer = NULL;
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	/* finish this stream of current file */
+	peer = gst_pad_get_peer(pad);
+	if (peer) {
+		gst_pad_send_event(peer, gst_event_new_eos());
+		gst_object_unref(peer);
+	}
+
+	g_mutex_lock(&segment->lock);
+
+	if (is_video)
+		segment->video_done = TRUE;
+	else
+		segment->audio_done = TRUE;
+
+	g_cond_broadcast(&segment->cond);
+
+	/* wait until next file is opened by segment thread, or splitting is failed or aborted */
+	while (g_atomic_int_get(&segment->state) == _MMCAMCORDER_SEGMENT_STATE_SPLITTING)
+		g_cond_wait(&segment->cond, &segment->lock);
+
+	g_mutex_unlock(&segment->lock);
+}
+
+
+static gpointer __mmcamcorder_segment_thread(gpointer data)
+{
+	gint64 end_time = 0;
+	gboolean do_switch = FALSE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(data);
+	_MMCamcorderSegment *segment = &hcamcorder->segment;
+
+	_mmcam_dbg_warn("start thread");
+
+	g_mutex_lock(&segment->lock);
+
+	while (!segment->exit) {
+		if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_SPLITTING) {
+			g_cond_wait(&segment->cond, &segment->lock);
+			continue;
+		}
+
+		/* audio could reach split point later than video by interleaving of muxer */
+		end_time = g_get_monotonic_time() + 2 * _MMCAMCORDER_SEGMENT_EOS_TIMEOUT;
+
+		while (!segment->exit &&
+		       g_atomic_int_get(&segment->state) == _MMCAMCORDER_SEGMENT_STATE_SPLITTING &&
+		       !(segment->video_done && segment->audio_done && segment->eos_received)) {
+			if (!g_cond_wait_until(&segment->cond, &segment->lock, end_time))
+				break;
+		}
+
+		if (segment->exit ||
+		    g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_SPLITTING)
+			continue;
+
+		do_switch = segment->video_done && segment->audio_done && segment->eos_received;
+
+		g_mutex_unlock(&segment->lock);
+
+		if (do_switch)
+			__mmcamcorder_segment_switch(hcamcorder);
+		else
+			__mmcamcorder_segment_fail(hcamcorder, MM_ERROR_CAMCORDER_RESPONSE_TIMEOUT);
+
+		g_mutex_lock(&segment->lock);
+	}
+
+	g_mutex_unlock(&segment->lock);
+
+	_mmcam_dbg_warn("exit thread");
+
+	return NULL;
+}
+
+
+static GstPadProbeReturn __mmcamcorder_video_dataprobe_segment(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
+{
+	GstClockTime running_time = GST_CLOCK_TIME_NONE;
+	GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
+	_MMCamcorderSubContext *sc = NULL;
+	_MMCamcorderSegment *segment = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, GST_PAD_PROBE_OK);
+	mmf_return_val_if_fail(buffer, GST_PAD_PROBE_DROP);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	mmf_return_val_if_fail(sc, GST_PAD_PROBE_OK);
+
+	segment = &hcamcorder->segment;
+
+	/* muxer is not restarted after failure of splitting */
+	if (g_atomic_int_get(&segment->failed))
+		return GST_PAD_PROBE_DROP;
+
+	/* next segment starts from keyframe */
+	if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_REQUESTED ||
+	    GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT))
+		return GST_PAD_PROBE_OK;
+
+	running_time = __mmcamcorder_segment_running_time(pad, buffer);
+	if (!GST_CLOCK_TIME_IS_VALID(running_time))
+		return GST_PAD_PROBE_OK;
+
+	g_mutex_lock(&segment->lock);
+
+	if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_REQUESTED) {
+		g_mutex_unlock(&segment->lock);
+		return GST_PAD_PROBE_OK;
+	}
+
+	segment->split_time = running_time;
+	segment->video_done = FALSE;
+	segment->audio_done = sc->audio_disable;
+	segment->eos_received = FALSE;
+	g_atomic_int_set(&segment->state, _MMCAMCORDER_SEGMENT_STATE_SPLITTING);
+
+	_mmcam_dbg_warn("split segment[%u] at %"GST_TIME_FORMAT, segment->index, GST_TIME_ARGS(running_time));
+
+	g_mutex_unlock(&segment->lock);
+
+	__mmcamcorder_segment_finish(hcamcorder, pad, TRUE);
+
+	/* keyframe is the first buffer of next file */
+	return g_atomic_int_get(&segment->failed) ? GST_PAD_PROBE_DROP : GST_PAD_PROBE_OK;
+}
+
+
+static GstPadProbeReturn __mmcamcorder_audio_dataprobe_segment(GstPad *pad, GstPadProbeInfo *info, gpointer u_data)
+{
+	gboolean reached = FALSE;
+	GstClockTime running_time = GST_CLOCK_TIME_NONE;
+	GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(u_data);
+	_MMCamcorderSegment *segment = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, GST_PAD_PROBE_OK);
+	mmf_return_val_if_fail(buffer, GST_PAD_PROBE_DROP);
+
+	segment = &hcamcorder->segment;
+
+	if (g_atomic_int_get(&segment->failed))
+		return GST_PAD_PROBE_DROP;
+
+	if (g_atomic_int_get(&segment->state) != _MMCAMCORDER_SEGMENT_STATE_SPLITTING)
+		return GST_PAD_PROBE_OK;
+
+	running_time = __mmcamcorder_segment_running_time(pad, buffer);
+	if (!GST_CLOCK_TIME_IS_VALID(running_time))
+		return GST_PAD_PROBE_OK;
+
+	/* audio buffers before keyframe of video are kept in current file */
+	g_mutex_lock(&segment->lock);
+	reached = g_atomic_int_get(&segment->state) == _MMCAMCORDER_SEGMENT_STATE_SPLITTING &&
+		!segment->audio_done && running_time >= segment->split_time;
+	g_mutex_unlock(&segment->lock);
+
+	if (!reached)
+		return GST_PAD_PROBE_OK;
+
+	__mmcamcorder_segment_finish(hcamcorder, pad, FALSE);
+
+	return g_atomic_int_get(&segment->failed) ? GST_PAD_PROBE_DROP : GST_PAD_PROBE_OK;
+}
+
+
+int _mmcamcorder_video_set_recording_segment(MMHandleType handle, int enable, const char *filename_template)
+{
+	int state = MM_CAMCORDER_STATE_NONE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_val_if_fail(hcamcorder, MM_ERROR_CAMCORDER_NOT_INITIALIZED);
+
+	if (hcamcorder->type != MM_CAMCORDER_MODE_VIDEO_CAPTURE) {
+		_mmcam_dbg_err("not supported in mode %d", hcamcorder->type);
+		return MM_ERROR_CAMCORDER_NOT_SUPPORTED;
+	}
+
+	state = _mmcamcorder_get_state(handle);
+	if (state == MM_CAMCORDER_STATE_RECORDING || state == MM_CAMCORDER_STATE_PAUSED) {
+		_mmcam_dbg_err("invalid state %d", state);
+		return MM_ERROR_CAMCORDER_INVALID_STATE;
+	}
+
+	_mmcam_dbg_log("segment %d, template [%s]", enable, filename_template ? filename_template : "NULL");
+
+	g_mutex_lock(&hcamcorder->segment.lock);
+
+	hcamcorder->segment.enable = enable ? TRUE : FALSE;
+	g_free(hcamcorder->segment.filename_template);
+	hcamcorder->segment.filename_template = g_strdup(filename_template);
+
+	g_mutex_unlock(&hcamcorder->segment.lock);
+
+	return MM_ERROR_NONE;
+}
+
+
+gboolean _mmcamcorder_video_segment_eos(MMHandleType handle)
+{
+	gboolean drop = FALSE;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+	_MMCamcorderSubContext *sc = NULL;
+	_MMCamcorderSegment *segment = NULL;
+
+	mmf_return_val_if_fail(hcamcorder, FALSE);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(handle);
+	mmf_return_val_if_fail(sc && sc->info_video, FALSE);
+
+	segment = &hcamcorder->segment;
+
+	g_mutex_lock(&segment->lock);
+
+	if (g_atomic_int_get(&segment->state) == _MMCAMCORDER_SEGMENT_STATE_SPLITTING) {
+		if (sc->info_video->b_commiting) {
+			/* recording is finished with current segment */
+			_mmcam_dbg_warn("commit while splitting segment[%u]", segment->index);
+			g_atomic_int_set(&segment->state, _MMCAMCORDER_SEGMENT_STATE_NONE);
+		} else {
+			segment->eos_received = TRUE;
+			drop = TRUE;
+		}
+
+		g_cond_broadcast(&segment->cond);
+	}
+
+	g_mutex_unlock(&segment->lock);
+
+	return drop;
+}
+
+
+void _mmcamcorder_video_segment_abort(MMHandleType handle)
+{
+	GThread *thread = NULL;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(handle);
+
+	mmf_return_if_fail(hcamcorder);
+
+	g_mutex_lock(&hcamcorder->segment.lock);
+
+	if (g_atomic_int_get(&hcamcorder->segment.state) != _MMCAMCORDER_SEGMENT_STATE_NONE) {
+		_mmcam_dbg_warn("abort splitting segment[%u]", hcamcorder->segment.index);
+		g_atomic_int_set(&hcamcorder->segment.state, _MMCAMCORDER_SEGMENT_STATE_NONE);
+	}
+
+	/* segment thread is finished with recording */
+	thread = hcamcorder->segment.thread;
+	hcamcorder->segment.thread = NULL;
+	hcamcorder->segment.exit = TRUE;
+
+	g_cond_broadcast(&hcamcorder->segment.cond);
+
+	g_mutex_unlock(&hcamcorder->segment.lock);
+
+	if (thread)
+		g_thread_join(thread);
+}
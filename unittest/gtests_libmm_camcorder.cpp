@@ -16,7 +16,12 @@
 
 
 #include <gio/gio.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
 #include "gtests_libmm_camcorder.h"
+#include "mm_camcorder_internal.h"
 
 using namespace std;
 using ::testing::InitGoogleTest;
@@ -63,6 +68,220 @@ static int _message_callback(int id, void *param, void *user_param)
 	return 1;
 }
 
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+static int _message_order_callback(int id, void *param, void *user_param)
+{
+	MMMessageParamType *m = (MMMessageParamType *)param;
+	vector< pair<int, int> > *messages = (vector< pair<int, int> > *)user_param;
+
+	if (id == MM_MESSAGE_CAMCORDER_RECORDING_STATUS)
+		messages->push_back(make_pair(id, (int)m->recording_status.elapsed));
+	else
+		messages->push_back(make_pair(id, m->code));
+
+	return 1;
+}
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+
+typedef struct {
+	guint64 length;
+	guint64 next_offset;
+	gboolean discontinuous;
+} muxed_stream_result;
+
+static gboolean _muxed_stream_slow_callback(MMCamcorderMuxedStreamDataType *stream, void *user_param)
+{
+	muxed_stream_result *result = (muxed_stream_result *)user_param;
+
+	if (result->length > 0 && stream->offset != result->next_offset)
+		result->discontinuous = TRUE;
+
+	result->length += stream->length;
+	result->next_offset = stream->offset + stream->length;
+
+	/* slower than muxer */
+	g_usleep(1000);
+
+	return TRUE;
+}
+
+static void _push_muxed_stream(MMHandleType handle, int count, gsize size)
+{
+	int i = 0;
+	GstBuffer *buffer = NULL;
+	GstPadProbeInfo info;
+
+	for (i = 0 ; i < count ; i++) {
+		buffer = gst_buffer_new_allocate(NULL, size, NULL);
+
+		memset(&info, 0x0, sizeof(GstPadProbeInfo));
+		info.type = GST_PAD_PROBE_TYPE_BUFFER;
+		info.data = buffer;
+
+		__mmcamcorder_muxed_dataprobe(NULL, &info, (gpointer)handle);
+
+		gst_buffer_unref(buffer);
+	}
+}
+
+static gboolean _make_synthetic_mp4(const char *filename, guint64 mdat_size)
+{
+	int fd = -1;
+	gboolean ret = FALSE;
+	guchar header[32];
+	guchar moov[16];
+
+	/* ftyp, mdat with largesize and moov with empty udta, payload of mdat is sparse */
+	GST_WRITE_UINT32_BE(header, 16);
+	memcpy(header + 4, "ftypisom", 8);
+	GST_WRITE_UINT32_BE(header + 12, 0);
+	GST_WRITE_UINT32_BE(header + 16, 1);
+	memcpy(header + 20, "mdat", 4);
+	GST_WRITE_UINT64_BE(header + 24, mdat_size);
+
+	GST_WRITE_UINT32_BE(moov, 16);
+	memcpy(moov + 4, "moov", 4);
+	GST_WRITE_UINT32_BE(moov + 8, 8);
+	memcpy(moov + 12, "udta", 4);
+
+	fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return FALSE;
+
+	if (pwrite(fd, header, sizeof(header), 0) == sizeof(header) &&
+		ftruncate(fd, (off_t)(16 + mdat_size)) == 0 &&
+		pwrite(fd, moov, sizeof(moov), (off_t)(16 + mdat_size)) == sizeof(moov))
+		ret = TRUE;
+
+	close(fd);
+
+	return ret;
+}
+
+/* temporary file is removed when it goes out of scope, also by failed assertion */
+class temp_file {
+	public:
+		explicit temp_file(const char *name) {
+			path = g_build_filename(g_get_tmp_dir(), name, NULL);
+		}
+
+		~temp_file() {
+			unlink(path);
+			g_free(path);
+		}
+
+		gchar *path;
+};
+
+/* segmented recording is disabled and reported files are removed when it goes out of scope */
+class segment_result {
+	public:
+		explicit segment_result(MMHandleType handle) : camcorder(handle) {
+			g_mutex_init(&lock);
+		}
+
+		~segment_result() {
+			unsigned int i = 0;
+
+			mm_camcorder_set_recording_segment_callback(camcorder, NULL, NULL);
+			mm_camcorder_set_recording_segment(camcorder, 0, NULL);
+
+			for (i = 0 ; i < filenames.size() ; i++)
+				unlink(filenames[i].c_str());
+
+			g_mutex_clear(&lock);
+		}
+
+		MMHandleType camcorder;
+		GMutex lock;
+		vector<string> filenames;
+		vector<unsigned long long> durations;
+};
+
+static gboolean _recording_segment_callback(MMCamcorderRecordingSegmentType *segment, void *user_param)
+{
+	segment_result *result = (segment_result *)user_param;
+
+	cout << "[RECORDING_SEGMENT_CALLBACK] " << segment->index << " " << segment->filename
+		<< " " << segment->duration << " ms" << endl;
+
+	if (result) {
+		g_mutex_lock(&result->lock);
+		result->filenames.push_back(segment->filename);
+		result->durations.push_back(segment->duration);
+		g_mutex_unlock(&result->lock);
+	}
+
+	return TRUE;
+}
+
+/* synthetic encoded frames of 10 fps, delta frames before first keyframe are also pushed */
+static void _push_pre_record_frames(MMHandleType handle, int count, int gop_length, gsize size)
+{
+	int i = 0;
+	GstBuffer *buffer = NULL;
+
+	for (i = -2 ; i < count ; i++) {
+		buffer = gst_buffer_new_allocate(NULL, size, NULL);
+		if (!buffer)
+			return;
+
+		gst_buffer_memset(buffer, 0, 0, size);
+
+		GST_BUFFER_PTS(buffer) = MAX(i, 0) * 100 * GST_MSECOND;
+
+		if (i < 0 || i % gop_length != 0)
+			GST_BUFFER_FLAG_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+
+		_mmcamcorder_video_pre_record_push(handle, buffer);
+		gst_buffer_unref(buffer);
+	}
+}
+
+/* duration in mvhd of finished file, -1 if moov is not written */
+static gint64 _get_mp4_duration(const char *filename)
+{
+	guchar buf[20];
+	guint32 timescale = 0;
+	guint64 duration = 0;
+	gint64 ret = -1;
+	FILE *f = fopen64(filename, "rb");
+
+	if (!f)
+		return -1;
+
+	if (!_mmcamcorder_find_tag(f, MMCAM_FOURCC('m', 'o', 'o', 'v'), TRUE) ||
+	    !_mmcamcorder_find_fourcc(f, MMCAM_FOURCC('m', 'v', 'h', 'd'), FALSE) ||
+	    fread(buf, 1, 4, f) != 4)
+		goto _DONE;
+
+	/* version 1 has 64 bit times */
+	if (buf[0] == 1) {
+		if (fread(buf, 1, 20, f) != 20)
+			goto _DONE;
+
+		timescale = GST_READ_UINT32_BE(buf + 16);
+		if (fread(buf, 1, 8, f) != 8)
+			goto _DONE;
+
+		duration = GST_READ_UINT64_BE(buf);
+	} else {
+		if (fread(buf, 1, 16, f) != 16)
+			goto _DONE;
+
+		timescale = GST_READ_UINT32_BE(buf + 8);
+		duration = GST_READ_UINT32_BE(buf + 12);
+	}
+
+	if (timescale > 0)
+		ret = (gint64)(duration * 1000 / timescale);
+
+_DONE:
+	fclose(f);
+
+	return ret;
+}
+
 static gboolean _get_video_recording_settings(int *video_encoder, int *audio_encoder, int *file_format)
 {
 	int i = 0;
@@ -155,6 +374,15 @@ static gboolean _video_stream_callback(MMCamcorderVideoStreamDataType *stream, v
 	return TRUE;
 }
 
+/* slow consumer, preview frames are queued and dropped while it's running */
+static gboolean _video_stream_slow_callback(MMCamcorderVideoStreamDataType *stream, void *user_param)
+{
+	g_atomic_int_inc((gint *)user_param);
+	g_usleep(100000);
+
+	return TRUE;
+}
+
 static gboolean _audio_stream_callback(MMCamcorderAudioStreamDataType *stream, void *user_param)
 {
 	cout << "[AUDIO_STREAM_CALLBACK]" << endl;
@@ -176,6 +404,26 @@ static gboolean _video_capture_callback(MMCamcorderCaptureDataType *frame, MMCam
 	return TRUE;
 }
 
+static int _captured_message_callback(int id, void *param, void *user_param)
+{
+	MMMessageParamType *m = (MMMessageParamType *)param;
+	vector<int> *counts = (vector<int> *)user_param;
+
+	if (id == MM_MESSAGE_CAMCORDER_CAPTURED) {
+		g_mutex_lock(&g_lock);
+		counts->push_back(m->code);
+		g_mutex_unlock(&g_lock);
+	}
+
+	return 1;
+}
+
+static gboolean _video_capture_count_callback(MMCamcorderCaptureDataType *frame, MMCamcorderCaptureDataType *thumbnail, void *user_data)
+{
+	g_atomic_int_inc((gint *)user_data);
+	return TRUE;
+}
+
 static int _start_preview(MMHandleType handle)
 {
 	int ret = MM_ERROR_NONE;
@@ -306,6 +554,28 @@ TEST_F(MMCamcorderTest, RealizeN)
 	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
 }
 
+TEST_F(MMCamcorderTest, RealizeRepeatP)
+{
+	int i = 0;
+	int ret = MM_ERROR_NONE;
+	gint64 start = 0;
+	gint64 elapsed = 0;
+
+	for (i = 0 ; i < 10 ; i++) {
+		start = g_get_monotonic_time();
+
+		ret = mm_camcorder_realize(g_cam_handle);
+		ASSERT_EQ(ret, MM_ERROR_NONE);
+
+		elapsed += g_get_monotonic_time() - start;
+
+		ret = mm_camcorder_unrealize(g_cam_handle);
+		ASSERT_EQ(ret, MM_ERROR_NONE);
+	}
+
+	cout << "[REALIZE] average " << elapsed / i << " us" << endl;
+}
+
 TEST_F(MMCamcorderTest, UnrealizeP)
 {
 	int ret = MM_ERROR_NONE;
@@ -480,6 +750,91 @@ TEST_F(MMCamcorderTest, CaptureStopP)
 	_stop_preview(g_cam_handle);
 }
 
+TEST_F(MMCamcorderTest, CapturePipelineMultiShotP)
+{
+	int ret = MM_ERROR_NONE;
+	int capture_count = 3;
+	gint callback_count = 0;
+	gint64 end_time = 0;
+	int send_count = 0;
+	gboolean capturing = FALSE;
+	size_t received = 0;
+	vector<int> counts;
+	vector<int> received_counts;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(g_cam_handle);
+	_MMCamcorderSubContext *sc = NULL;
+
+	ASSERT_TRUE(hcamcorder != NULL);
+
+	/* restart capture stages with queue depth, captured images are delivered in other threads */
+	_mmcamcorder_capture_pipeline_destroy(g_cam_handle);
+	ASSERT_EQ(_mmcamcorder_capture_pipeline_start(g_cam_handle, 2), MM_ERROR_NONE);
+	ASSERT_EQ(hcamcorder->capture_pipeline.depth, 2);
+
+	ASSERT_EQ(_start_preview(g_cam_handle), MM_ERROR_NONE);
+
+	mm_camcorder_set_message_callback(g_cam_handle, _captured_message_callback, &counts);
+	mm_camcorder_set_video_capture_callback(g_cam_handle, _video_capture_count_callback, &callback_count);
+
+	ret = mm_camcorder_set_attributes(g_cam_handle, NULL,
+		MMCAM_CAPTURE_COUNT, capture_count,
+		NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_capture_start(g_cam_handle);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	if (ret == MM_ERROR_NONE) {
+		end_time = g_get_monotonic_time() + 10 * G_TIME_SPAN_SECOND;
+
+		do {
+			while (g_main_context_iteration(NULL, FALSE));
+
+			g_mutex_lock(&g_lock);
+			received = counts.size();
+			g_mutex_unlock(&g_lock);
+
+			if (received >= (size_t)capture_count)
+				break;
+
+			g_usleep(10000);
+		} while (g_get_monotonic_time() < end_time);
+
+		mm_camcorder_capture_stop(g_cam_handle);
+	}
+
+	/* flush is done without command lock, it should not wait for capture callback */
+	EXPECT_EQ(mm_camcorder_stop(g_cam_handle), MM_ERROR_NONE);
+	EXPECT_EQ(hcamcorder->capture_pipeline.in_flight, 0);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(hcamcorder);
+	if (sc && sc->info_image) {
+		g_mutex_lock(&hcamcorder->capture_pipeline.lock);
+		capturing = sc->info_image->capturing;
+		send_count = sc->info_image->capture_send_count;
+		g_mutex_unlock(&hcamcorder->capture_pipeline.lock);
+
+		EXPECT_FALSE(capturing);
+		EXPECT_EQ(send_count, 0);
+	}
+
+	mm_camcorder_unrealize(g_cam_handle);
+
+	while (g_main_context_iteration(NULL, FALSE));
+
+	mm_camcorder_set_message_callback(g_cam_handle, _message_callback, g_cam_handle);
+
+	/* all images are delivered in order */
+	g_mutex_lock(&g_lock);
+	received_counts = counts;
+	g_mutex_unlock(&g_lock);
+
+	EXPECT_EQ(g_atomic_int_get(&callback_count), capture_count);
+	ASSERT_EQ(received_counts.size(), (size_t)capture_count);
+	for (received = 0 ; received < received_counts.size() ; received++)
+		EXPECT_EQ(received_counts[received], (int)received + 1);
+}
+
 TEST_F(MMCamcorderTest, SetMessageCallbackP)
 {
 	int ret = MM_ERROR_NONE;
@@ -725,35 +1080,1088 @@ TEST_F(MMCamcorderTest, GetState2P)
 	ASSERT_EQ(ret, MM_ERROR_NONE);
 }
 
-TEST_F(MMCamcorderTest, GetAttributesP)
+TEST_F(MMCamcorderTest, GetPreviewProfileP)
 {
 	int ret = MM_ERROR_NONE;
-	int device_count = 0;
-	int audio_device = 0;
+	MMCamcorderPreviewProfileType profile;
 
-	ret = mm_camcorder_get_attributes(g_cam_handle, NULL,
-		MMCAM_CAMERA_DEVICE_COUNT, &device_count,
-		MMCAM_AUDIO_DEVICE, &audio_device,
-		NULL);
+	ret = mm_camcorder_set_video_stream_callback(g_cam_handle, _video_stream_callback, g_cam_handle);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_preview_profile(g_cam_handle, 1);
 	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	ASSERT_EQ(_start_preview(g_cam_handle), MM_ERROR_NONE);
+
+	sleep(1);
+
+	ret = mm_camcorder_get_preview_profile(g_cam_handle, &profile);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+	EXPECT_EQ(profile.frame_count > 0, TRUE);
+	EXPECT_EQ(profile.stage[MM_CAMCORDER_PREVIEW_PROFILE_STAGE_PROBE].count, profile.frame_count);
+
+	mm_camcorder_set_preview_profile(g_cam_handle, 0);
+
+	_stop_preview(g_cam_handle);
 }
 
-TEST_F(MMCamcorderTest, SetAttributesP)
+TEST_F(MMCamcorderTest, GetPreviewProfileN)
 {
 	int ret = MM_ERROR_NONE;
-	int audio_encoder = 0;
-	int file_format = 0;
-	gboolean ret_settings = FALSE;
+	MMCamcorderPreviewProfileType profile;
 
-	ret_settings = _get_audio_recording_settings(&audio_encoder, &file_format);
-	ASSERT_EQ(ret_settings, TRUE);
+	ret = mm_camcorder_get_preview_profile(NULL, &profile);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
 
-	ret = mm_camcorder_set_attributes(g_cam_handle, NULL,
-		MMCAM_MODE, MM_CAMCORDER_MODE_AUDIO,
-		MMCAM_AUDIO_ENCODER, audio_encoder,
-		MMCAM_FILE_FORMAT, file_format,
-		NULL);
+	ret = mm_camcorder_get_preview_profile(g_cam_handle, NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, GetJpegFallbackCountP)
+{
+	int ret = MM_ERROR_NONE;
+	int count = -1;
+	unsigned int width = 64;
+	unsigned int height = 16;
+	unsigned int stride = (width << 1) + 32;
+	unsigned int length = 0;
+	unsigned char *src = NULL;
+	void *result = NULL;
+
+	ret = mm_camcorder_get_jpeg_fallback_count(g_cam_handle, &count);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+	EXPECT_EQ(count, 0);
+
+	/* padded YUYV can not be encoded directly, it's converted to I420 */
+	src = (unsigned char *)g_malloc0(stride * height);
+
+	if (_mmcamcorder_encode_jpeg(g_cam_handle, src, width, height, MM_PIXEL_FORMAT_YUYV,
+		stride * height, stride, 90, &result, &length))
+		free(result);
+
+	g_free(src);
+
+	ret = mm_camcorder_get_jpeg_fallback_count(g_cam_handle, &count);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+	EXPECT_EQ(count, 1);
+}
+
+TEST_F(MMCamcorderTest, EncodeJpegPaddedNV12P)
+{
+	int count = -1;
+	int direct_count = -1;
+	unsigned int width = 1920;
+	unsigned int height = 1080;
+	unsigned int stride = 0;
+	unsigned int length = (((width * height * 3) >> 1) + 4095) & ~4095;
+	unsigned int result_length = 0;
+	unsigned char *src = NULL;
+	void *result = NULL;
+
+	/* size is aligned to 4K, it's not used to derive stride */
+	EXPECT_TRUE(_mmcamcorder_get_src_stride(MM_PIXEL_FORMAT_NV12, width, height, length, 0, &stride));
+	EXPECT_EQ(stride, width);
+
+	/* stride from video meta or caps */
+	EXPECT_TRUE(_mmcamcorder_get_src_stride(MM_PIXEL_FORMAT_NV12, width, height, 2048 * 1620, 2048, &stride));
+	EXPECT_EQ(stride, 2048u);
+
+	/* stride is derived only if length is exactly same with planes */
+	EXPECT_TRUE(_mmcamcorder_get_src_stride(MM_PIXEL_FORMAT_NV12, width, height, 2048 * 1620, 0, &stride));
+	EXPECT_EQ(stride, 2048u);
+
+	/* stride which is not fit in buffer is ignored */
+	EXPECT_TRUE(_mmcamcorder_get_src_stride(MM_PIXEL_FORMAT_NV12, width, height, length, 4096, &stride));
+	EXPECT_EQ(stride, width);
+
+	EXPECT_TRUE(_mmcamcorder_get_src_stride(MM_PIXEL_FORMAT_YUYV, width, height, length, 0, &stride));
+	EXPECT_EQ(stride, width << 1);
+
+	/* too small */
+	EXPECT_FALSE(_mmcamcorder_get_src_stride(MM_PIXEL_FORMAT_NV12, width, height, width * height, 0, &stride));
+
+	/* tight rows with padding at the end, it's encoded directly if it's supported */
+	src = (unsigned char *)g_malloc0(length);
+
+	EXPECT_TRUE(_mmcamcorder_encode_jpeg(g_cam_handle, src, width, height, MM_PIXEL_FORMAT_NV12,
+		length, 0, 90, &result, &result_length));
+	free(result);
+	result = NULL;
+
+	EXPECT_EQ(mm_camcorder_get_jpeg_fallback_count(g_cam_handle, &direct_count), MM_ERROR_NONE);
+
+	/* padded rows are converted with stride of source */
+	EXPECT_TRUE(_mmcamcorder_encode_jpeg(g_cam_handle, src, 1280, 720, MM_PIXEL_FORMAT_NV12,
+		length, 1536, 90, &result, &result_length));
+	free(result);
+
+	EXPECT_EQ(mm_camcorder_get_jpeg_fallback_count(g_cam_handle, &count), MM_ERROR_NONE);
+	EXPECT_EQ(count, direct_count + 1);
+
+	g_free(src);
+}
+
+TEST_F(MMCamcorderTest, ExifTemplateReuseP)
+{
+	int ret = MM_ERROR_NONE;
+	int count = 0;
+	ExifData *ed = NULL;
+	ExifEntry *entry = NULL;
+	mm_exif_info_t *info = NULL;
+	mm_exif_template_t tmpl;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(g_cam_handle);
+
+	ASSERT_TRUE(hcamcorder != NULL);
+
+	/* EXIF is made for first capture and patched for next one */
+	ret = mm_camcorder_realize(g_cam_handle);
 	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	mm_exif_template_clear(&hcamcorder->exif_template);
+	EXPECT_EQ(mm_exif_create_exif_info(&hcamcorder->exif_info), MM_ERROR_NONE);
+
+	if (hcamcorder->exif_info) {
+		EXPECT_EQ(__mmcamcorder_set_exif_basic_info(g_cam_handle, 640, 480), MM_ERROR_NONE);
+		EXPECT_EQ(hcamcorder->exif_template.state, MM_EXIF_TEMPLATE_STATE_READY);
+		EXPECT_EQ(hcamcorder->exif_template.cursor, 0);
+
+		count = hcamcorder->exif_template.count;
+		EXPECT_GT(count, 0);
+
+		EXPECT_EQ(__mmcamcorder_set_exif_basic_info(g_cam_handle, 640, 480), MM_ERROR_NONE);
+		EXPECT_EQ(hcamcorder->exif_template.state, MM_EXIF_TEMPLATE_STATE_READY);
+		EXPECT_EQ(hcamcorder->exif_template.count, count);
+		EXPECT_EQ(hcamcorder->exif_template.cursor, count);
+
+		mm_exif_destory_exif_info(hcamcorder->exif_info);
+		hcamcorder->exif_info = NULL;
+	}
+
+	mm_camcorder_unrealize(g_cam_handle);
+
+	/* tag is set twice with different length, the last one is in template */
+	memset(&tmpl, 0x0, sizeof(mm_exif_template_t));
+	ASSERT_EQ(mm_exif_create_exif_info(&info), MM_ERROR_NONE);
+
+	ed = exif_data_new();
+	if (ed) {
+		exif_data_set_byte_order(ed, EXIF_BYTE_ORDER_INTEL);
+
+		mm_exif_template_record_begin(&tmpl);
+		EXPECT_EQ(mm_exif_template_set_entry(&tmpl, ed, EXIF_IFD_0, EXIF_TAG_SOFTWARE,
+			EXIF_FORMAT_ASCII, 4, "1.0"), MM_ERROR_NONE);
+		EXPECT_EQ(mm_exif_template_set_entry(&tmpl, ed, EXIF_IFD_0, EXIF_TAG_SOFTWARE,
+			EXIF_FORMAT_ASCII, 10, "Tizen 5.5"), MM_ERROR_NONE);
+		EXPECT_EQ(mm_exif_set_exif_to_info(info, ed), MM_ERROR_NONE);
+		EXPECT_EQ(mm_exif_template_record_end(&tmpl, info), MM_ERROR_NONE);
+		EXPECT_EQ(tmpl.state, MM_EXIF_TEMPLATE_STATE_READY);
+
+		exif_data_unref(ed);
+		ed = NULL;
+	}
+
+	if (tmpl.state == MM_EXIF_TEMPLATE_STATE_READY) {
+		EXPECT_EQ(mm_exif_template_patch_begin(&tmpl), MM_ERROR_NONE);
+		EXPECT_EQ(mm_exif_template_set_entry(&tmpl, NULL, EXIF_IFD_0, EXIF_TAG_SOFTWARE,
+			EXIF_FORMAT_ASCII, 4, "2.0"), MM_ERROR_NONE);
+		EXPECT_EQ(mm_exif_template_set_entry(&tmpl, NULL, EXIF_IFD_0, EXIF_TAG_SOFTWARE,
+			EXIF_FORMAT_ASCII, 10, "Tizen 6.0"), MM_ERROR_NONE);
+		EXPECT_EQ(mm_exif_template_patch_end(&tmpl, info), MM_ERROR_NONE);
+
+		ed = exif_data_new_from_data((const unsigned char *)info->data, info->size);
+		EXPECT_TRUE(ed != NULL);
+		if (ed) {
+			entry = exif_content_get_entry(ed->ifd[EXIF_IFD_0], EXIF_TAG_SOFTWARE);
+			EXPECT_TRUE(entry != NULL);
+			if (entry) {
+				EXPECT_EQ(entry->components, (unsigned long)10);
+				EXPECT_STREQ((const char *)entry->data, "Tizen 6.0");
+			}
+
+			exif_data_unref(ed);
+		}
+	}
+
+	mm_exif_template_clear(&tmpl);
+	mm_exif_destory_exif_info(info);
+}
+
+TEST_F(MMCamcorderTest, GetJpegFallbackCountN)
+{
+	int ret = MM_ERROR_NONE;
+	int count = 0;
+
+	ret = mm_camcorder_get_jpeg_fallback_count(NULL, &count);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_get_jpeg_fallback_count(g_cam_handle, NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, GetVideoStreamDeliveryCountP)
+{
+	int ret = MM_ERROR_NONE;
+	int delivered = -1;
+	int dropped = -1;
+
+	ret = mm_camcorder_set_video_stream_callback(g_cam_handle, _video_stream_callback, g_cam_handle);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ASSERT_EQ(_start_preview(g_cam_handle), MM_ERROR_NONE);
+
+	sleep(1);
+
+	_stop_preview(g_cam_handle);
+
+	ret = mm_camcorder_get_video_stream_delivery_count(g_cam_handle, &delivered, &dropped);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+	EXPECT_GT(delivered, 0);
+	EXPECT_GE(dropped, 0);
+}
+
+TEST_F(MMCamcorderTest, VideoStreamDeliveryQueueP)
+{
+	int ret = MM_ERROR_NONE;
+	int delivered = 0;
+	int dropped = 0;
+	unsigned int i = 0;
+	gint callback_count = 0;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(g_cam_handle);
+	const int drop_policy[] = {_MMCAMCORDER_VSTREAM_DROP_NEWEST, _MMCAMCORDER_VSTREAM_DROP_OLDEST};
+
+	ASSERT_TRUE(hcamcorder != NULL);
+
+	for (i = 0 ; i < G_N_ELEMENTS(drop_policy) ; i++) {
+		/* restart delivery thread with queue depth, video stream is delivered in it */
+		_mmcamcorder_vstream_delivery_destroy(g_cam_handle);
+		ASSERT_EQ(_mmcamcorder_vstream_delivery_start(g_cam_handle, 2, drop_policy[i]), MM_ERROR_NONE);
+		ASSERT_TRUE(hcamcorder->vstream_delivery.thread != NULL);
+
+		g_atomic_int_set(&callback_count, 0);
+
+		ret = mm_camcorder_set_video_stream_callback(g_cam_handle, _video_stream_slow_callback, &callback_count);
+		EXPECT_EQ(ret, MM_ERROR_NONE);
+
+		ASSERT_EQ(_start_preview(g_cam_handle), MM_ERROR_NONE);
+
+		sleep(1);
+
+		/* queued frames are delivered before preview stop returns */
+		_stop_preview(g_cam_handle);
+
+		ret = mm_camcorder_get_video_stream_delivery_count(g_cam_handle, &delivered, &dropped);
+		EXPECT_EQ(ret, MM_ERROR_NONE);
+
+		cout << "[DROP POLICY " << drop_policy[i] << "] delivered " << delivered << ", dropped " << dropped << endl;
+
+		EXPECT_GT(delivered, 0);
+		EXPECT_EQ(delivered, g_atomic_int_get(&callback_count));
+
+		/* streaming thread is not blocked by slow callback, frames are dropped instead */
+		EXPECT_GT(dropped, 0);
+	}
+
+	mm_camcorder_set_video_stream_callback(g_cam_handle, NULL, NULL);
+	_mmcamcorder_vstream_delivery_destroy(g_cam_handle);
+}
+
+TEST_F(MMCamcorderTest, GetVideoStreamDeliveryCountN)
+{
+	int ret = MM_ERROR_NONE;
+	int delivered = 0;
+	int dropped = 0;
+
+	ret = mm_camcorder_get_video_stream_delivery_count(NULL, &delivered, &dropped);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_get_video_stream_delivery_count(g_cam_handle, NULL, &dropped);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_get_video_stream_delivery_count(g_cam_handle, &delivered, NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, GetRecordingStatsP)
+{
+	int ret = MM_ERROR_NONE;
+	MMCamcorderRecordingStatsType stats;
+
+	ret = mm_camcorder_get_recording_stats(g_cam_handle, &stats);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+	EXPECT_EQ(stats.dropped_frames, 0);
+}
+
+TEST_F(MMCamcorderTest, GetRecordingStatsN)
+{
+	int ret = MM_ERROR_NONE;
+	MMCamcorderRecordingStatsType stats;
+
+	ret = mm_camcorder_get_recording_stats(NULL, &stats);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_get_recording_stats(g_cam_handle, NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, SetRecordingStatusIntervalP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_recording_status_interval(g_cam_handle, 250);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_recording_status_interval(g_cam_handle, 0);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, RecordingStatusIntervalRateLimitP)
+{
+	int ret = MM_ERROR_NONE;
+	int sent = 0;
+	guint64 elapsed = 0;
+	MMCamcorderRecordingStatsType stats;
+
+	/* send status at most every 250 msec */
+	ret = mm_camcorder_set_recording_status_interval(g_cam_handle, 250);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	_mmcamcorder_recording_stats_reset(g_cam_handle);
+
+	for (elapsed = 0 ; elapsed < 1000 ; elapsed += 10) {
+		if (_mmcamcorder_recording_stats_update(g_cam_handle, elapsed, elapsed, 0))
+			sent++;
+	}
+
+	/* 0, 250, 500 and 750 msec */
+	EXPECT_EQ(sent, 4);
+
+	/* stats is updated for every buffer regardless of interval */
+	ret = mm_camcorder_get_recording_stats(g_cam_handle, &stats);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+	EXPECT_EQ(stats.elapsed, (unsigned long long)990);
+
+	/* new recording restarts recording time */
+	EXPECT_TRUE(_mmcamcorder_recording_stats_update(g_cam_handle, 0, 0, 0));
+
+	/* every buffer */
+	ret = mm_camcorder_set_recording_status_interval(g_cam_handle, 0);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	for (sent = 0, elapsed = 10 ; elapsed < 1000 ; elapsed += 10) {
+		if (_mmcamcorder_recording_stats_update(g_cam_handle, elapsed, elapsed, 0))
+			sent++;
+	}
+
+	EXPECT_EQ(sent, 99);
+}
+
+TEST_F(MMCamcorderTest, SetRecordingStatusIntervalN)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_recording_status_interval(NULL, 250);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_set_recording_status_interval(g_cam_handle, -1);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, SetPreRecordP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_pre_record(g_cam_handle, 3000, 8192);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_pre_record(g_cam_handle, 0, 0);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, SetPreRecordN)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_pre_record(NULL, 3000, 8192);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_set_pre_record(g_cam_handle, -1, 8192);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_set_pre_record(g_cam_handle, 3000, 0);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, PreRecordEvictionP)
+{
+	int ret = MM_ERROR_NONE;
+	GQueue frames = G_QUEUE_INIT;
+	GstBuffer *frame = NULL;
+
+	/* 3 seconds of 10 fps, keyframe for every second, 100 bytes per frame */
+	ret = mm_camcorder_set_pre_record(g_cam_handle, 1000, 8192);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	_push_pre_record_frames(g_cam_handle, 30, 10, 100);
+	_mmcamcorder_video_pre_record_take(g_cam_handle, &frames);
+
+	/* oldest GOP is evicted, because next one still covers the duration */
+	EXPECT_EQ(g_queue_get_length(&frames), 20u);
+
+	frame = (GstBuffer *)g_queue_peek_head(&frames);
+	ASSERT_TRUE(frame != NULL);
+	EXPECT_FALSE(GST_BUFFER_FLAG_IS_SET(frame, GST_BUFFER_FLAG_DELTA_UNIT));
+	EXPECT_EQ(GST_BUFFER_PTS(frame), (GstClockTime)GST_SECOND);
+
+	/* kept frames cover the duration */
+	EXPECT_GE(GST_BUFFER_PTS((GstBuffer *)g_queue_peek_tail(&frames)) - GST_BUFFER_PTS(frame), (GstClockTime)GST_SECOND);
+
+	while ((frame = (GstBuffer *)g_queue_pop_head(&frames)) != NULL)
+		gst_buffer_unref(frame);
+
+	/* size limit 1 KB keeps only the last GOP of 1000 bytes */
+	ret = mm_camcorder_set_pre_record(g_cam_handle, 10000, 1);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	_push_pre_record_frames(g_cam_handle, 30, 10, 100);
+	_mmcamcorder_video_pre_record_take(g_cam_handle, &frames);
+
+	EXPECT_EQ(g_queue_get_length(&frames), 10u);
+
+	frame = (GstBuffer *)g_queue_peek_head(&frames);
+	ASSERT_TRUE(frame != NULL);
+	EXPECT_FALSE(GST_BUFFER_FLAG_IS_SET(frame, GST_BUFFER_FLAG_DELTA_UNIT));
+	EXPECT_EQ(GST_BUFFER_PTS(frame), (GstClockTime)(2 * GST_SECOND));
+
+	while ((frame = (GstBuffer *)g_queue_pop_head(&frames)) != NULL)
+		gst_buffer_unref(frame);
+
+	ret = mm_camcorder_set_pre_record(g_cam_handle, 0, 0);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, SetWarmRecordP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_warm_record(g_cam_handle, 1);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_warm_record(g_cam_handle, 0);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, SetWarmRecordN)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_warm_record(NULL, 1);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, RecordStartLatencyP)
+{
+	int ret = MM_ERROR_NONE;
+	int warm = 0;
+	int video_encoder = 0;
+	int audio_encoder = 0;
+	int file_format = 0;
+	int retry = 0;
+	gboolean ret_settings = FALSE;
+	GstElement *parked_pipe = NULL;
+	MMCamcorderRecordingStatsType stats;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(g_cam_handle);
+	_MMCamcorderSubContext *sc = NULL;
+
+	ASSERT_EQ(_start_preview(g_cam_handle), MM_ERROR_NONE);
+
+	sc = MMF_CAMCORDER_SUBCONTEXT(g_cam_handle);
+	ASSERT_TRUE(sc != NULL);
+
+	ret_settings = _get_video_recording_settings(&video_encoder, &audio_encoder, &file_format);
+	EXPECT_EQ(ret_settings, TRUE);
+
+	ret = mm_camcorder_set_attributes(g_cam_handle, NULL,
+		MMCAM_VIDEO_ENCODER, video_encoder,
+		MMCAM_AUDIO_ENCODER, audio_encoder,
+		MMCAM_FILE_FORMAT, file_format,
+		NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	for (warm = 0 ; warm <= 1 ; warm++) {
+		ret = mm_camcorder_set_warm_record(g_cam_handle, warm);
+		EXPECT_EQ(ret, MM_ERROR_NONE);
+
+		/* wait for encoding pipeline to be built by task thread */
+		parked_pipe = NULL;
+		for (retry = 0 ; warm && retry < 30 && !parked_pipe ; retry++) {
+			g_mutex_lock(&hcamcorder->task_thread_lock);
+			if (sc->encode_pipe_parked)
+				parked_pipe = sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst;
+			g_mutex_unlock(&hcamcorder->task_thread_lock);
+
+			if (!parked_pipe)
+				g_usleep(100000);
+		}
+
+		EXPECT_EQ(parked_pipe != NULL, warm == 1);
+
+		ret = mm_camcorder_record(g_cam_handle);
+		EXPECT_EQ(ret, MM_ERROR_NONE);
+		if (ret != MM_ERROR_NONE)
+			break;
+
+		/* warm start records with the kept pipeline instead of new one */
+		if (parked_pipe) {
+			EXPECT_EQ(sc->encode_element[_MMCAMCORDER_ENCODE_MAIN_PIPE].gst, parked_pipe);
+			EXPECT_FALSE(sc->encode_pipe_parked);
+		}
+
+		sleep(1);
+
+		mm_camcorder_cancel(g_cam_handle);
+
+		memset(&stats, 0x0, sizeof(MMCamcorderRecordingStatsType));
+
+		ret = mm_camcorder_get_recording_stats(g_cam_handle, &stats);
+		EXPECT_EQ(ret, MM_ERROR_NONE);
+
+		cout << "[warm record " << warm << "] start latency " << stats.start_latency << " ms" << endl;
+	}
+
+	mm_camcorder_set_warm_record(g_cam_handle, 0);
+
+	_stop_preview(g_cam_handle);
+}
+
+TEST_F(MMCamcorderTest, SetRecordingSegmentP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_recording_segment(g_cam_handle, 1, "/tmp/segment_%N_%Y%m%d.mp4");
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_recording_segment(g_cam_handle, 0, NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, SetRecordingSegmentN)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_recording_segment(NULL, 1, NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, SetRecordingSegmentCallbackP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_recording_segment_callback(g_cam_handle, _recording_segment_callback, NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, SetRecordingSegmentCallbackN)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_set_recording_segment_callback(NULL, _recording_segment_callback, NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+}
+
+TEST_F(MMCamcorderTest, RecordingSegmentRolloverP)
+{
+	int ret = MM_ERROR_NONE;
+	int video_encoder = 0;
+	int audio_encoder = 0;
+	int file_format = 0;
+	unsigned int i = 0;
+	gint64 duration = 0;
+	gboolean ret_settings = FALSE;
+	temp_file target("gtests_segment.mp4");
+	temp_file second("gtests_segment_2.mp4");
+	segment_result result(g_cam_handle);
+
+	unlink(target.path);
+	unlink(second.path);
+
+	ASSERT_EQ(_start_preview(g_cam_handle), MM_ERROR_NONE);
+
+	ret_settings = _get_video_recording_settings(&video_encoder, &audio_encoder, &file_format);
+	EXPECT_EQ(ret_settings, TRUE);
+
+	/* roll over to next file for every 2 seconds */
+	ret = mm_camcorder_set_attributes(g_cam_handle, NULL,
+		MMCAM_VIDEO_ENCODER, video_encoder,
+		MMCAM_AUDIO_ENCODER, audio_encoder,
+		MMCAM_FILE_FORMAT, file_format,
+		MMCAM_TARGET_FILENAME, target.path, strlen(target.path),
+		MMCAM_TARGET_TIME_LIMIT, 2,
+		NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_recording_segment(g_cam_handle, 1, NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_recording_segment_callback(g_cam_handle, _recording_segment_callback, &result);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_record(g_cam_handle);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	if (ret == MM_ERROR_NONE) {
+		sleep(5);
+		ret = mm_camcorder_commit(g_cam_handle);
+		EXPECT_EQ(ret, MM_ERROR_NONE);
+	}
+
+	_stop_preview(g_cam_handle);
+
+	/* first segment is target file, and "_2" is added for the next one */
+	ASSERT_GE(result.filenames.size(), 2u);
+	EXPECT_STREQ(result.filenames[0].c_str(), target.path);
+	EXPECT_STREQ(result.filenames[1].c_str(), second.path);
+
+	for (i = 0 ; i < result.filenames.size() ; i++) {
+		duration = _get_mp4_duration(result.filenames[i].c_str());
+		cout << "[SEGMENT " << i + 1 << "] " << result.filenames[i] << " " << duration << " ms" << endl;
+
+		/* each file is finished with its own moov */
+		EXPECT_GT(duration, 0);
+		EXPECT_NEAR(duration, (gint64)result.durations[i], 500);
+
+		/* segment is finished at the first keyframe after the limit */
+		if (i + 1 < result.filenames.size()) {
+			EXPECT_GE(duration, 2000 - 100);
+			EXPECT_LT(duration, 2000 + 3000);
+		}
+	}
+}
+
+TEST_F(MMCamcorderTest, MuxedStreamDeliveryP)
+{
+	int ret = MM_ERROR_NONE;
+	muxed_stream_result result;
+
+	memset(&result, 0x0, sizeof(muxed_stream_result));
+
+	ret = mm_camcorder_realize(g_cam_handle);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_muxed_stream_callback(g_cam_handle, _muxed_stream_slow_callback, &result);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	/* queue is smaller than pushed data */
+	_mmcamcorder_mstream_delivery_destroy(g_cam_handle);
+	ret = _mmcamcorder_mstream_delivery_start(g_cam_handle, 64, 0, 64);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	/* muxer waits for delivery instead of dropping data */
+	_push_muxed_stream(g_cam_handle, 256, 16);
+	_mmcamcorder_mstream_delivery_flush(g_cam_handle);
+
+	EXPECT_EQ(result.length, (guint64)(256 * 16));
+	EXPECT_FALSE(result.discontinuous);
+
+	/* queued data and data after cancel are not delivered */
+	_push_muxed_stream(g_cam_handle, 8, 16);
+	_mmcamcorder_mstream_delivery_cancel(g_cam_handle);
+
+	memset(&result, 0x0, sizeof(muxed_stream_result));
+
+	_push_muxed_stream(g_cam_handle, 8, 16);
+	_mmcamcorder_mstream_delivery_flush(g_cam_handle);
+
+	EXPECT_EQ(result.length, (guint64)0);
+
+	/* delivered again after reset */
+	_mmcamcorder_mstream_delivery_reset(g_cam_handle);
+	_push_muxed_stream(g_cam_handle, 8, 16);
+	_mmcamcorder_mstream_delivery_flush(g_cam_handle);
+
+	EXPECT_EQ(result.length, (guint64)(8 * 16));
+
+	mm_camcorder_set_muxed_stream_callback(g_cam_handle, NULL, NULL);
+	_mmcamcorder_mstream_delivery_destroy(g_cam_handle);
+
+	mm_camcorder_unrealize(g_cam_handle);
+}
+
+TEST_F(MMCamcorderTest, WriteMetadataInPlaceP)
+{
+	int ret = MM_ERROR_NONE;
+	int fd = -1;
+	guint64 mdat_size = 4 * 1024 * 1024;
+	guint64 mdat_size_written = 0;
+	guint32 moov_size = 0;
+	guint32 udta_size = 0;
+	long children_len = 0;
+	guchar header[8];
+	guchar children[256];
+	guchar written[256];
+	struct stat st;
+	FILE *f = NULL;
+	temp_file file("gtests_metadata_in_place.mp4");
+	_MMCamcorderMuxIndex index;
+	_MMCamcorderLocationInfo location;
+	_MMCamcorderLocationInfo geotag;
+
+	ASSERT_TRUE(_make_synthetic_mp4(file.path, mdat_size));
+
+	location.longitude = 126978;
+	location.latitude = 37566;
+	location.altitude = 38;
+	geotag = location;
+
+	/* expected loci and geodata */
+	f = fmemopen(children, sizeof(children), "w+");
+	ASSERT_TRUE(f != NULL);
+	EXPECT_TRUE(_mmcamcorder_write_loci(f, location));
+	EXPECT_TRUE(_mmcamcorder_write_geodata(f, geotag));
+	children_len = ftell(f);
+	fclose(f);
+
+	ASSERT_GT(children_len, 0);
+	ASSERT_LE((size_t)children_len, sizeof(written));
+
+	/* index of muxing is not available, it's made from mapped file */
+	_mmcamcorder_mux_index_reset(&index);
+
+	ret = _mmcamcorder_write_metadata_in_place(file.path, &index, TRUE, location, geotag, -1);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	/* loci and geodata are appended to udta at the end of moov */
+	fd = open(file.path, O_RDONLY);
+	ASSERT_GE(fd, 0);
+
+	EXPECT_EQ(fstat(fd, &st), 0);
+	EXPECT_EQ(pread(fd, header, sizeof(header), 24), (ssize_t)sizeof(header));
+	mdat_size_written = GST_READ_UINT64_BE(header);
+	EXPECT_EQ(pread(fd, header, sizeof(header), (off_t)(16 + mdat_size)), (ssize_t)sizeof(header));
+	moov_size = GST_READ_UINT32_BE(header);
+	EXPECT_EQ(memcmp(header + 4, "moov", 4), 0);
+	EXPECT_EQ(pread(fd, header, sizeof(header), (off_t)(16 + mdat_size + 8)), (ssize_t)sizeof(header));
+	udta_size = GST_READ_UINT32_BE(header);
+	EXPECT_EQ(memcmp(header + 4, "udta", 4), 0);
+	EXPECT_EQ(pread(fd, written, children_len, (off_t)(16 + mdat_size + 16)), (ssize_t)children_len);
+
+	close(fd);
+
+	/* mdat is not changed and udta has only the new children */
+	EXPECT_EQ(mdat_size_written, mdat_size);
+	EXPECT_EQ(udta_size, (guint32)children_len + 8);
+	EXPECT_EQ(moov_size, udta_size + 8);
+	EXPECT_EQ((guint64)st.st_size, 16 + mdat_size + moov_size);
+	EXPECT_EQ(memcmp(written, children, children_len), 0);
+}
+
+TEST_F(MMCamcorderTest, SplitYUV422RowP)
+{
+	int i = 0;
+	int width = 0;
+	int is_uyvy = 0;
+	unsigned char src[(67 + 1) << 1];
+	unsigned char dst[3][67];
+	unsigned char dst_ref[3][67];
+
+	for (i = 0 ; i < (int)sizeof(src) ; i++)
+		src[i] = (unsigned char)(i * 7 + 3);
+
+	/* odd widths and widths which are not multiple of vector */
+	for (is_uyvy = 0 ; is_uyvy < 2 ; is_uyvy++) {
+		for (width = 1 ; width <= 67 ; width++) {
+			memset(dst, 0x0, sizeof(dst));
+			memset(dst_ref, 0x0, sizeof(dst_ref));
+
+			_mmcamcorder_split_yuv422_row(src, dst[0], dst[1], dst[2], width, is_uyvy);
+			_mmcamcorder_split_yuv422_row_ref(src, dst_ref[0], dst_ref[1], dst_ref[2], width, is_uyvy);
+
+			ASSERT_EQ(memcmp(dst, dst_ref, sizeof(dst)), 0) << "uyvy " << is_uyvy << ", width " << width;
+
+			/* odd line without chroma */
+			memset(dst, 0x0, sizeof(dst));
+			memset(dst_ref, 0x0, sizeof(dst_ref));
+
+			_mmcamcorder_split_yuv422_row(src, dst[0], NULL, NULL, width, is_uyvy);
+			_mmcamcorder_split_yuv422_row_ref(src, dst_ref[0], NULL, NULL, width, is_uyvy);
+
+			ASSERT_EQ(memcmp(dst, dst_ref, sizeof(dst)), 0) << "uyvy " << is_uyvy << ", width " << width;
+			ASSERT_EQ(dst[0][width - 1], src[((width - 1) << 1) + is_uyvy]) << "uyvy " << is_uyvy << ", width " << width;
+		}
+	}
+}
+
+TEST_F(MMCamcorderTest, AudioSquareSumP)
+{
+	int i = 0;
+	int channel = 0;
+	int sample_num = 0;
+	int count = 0;
+	int count_ref = 0;
+	gint16 pcm16[1027];
+	guint64 square_sum[_MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX];
+	guint64 square_sum_ref[_MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX];
+	GRand *rand = g_rand_new_with_seed(0x1234);
+
+	/* full scale samples with INT16_MIN */
+	for (i = 0 ; i < 1027 ; i++) {
+		if (i % 5 == 0)
+			pcm16[i] = G_MININT16;
+		else
+			pcm16[i] = (gint16)g_rand_int_range(rand, G_MININT16, G_MAXINT16 + 1);
+	}
+
+	g_rand_free(rand);
+
+	/* every length to cover remained samples which are not multiple of vector */
+	for (channel = 1 ; channel <= _MMCAMCORDER_AUDIO_LEVEL_CHANNEL_MAX ; channel++) {
+		for (sample_num = 0 ; sample_num <= 1027 ; sample_num++) {
+			ASSERT_TRUE(_mmcamcorder_get_audio_square_sum((unsigned char *)pcm16, sample_num << 1,
+				MM_CAMCORDER_AUDIO_FORMAT_PCM_S16_LE, channel, square_sum, &count));
+			ASSERT_TRUE(_mmcamcorder_get_audio_square_sum_ref((unsigned char *)pcm16, sample_num << 1,
+				MM_CAMCORDER_AUDIO_FORMAT_PCM_S16_LE, channel, square_sum_ref, &count_ref));
+
+			ASSERT_EQ(count, count_ref) << "channel " << channel << ", sample " << sample_num;
+
+			for (i = 0 ; i < channel ; i++)
+				ASSERT_EQ(square_sum[i], square_sum_ref[i]) << "channel " << channel << ", sample " << sample_num;
+		}
+	}
+}
+
+#ifdef _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK
+TEST_F(MMCamcorderTest, MessageOrderP)
+{
+	int ret = MM_ERROR_NONE;
+	int i = 0;
+	int total = _MMCAMCORDER_MSG_RING_SIZE * 2;
+	vector< pair<int, int> > messages;
+	_MMCamcorderMsgItem msg;
+
+	/* flush messages sent by create */
+	while (g_main_context_iteration(NULL, FALSE));
+
+	ret = mm_camcorder_set_message_callback(g_cam_handle, _message_order_callback, &messages);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	memset(&msg, 0x0, sizeof(_MMCamcorderMsgItem));
+	msg.id = MM_MESSAGE_CAMCORDER_ERROR;
+	msg.param.code = -1;
+	EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+
+	/* only the latest one is delivered at the position of the first one */
+	memset(&msg, 0x0, sizeof(_MMCamcorderMsgItem));
+	msg.id = MM_MESSAGE_CAMCORDER_RECORDING_STATUS;
+	msg.param.recording_status.elapsed = 1;
+	EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+	msg.param.recording_status.elapsed = 2;
+	EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+
+	/* overflow the ring */
+	for (i = 0 ; i < total ; i++) {
+		memset(&msg, 0x0, sizeof(_MMCamcorderMsgItem));
+		msg.id = MM_MESSAGE_CAMCORDER_ERROR;
+		msg.param.code = i;
+		EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+	}
+
+	memset(&msg, 0x0, sizeof(_MMCamcorderMsgItem));
+	msg.id = MM_MESSAGE_CAMCORDER_TIME_LIMIT;
+	EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+
+	while (g_main_context_iteration(NULL, FALSE));
+
+	mm_camcorder_set_message_callback(g_cam_handle, _message_callback, NULL);
+
+	ASSERT_EQ(messages.size(), (size_t)(total + 3));
+	EXPECT_EQ(messages[0], make_pair((int)MM_MESSAGE_CAMCORDER_ERROR, -1));
+	EXPECT_EQ(messages[1], make_pair((int)MM_MESSAGE_CAMCORDER_RECORDING_STATUS, 2));
+
+	for (i = 0 ; i < total ; i++)
+		EXPECT_EQ(messages[i + 2], make_pair((int)MM_MESSAGE_CAMCORDER_ERROR, i));
+
+	EXPECT_EQ(messages[total + 2].first, (int)MM_MESSAGE_CAMCORDER_TIME_LIMIT);
+}
+
+TEST_F(MMCamcorderTest, MessageOverflowDropP)
+{
+	int ret = MM_ERROR_NONE;
+	int i = 0;
+	int dropped = 8;
+	int capacity = _MMCAMCORDER_MSG_RING_SIZE + _MMCAMCORDER_MSG_OVERFLOW_SIZE;
+	vector< pair<int, int> > messages;
+	_MMCamcorderMsgItem msg;
+	mmf_camcorder_t *hcamcorder = MMF_CAMCORDER(g_cam_handle);
+	_MMCamcorderMsgSource *msg_source = NULL;
+
+	ASSERT_TRUE(hcamcorder != NULL);
+
+	msg_source = (_MMCamcorderMsgSource *)hcamcorder->msg_source;
+	ASSERT_TRUE(msg_source != NULL);
+
+	/* flush messages sent by create */
+	while (g_main_context_iteration(NULL, FALSE));
+
+	ret = mm_camcorder_set_message_callback(g_cam_handle, _message_order_callback, &messages);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	/* ring and overflow queue are full, then new messages are dropped */
+	for (i = 0 ; i < capacity + dropped ; i++) {
+		memset(&msg, 0x0, sizeof(_MMCamcorderMsgItem));
+		msg.id = MM_MESSAGE_CAMCORDER_ERROR;
+		msg.param.code = i;
+		EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+	}
+
+	EXPECT_EQ(msg_source->overflow_count, _MMCAMCORDER_MSG_OVERFLOW_SIZE);
+	EXPECT_EQ(msg_source->overflow_dropped, dropped);
+
+	while (g_main_context_iteration(NULL, FALSE));
+
+	EXPECT_EQ(msg_source->overflow_count, 0);
+
+	/* ring is available again after it's drained */
+	memset(&msg, 0x0, sizeof(_MMCamcorderMsgItem));
+	msg.id = MM_MESSAGE_CAMCORDER_TIME_LIMIT;
+	EXPECT_TRUE(_mmcamcorder_send_message(g_cam_handle, &msg));
+
+	while (g_main_context_iteration(NULL, FALSE));
+
+	mm_camcorder_set_message_callback(g_cam_handle, _message_callback, NULL);
+
+	ASSERT_EQ(messages.size(), (size_t)(capacity + 1));
+
+	for (i = 0 ; i < capacity ; i++)
+		EXPECT_EQ(messages[i], make_pair((int)MM_MESSAGE_CAMCORDER_ERROR, i));
+
+	EXPECT_EQ(messages[capacity].first, (int)MM_MESSAGE_CAMCORDER_TIME_LIMIT);
+	EXPECT_EQ(msg_source->overflow_dropped, dropped);
+}
+#endif /* _MMCAMCORDER_ENABLE_IDLE_MESSAGE_CALLBACK */
+
+TEST_F(MMCamcorderTest, InvalidateConfigureP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_destroy(g_cam_handle);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	g_cam_handle = NULL;
+
+	ret = mm_camcorder_invalidate_configure();
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_create(&g_cam_handle, &g_info);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, CorruptConfigureCacheP)
+{
+	int ret = MM_ERROR_NONE;
+	int i = 0;
+	gsize length = 0;
+	gchar *contents = NULL;
+	gchar *cache_path = NULL;
+	conf_cache_header *header = NULL;
+
+	ret = mm_camcorder_destroy(g_cam_handle);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	g_cam_handle = NULL;
+
+	/* cache is saved by the handle created in SetUp */
+	cache_path = g_strdup_printf("%s/libmm-camcorder/%s.cache", g_get_user_cache_dir(), CONFIGURE_MAIN_FILE);
+	ASSERT_TRUE(g_file_get_contents(cache_path, &contents, &length, NULL));
+
+	header = (conf_cache_header *)contents;
+	for (i = 0 ; i < CONFIGURE_CATEGORY_MAIN_NUM && header->category[i] == 0 ; i++);
+	ASSERT_LT(i, CONFIGURE_CATEGORY_MAIN_NUM);
+
+	/* detail array runs over the end of cache */
+	((conf_detail *)(contents + header->category[i]))->count = G_MAXINT;
+	ASSERT_TRUE(g_file_set_contents(cache_path, contents, length, NULL));
+	g_free(contents);
+
+	ret = mm_camcorder_invalidate_configure();
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	/* corrupt cache is ignored and ini file is parsed again */
+	ret = mm_camcorder_create(&g_cam_handle, &g_info);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	/* cache is saved again */
+	ASSERT_TRUE(g_file_get_contents(cache_path, &contents, &length, NULL));
+	header = (conf_cache_header *)contents;
+	EXPECT_NE(((conf_detail *)(contents + header->category[i]))->count, G_MAXINT);
+
+	g_free(contents);
+	g_free(cache_path);
+}
+
+TEST_F(MMCamcorderTest, GetAttributesP)
+{
+	int ret = MM_ERROR_NONE;
+	int device_count = 0;
+	int audio_device = 0;
+
+	ret = mm_camcorder_get_attributes(g_cam_handle, NULL,
+		MMCAM_CAMERA_DEVICE_COUNT, &device_count,
+		MMCAM_AUDIO_DEVICE, &audio_device,
+		NULL);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, SetAttributesP)
+{
+	int ret = MM_ERROR_NONE;
+	int audio_encoder = 0;
+	int file_format = 0;
+	gboolean ret_settings = FALSE;
+
+	ret_settings = _get_audio_recording_settings(&audio_encoder, &file_format);
+	ASSERT_EQ(ret_settings, TRUE);
+
+	ret = mm_camcorder_set_attributes(g_cam_handle, NULL,
+		MMCAM_MODE, MM_CAMCORDER_MODE_AUDIO,
+		MMCAM_AUDIO_ENCODER, audio_encoder,
+		MMCAM_FILE_FORMAT, file_format,
+		NULL);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, CommitAttributesP)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_begin_attributes(g_cam_handle);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_set_attributes(g_cam_handle, NULL,
+		MMCAM_DISPLAY_ROTATION, MM_DISPLAY_ROTATION_NONE,
+		MMCAM_DISPLAY_FLIP, MM_FLIP_NONE,
+		NULL);
+	EXPECT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_commit_attributes(g_cam_handle);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+}
+
+TEST_F(MMCamcorderTest, CommitAttributesN)
+{
+	int ret = MM_ERROR_NONE;
+
+	ret = mm_camcorder_begin_attributes(NULL);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_ARGUMENT);
+
+	ret = mm_camcorder_commit_attributes(g_cam_handle);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_STATE);
+
+	ret = mm_camcorder_begin_attributes(g_cam_handle);
+	ASSERT_EQ(ret, MM_ERROR_NONE);
+
+	ret = mm_camcorder_begin_attributes(g_cam_handle);
+	EXPECT_EQ(ret, MM_ERROR_CAMCORDER_INVALID_STATE);
+
+	mm_camcorder_commit_attributes(g_cam_handle);
 }
 
 TEST_F(MMCamcorderTest, GetAttributeInfoP)